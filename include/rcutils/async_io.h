@@ -0,0 +1,256 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+/// \brief Asynchronous file operations, submitted in batches.
+/**
+ * File operations are submitted with rcutils_async_io_submit() without blocking, and their
+ * results are given to the callbacks of the requests by rcutils_async_io_wait().
+ *
+ * On Linux 5.11 or later, the operations are done by the kernel through an io_uring, so that a
+ * whole batch is submitted with a single system call.
+ * Elsewhere, or if io_uring isn't available, like when it is forbidden by a seccomp filter,
+ * they are done by a pool of threads calling the blocking functions.
+ *
+ * An rcutils_async_io_t must only be used by one thread at a time.
+ */
+
+#ifndef RCUTILS__ASYNC_IO_H_
+#define RCUTILS__ASYNC_IO_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/filesystem.h"
+#include "rcutils/macros.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control.h"
+
+/// How the operations are done.
+typedef enum rcutils_async_io_backend_e
+{
+  /// With io_uring if available, and with a pool of threads otherwise.
+  RCUTILS_ASYNC_IO_BACKEND_AUTO = 0,
+  /// By the kernel through an io_uring, which is only available on Linux.
+  RCUTILS_ASYNC_IO_BACKEND_IO_URING,
+  /// By a pool of threads calling the blocking functions.
+  RCUTILS_ASYNC_IO_BACKEND_THREAD_POOL
+} rcutils_async_io_backend_t;
+
+/// The options of rcutils_async_io_init().
+typedef struct rcutils_async_io_options_s
+{
+  /// How the operations are done.
+  rcutils_async_io_backend_t backend;
+  /// The maximum number of operations in progress at the same time, up to 32768, or 0 for 256.
+  size_t queue_depth;
+  /// The number of threads of the pool, if one is used, or 0 for 4.
+  size_t thread_count;
+} rcutils_async_io_options_t;
+
+/// The operation of an rcutils_async_io_request_t.
+typedef enum rcutils_async_io_operation_e
+{
+  /// Read length bytes at offset of fd into buffer, like pread().
+  RCUTILS_ASYNC_IO_READ = 0,
+  /// Write length bytes of buffer at offset of fd, like pwrite().
+  RCUTILS_ASYNC_IO_WRITE,
+  /// Flush the data of fd to its storage device, like fsync().
+  RCUTILS_ASYNC_IO_FSYNC,
+  /// Get the information about the file at path into stat, like stat().
+  RCUTILS_ASYNC_IO_STAT,
+  /// Open the file at path, like open(), giving its descriptor as result.
+  RCUTILS_ASYNC_IO_OPEN,
+  /// Close fd, like close().
+  RCUTILS_ASYNC_IO_CLOSE
+} rcutils_async_io_operation_t;
+
+/// The flags of an rcutils_async_io_request_t, which may be combined.
+typedef enum rcutils_async_io_flag_e
+{
+  /// For #RCUTILS_ASYNC_IO_OPEN, open the file for reading.
+  RCUTILS_ASYNC_IO_OPEN_READ = 1 << 0,
+  /// For #RCUTILS_ASYNC_IO_OPEN, open the file for writing.
+  RCUTILS_ASYNC_IO_OPEN_WRITE = 1 << 1,
+  /// For #RCUTILS_ASYNC_IO_OPEN, create the file if it doesn't exist.
+  RCUTILS_ASYNC_IO_OPEN_CREATE = 1 << 2,
+  /// For #RCUTILS_ASYNC_IO_OPEN, empty the file if it exists.
+  RCUTILS_ASYNC_IO_OPEN_TRUNCATE = 1 << 3,
+  /// For #RCUTILS_ASYNC_IO_OPEN, write at the end of the file, whatever the offset.
+  RCUTILS_ASYNC_IO_OPEN_APPEND = 1 << 4,
+  /// For #RCUTILS_ASYNC_IO_FSYNC, only flush the data, and the metadata needed to read it.
+  RCUTILS_ASYNC_IO_FSYNC_DATA_ONLY = 1 << 5,
+  /// For #RCUTILS_ASYNC_IO_STAT, get the information about symbolic links themselves.
+  RCUTILS_ASYNC_IO_STAT_NO_FOLLOW = 1 << 6
+} rcutils_async_io_flag_t;
+
+struct rcutils_async_io_request_s;
+
+/// The function given the result of a request.
+/**
+ * It is called by rcutils_async_io_wait(), rcutils_async_io_submit() or
+ * rcutils_async_io_fini(), on their calling thread.
+ *
+ * \param[in] request A copy of the request submitted, valid only during the call
+ * \param[in] result The number of bytes read or written, the descriptor of the opened file,
+ *   0 for the other operations, or a negative errno value if the operation failed
+ */
+typedef void (* rcutils_async_io_callback_t)(
+  const struct rcutils_async_io_request_s * request, int64_t result);
+
+/// A file operation to do.
+/**
+ * The memory it points to must stay valid until its callback is called.
+ */
+typedef struct rcutils_async_io_request_s
+{
+  /// The operation to do.
+  rcutils_async_io_operation_t operation;
+  /// The file descriptor, for #RCUTILS_ASYNC_IO_READ, WRITE, FSYNC and CLOSE.
+  int fd;
+  /// The path of the file, for #RCUTILS_ASYNC_IO_STAT and OPEN.
+  const char * path;
+  /// The data to write, or the buffer to read into.
+  void * buffer;
+  /// The number of bytes to read or write.
+  /**
+   * As with pread() and pwrite(), fewer may be read or written, up to 2 GiB on Linux.
+   */
+  size_t length;
+  /// The offset in the file to read or write at.
+  uint64_t offset;
+  /// A combination of #rcutils_async_io_flag_t.
+  uint32_t flags;
+  /// The information about the file, for #RCUTILS_ASYNC_IO_STAT.
+  rcutils_file_stat_t * stat;
+  /// The function given the result, or `NULL`.
+  rcutils_async_io_callback_t callback;
+  /// Data for the callback.
+  void * user_data;
+} rcutils_async_io_request_t;
+
+struct rcutils_async_io_impl_s;
+
+/// An engine doing file operations asynchronously.
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_async_io_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_async_io_impl_s * impl;
+} rcutils_async_io_t;
+
+/// Return an empty engine struct, to be initialized with rcutils_async_io_init().
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_async_io_t
+rcutils_get_zero_initialized_async_io(void);
+
+/// Return the default options of rcutils_async_io_init().
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_async_io_options_t
+rcutils_get_default_async_io_options(void);
+
+/// Initialize an engine doing file operations asynchronously.
+/**
+ * \param[inout] io The zero initialized engine
+ * \param[in] options The options of the engine, or `NULL` for the default ones
+ * \param[in] allocator The allocator of the engine, which may be used by its threads
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCUTILS_RET_ERROR if the io_uring backend was asked for but isn't available, or
+ *   the threads couldn't be started.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_async_io_init(
+  rcutils_async_io_t * io,
+  const rcutils_async_io_options_t * options,
+  const rcutils_allocator_t * allocator);
+
+/// Wait for the operations in progress, and finalize an engine.
+/**
+ * The callbacks of the operations in progress are called.
+ * Finalizing a zero initialized engine does nothing.
+ *
+ * \param[inout] io The engine to finalize
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_async_io_fini(rcutils_async_io_t * io);
+
+/// Return how the operations of an engine are done, or #RCUTILS_ASYNC_IO_BACKEND_AUTO if it
+/// isn't initialized.
+RCUTILS_PUBLIC
+rcutils_async_io_backend_t
+rcutils_async_io_get_backend(const rcutils_async_io_t * io);
+
+/// Start a batch of file operations.
+/**
+ * The requests are copied, so the array may be reused once this returns.
+ * If more operations than the queue depth would be in progress, this waits for some to
+ * complete, and calls their callbacks.
+ *
+ * \param[in] io The initialized engine
+ * \param[in] requests The operations to start
+ * \param[in] count The number of requests
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if the operations couldn't be submitted, in which case the ones
+ *   before the one failing were.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_async_io_submit(
+  rcutils_async_io_t * io,
+  const rcutils_async_io_request_t * requests,
+  size_t count);
+
+/// Wait for operations to complete, and call their callbacks.
+/**
+ * \param[in] io The initialized engine
+ * \param[in] min_completions The number of operations to wait for, which is limited to the
+ *   number in progress, so that SIZE_MAX waits for all of them, and 0 doesn't wait
+ * \param[in] timeout The maximum time to wait in nanoseconds, or a negative value to wait
+ *   without limit
+ * \param[out] completions The number of operations completed, which may be `NULL`
+ * \return #RCUTILS_RET_OK if successful, even if the timeout expired, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if waiting failed.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_async_io_wait(
+  rcutils_async_io_t * io,
+  size_t min_completions,
+  int64_t timeout,
+  size_t * completions);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__ASYNC_IO_H_
@@ -0,0 +1,166 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+/// \brief Walk a directory tree with several threads.
+
+#ifndef RCUTILS__DIR_WALK_H_
+#define RCUTILS__DIR_WALK_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/filesystem.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control.h"
+
+/// What to do after an entry is given to a rcutils_dir_walk_callback_t.
+typedef enum rcutils_dir_walk_action_e
+{
+  /// Continue the walk, into the entry if it is a directory.
+  RCUTILS_DIR_WALK_CONTINUE = 0,
+  /// Continue the walk, but not into the entry.
+  RCUTILS_DIR_WALK_SKIP_SUBTREE,
+  /// Stop the walk as soon as possible.
+  RCUTILS_DIR_WALK_STOP
+} rcutils_dir_walk_action_t;
+
+/// How symbolic links are walked.
+typedef enum rcutils_dir_walk_symlinks_e
+{
+  /// Symbolic links are given as such, and never walked into.
+  RCUTILS_DIR_WALK_SYMLINKS_NO_FOLLOW = 0,
+  /// Symbolic links are given as the entry they point to, and walked into if it is a directory.
+  /**
+   * Each directory is walked once, even if several links point to it, so that cycles end.
+   * On Windows, directories aren't identified, so max_depth should limit cycles instead.
+   */
+  RCUTILS_DIR_WALK_SYMLINKS_FOLLOW
+} rcutils_dir_walk_symlinks_t;
+
+/// The options of rcutils_dir_walk().
+typedef struct rcutils_dir_walk_options_s
+{
+  /// The number of threads walking, including the calling one.
+  /**
+   * 0 means as many as processors, up to 16.
+   */
+  size_t thread_count;
+  /// The maximum depth of the entries, as for rcutils_calculate_directory_size_with_recursion().
+  /**
+   * The entries of the walked directory are at depth 1, the ones of its subdirectories at
+   * depth 2, and so on. 0 means no limitation.
+   */
+  size_t max_depth;
+  /// How symbolic links are walked.
+  rcutils_dir_walk_symlinks_t symlinks;
+} rcutils_dir_walk_options_t;
+
+struct rcutils_dir_walk_entry_impl_s;
+
+/// An entry found by rcutils_dir_walk().
+typedef struct rcutils_dir_walk_entry_s
+{
+  /// The name of the entry in its directory.
+  const char * name;
+  /// The path of the directory of the entry, relative to the walked one, or "" for it.
+  const char * directory;
+  /// The depth of the entry, 1 for the entries of the walked directory.
+  size_t depth;
+  /// The type of the entry, which is never #RCUTILS_FILE_TYPE_UNKNOWN.
+  rcutils_file_type_t type;
+  /// The private implementation of the entry.
+  struct rcutils_dir_walk_entry_impl_s * impl;
+} rcutils_dir_walk_entry_t;
+
+/// The function given each entry found by rcutils_dir_walk().
+/**
+ * It is called concurrently from all the walking threads.
+ * The entry, and the strings it points to, are only valid during the call.
+ *
+ * \param[in] entry The entry found
+ * \param[in] user_data The pointer given to rcutils_dir_walk()
+ * \return What to do next.
+ */
+typedef rcutils_dir_walk_action_t (* rcutils_dir_walk_callback_t)(
+  const rcutils_dir_walk_entry_t * entry, void * user_data);
+
+/// Return the default options of rcutils_dir_walk().
+/**
+ * They walk with as many threads as processors, without depth limit nor following symbolic
+ * links.
+ *
+ * \return The default options.
+ */
+RCUTILS_PUBLIC
+rcutils_dir_walk_options_t
+rcutils_get_default_dir_walk_options(void);
+
+/// Walk a directory tree with several threads, giving each entry to a callback.
+/**
+ * Each directory is walked by a single thread, and the threads take the directories found by
+ * others when they have none left, starting with the ones found first, which tend to hold the
+ * largest subtrees.
+ * The entries "." and ".." aren't given.
+ *
+ * On POSIX systems, the entries are queried relatively to their directory, and their type is
+ * given by the directory itself on most file systems, so nothing is queried for them unless
+ * rcutils_dir_walk_entry_stat() is called.
+ *
+ * \param[in] directory_path The path of the directory to walk.
+ * \param[in] options The options of the walk, or `NULL` for the default ones.
+ * \param[in] callback The function to give each entry.
+ * \param[in] user_data The pointer given to the callback.
+ * \param[in] allocator The allocator used for the walk, which must be usable from several
+ *   threads at the same time.
+ * \return #RCUTILS_RET_OK if the walk completed, or was stopped by the callback, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if a directory can't be read.
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_dir_walk(
+  const char * directory_path,
+  const rcutils_dir_walk_options_t * options,
+  rcutils_dir_walk_callback_t callback,
+  void * user_data,
+  rcutils_allocator_t allocator);
+
+/// Get the information about an entry given to a rcutils_dir_walk_callback_t.
+/**
+ * The entry is only queried the first time, and only if its directory didn't give the
+ * information already.
+ * With #RCUTILS_DIR_WALK_SYMLINKS_FOLLOW, symbolic links are followed.
+ *
+ * \param[in] entry The entry given to the callback.
+ * \param[out] stat The information about the entry.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if the entry can't be queried, for example if it was removed.
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_dir_walk_entry_stat(const rcutils_dir_walk_entry_t * entry, rcutils_file_stat_t * stat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__DIR_WALK_H_
@@ -134,19 +134,21 @@ static_assert(
 
 /// Forces initialization of thread-local storage if called in a newly created thread.
 /**
+ * The error state, error string, and error chain of a thread are not kept in
+ * thread-local variables, which every thread would pay for, but in storage
+ * which is allocated the first time it is needed and deallocated when the
+ * thread exits.
+ *
+ * This function allocates that storage with the given allocator, so that
+ * setting and getting errors afterwards in this thread does not allocate memory.
  * If this function is not called beforehand, then the first time the error
- * state is set or the first time the error message is retrieved, the default
- * allocator will be used to allocate thread-local storage.
- *
- * This function may or may not allocate memory.
- * The system's thread-local storage implementation may need to allocate
- * memory, since it usually has no way of knowing how much storage is needed
- * without knowing how many threads will be created.
- * Most implementations (e.g. C11, C++11, and pthread) do not have ways to
- * specify how this memory is allocated, but if the implementation allows, the
- * given allocator to this function will be used, but is otherwise unused.
- * This only occurs when creating and destroying threads, which can be avoided
- * in the "steady" state by reusing pools of threads.
+ * state is copied, the error state is retrieved, or an error frame is pushed,
+ * the default allocator will be used to allocate the storage.
+ * Setting an error by reference, see RCUTILS_SET_ERROR_MSG_STATIC(), and
+ * getting the error string never allocate the storage.
+ *
+ * The storage is deallocated with the same allocator when the thread exits,
+ * therefore the allocator must remain valid until then.
  *
  * It is worth considering that repeated thread creation and destruction will
  * result in repeated memory allocations and could result in memory
@@ -185,6 +187,11 @@ rcutils_initialize_error_handling_thread_local_storage(rcutils_allocator_t alloc
  * The file parameter is copied into the internal error storage and must
  * be null terminated.
  *
+ * If the thread-local storage is not initialized yet, it is allocated with the
+ * default allocator, see rcutils_initialize_error_handling_thread_local_storage().
+ * If that fails, an error is still set, but with a message saying that the
+ * error state is unavailable.
+ *
  * \param[in] error_string The error message to set.
  * \param[in] file The path to the file in which the error occurred.
  * \param[in] line_number The line number on which the error occurred.
@@ -193,6 +200,27 @@ RCUTILS_PUBLIC
 void
 rcutils_set_error_state(const char * error_string, const char * file, size_t line_number);
 
+/// Set the error message, as well as the file and line on which it occurred, by reference.
+/**
+ * This is not meant to be used directly, but instead via the
+ * RCUTILS_SET_ERROR_MSG_STATIC(msg) macro.
+ *
+ * Unlike rcutils_set_error_state(), only the pointers and the line number are
+ * recorded; copying the strings into the error state and formatting the error
+ * string are deferred until rcutils_get_error_state() or rcutils_get_error_string()
+ * are called.
+ * Therefore both error_string and file must be null terminated and have static
+ * storage duration, e.g. be string literals, and must not be part of a shared
+ * library which is unloaded while the error is set.
+ *
+ * \param[in] error_string The error message to set.
+ * \param[in] file The path to the file in which the error occurred.
+ * \param[in] line_number The line number on which the error occurred.
+ */
+RCUTILS_PUBLIC
+void
+rcutils_set_error_state_static(const char * error_string, const char * file, size_t line_number);
+
 /// Check an argument for a null value.
 /**
  * If the argument's value is `NULL`, set the error message saying so and
@@ -231,11 +259,30 @@ rcutils_set_error_state(const char * error_string, const char * file, size_t lin
  * Error state storage is thread local and so all error related functions are
  * also thread local.
  *
+ * The message and the file are copied into the error state.
+ *
  * \param[in] msg The error message to be set.
  */
 #define RCUTILS_SET_ERROR_MSG(msg) \
   do {rcutils_set_error_state(msg, __FILE__, __LINE__);} while (0)
 
+/// Set the error message by reference, as well as append the current file and line number.
+/**
+ * Same as RCUTILS_SET_ERROR_MSG(), except that the message and the file are not
+ * copied, see rcutils_set_error_state_static(), which makes setting errors cheaper
+ * in code where they are frequent and seldom read.
+ *
+ * The message must be a string literal.
+ * It is only copied when the error is read, so the library or executable calling
+ * this macro, which holds both the message and the `__FILE__` string, must not be
+ * unloaded, e.g. with `dlclose()`, while the error is set.
+ * Use RCUTILS_SET_ERROR_MSG() if that isn't guaranteed.
+ *
+ * \param[in] msg The error message to be set, as a string literal.
+ */
+#define RCUTILS_SET_ERROR_MSG_STATIC(msg) \
+  do {rcutils_set_error_state_static("" msg, __FILE__, __LINE__);} while (0)
+
 /// Set the error message using a format string and format arguments.
 /**
  * This function sets the error message using the given format string.
@@ -309,11 +356,163 @@ RCUTILS_WARN_UNUSED
 rcutils_error_string_t
 rcutils_get_error_string(void);
 
+/// Return the error message followed by `, at <file>:<line>` if set, else "error not set".
+/**
+ * Unlike rcutils_get_error_string(), this function does not copy the error
+ * string but returns a pointer to the thread-local storage, which avoids
+ * copying RCUTILS_ERROR_MESSAGE_MAX_LENGTH bytes when the error string is only
+ * logged or formatted into another string.
+ *
+ * The returned string is valid until RCUTILS_SET_ERROR_MSG, rcutils_set_error_state,
+ * or rcutils_reset_error are called in the same thread, and must not be used from
+ * other threads.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes [1]
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if the thread-local storage is not initialized yet, see
+ * rcutils_initialize_error_handling_thread_local_storage()</i>
+ *
+ * \return The current error string, with file and line number, or "error not set" if not set.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+const char *
+rcutils_get_error_c_str(void);
+
 /// Reset the error state by clearing any previously set error state.
+/**
+ * This also clears the error chain, see rcutils_push_error_frame().
+ */
 RCUTILS_PUBLIC
 void
 rcutils_reset_error(void);
 
+/// The maximum number of frames kept in the error chain of a thread.
+#define RCUTILS_ERROR_CHAIN_MAX_FRAMES 16
+
+/// Struct which describes one frame of the error chain, see rcutils_push_error_frame().
+typedef struct rcutils_error_frame_s
+{
+  /// The error message, by reference.
+  const char * message;
+  /// The path to the file in which the error occurred, by reference.
+  const char * file;
+  /// Line number of the error.
+  size_t line_number;
+  /// The error code returned because of the error.
+  rcutils_ret_t code;
+} rcutils_error_frame_t;
+
+/// Push a frame on the error chain of the calling thread.
+/**
+ * This is not meant to be used directly, but instead via the
+ * RCUTILS_PUSH_ERROR_FRAME(code, msg) macro.
+ *
+ * The error chain records where an error was propagated through a call stack,
+ * from the root cause to the outermost caller, with each layer pushing a frame
+ * when it returns an error because of the layer below it.
+ * It is independent from the error message set with RCUTILS_SET_ERROR_MSG(), and
+ * pushing a frame neither copies nor formats any string.
+ * The chain is rendered on demand by rcutils_get_error_chain_string().
+ *
+ * The chain holds at most RCUTILS_ERROR_CHAIN_MAX_FRAMES frames: once full, the
+ * first frame, i.e. the root cause, is kept and the oldest of the following frames
+ * are dropped.
+ * The chain is cleared by rcutils_reset_error().
+ *
+ * Both message and file are recorded by reference, so they must be null
+ * terminated and have static storage duration, e.g. be string literals.
+ * If the thread-local storage cannot be allocated, the frame is not pushed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes [1]
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if the thread-local storage is not initialized yet, see
+ * rcutils_initialize_error_handling_thread_local_storage()</i>
+ *
+ * \param[in] code The error code returned because of the error.
+ * \param[in] message The error message.
+ * \param[in] file The path to the file in which the error occurred.
+ * \param[in] line_number The line number on which the error occurred.
+ */
+RCUTILS_PUBLIC
+void
+rcutils_push_error_frame(
+  rcutils_ret_t code, const char * message, const char * file, size_t line_number);
+
+/// Push a frame with the current file and line number on the error chain.
+/**
+ * \param[in] code The error code returned because of the error.
+ * \param[in] msg The error message, must be a string literal.
+ */
+#define RCUTILS_PUSH_ERROR_FRAME(code, msg) \
+  do {rcutils_push_error_frame(code, "" msg, __FILE__, __LINE__);} while (0)
+
+/// Return the number of frames in the error chain of the calling thread.
+/**
+ * This does not include the frames which were dropped, see
+ * rcutils_get_error_chain_dropped_frame_count().
+ *
+ * \return The number of frames, at most RCUTILS_ERROR_CHAIN_MAX_FRAMES.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+size_t
+rcutils_get_error_chain_size(void);
+
+/// Return the number of frames which were dropped from the error chain of the calling thread.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+size_t
+rcutils_get_error_chain_dropped_frame_count(void);
+
+/// Return a frame of the error chain of the calling thread.
+/**
+ * The frames are ordered from the root cause, at index 0, to the most recently
+ * pushed frame, at index `rcutils_get_error_chain_size() - 1`.
+ * If frames were dropped, they were between the frames at index 0 and 1.
+ *
+ * The returned pointer is valid until rcutils_push_error_frame() or
+ * rcutils_reset_error() are called in the same thread.
+ *
+ * \param[in] index The index of the frame.
+ * \return A pointer to the frame, or
+ * \return `NULL` if the index is out of range.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+const rcutils_error_frame_t *
+rcutils_get_error_chain_frame(size_t index);
+
+/// Return the rendered error chain of the calling thread, or "error chain empty".
+/**
+ * The frames are rendered from the most recent one to the root cause, e.g.:
+ *
+ * ```
+ * failed to take (error code 1), at rcl/subscription.c:42
+ *   caused by: no data (error code 1), at rmw/take.c:7
+ * ```
+ *
+ * If frames were dropped, their number is rendered before the root cause, as
+ * `[N frames dropped]`.
+ * The string is silently truncated at RCUTILS_ERROR_MESSAGE_MAX_LENGTH.
+ *
+ * \return The rendered error chain.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_error_string_t
+rcutils_get_error_chain_string(void);
+
 /// Set the error message using RCUTILS_SET_ERROR_MSG and append the previous error.
 /**
  * If there is no previous error, has same behavior as RCUTILS_SET_ERROR_MSG.
@@ -321,10 +520,15 @@ rcutils_reset_error(void);
  */
 #define RCUTILS_SET_ERROR_MSG_AND_APPEND_PREV_ERROR(msg) \
   do { \
-    rcutils_error_string_t error_string = rcutils_get_error_string(); \
+    char output_msg[RCUTILS_ERROR_MESSAGE_MAX_LENGTH]; \
+    int ret = rcutils_snprintf( \
+      output_msg, sizeof(output_msg), RCUTILS_EXPAND(msg ": %s"), rcutils_get_error_c_str()); \
     rcutils_reset_error(); \
-    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING( \
-      RCUTILS_EXPAND(msg ": %s"), error_string.str); \
+    if (ret < 0) { \
+      RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to call snprintf for error message formatting\n"); \
+    } else { \
+      RCUTILS_SET_ERROR_MSG(output_msg); \
+    } \
   } while (0)
 
 /// Set the error message with RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING and append the previous
@@ -341,10 +545,16 @@ rcutils_reset_error(void);
  */
 #define RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING_AND_APPEND_PREV_ERROR(format_string, ...) \
   do { \
-    rcutils_error_string_t error_string = rcutils_get_error_string(); \
+    char output_msg[RCUTILS_ERROR_MESSAGE_MAX_LENGTH]; \
+    int ret = rcutils_snprintf( \
+      output_msg, sizeof(output_msg), RCUTILS_EXPAND(format_string ": %s"), __VA_ARGS__, \
+      rcutils_get_error_c_str()); \
     rcutils_reset_error(); \
-    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING( \
-      RCUTILS_EXPAND(format_string ": %s"), __VA_ARGS__, error_string.str); \
+    if (ret < 0) { \
+      RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to call snprintf for error message formatting\n"); \
+    } else { \
+      RCUTILS_SET_ERROR_MSG(output_msg); \
+    } \
   } while (0)
 
 /// Write the given msg out to stderr, limiting the buffer size in the `fwrite`, appending the
@@ -355,10 +565,9 @@ rcutils_reset_error(void);
  */
 #define RCUTILS_SAFE_FWRITE_TO_STDERR_AND_APPEND_PREV_ERROR(msg) \
   do { \
-    rcutils_error_string_t error_string = rcutils_get_error_string(); \
-    rcutils_reset_error(); \
     RCUTILS_SAFE_FWRITE_TO_STDERR(msg); \
-    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(": %s", error_string.str); \
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(": %s", rcutils_get_error_c_str()); \
+    rcutils_reset_error(); \
   } while (0)
 
 /// Set the error message to stderr using a format string and format arguments, appending the
@@ -377,10 +586,9 @@ rcutils_reset_error(void);
  */
 #define RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING_AND_APPEND_PREV_ERROR(format_string, ...) \
   do { \
-    rcutils_error_string_t error_string = rcutils_get_error_string(); \
-    rcutils_reset_error(); \
     RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(format_string, __VA_ARGS__); \
-    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(": %s", error_string.str); \
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(": %s", rcutils_get_error_c_str()); \
+    rcutils_reset_error(); \
   } while (0)
 
 #ifdef __cplusplus
@@ -218,7 +218,8 @@ rcutils_calculate_directory_size(
  *                    ...
  * \endcode
  *
- * \note This API does not follow symlinks to files or directories.
+ * \note Symbolic links are followed: the files they point to are counted, and the
+ *   directories they point to are walked, as many times as they are linked.
  * \param[in] directory_path The directory path to calculate the size of.
  * \param[in] max_depth The maximum depth of subdirectory. 0 means no limitation.
  * \param[out] size The size of the directory in bytes on success.
@@ -236,6 +237,106 @@ rcutils_calculate_directory_size_with_recursion(
   uint64_t * size,
   rcutils_allocator_t allocator);
 
+/// The size of a file counted by rcutils_calculate_directory_size_with_mode().
+typedef enum rcutils_directory_size_mode_e
+{
+  /// The length of the file, as given by rcutils_get_file_size().
+  RCUTILS_DIRECTORY_SIZE_APPARENT = 0,
+  /// The space allocated for the file on disk, which is smaller for sparse files.
+  RCUTILS_DIRECTORY_SIZE_ALLOCATED
+} rcutils_directory_size_mode_t;
+
+/// Calculate the size of the specified directory with recursion, counting a given size.
+/**
+ * Same as rcutils_calculate_directory_size_with_recursion(), which counts the apparent size of
+ * the files, except that the size of each file is counted according to mode.
+ * Only regular files are counted, and not the directories themselves.
+ * Symbolic links are followed in the same way.
+ *
+ * The directory is walked by the calling thread only.
+ *
+ * \note On Windows, the allocated size is the apparent size.
+ * \param[in] directory_path The directory path to calculate the size of.
+ * \param[in] max_depth The maximum depth of subdirectory. 0 means no limitation.
+ * \param[in] mode The size counted for each file.
+ * \param[out] size The size of the directory in bytes on success.
+ * \param[in] allocator Allocator being used for the walk.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails
+ * \return #RCUTILS_RET_ERROR if other error occurs
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_calculate_directory_size_with_mode(
+  const char * directory_path,
+  size_t max_depth,
+  rcutils_directory_size_mode_t mode,
+  uint64_t * size,
+  rcutils_allocator_t allocator);
+
+/// Calculate the size of the specified directory with recursion, walking it with several threads.
+/**
+ * Same as rcutils_calculate_directory_size_with_mode(), except that the directory is walked
+ * with rcutils_dir_walk() by thread_count threads, so the allocator is called from all of them
+ * at the same time.
+ * A directory found through a symbolic link is walked by the thread which found the link.
+ *
+ * \param[in] directory_path The directory path to calculate the size of.
+ * \param[in] max_depth The maximum depth of subdirectory. 0 means no limitation.
+ * \param[in] mode The size counted for each file.
+ * \param[in] thread_count The number of threads walking, including the calling one, or 0 for
+ *   as many as processors, up to 16.
+ * \param[out] size The size of the directory in bytes on success.
+ * \param[in] allocator Allocator being used for the walk, which must be usable from several
+ *   threads at the same time.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails
+ * \return #RCUTILS_RET_ERROR if other error occurs
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_calculate_directory_size_parallel(
+  const char * directory_path,
+  size_t max_depth,
+  rcutils_directory_size_mode_t mode,
+  size_t thread_count,
+  uint64_t * size,
+  rcutils_allocator_t allocator);
+
+/// The type of a file system entry.
+typedef enum rcutils_file_type_e
+{
+  /// The type isn't known.
+  RCUTILS_FILE_TYPE_UNKNOWN = 0,
+  /// A regular file.
+  RCUTILS_FILE_TYPE_REGULAR,
+  /// A directory.
+  RCUTILS_FILE_TYPE_DIRECTORY,
+  /// A symbolic link, or on Windows another reparse point such as a junction.
+  RCUTILS_FILE_TYPE_SYMLINK,
+  /// Another type of file, such as a device, a pipe or a socket.
+  RCUTILS_FILE_TYPE_OTHER
+} rcutils_file_type_t;
+
+/// The information about a file system entry.
+typedef struct rcutils_file_stat_s
+{
+  /// The type of the entry.
+  rcutils_file_type_t type;
+  /// The length of the file in bytes.
+  uint64_t size;
+  /// The space allocated for the file on disk in bytes, which is its length on Windows.
+  uint64_t allocated_size;
+  /// The identifier of the device holding the file, which is 0 on Windows.
+  uint64_t device;
+  /// The number of the file on its device, which is 0 on Windows.
+  uint64_t inode;
+  /// The time of the last modification of the file, in nanoseconds since the Unix epoch.
+  int64_t modification_time;
+} rcutils_file_stat_t;
+
 /// Calculate the size of the specifed file.
 /**
  * \param[in] file_path The path of the file to obtain its size of.
@@ -256,6 +357,15 @@ typedef struct rcutils_dir_iter_s
   rcutils_allocator_t allocator;
   /// The platform-specific iteration state
   struct rcutils_dir_iter_state_s * state;
+  /// The type of the enumerated entry, as given by the directory
+  /**
+   * It is #RCUTILS_FILE_TYPE_UNKNOWN on file systems which don't give it, in which case
+   * rcutils_dir_iter_stat() gives it.
+   * Symbolic links are given as such.
+   */
+  rcutils_file_type_t entry_type;
+  /// The number of the enumerated entry on its device, or 0 if not known, like on Windows
+  uint64_t entry_inode;
 } rcutils_dir_iter_t;
 
 /// Begin iterating over the contents of the specified directory.
@@ -277,6 +387,37 @@ RCUTILS_PUBLIC
 rcutils_dir_iter_t *
 rcutils_dir_iter_start(const char * directory_path, const rcutils_allocator_t allocator);
 
+/// The smallest buffer accepted by rcutils_dir_iter_start_with_buffer().
+#define RCUTILS_DIR_ITER_MIN_BUFFER_SIZE 1024
+
+/// Begin iterating over the contents of a directory, reading its entries in large batches.
+/**
+ * This is the same as rcutils_dir_iter_start(), except that on Linux the entries are read
+ * with getdents64() directly into the given buffer, as many at a time as it holds, rather
+ * than in the small buffer of readdir().
+ * Directories with many entries, or on network file systems, are then listed with fewer
+ * system calls.
+ * On other systems, the buffer isn't used.
+ *
+ * The buffer must stay valid until rcutils_dir_iter_end() is called, and entry_name points
+ * into it.
+ *
+ * \param[in] directory_path The directory path to iterate over the contents of.
+ * \param[in] buffer The buffer the entries are read into.
+ * \param[in] buffer_size The size of the buffer in bytes, which must be at least
+ *   #RCUTILS_DIR_ITER_MIN_BUFFER_SIZE. 32 KiB or more is recommended.
+ * \param[in] allocator Allocator used to create the returned structure.
+ * \return An iterator object used to continue iterating directory contents
+ * \return NULL if an error occurred
+ */
+RCUTILS_PUBLIC
+rcutils_dir_iter_t *
+rcutils_dir_iter_start_with_buffer(
+  const char * directory_path,
+  void * buffer,
+  size_t buffer_size,
+  const rcutils_allocator_t allocator);
+
 /// Continue iterating over the contents of a directory.
 /**
  * \param[in] iter An iterator created by ::rcutils_dir_iter_start.
@@ -287,6 +428,25 @@ RCUTILS_PUBLIC
 bool
 rcutils_dir_iter_next(rcutils_dir_iter_t * iter);
 
+/// Get the information about the entry an iterator is on.
+/**
+ * On POSIX systems, the entry is queried relatively to the open directory the first time this
+ * is called for it, without resolving its path again, and the result is kept until the
+ * iterator moves to the next entry.
+ * Symbolic links aren't followed.
+ * On Windows, the information is given by the directory, so nothing is queried.
+ *
+ * \param[in] iter An iterator created by ::rcutils_dir_iter_start.
+ * \param[out] stat The information about the entry.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if the iterator isn't on an entry, or if the entry can't be
+ *   queried, for example if it was removed.
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_dir_iter_stat(rcutils_dir_iter_t * iter, rcutils_file_stat_t * stat);
+
 /// Finish iterating over the contents of a directory.
 /**
  * \param[in] iter An iterator created by ::rcutils_dir_iter_start.
@@ -295,6 +455,41 @@ RCUTILS_PUBLIC
 void
 rcutils_dir_iter_end(rcutils_dir_iter_t * iter);
 
+/// Function which rcutils_digest_file() gives the contents of a file to, piece by piece.
+/**
+ * \param[in] data The next piece of the file
+ * \param[in] size The size of the piece in bytes, which is never 0
+ * \param[inout] state The state given to rcutils_digest_file()
+ */
+typedef void (* rcutils_file_digest_update_t)(const uint8_t * data, size_t size, void * state);
+
+/// Give the contents of a file to a function in order, to compute a digest of it.
+/**
+ * Regular files are mapped read-only in large windows, with the kernel told that they are
+ * read sequentially, so that they are fed to `update` without being copied.
+ * Files which can't be mapped, like pipes, or the files of special file systems which don't
+ * report a size, are read instead in chunks of 1 MiB into a page aligned buffer.
+ *
+ * The file must not be truncated while it is mapped, as reading the missing pages would
+ * then raise a SIGBUS signal.
+ *
+ * \param[in] file_path The path of the file.
+ * \param[in] update The function given the contents of the file.
+ * \param[inout] state The state given to `update`.
+ * \param[in] allocator Allocator used for the read buffer.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCUTILS_RET_ERROR if the file couldn't be opened or read.
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_digest_file(
+  const char * file_path,
+  rcutils_file_digest_update_t update,
+  void * state,
+  rcutils_allocator_t allocator);
+
 #ifdef __cplusplus
 }
 #endif
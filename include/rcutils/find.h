@@ -85,6 +85,66 @@ RCUTILS_PUBLIC
 size_t
 rcutils_find_lastn(const char * str, char delimiter, size_t string_length);
 
+/// Return the first index of any of a set of characters in a string.
+/**
+ * Search in a string for the first occurence of any of the given delimiters.
+ *
+ * \param[in] str null terminated c string to search
+ * \param[in] delimiters null terminated c string of the characters to search for
+ * \return the index of the first occurence of any delimiter if found, or
+ * \return `SIZE_MAX` for invalid arguments, or
+ * \return `SIZE_MAX` if no delimiter is found.
+ */
+RCUTILS_PUBLIC
+size_t
+rcutils_find_any(const char * str, const char * delimiters);
+
+/// Return the first index of any of a set of characters in a string of specified length.
+/**
+ * Identical to rcutils_find_any() but without relying on the string to be a
+ * null terminated c string.
+ *
+ * \param[in] str string to search
+ * \param[in] delimiters null terminated c string of the characters to search for
+ * \param[in] string_length length of the string to search
+ * \return the index of the first occurence of any delimiter if found, or
+ * \return `SIZE_MAX` for invalid arguments, or
+ * \return `SIZE_MAX` if no delimiter is found.
+ */
+RCUTILS_PUBLIC
+size_t
+rcutils_find_anyn(const char * str, const char * delimiters, size_t string_length);
+
+/// Return the last index of any of a set of characters in a string.
+/**
+ * Search in a string for the last occurence of any of the given delimiters.
+ *
+ * \param[in] str null terminated c string to search
+ * \param[in] delimiters null terminated c string of the characters to search for
+ * \return the index of the last occurence of any delimiter if found, or
+ * \return `SIZE_MAX` for invalid arguments, or
+ * \return `SIZE_MAX` if no delimiter is found.
+ */
+RCUTILS_PUBLIC
+size_t
+rcutils_find_last_any(const char * str, const char * delimiters);
+
+/// Return the last index of any of a set of characters in a string of specified length.
+/**
+ * Identical to rcutils_find_last_any() but without relying on the string to be a
+ * null terminated c string.
+ *
+ * \param[in] str string to search
+ * \param[in] delimiters null terminated c string of the characters to search for
+ * \param[in] string_length length of the string to search
+ * \return the index of the last occurence of any delimiter if found, or
+ * \return `SIZE_MAX` for invalid arguments, or
+ * \return `SIZE_MAX` if no delimiter is found.
+ */
+RCUTILS_PUBLIC
+size_t
+rcutils_find_last_anyn(const char * str, const char * delimiters, size_t string_length);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,137 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+/// \brief Fast non-cryptographic hashing and checksums.
+/**
+ * rcutils_hash64() is a 64-bit hash for hash tables and fingerprints, which is the final
+ * version 4 of wyhash by Wang Yi, with its default secret.
+ * rcutils_crc32c() is the CRC-32C (Castagnoli) checksum, for detecting corrupted data.
+ *
+ * Neither is suitable for security purposes, which sha256.h is meant for.
+ */
+
+#ifndef RCUTILS__HASH_H_
+#define RCUTILS__HASH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcutils/visibility_control.h"
+
+/// The state of a 64-bit hash computed piece by piece.
+/**
+ * The members are private, and must only be used through the rcutils_hash64_*() functions.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_hash64_state_s
+{
+  /// The seed mixed with the stripes hashed so far.
+  uint64_t seed;
+  /// The two other accumulators of the stripes.
+  uint64_t see1;
+  uint64_t see2;
+  /// The length of the data hashed so far.
+  uint64_t length;
+  /// The last 16 bytes of the previous stripe, followed by the data not hashed yet.
+  uint8_t buffer[64];
+  /// The number of bytes in buffer which are not hashed yet.
+  size_t buffered;
+} rcutils_hash64_state_t;
+
+/// Compute the 64-bit hash of some data.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] data The data to hash, which may be `NULL` if length is 0
+ * \param[in] length The length of the data in bytes
+ * \param[in] seed Value which changes the hash, to have several independent hash functions
+ * \return The hash of the data.
+ */
+RCUTILS_PUBLIC
+uint64_t
+rcutils_hash64(const void * data, size_t length, uint64_t seed);
+
+/// Start computing the 64-bit hash of some data given piece by piece.
+/**
+ * The hash of the concatenated pieces is the same as the one given by rcutils_hash64().
+ *
+ * \param[out] state The state to initialize
+ * \param[in] seed Value which changes the hash, as for rcutils_hash64()
+ */
+RCUTILS_PUBLIC
+void
+rcutils_hash64_init(rcutils_hash64_state_t * state, uint64_t seed);
+
+/// Add a piece of data to a 64-bit hash.
+/**
+ * \param[inout] state The state initialized by rcutils_hash64_init()
+ * \param[in] data The next piece of data, which may be `NULL` if length is 0
+ * \param[in] length The length of the piece in bytes
+ */
+RCUTILS_PUBLIC
+void
+rcutils_hash64_update(rcutils_hash64_state_t * state, const void * data, size_t length);
+
+/// Return the 64-bit hash of the data given so far.
+/**
+ * The state isn't changed, so more data may be added afterwards.
+ *
+ * \param[in] state The state initialized by rcutils_hash64_init()
+ * \return The hash of the pieces of data given so far.
+ */
+RCUTILS_PUBLIC
+uint64_t
+rcutils_hash64_final(const rcutils_hash64_state_t * state);
+
+/// Compute or continue a CRC-32C checksum.
+/**
+ * The checksum is computed with the CRC instructions of SSE4.2 or ARMv8 if the processor
+ * supports them, and otherwise eight bytes at a time with lookup tables.
+ *
+ * To compute the checksum of data given piece by piece, pass 0 as the crc of the first
+ * piece, and the result for the previous piece for the next ones.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] crc The checksum of the previous data, or 0
+ * \param[in] data The data to checksum, which may be `NULL` if length is 0
+ * \param[in] length The length of the data in bytes
+ * \return The checksum of the previous data followed by this data.
+ */
+RCUTILS_PUBLIC
+uint32_t
+rcutils_crc32c(uint32_t crc, const void * data, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__HASH_H_
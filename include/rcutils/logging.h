@@ -19,6 +19,7 @@
 
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #include "rcutils/allocator.h"
@@ -411,6 +412,38 @@ RCUTILS_PUBLIC
 RCUTILS_WARN_UNUSED
 bool rcutils_logging_logger_is_enabled_for(const char * name, int severity);
 
+/// Determine if a logger is enabled for a severity level given the hash of its name.
+/**
+ * Identical to rcutils_logging_logger_is_enabled_for() but looks up the logger
+ * with a precomputed hash of its name instead of hashing it on every call.
+ * This is what the C++ logging macros in rcutils/logging_macros.hpp use, as they
+ * compute the hash of literal logger names at compile time.
+ *
+ * The name_hash must be the value rcutils_hash_map_string_hash_func() returns for
+ * the name, otherwise the severity level set for the logger itself will be ignored.
+ * The hash is only used for the logger itself, the lookup of its ancestors is
+ * unchanged.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No, provided logging system is already initialized
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] name The name of the logger, must be null terminated c string or NULL.
+ * \param[in] name_hash The hash of the name of the logger.
+ * \param[in] severity The severity level.
+ *
+ * \return `true` if the logger is enabled for the level, or
+ * \return `false` otherwise.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool rcutils_logging_logger_is_enabled_for_with_hash(
+  const char * name, size_t name_hash, int severity);
+
 /// Determine the effective level for a logger.
 /**
  * The effective level is determined as the severity level of
@@ -440,6 +473,31 @@ RCUTILS_PUBLIC
 RCUTILS_WARN_UNUSED
 int rcutils_logging_get_logger_effective_level(const char * name);
 
+/// Determine the effective level for a logger given the hash of its name.
+/**
+ * Identical to rcutils_logging_get_logger_effective_level() but looks up the
+ * logger with a precomputed hash of its name, see
+ * rcutils_logging_logger_is_enabled_for_with_hash().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No, provided logging system is already initialized
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] name The name of the logger, must be null terminated c string.
+ * \param[in] name_hash The hash of the name of the logger.
+ *
+ * \return The level, or
+ * \return -1 on invalid arguments, or
+ * \return -1 if an error occurred.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+int rcutils_logging_get_logger_effective_level_with_hash(const char * name, size_t name_hash);
+
 /// Internal call to log a message.
 /**
  * Unconditionally log a message.
@@ -519,6 +577,66 @@ RCUTILS_ATTRIBUTE_PRINTF_FORMAT(4, 5)
 /// @endcond
 ;
 
+/// The maximum length of a message logged with rcutils_log_signal_safe(), including the newline.
+/**
+ * Longer messages are truncated.
+ */
+#define RCUTILS_LOGGING_SIGNAL_SAFE_MAX_MESSAGE_LENGTH 512
+
+/// Log a message from a signal handler or a section which must not allocate or lock.
+/**
+ * This is a constrained alternative to rcutils_log() which only uses a fixed
+ * size buffer on the stack, its own minimal formatter and a single write(2) to
+ * the file descriptor of the logging output stream (`stderr` unless
+ * `RCUTILS_LOGGING_USE_STDOUT` was set when logging was initialized).
+ *
+ * The message is written as `[SEVERITY] [name]: message` followed by a newline;
+ * the output handler and the `RCUTILS_CONSOLE_OUTPUT_FORMAT` are not used.
+ * It is filtered against the default logger level only, since looking up the
+ * level of a named logger is not async-signal-safe.
+ * If the logging system isn't initialized, it is not initialized by this
+ * function, instead `RCUTILS_DEFAULT_LOGGER_DEFAULT_LEVEL` and `stderr` are used.
+ * Messages logged with this function are not counted in the logging statistics.
+ *
+ * The formatter supports the `d`, `i`, `u`, `x`, `X`, `c`, `s`, `p` and `%`
+ * conversions with the `hh`, `h`, `l`, `ll`, `j`, `z` and `t` length modifiers.
+ * The precision of an `s` conversion is honored, and the string is not read
+ * past that many characters, so it needn't be null terminated within them.
+ * Other flags, field widths and precisions are accepted but ignored.
+ * On the first unsupported conversion, e.g. a floating point one, the rest of
+ * the format string is written verbatim.
+ *
+ * This function never sets the error message, since doing so is not
+ * async-signal-safe, and preserves the value of `errno`.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * Signal-Safe        | Yes
+ *
+ * \param[in] severity The severity level
+ * \param[in] name The name of the logger, must be null terminated c string or NULL
+ * \param[in] format The format string
+ * \param[in] ... The variable arguments
+ * \return `RCUTILS_RET_OK` if the message was written or filtered out, or
+ * \return `RCUTILS_RET_INVALID_ARGUMENT` if the format is NULL or the severity is invalid, or
+ * \return `RCUTILS_RET_ERROR` if writing the message failed.
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t rcutils_log_signal_safe(
+  int severity,
+  const char * name,
+  const char * format,
+  ...)
+/// @cond Doxygen_Suppress
+RCUTILS_ATTRIBUTE_PRINTF_FORMAT(3, 4)
+/// @endcond
+;
+
 /// The default output handler outputs log messages to the standard streams.
 /**
  * The messages with a severity level `DEBUG` and `INFO` are written to `stdout`.
@@ -551,6 +669,80 @@ void rcutils_logging_console_output_handler(
   int severity, const char * name, rcutils_time_point_value_t timestamp,
   const char * format, va_list * args);
 
+/// The number of severity slots tracked in rcutils_logging_statistics_t.
+/**
+ * Severity levels are mapped to slots by dividing them by 10, i.e. the slot of
+ * `RCUTILS_LOG_SEVERITY_WARN` is `RCUTILS_LOG_SEVERITY_WARN / 10`.
+ */
+#define RCUTILS_LOGGING_STATISTICS_SEVERITY_SLOTS (RCUTILS_LOG_SEVERITY_FATAL / 10 + 1)
+
+/// The number of buckets in the output handler latency histogram.
+#define RCUTILS_LOGGING_STATISTICS_LATENCY_BUCKETS 16
+
+/// The exclusive upper bound of the first output handler latency bucket, in nanoseconds.
+/**
+ * Each following bucket doubles the upper bound of the previous one, and the
+ * last bucket holds every latency which did not fit in the previous buckets.
+ */
+#define RCUTILS_LOGGING_STATISTICS_LATENCY_FIRST_BUCKET_NS 256
+
+/// Counters describing the work done by the logging system.
+/**
+ * All counters are cumulative since the process started or since the last call
+ * to rcutils_logging_reset_statistics(), and are not reset by
+ * rcutils_logging_shutdown().
+ */
+typedef struct rcutils_logging_statistics_s
+{
+  /// Records passed to the output handler, indexed by severity slot.
+  uint64_t records[RCUTILS_LOGGING_STATISTICS_SEVERITY_SLOTS];
+  /// Records rejected by rcutils_logging_logger_is_enabled_for(), indexed by severity slot.
+  uint64_t suppressed[RCUTILS_LOGGING_STATISTICS_SEVERITY_SLOTS];
+  /// Bytes written to the output stream by rcutils_logging_console_output_handler().
+  uint64_t bytes_emitted;
+  /// Messages which could not be formatted, either by the console output handler or by
+  /// rcutils_logging_format_message().
+  uint64_t format_failures;
+  /// Histogram of the time spent in the output handler per record, see
+  /// RCUTILS_LOGGING_STATISTICS_LATENCY_FIRST_BUCKET_NS for the bucket bounds.
+  uint64_t handler_latency[RCUTILS_LOGGING_STATISTICS_LATENCY_BUCKETS];
+} rcutils_logging_statistics_t;
+
+/// Get a snapshot of the logging statistics.
+/**
+ * The counters are updated atomically but read one after the other, so the
+ * snapshot is not guaranteed to be consistent across counters while other
+ * threads are logging.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[out] statistics The structure to be filled with the current counters.
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if `statistics` is `NULL`.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t rcutils_logging_get_statistics(rcutils_logging_statistics_t * statistics);
+
+/// Reset all logging statistics counters to zero.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ */
+RCUTILS_PUBLIC
+void rcutils_logging_reset_statistics(void);
+
 /**
  * \def RCUTILS_LOGGING_AUTOINIT
  * \brief Initialize the rcl logging library.
@@ -569,17 +761,70 @@ void rcutils_logging_console_output_handler(
 #define RCUTILS_LOGGING_AUTOINIT_WITH_ALLOCATOR(alloc) \
   do { \
     if (RCUTILS_UNLIKELY(!g_rcutils_logging_initialized)) { \
-      if (rcutils_logging_initialize_with_allocator(alloc) != RCUTILS_RET_OK) { \
-        RCUTILS_SAFE_FWRITE_TO_STDERR( \
-          "[rcutils|" __FILE__ ":" RCUTILS_STRINGIFY(__LINE__) \
-          "] error initializing logging: "); \
-        RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str); \
-        RCUTILS_SAFE_FWRITE_TO_STDERR("\n"); \
-        rcutils_reset_error(); \
-      } \
+      rcutils_logging_autoinit_with_allocator(alloc, __FILE__, __LINE__); \
     } \
   } while (0)
 
+/// Internal call to initialize the logging system on behalf of RCUTILS_LOGGING_AUTOINIT.
+/**
+ * Call rcutils_logging_initialize_with_allocator() and, if it fails, report
+ * the error to stderr together with the location of the caller and reset it.
+ * This is kept out of line so that the code expanded by the logging macros
+ * stays small.
+ * End-user software should never call this, and instead should use the
+ * RCUTILS_LOGGING_AUTOINIT macros.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] allocator rcutils_allocator_t to be used.
+ * \param[in] file The file from which the initialization was triggered.
+ * \param[in] line The line from which the initialization was triggered.
+ */
+RCUTILS_PUBLIC
+RCUTILS_COLD
+void rcutils_logging_autoinit_with_allocator(
+  rcutils_allocator_t allocator, const char * file, size_t line);
+
+/// Internal call to evaluate the `throttle` condition of the logging macros.
+/**
+ * Decide whether a throttled log call is due, given the result of fetching the
+ * current time, and update the time of the last logged message if it is.
+ * If fetching the time failed an error is logged and the call is let through,
+ * as if the throttle interval had elapsed.
+ * End-user software should never call this, and instead should use the
+ * `RCUTILS_LOG_*_THROTTLE` macros.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] time_ret The return value of the call fetching the current time.
+ * \param[in] now The current time, only valid if `time_ret` is #RCUTILS_RET_OK.
+ * \param[in] duration The throttle interval in nanoseconds.
+ * \param[in,out] last_logged The time of the last logged message.
+ * \param[in] location The location of the log call, used to report errors.
+ * \return `true` if the message should be logged, or
+ * \return `false` otherwise.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool rcutils_logging_throttle_is_due(
+  rcutils_ret_t time_ret,
+  rcutils_time_point_value_t now,
+  rcutils_duration_value_t duration,
+  rcutils_time_point_value_t * last_logged,
+  const rcutils_log_location_t * location);
+
 #ifdef __cplusplus
 }
 #endif
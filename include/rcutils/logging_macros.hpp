@@ -0,0 +1,459 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file
+/**
+ * C++ logging macros layered on top of rcutils/logging_macros.h.
+ *
+ * Compared to the C macros these macros:
+ * - hash the logger name at compile time and look the logger up with
+ *   rcutils_logging_logger_is_enabled_for_with_hash(), so the name isn't
+ *   hashed again on every call,
+ * - check at compile time that the format string agrees with the types of the
+ *   arguments, independently of compiler specific format warnings,
+ * - pass common C++ argument types, like std::string, to the output handler
+ *   without copying them.
+ *
+ * Both the logger name and the format string must be string literals.
+ */
+
+#ifndef RCUTILS__LOGGING_MACROS_HPP_
+#define RCUTILS__LOGGING_MACROS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "rcutils/logging.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/macros.h"
+
+namespace rcutils
+{
+namespace logging
+{
+
+/// Compute the hash of a logger name at compile time.
+/**
+ * The result is the same as the one of rcutils_hash_map_string_hash_func(),
+ * which is used for the logger severity map.
+ *
+ * \param[in] name The name of the logger, must be null terminated c string
+ * \return The hash of the name.
+ */
+constexpr size_t hash_logger_name(const char * name) noexcept
+{
+  size_t hash = 5381;
+  while ('\0' != *name) {
+    const char c = *(name++);
+    hash = ((hash << 5) + hash) + static_cast<size_t>(c);  // hash * 33 + c
+  }
+  return hash;
+}
+
+/// \cond Doxygen_Suppress
+namespace detail
+{
+
+enum class arg_kind
+{
+  integer,
+  floating,
+  c_string,
+  pointer,
+  unsupported,
+};
+
+// How an argument is passed through the variable arguments: its kind and its size
+// after the default argument promotions.
+struct arg_info
+{
+  arg_kind kind;
+  size_t size;
+};
+
+// Adapt an argument to the type passed to the output handler.
+// The primary template covers types which can't be passed to a printf-like function.
+template<typename T, typename Enable = void>
+struct log_arg
+{
+  static constexpr arg_info info{arg_kind::unsupported, 0};
+};
+
+template<typename T>
+struct log_arg<T, std::enable_if_t<std::is_integral<T>::value>>
+{
+  // bool, char and short are promoted to int, like printf() expects them.
+  using promoted_type = decltype(+std::declval<T>());
+  static constexpr arg_info info{arg_kind::integer, sizeof(promoted_type)};
+  static constexpr promoted_type convert(T value) {return value;}
+};
+
+template<typename T>
+struct log_arg<T, std::enable_if_t<std::is_enum<T>::value>>
+{
+  using promoted_type = decltype(+std::declval<std::underlying_type_t<T>>());
+  static constexpr arg_info info{arg_kind::integer, sizeof(promoted_type)};
+  static constexpr promoted_type convert(T value) {return static_cast<promoted_type>(value);}
+};
+
+template<typename T>
+struct log_arg<T, std::enable_if_t<std::is_floating_point<T>::value>>
+{
+  // float is promoted to double.
+  using promoted_type = std::conditional_t<std::is_same<T, float>::value, double, T>;
+  static constexpr arg_info info{arg_kind::floating, sizeof(promoted_type)};
+  static constexpr promoted_type convert(T value) {return value;}
+};
+
+template<typename T>
+struct log_arg<T *>
+{
+  static constexpr arg_info info{arg_kind::pointer, sizeof(void *)};
+  static constexpr const void * convert(const T * value) {return value;}
+};
+
+template<>
+struct log_arg<std::nullptr_t>
+{
+  static constexpr arg_info info{arg_kind::pointer, sizeof(void *)};
+  static constexpr const void * convert(std::nullptr_t) {return nullptr;}
+};
+
+template<>
+struct log_arg<const char *>
+{
+  static constexpr arg_info info{arg_kind::c_string, sizeof(const char *)};
+  static constexpr const char * convert(const char * value) {return value;}
+};
+
+template<>
+struct log_arg<char *>: log_arg<const char *> {};
+
+// Strings are passed by their buffer instead of being copied into a c string.
+template<>
+struct log_arg<std::string>
+{
+  static constexpr arg_info info{arg_kind::c_string, sizeof(const char *)};
+  static const char * convert(const std::string & value) {return value.c_str();}
+};
+
+enum class length_modifier
+{
+  none,
+  hh,
+  h,
+  l,
+  ll,
+  j,
+  z,
+  t,
+  L,
+};
+
+constexpr size_t integer_size(length_modifier length)
+{
+  switch (length) {
+    case length_modifier::none:
+    case length_modifier::hh:
+    case length_modifier::h:
+      return sizeof(int);
+    case length_modifier::l:
+      return sizeof(long);  // NOLINT(runtime/int)
+    case length_modifier::ll:
+      return sizeof(long long);  // NOLINT(runtime/int)
+    case length_modifier::j:
+      return sizeof(intmax_t);
+    case length_modifier::z:
+      return sizeof(size_t);
+    case length_modifier::t:
+      return sizeof(ptrdiff_t);
+    case length_modifier::L:
+      break;
+  }
+  return 0;
+}
+
+constexpr bool is_digit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+// Check a printf format string against the arguments, the syntax being the one of
+// the C standard and the POSIX ' flag.
+// Positional arguments and wide characters or strings are not supported.
+constexpr bool format_matches(const char * format, const arg_info * args, size_t num_args)
+{
+  size_t next = 0;
+  while ('\0' != *format) {
+    if ('%' != *(format++)) {
+      continue;
+    }
+    if ('%' == *format) {
+      ++format;
+      continue;
+    }
+    while ('-' == *format || '+' == *format || ' ' == *format || '#' == *format ||
+      '0' == *format || '\'' == *format)
+    {
+      ++format;
+    }
+    // The field width and precision may be given by int arguments.
+    for (int field = 0; field < 2; ++field) {
+      if (1 == field) {
+        if ('.' != *format) {
+          break;
+        }
+        ++format;
+      }
+      if ('*' == *format) {
+        if (next >= num_args || arg_kind::integer != args[next].kind ||
+          sizeof(int) != args[next].size)
+        {
+          return false;
+        }
+        ++next;
+        ++format;
+      } else {
+        while (is_digit(*format)) {
+          ++format;
+        }
+      }
+    }
+    length_modifier length = length_modifier::none;
+    switch (*format) {
+      case 'h':
+        length = 'h' == *(++format) ? (++format, length_modifier::hh) : length_modifier::h;
+        break;
+      case 'l':
+        length = 'l' == *(++format) ? (++format, length_modifier::ll) : length_modifier::l;
+        break;
+      case 'j':
+        length = length_modifier::j;
+        ++format;
+        break;
+      case 'z':
+        length = length_modifier::z;
+        ++format;
+        break;
+      case 't':
+        length = length_modifier::t;
+        ++format;
+        break;
+      case 'L':
+        length = length_modifier::L;
+        ++format;
+        break;
+      default:
+        break;
+    }
+    const char conversion = *format;
+    if ('\0' == conversion || next >= num_args) {
+      return false;
+    }
+    ++format;
+    const arg_info arg = args[next++];
+    switch (conversion) {
+      case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+        if (arg_kind::integer != arg.kind || integer_size(length) != arg.size) {
+          return false;
+        }
+        break;
+      case 'c':
+        if (length_modifier::none != length || arg_kind::integer != arg.kind ||
+          sizeof(int) != arg.size)
+        {
+          return false;
+        }
+        break;
+      case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        if (arg_kind::floating != arg.kind ||
+          (length_modifier::L == length ? sizeof(long double) : sizeof(double)) != arg.size ||
+          (length_modifier::none != length && length_modifier::l != length &&
+          length_modifier::L != length))
+        {
+          return false;
+        }
+        break;
+      case 's':
+        if (length_modifier::none != length || arg_kind::c_string != arg.kind) {
+          return false;
+        }
+        break;
+      case 'p':
+        if (length_modifier::none != length ||
+          (arg_kind::pointer != arg.kind && arg_kind::c_string != arg.kind))
+        {
+          return false;
+        }
+        break;
+      default:
+        // Including %n, which is never wanted in a log message.
+        return false;
+    }
+  }
+  return next == num_args;
+}
+
+template<typename ... Args>
+struct type_list {};
+
+// Only used in unevaluated context to get the decayed types of the macro arguments.
+template<typename ... Args>
+type_list<std::decay_t<Args>...> arg_types(const char * format, Args && ... args);
+
+template<typename TypeList>
+struct format_checker;
+
+template<typename ... Args>
+struct format_checker<type_list<Args...>>
+{
+  // The trailing element avoids a zero sized array when there are no arguments.
+  static constexpr arg_info infos[sizeof...(Args) + 1] = {
+    log_arg<Args>::info..., arg_info{arg_kind::unsupported, 0}};
+
+  static constexpr bool matches(const char * format)
+  {
+    return format_matches(format, infos, sizeof...(Args));
+  }
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+# pragma GCC diagnostic push
+// The format has been checked at compile time by the calling macro.
+# pragma GCC diagnostic ignored "-Wformat-nonliteral"
+# pragma GCC diagnostic ignored "-Wformat-security"
+#endif
+
+template<typename ... Args>
+void log_internal(
+  const rcutils_log_location_t * location, int severity, const char * name,
+  const char * format, const Args & ... args)
+{
+  rcutils_log_internal(
+    location, severity, name, format, log_arg<std::decay_t<Args>>::convert(args)...);
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+# pragma GCC diagnostic pop
+#endif
+
+}  // namespace detail
+/// \endcond
+
+}  // namespace logging
+}  // namespace rcutils
+
+/// \cond Doxygen_Suppress
+#define RCUTILS_CPP_LOG_FORMAT_IMPL(format, ...) format
+#define RCUTILS_CPP_LOG_FORMAT(...) RCUTILS_EXPAND(RCUTILS_CPP_LOG_FORMAT_IMPL(__VA_ARGS__, 0))
+/// \endcond
+
+/**
+ * \def RCUTILS_CPP_LOG_COND_NAMED
+ * The C++ counterpart of RCUTILS_LOG_COND_NAMED, which all other C++ logging macros call.
+ *
+ * It accepts the same conditions as RCUTILS_LOG_COND_NAMED, e.g.
+ * RCUTILS_LOG_CONDITION_ONCE_BEFORE and RCUTILS_LOG_CONDITION_ONCE_AFTER.
+ *
+ * \note The condition will only be evaluated if this logging statement is enabled.
+ *
+ * \param[in] severity The severity level
+ * \param[in] condition_before The condition macro(s) inserted before the log call
+ * \param[in] condition_after The condition macro(s) inserted after the log call
+ * \param[in] name The name of the logger, must be a string literal
+ * \param[in] ... The format string, which must be a string literal, followed by the
+ *   variable arguments for the format string
+ */
+#define RCUTILS_CPP_LOG_COND_NAMED(severity, condition_before, condition_after, name, ...) \
+  do { \
+    static_assert( \
+      ::rcutils::logging::detail::format_checker< \
+        decltype(::rcutils::logging::detail::arg_types(__VA_ARGS__))>::matches( \
+        RCUTILS_CPP_LOG_FORMAT(__VA_ARGS__)), \
+      "The format string doesn't match the logging arguments"); \
+    constexpr size_t __rcutils_logging_name_hash = ::rcutils::logging::hash_logger_name(name); \
+    static const rcutils_log_location_t __rcutils_logging_location = \
+    {__func__, __FILE__, __LINE__}; \
+    if (RCUTILS_UNLIKELY(rcutils_logging_logger_is_enabled_for_with_hash( \
+        name, __rcutils_logging_name_hash, severity))) \
+    { \
+      condition_before \
+      ::rcutils::logging::detail::log_internal( \
+        &__rcutils_logging_location, severity, name, __VA_ARGS__); \
+      condition_after \
+    } \
+  } while (0)
+
+/**
+ * \def RCUTILS_CPP_LOG_NAMED
+ * Log a message with the given severity to a named logger.
+ *
+ * \param[in] severity The severity level
+ * \param[in] name The name of the logger, must be a string literal
+ * \param[in] ... The format string, which must be a string literal, followed by the
+ *   variable arguments for the format string
+ */
+#define RCUTILS_CPP_LOG_NAMED(severity, name, ...) \
+  RCUTILS_CPP_LOG_COND_NAMED( \
+    severity, RCUTILS_LOG_CONDITION_EMPTY, RCUTILS_LOG_CONDITION_EMPTY, name, __VA_ARGS__)
+
+/** @name C++ logging macros for each severity.
+ * These are compiled out like the C logging macros according to RCUTILS_LOG_MIN_SEVERITY.
+ */
+///@{
+#if (RCUTILS_LOG_MIN_SEVERITY > RCUTILS_LOG_MIN_SEVERITY_DEBUG)
+# define RCUTILS_CPP_LOG_DEBUG_NAMED(name, ...)
+#else
+/// Log a message with severity DEBUG to a named logger.
+# define RCUTILS_CPP_LOG_DEBUG_NAMED(name, ...) \
+  RCUTILS_CPP_LOG_NAMED(RCUTILS_LOG_SEVERITY_DEBUG, name, __VA_ARGS__)
+#endif
+
+#if (RCUTILS_LOG_MIN_SEVERITY > RCUTILS_LOG_MIN_SEVERITY_INFO)
+# define RCUTILS_CPP_LOG_INFO_NAMED(name, ...)
+#else
+/// Log a message with severity INFO to a named logger.
+# define RCUTILS_CPP_LOG_INFO_NAMED(name, ...) \
+  RCUTILS_CPP_LOG_NAMED(RCUTILS_LOG_SEVERITY_INFO, name, __VA_ARGS__)
+#endif
+
+#if (RCUTILS_LOG_MIN_SEVERITY > RCUTILS_LOG_MIN_SEVERITY_WARN)
+# define RCUTILS_CPP_LOG_WARN_NAMED(name, ...)
+#else
+/// Log a message with severity WARN to a named logger.
+# define RCUTILS_CPP_LOG_WARN_NAMED(name, ...) \
+  RCUTILS_CPP_LOG_NAMED(RCUTILS_LOG_SEVERITY_WARN, name, __VA_ARGS__)
+#endif
+
+#if (RCUTILS_LOG_MIN_SEVERITY > RCUTILS_LOG_MIN_SEVERITY_ERROR)
+# define RCUTILS_CPP_LOG_ERROR_NAMED(name, ...)
+#else
+/// Log a message with severity ERROR to a named logger.
+# define RCUTILS_CPP_LOG_ERROR_NAMED(name, ...) \
+  RCUTILS_CPP_LOG_NAMED(RCUTILS_LOG_SEVERITY_ERROR, name, __VA_ARGS__)
+#endif
+
+#if (RCUTILS_LOG_MIN_SEVERITY > RCUTILS_LOG_MIN_SEVERITY_FATAL)
+# define RCUTILS_CPP_LOG_FATAL_NAMED(name, ...)
+#else
+/// Log a message with severity FATAL to a named logger.
+# define RCUTILS_CPP_LOG_FATAL_NAMED(name, ...) \
+  RCUTILS_CPP_LOG_NAMED(RCUTILS_LOG_SEVERITY_FATAL, name, __VA_ARGS__)
+#endif
+///@}
+
+#endif  // RCUTILS__LOGGING_MACROS_HPP_
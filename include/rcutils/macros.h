@@ -144,6 +144,22 @@ extern "C"
 # define RCUTILS_UNLIKELY(x) (x)
 #endif  // _WIN32
 
+// Keep rarely executed functions out of line and away from the hot code
+#ifndef _WIN32
+/**
+ * \def RCUTILS_COLD
+ * Instruct the compiler that the function is unlikely to be executed, so that it
+ * is not inlined and calls to it are treated as unlikely branches.
+ */
+# define RCUTILS_COLD __attribute__((cold, noinline))
+#else
+/**
+ * \def RCUTILS_COLD
+ * Only prevents inlining since Windows doesn't support marking functions as cold.
+ */
+# define RCUTILS_COLD __declspec(noinline)
+#endif  // _WIN32
+
 // Provide the compiler a hint about an argument being nonnull when possible.
 #ifndef _WIN32
 # define RCUTILS_NONNULL __attribute__((__nonnull__))
@@ -0,0 +1,189 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+/// \brief Read-only access to the contents of a file mapped in memory.
+/**
+ * A file opened with rcutils_mapped_file_open() is mapped read-only, so that its contents are
+ * read by the kernel directly into the page cache, and accessed without being copied.
+ * Files which can't be mapped, like pipes or the files of special file systems which don't
+ * report a size, are read into memory instead, so that the contents are always available.
+ */
+
+#ifndef RCUTILS__MAPPED_FILE_H_
+#define RCUTILS__MAPPED_FILE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/types/uint8_array.h"
+#include "rcutils/visibility_control.h"
+
+/// The flags of rcutils_mapped_file_open(), which may be combined.
+typedef enum rcutils_mapped_file_flag_e
+{
+  /// Map the file and let its pages be read when they are first accessed.
+  RCUTILS_MAPPED_FILE_DEFAULT = 0,
+  /// Read the whole file when it is mapped, so that accessing it causes no page fault.
+  /**
+   * This is done with MAP_POPULATE on Linux, and like rcutils_mapped_file_prefetch()
+   * elsewhere.
+   */
+  RCUTILS_MAPPED_FILE_POPULATE = 1 << 0,
+  /// Ask for the file to be mapped with huge pages, to use fewer TLB entries.
+  /**
+   * This is only a hint, which is followed on Linux if the kernel supports huge pages for
+   * the page cache of the file system.
+   */
+  RCUTILS_MAPPED_FILE_HUGE_PAGES = 1 << 1
+} rcutils_mapped_file_flag_t;
+
+/// How a mapped file is going to be accessed, given to rcutils_mapped_file_advise().
+typedef enum rcutils_mapped_file_advice_e
+{
+  /// No particular access pattern, which is the default.
+  RCUTILS_MAPPED_FILE_ADVICE_NORMAL = 0,
+  /// The pages are accessed in order, so they can be read ahead aggressively.
+  RCUTILS_MAPPED_FILE_ADVICE_SEQUENTIAL,
+  /// The pages are accessed in random order, so reading ahead is useless.
+  RCUTILS_MAPPED_FILE_ADVICE_RANDOM,
+  /// The pages will be accessed soon, so they can be read in the background now.
+  RCUTILS_MAPPED_FILE_ADVICE_WILL_NEED,
+  /// The pages won't be accessed soon, so their memory can be reclaimed.
+  RCUTILS_MAPPED_FILE_ADVICE_DONT_NEED
+} rcutils_mapped_file_advice_t;
+
+/// The contents of a file opened with rcutils_mapped_file_open().
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_mapped_file_s
+{
+  /// The contents of the file, which may be `NULL` if it is empty.
+  const uint8_t * data;
+  /// The size of the contents in bytes.
+  size_t size;
+  /// Whether the file is mapped, or was read into contents.
+  bool is_mapped;
+  /// The buffer holding the contents of the file if it isn't mapped.
+  rcutils_uint8_array_t contents;
+} rcutils_mapped_file_t;
+
+/// Return a zero initialized mapped file, which is neither mapped nor holds anything.
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_mapped_file_t
+rcutils_get_zero_initialized_mapped_file(void);
+
+/// Open a file and map its contents read-only in memory.
+/**
+ * If the file can't be mapped, it is read into a buffer allocated with the allocator instead,
+ * and is_mapped is false.
+ * The file is closed once mapped, so it may be renamed or removed while mapped.
+ * It must not be truncated, as accessing the missing pages would then raise a SIGBUS signal.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes, if the file can't be mapped
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[out] file The zero initialized mapped file to open
+ * \param[in] file_path The path of the file
+ * \param[in] flags A combination of #rcutils_mapped_file_flag_t
+ * \param[in] allocator The allocator used if the file is read instead of mapped
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCUTILS_RET_ERROR if the file couldn't be opened or read.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_mapped_file_open(
+  rcutils_mapped_file_t * file,
+  const char * file_path,
+  uint32_t flags,
+  const rcutils_allocator_t * allocator);
+
+/// Tell the kernel how a range of a mapped file is going to be accessed.
+/**
+ * This is only a hint, which is ignored if the file isn't mapped, or where the operating
+ * system has no equivalent.
+ * The range is extended to whole pages, and limited to the end of the file.
+ *
+ * \param[in] file The opened mapped file
+ * \param[in] offset The offset of the range in bytes
+ * \param[in] length The length of the range in bytes, or 0 for the rest of the file
+ * \param[in] advice How the range is going to be accessed
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if the operating system rejected the advice.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_mapped_file_advise(
+  rcutils_mapped_file_t * file,
+  size_t offset,
+  size_t length,
+  rcutils_mapped_file_advice_t advice);
+
+/// Read a range of a mapped file into memory now, so that accessing it causes no page fault.
+/**
+ * On Linux 5.14 or later, the pages are read and mapped with MADV_POPULATE_READ, without any
+ * page fault.
+ * Elsewhere, a byte of each page is read.
+ * Nothing is done if the file isn't mapped, as it is in memory already.
+ *
+ * \param[in] file The opened mapped file
+ * \param[in] offset The offset of the range in bytes
+ * \param[in] length The length of the range in bytes, or 0 for the rest of the file
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if the pages couldn't be read.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_mapped_file_prefetch(rcutils_mapped_file_t * file, size_t offset, size_t length);
+
+/// Unmap a mapped file, or free the contents read instead.
+/**
+ * The file is zero initialized afterwards, so it may be opened again.
+ * Closing a zero initialized file does nothing.
+ *
+ * \param[inout] file The mapped file to close
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if the file couldn't be unmapped.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_mapped_file_close(rcutils_mapped_file_t * file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__MAPPED_FILE_H_
@@ -0,0 +1,238 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+/// \brief Build and normalize paths in a reusable buffer.
+/**
+ * A path builder stores its path in an inline buffer while it is short enough, and in memory
+ * from its allocator otherwise, which is kept until it is finalized.
+ * Components can then be pushed and popped, for instance while walking a tree of
+ * directories, without allocating for each of them.
+ */
+
+#ifndef RCUTILS__PATH_BUILDER_H_
+#define RCUTILS__PATH_BUILDER_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/types/rcutils_ret.h"
+#include "rcutils/visibility_control.h"
+
+/// The size of the inline buffer of a path builder, including the terminating null character.
+#define RCUTILS_PATH_BUILDER_INLINE_SIZE 256
+
+/// A path being built.
+/**
+ * It must not be copied once initialized, and its fields must not be modified directly.
+ */
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_path_builder_s
+{
+  /// The length of the path, without its terminating null character.
+  size_t length;
+  /// The size of allocated_buffer, or 0 while the inline buffer is used.
+  size_t capacity;
+  /// The buffer allocated for the path once it didn't fit in the inline one, or `NULL`.
+  char * allocated_buffer;
+  /// The buffer of the path while it is short enough.
+  char inline_buffer[RCUTILS_PATH_BUILDER_INLINE_SIZE];
+  /// The allocator used for allocated_buffer.
+  rcutils_allocator_t allocator;
+} rcutils_path_builder_t;
+
+/// Return an empty path builder struct, to be initialized with rcutils_path_builder_init().
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_path_builder_t
+rcutils_get_zero_initialized_path_builder(void);
+
+/// Initialize a path builder with an empty path.
+/**
+ * No memory is allocated until the path is longer than the inline buffer.
+ *
+ * \param[inout] builder The zero initialized path builder
+ * \param[in] allocator The allocator to use if the path doesn't fit in the inline buffer
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_path_builder_init(
+  rcutils_path_builder_t * builder,
+  const rcutils_allocator_t * allocator);
+
+/// Free the memory of a path builder, which is zero initialized again.
+/**
+ * Finalizing a zero initialized path builder does nothing.
+ *
+ * \param[inout] builder The path builder to finalize
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_path_builder_fini(rcutils_path_builder_t * builder);
+
+/// Return the null terminated path of a path builder.
+/**
+ * The path is owned by the builder, and is only valid until it is modified.
+ *
+ * \param[in] builder The path builder
+ * \return The path, or `NULL` if builder is `NULL`.
+ */
+RCUTILS_PUBLIC
+const char *
+rcutils_path_builder_get_path(const rcutils_path_builder_t * builder);
+
+/// Make sure a path of the given length fits in a path builder without allocating.
+/**
+ * \param[inout] builder The initialized path builder
+ * \param[in] length The length of the path, without its terminating null character
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating memory failed.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_path_builder_reserve(rcutils_path_builder_t * builder, size_t length);
+
+/// Replace the path of a path builder.
+/**
+ * \param[inout] builder The initialized path builder
+ * \param[in] path The new path, which may be empty
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating memory failed, in which case the path is
+ *   unchanged.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_path_builder_set(rcutils_path_builder_t * builder, const char * path);
+
+/// Append characters to the path of a path builder, without adding a separator.
+/**
+ * \param[inout] builder The initialized path builder
+ * \param[in] string The characters to append, which needn't be null terminated
+ * \param[in] length The number of characters to append
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating memory failed, in which case the path is
+ *   unchanged.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_path_builder_append(
+  rcutils_path_builder_t * builder,
+  const char * string,
+  size_t length);
+
+/// Append a component to the path of a path builder.
+/**
+ * The native separator is added before the component, unless the path is empty or already
+ * ends with a separator.
+ * The component is appended as is, so it may contain separators itself.
+ *
+ * \param[inout] builder The initialized path builder
+ * \param[in] component The component to append
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating memory failed, in which case the path is
+ *   unchanged.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_path_builder_push(rcutils_path_builder_t * builder, const char * component);
+
+/// Remove the last component from the path of a path builder.
+/**
+ * The separators before it are removed too, except for the root of the path, so that popping
+ * from `/foo/bar/` gives `/foo`, and then `/`.
+ *
+ * \param[inout] builder The path builder
+ * \return `true` if a component was removed, or
+ * \return `false` if the path has no component left, or builder is `NULL`.
+ */
+RCUTILS_PUBLIC
+bool
+rcutils_path_builder_pop(rcutils_path_builder_t * builder);
+
+/// Normalize the path of a path builder lexically, without accessing the file system.
+/**
+ * Duplicate separators and `.` components are removed, and each `..` component removes the
+ * component before it, if any.
+ * The components are separated by the native separator, and a trailing separator is removed.
+ * A `..` at the root of an absolute path is removed, while the ones at the start of a relative
+ * path are kept.
+ * An empty path becomes `.`.
+ *
+ * As symbolic links aren't resolved, `foo/..` may not name the same directory as `.` when
+ * `foo` is a link.
+ *
+ * \param[inout] builder The initialized path builder
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_path_builder_normalize(rcutils_path_builder_t * builder);
+
+/// Replace the `/` separators of the path of a path builder by the native ones.
+/**
+ * This does nothing on platforms whose native separator is `/`.
+ *
+ * \param[inout] builder The initialized path builder
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_path_builder_to_native(rcutils_path_builder_t * builder);
+
+/// Return the path of a path builder as a newly allocated string, and empty the builder.
+/**
+ * The allocated buffer of the builder is handed over when it has one, so that this only
+ * allocates when the path was in the inline buffer.
+ * It is up to the caller to release the memory once it is done with it by
+ * calling `deallocate` on the allocator of the builder.
+ *
+ * \param[inout] builder The initialized path builder
+ * \return The path, or
+ * \return `NULL` on invalid arguments, or
+ * \return `NULL` if allocating memory failed, in which case the path is unchanged.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+char *
+rcutils_path_builder_detach(rcutils_path_builder_t * builder);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__PATH_BUILDER_H_
@@ -33,8 +33,11 @@ extern "C"
 {
 #endif
 
+#include <stddef.h>
+
 #include "rcutils/allocator.h"
 #include "rcutils/macros.h"
+#include "rcutils/types/rcutils_ret.h"
 #include "rcutils/visibility_control.h"
 
 /// Replace all the occurrences of one string for another in the given string.
@@ -135,6 +138,132 @@ rcutils_repl_str(
 
 // Implementation copied from above mentioned source continues in repl_str.c.
 
+struct rcutils_repl_str_set_impl_s;
+
+/// A set of strings to replace, compiled once to be applied to many strings.
+typedef struct RCUTILS_PUBLIC_TYPE rcutils_repl_str_set_s
+{
+  /// A pointer to the PIMPL implementation type.
+  struct rcutils_repl_str_set_impl_s * impl;
+} rcutils_repl_str_set_t;
+
+/// Return a zero initialized set of strings to replace.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ */
+RCUTILS_PUBLIC
+rcutils_repl_str_set_t
+rcutils_get_zero_initialized_repl_str_set(void);
+
+/// Compile a set of strings to replace.
+/**
+ * The `from` strings are compiled into an Aho-Corasick automaton, so that
+ * rcutils_repl_str_multi() replaces all of them in a single pass over a string.
+ * The `to` strings are copied, so neither array needs to outlive the set.
+ *
+ * If the same `from` string is given more than once, its first replacement is used.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * Example:
+ *
+ * ```c
+ * const char * from[] = {"~", "$(ns)", "$(node)"};
+ * const char * to[] = {"/home/user", "/robot", "driver"};
+ * rcutils_allocator_t allocator = rcutils_get_default_allocator();
+ * rcutils_repl_str_set_t set = rcutils_get_zero_initialized_repl_str_set();
+ * rcutils_ret_t ret = rcutils_repl_str_set_init(&set, from, to, 3, &allocator);
+ * if (ret != RCUTILS_RET_OK) {
+ *   // ... error handling
+ * }
+ * char * out = rcutils_repl_str_multi("$(ns)/$(node)/log", &set, &allocator);
+ * // out is "/robot/driver/log"
+ * allocator.deallocate(out, allocator.state);
+ * ret = rcutils_repl_str_set_fini(&set);
+ * ```
+ *
+ * \param[inout] set zero initialized set to be initialized
+ * \param[in] from array of the non empty strings to match for replacement
+ * \param[in] to array of the strings to replace the matching `from` strings with
+ * \param[in] count number of strings in the `from` and `to` arrays
+ * \param[in] allocator to be used to allocate and deallocate memory
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_repl_str_set_init(
+  rcutils_repl_str_set_t * set,
+  const char * const * from,
+  const char * const * to,
+  size_t count,
+  const rcutils_allocator_t * allocator);
+
+/// Finalize a set of strings to replace, reclaiming all resources.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] set to be finalized
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if set is `NULL`, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if set is not initialized.
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_repl_str_set_fini(rcutils_repl_str_set_t * set);
+
+/// Replace all the occurrences of a set of strings in the given string.
+/**
+ * The string is scanned once, from left to right, and each match is replaced by the
+ * `to` string of its `from` string.
+ * Where matches overlap, the one starting first is replaced, and among the ones starting
+ * at the same position, the longest.
+ * Unlike successive calls to rcutils_repl_str(), the replacements are never matched again.
+ *
+ * The size of the result is computed before it is allocated, so that it is allocated once.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] str string to have substrings found and replaced within
+ * \param[in] set initialized set of strings to replace
+ * \param[in] allocator structure defining functions to be used for allocation
+ * \return duplicated `str` with all the matches replaced, or
+ * \return `NULL` for invalid arguments, or if memory allocation fails.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+char *
+rcutils_repl_str_multi(
+  const char * str,
+  const rcutils_repl_str_set_t * set,
+  const rcutils_allocator_t * allocator);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,8 @@
  *  Algorithm specification can be found here:
  *  http://csrc.nist.gov/publications/fips/fips180-2/fips180-2withchangenotice.pdf
  *  This implementation uses little endian byte order.
+ *  Blocks are hashed with the SHA extensions or AVX2 on x86 processors, and with the
+ *  cryptography extensions on ARMv8 processors, when the processor supports them.
  *  This implementation makes no security guarantees, its use case if for
  *  non-sensitive comparison of message digests.
  */
@@ -37,6 +39,8 @@ extern "C"
 #include <stddef.h>
 #include <stdint.h>
 
+#include "rcutils/allocator.h"
+#include "rcutils/types/rcutils_ret.h"
 #include "rcutils/visibility_control.h"
 
 #define RCUTILS_SHA256_BLOCK_SIZE 32
@@ -93,6 +97,92 @@ void rcutils_sha256_final(
   uint8_t output_hash[RCUTILS_SHA256_BLOCK_SIZE]);
 #endif
 
+/**
+ * Hash many independent messages at once.
+ *
+ * This gives the same hashes as calling rcutils_sha256_init(), rcutils_sha256_update() and
+ * rcutils_sha256_final() for each message, but it hashes up to 4, 8 or 16 messages at the
+ * same time with SSE2 or NEON, AVX2 or AVX-512, each message in a lane of the vectors.
+ * It is meant for many short messages, which can't make use of the vectors on their own.
+ * On processors with SHA instructions but without AVX-512, the messages are hashed one by
+ * one with them instead, which is faster.
+ *
+ * \param[in] data Array of count messages, which may be `NULL` if their length is 0
+ * \param[in] data_lengths Array of the count message lengths
+ * \param[in] count Number of messages
+ * \param[out] output_hashes Array of count * RCUTILS_SHA256_BLOCK_SIZE bytes to be filled
+ *   with the message digests, one after the other in the order of the messages
+ * \return void
+ */
+RCUTILS_PUBLIC
+void rcutils_sha256_batch(
+  const uint8_t * const * data,
+  const size_t * data_lengths,
+  size_t count,
+  uint8_t * output_hashes);
+
+/**
+ * Compute the sha256 message digest of the contents of a file.
+ *
+ * The file is read with rcutils_digest_file(), so regular files are hashed straight from
+ * a read-only mapping of them.
+ *
+ * \param[in] file_path The path of the file to hash
+ * \param[in] allocator Allocator used for the read buffer of files which can't be mapped
+ * \param[out] output_hash Calculated sha256 message digest to be filled
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCUTILS_RET_ERROR if the file couldn't be opened or read.
+ */
+#ifdef DOXYGEN_ONLY
+RCUTILS_PUBLIC
+rcutils_ret_t rcutils_sha256_file(
+  const char * file_path,
+  rcutils_allocator_t allocator,
+  uint8_t * output_hash);
+#else
+RCUTILS_PUBLIC
+rcutils_ret_t rcutils_sha256_file(
+  const char * file_path,
+  rcutils_allocator_t allocator,
+  uint8_t output_hash[RCUTILS_SHA256_BLOCK_SIZE]);
+#endif
+
+/**
+ * Compute a tree digest of the contents of a file, for very large files.
+ *
+ * The file is split in chunks of chunk_size bytes, the last one being shorter if needed,
+ * which are hashed with rcutils_sha256_batch() several at a time.
+ * The result is the sha256 message digest of the digests of the chunks one after the other,
+ * so it differs from the one of rcutils_sha256_file(), and depends on chunk_size.
+ * The digest of an empty file is the one of an empty message.
+ *
+ * \param[in] file_path The path of the file to hash
+ * \param[in] chunk_size The size of the chunks, which must not be 0
+ * \param[in] allocator Allocator used for the read buffer of files which can't be mapped
+ * \param[out] output_hash Calculated tree digest to be filled
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCUTILS_RET_ERROR if the file couldn't be opened or read.
+ */
+#ifdef DOXYGEN_ONLY
+RCUTILS_PUBLIC
+rcutils_ret_t rcutils_sha256_file_tree(
+  const char * file_path,
+  size_t chunk_size,
+  rcutils_allocator_t allocator,
+  uint8_t * output_hash);
+#else
+RCUTILS_PUBLIC
+rcutils_ret_t rcutils_sha256_file_tree(
+  const char * file_path,
+  size_t chunk_size,
+  rcutils_allocator_t allocator,
+  uint8_t output_hash[RCUTILS_SHA256_BLOCK_SIZE]);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
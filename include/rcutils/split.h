@@ -22,6 +22,9 @@ extern "C"
 {
 #endif
 
+#include <stdbool.h>
+#include <stddef.h>
+
 #include "rcutils/allocator.h"
 #include "rcutils/types.h"
 #include "rcutils/visibility_control.h"
@@ -45,6 +48,29 @@ rcutils_split(
   rcutils_allocator_t allocator,
   rcutils_string_array_t * string_array);
 
+/// Split a given string with the specified delimiter into a packed string array
+/**
+ * This function produces the same tokens as rcutils_split(), but stores the array of pointers
+ * and all of the tokens in a single allocation, see rcutils_string_array_init_packed().
+ * The result is finalized with rcutils_string_array_fini() as usual.
+ *
+ * \param[in] str string to split
+ * \param[in] delimiter on where to split
+ * \param[in] allocator for allocating new memory for the output array
+ * \param[out] string_array with the split tokens
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_split_packed(
+  const char * str,
+  char delimiter,
+  rcutils_allocator_t allocator,
+  rcutils_string_array_t * string_array);
+
 /// Split a given string on the last occurrence of the specified delimiter
 /**
  * \param[in] str string to split
@@ -63,6 +89,105 @@ rcutils_split_last(
   rcutils_allocator_t allocator,
   rcutils_string_array_t * string_array);
 
+/// Split a given string on the last occurrence of the specified delimiter into a packed array
+/**
+ * This function produces the same tokens as rcutils_split_last(), but stores the array of
+ * pointers and the tokens in a single allocation, see rcutils_string_array_init_packed().
+ *
+ * \param[in] str string to split
+ * \param[in] delimiter on where to split
+ * \param[in] allocator for allocating new memory for the output array
+ * \param[out] string_array with the split tokens
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_split_last_packed(
+  const char * str,
+  char delimiter,
+  rcutils_allocator_t allocator,
+  rcutils_string_array_t * string_array);
+
+/// An iterator over the tokens of a string, which doesn't copy or allocate them
+typedef struct rcutils_split_tokenizer_s
+{
+  /// The beginning of the part of the string which is not tokenized yet
+  const char * position;
+  /// The end of the string
+  const char * end;
+  /// The delimiter between tokens
+  char delimiter;
+} rcutils_split_tokenizer_t;
+
+/// Begin iterating over the tokens of a string split with the specified delimiter.
+/**
+ * The tokens are the same as the ones given by rcutils_split(): leading, trailing and
+ * repeated delimiters are skipped, so that no token is empty.
+ * They are returned by rcutils_split_tokenizer_next() as views into the original string,
+ * which must outlive the tokenizer.
+ *
+ * For example:
+ *
+ * ```c
+ * rcutils_split_tokenizer_t tokenizer;
+ * rcutils_ret_t ret = rcutils_split_tokenizer_init(&tokenizer, "/ns/node", '/');
+ * const char * token;
+ * size_t token_length;
+ * while (rcutils_split_tokenizer_next(&tokenizer, &token, &token_length)) {
+ *   printf("%.*s\n", (int)token_length, token);
+ * }
+ * ```
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[out] tokenizer to be initialized
+ * \param[in] str null terminated string to split, which is handled as an empty string if `NULL`
+ * \param[in] delimiter on where to split
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if tokenizer is `NULL`
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_split_tokenizer_init(
+  rcutils_split_tokenizer_t * tokenizer,
+  const char * str,
+  char delimiter);
+
+/// Get the next token of a string being split.
+/**
+ * The delimiter which ends the token is searched with rcutils_findn(), which uses vector
+ * instructions when the processor supports them.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] tokenizer initialized with rcutils_split_tokenizer_init()
+ * \param[out] token the beginning of the token, which is not null terminated
+ * \param[out] token_length the number of characters of the token
+ * \return `true` if a token was found, or
+ * \return `false` if there are no tokens left, or if any argument is `NULL`.
+ */
+RCUTILS_PUBLIC
+bool
+rcutils_split_tokenizer_next(
+  rcutils_split_tokenizer_t * tokenizer,
+  const char ** token,
+  size_t * token_length);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,74 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCUTILS__TESTING__SHA256_H_
+#define RCUTILS__TESTING__SHA256_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "rcutils/macros.h"
+#include "rcutils/visibility_control.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// The transforms rcutils_sha256_update() hashes the blocks of a message with.
+typedef enum rcutils_sha256_implementation_e
+{
+  /// The fastest one the processor supports.
+  RCUTILS_SHA256_IMPLEMENTATION_AUTO = 0,
+  /// Portable C.
+  RCUTILS_SHA256_IMPLEMENTATION_SCALAR,
+  /// The SHA extensions of x86 processors.
+  RCUTILS_SHA256_IMPLEMENTATION_SHANI,
+  /// AVX2 and BMI2 on x86 processors.
+  RCUTILS_SHA256_IMPLEMENTATION_AVX2,
+  /// The cryptographic extension of ARMv8 processors.
+  RCUTILS_SHA256_IMPLEMENTATION_ARMV8
+} rcutils_sha256_implementation_t;
+
+/// Make the SHA-256 functions use the given transform for single messages, for testing.
+/**
+ * This is meant for tests, which check each transform the processor supports with it.
+ *
+ * \param[in] implementation The transform to use, or #RCUTILS_SHA256_IMPLEMENTATION_AUTO to
+ *   pick the fastest one again.
+ * \return `true` if the transform is used from now on, or
+ * \return `false` if it isn't compiled in or the processor doesn't support it.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool
+rcutils_sha256_force_implementation(rcutils_sha256_implementation_t implementation);
+
+/// Make rcutils_sha256_batch() hash the given number of messages at once, for testing.
+/**
+ * \param[in] lane_count 1 to hash the messages one by one, 4, 8 or 16 for the vector
+ *   transforms, or 0 to pick the fastest number again.
+ * \return `true` if the number of lanes is used from now on, or
+ * \return `false` if it isn't compiled in or the processor doesn't support it.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+bool
+rcutils_sha256_force_lane_count(size_t lane_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCUTILS__TESTING__SHA256_H_
@@ -180,6 +180,84 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_array_list_add(rcutils_array_list_t * array_list, const void * data);
 
+/// Adds several entries to the list
+/**
+ * This function adds the provided count entries, stored contiguously at data,
+ * to the end of the list, growing the list at most once.
+ * A shallow copy of the provided data is made, like with rcutils_array_list_add().
+ * The provided data must not point into the list itself.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] array_list to add the data to
+ * \param[in] data a pointer to the entries to add to the list, can be NULL if count is 0
+ * \param[in] count the number of entries to add
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_array_list_add_n(rcutils_array_list_t * array_list, const void * data, size_t count);
+
+/// Reserves capacity for entries in the list
+/**
+ * This function grows the capacity of the list to at least the provided
+ * capacity, so that adding entries up to that capacity does not allocate memory.
+ * The capacity is never decreased, see rcutils_array_list_shrink_to_fit() for that.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] array_list to reserve capacity in
+ * \param[in] capacity the minimum number of entries the list can hold afterwards
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_array_list_reserve(rcutils_array_list_t * array_list, size_t capacity);
+
+/// Reduces the capacity of the list to its size
+/**
+ * This function reallocates the storage of the list so that its capacity
+ * matches its size, or 1 if the list is empty.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] array_list to shrink
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_array_list_shrink_to_fit(rcutils_array_list_t * array_list);
+
 /// Sets an entry in the list to the provided data
 /**
  * This function sets the provided data at the specified index in the list.
@@ -232,6 +310,33 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_array_list_remove(rcutils_array_list_t * array_list, size_t index);
 
+/// Removes an entry in the list at the provided index, without preserving the order
+/**
+ * This function removes data from the list at the specified index by moving
+ * the last entry of the list in its place, which unlike rcutils_array_list_remove()
+ * takes constant time but changes the order of the entries.
+ * The capacity of the list will never decrease when entries are removed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] array_list to remove the data from
+ * \param[in] index the index of the item to remove from the list
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT if index out of bounds, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_array_list_swap_remove(rcutils_array_list_t * array_list, size_t index);
+
 /// Retrieves an entry in the list at the provided index
 /**
  * This function retrieves a copy of the data stored in the list at the provided index.
@@ -281,6 +386,59 @@ RCUTILS_WARN_UNUSED
 rcutils_ret_t
 rcutils_array_list_get_size(const rcutils_array_list_t * array_list, size_t * size);
 
+/// Retrieves the capacity of the provided array_list
+/**
+ * This function retrieves the number of items the provided array list can
+ * hold without allocating memory.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] array_list list to get the capacity of
+ * \param[out] capacity The number of items the list can hold
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_array_list_get_capacity(const rcutils_array_list_t * array_list, size_t * capacity);
+
+/// Retrieves the storage of the provided array_list
+/**
+ * This function retrieves a pointer to the entries stored in the list, which
+ * are contiguous, and the number of entries, so that they can be iterated over
+ * and modified in place without copying each of them with rcutils_array_list_get().
+ *
+ * The pointer is valid until an entry is added, the capacity of the list changes,
+ * or the list is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] array_list list to get the storage of
+ * \param[out] data A pointer to the first entry of the list
+ * \param[out] size The number of items currently stored in the list
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_array_list_get_data(const rcutils_array_list_t * array_list, void ** data, size_t * size);
+
 #ifdef __cplusplus
 }
 #endif
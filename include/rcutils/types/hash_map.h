@@ -77,6 +77,10 @@ typedef int (* rcutils_hash_map_key_cmp_t)(
 /**
  * A hashing function for a null terminated c string.
  * Should be used when your key is just a pointer to a c-string
+ *
+ * The hash is the djb2 string hash computed in `size_t` arithmetic, which
+ * rcutils::logging::hash_logger_name() in rcutils/logging_macros.hpp reproduces
+ * at compile time; the two must be kept in sync.
  */
 RCUTILS_PUBLIC
 size_t
@@ -366,6 +370,38 @@ RCUTILS_PUBLIC
 rcutils_ret_t
 rcutils_hash_map_get(const rcutils_hash_map_t * hash_map, const void * key, void * data);
 
+/// Get value given a key and its precomputed hash.
+/**
+ * Identical to rcutils_hash_map_get() but skips calling the key hashing function
+ * of the hash_map, which allows callers to compute the hash of a key once, for
+ * instance at compile time, and reuse it for every lookup.
+ *
+ * The key_hash must be the value the key hashing function given to
+ * rcutils_hash_map_init() returns for the key, otherwise the key will not be found.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] hash_map rcutils_hash_map_t to be searched
+ * \param[in] key hash_map key to look up the data for
+ * \param[in] key_hash The hashed value of the key
+ * \param[out] data A copy of the data stored in the map
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_NOT_INITIALIZED if the hash_map is invalid, or
+ * \return #RCUTILS_RET_NOT_FOUND if the key doesn't exist in the map, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+rcutils_ret_t
+rcutils_hash_map_get_with_hash(
+  const rcutils_hash_map_t * hash_map, const void * key, size_t key_hash, void * data);
+
 /// Get the next key in the hash_map, unless NULL is given, then get the first key.
 /**
  * This function allows you to iteratively get each key/value pair in the hash_map.
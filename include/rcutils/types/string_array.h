@@ -103,13 +103,71 @@ rcutils_string_array_init(
   size_t size,
   const rcutils_allocator_t * allocator);
 
+/// Initialize a string array with a given size, storing the strings in the same allocation.
+/**
+ * This function will initialize a given, zero initialized, string array to
+ * a given size, with a single allocation holding both the array of strings and
+ * characters_size characters for the strings themselves, which is much cheaper
+ * to allocate and deallocate than one allocation per string.
+ *
+ * The entries of the array are set to `NULL`, and characters is set to the
+ * characters storage, into which the caller writes the strings and makes the
+ * entries point to.
+ * Unlike with rcutils_string_array_init(), the strings are owned by the array
+ * as a whole: an entry must not be deallocated or replaced by a string which
+ * was allocated separately.
+ * rcutils_string_array_resize() converts a packed string array into one with
+ * separately allocated strings.
+ *
+ * The allocator member of a packed string array is a private one, which forwards
+ * to the given allocator until the string array is finalized, and which must not
+ * be replaced; rcutils_string_array_fini() restores the given allocator.
+ *
+ * Example:
+ *
+ * ```c
+ * rcutils_allocator_t allocator = rcutils_get_default_allocator();
+ * rcutils_string_array_t string_array = rcutils_get_zero_initialized_string_array();
+ * char * characters = NULL;
+ * rcutils_ret_t ret = rcutils_string_array_init_packed(
+ *   &string_array, 2, sizeof("Hello") + sizeof("World"), &allocator, &characters);
+ * if (ret != RCUTILS_RET_OK) {
+ *   // ... error handling
+ * }
+ * string_array.data[0] = memcpy(characters, "Hello", sizeof("Hello"));
+ * string_array.data[1] = memcpy(characters + sizeof("Hello"), "World", sizeof("World"));
+ * ret = rcutils_string_array_fini(&string_array);
+ * ```
+ *
+ * \param[inout] string_array object to be initialized
+ * \param[in] size the size the array should be
+ * \param[in] characters_size the number of characters to allocate for the strings,
+ *   including their null terminators
+ * \param[in] allocator to be used to allocate and deallocate memory
+ * \param[out] characters the storage for characters_size characters
+ * \return #RCUTILS_RET_OK if successful, or
+ * \return #RCUTILS_RET_INVALID_ARGUMENT for invalid arguments, or
+ * \return #RCUTILS_RET_BAD_ALLOC if memory allocation fails, or
+ * \return #RCUTILS_RET_ERROR if an unknown error occurs.
+ */
+RCUTILS_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t
+rcutils_string_array_init_packed(
+  rcutils_string_array_t * string_array,
+  size_t size,
+  size_t characters_size,
+  const rcutils_allocator_t * allocator,
+  char ** characters);
+
 /// Finalize a string array, reclaiming all resources.
 /**
  * This function reclaims any memory owned by the string array, including the
  * strings it references.
  *
  * The allocator used to initialize the string array is used to deallocate each
- * string in the array and the array of strings itself.
+ * string in the array and the array of strings itself, or the single allocation
+ * holding both if the string array is packed.
  *
  * \param[inout] string_array object to be finalized
  * \return #RCUTILS_RET_OK if successful, or
@@ -150,6 +208,8 @@ rcutils_string_array_cmp(
  * are zero- initialized.
  * If the new size is smaller, entries are removed from the end of the array
  * and their resources reclaimed.
+ * If the string array is packed, the remaining strings are copied into separate
+ * allocations, and the string array is not packed anymore afterwards.
  *
  * \par Note:
  * Resizing to 0 is not a substitute for calling ::rcutils_string_array_fini.
@@ -60,6 +60,9 @@ extern "C"
 // The RCUTILS_LOG_COND_NAMED macro is surrounded by do { .. } while (0) to implement
 // the standard C macro idiom to make the macro safe in all contexts; see
 // http://c-faq.com/cpp/multistmt.html for more information.
+// The expansion is kept small since it is repeated at every call site: the logging system
+// is initialized on demand by rcutils_logging_logger_is_enabled_for(), and the code for
+// enabled statements is laid out away from the severity check.
 /**
  * \def RCUTILS_LOG_COND_NAMED
  * The logging macro all other logging macros call directly or indirectly.
@@ -74,9 +77,8 @@ extern "C"
  */
 #define RCUTILS_LOG_COND_NAMED(severity, condition_before, condition_after, name, ...) \
   do { \
-    RCUTILS_LOGGING_AUTOINIT; \
-    static rcutils_log_location_t __rcutils_logging_location = {__func__, __FILE__, __LINE__}; \
-    if (rcutils_logging_logger_is_enabled_for(name, severity)) { \
+    static const rcutils_log_location_t __rcutils_logging_location = {__func__, __FILE__, __LINE__}; \
+    if (RCUTILS_UNLIKELY(rcutils_logging_logger_is_enabled_for(name, severity))) { \
       condition_before \
       rcutils_log_internal(&__rcutils_logging_location, severity, name, __VA_ARGS__); \
       condition_after \
@@ -186,18 +188,10 @@ typedef bool (* RclLogFilter)(void);
   static rcutils_duration_value_t __rcutils_logging_duration = RCUTILS_MS_TO_NS(RCUTILS_CAST_DURATION(duration)); \
   static rcutils_time_point_value_t __rcutils_logging_last_logged = 0; \
   rcutils_time_point_value_t __rcutils_logging_now = 0; \
-  bool __rcutils_logging_condition = true; \
-  if (get_time_point_value(&__rcutils_logging_now) != RCUTILS_RET_OK) { \
-  rcutils_log( \
-      &__rcutils_logging_location, RCUTILS_LOG_SEVERITY_ERROR, "", \
-      "%s() at %s:%d getting current steady time failed\n", \
-      __func__, __FILE__, __LINE__); \
-  } else { \
-  __rcutils_logging_condition = __rcutils_logging_now >= __rcutils_logging_last_logged + __rcutils_logging_duration; \
-  } \
- \
-  if (RCUTILS_LIKELY(__rcutils_logging_condition)) { \
-  __rcutils_logging_last_logged = __rcutils_logging_now;
+  rcutils_ret_t __rcutils_logging_time_ret = get_time_point_value(&__rcutils_logging_now); \
+  if (RCUTILS_LIKELY(rcutils_logging_throttle_is_due( \
+      __rcutils_logging_time_ret, __rcutils_logging_now, __rcutils_logging_duration, \
+      &__rcutils_logging_last_logged, &__rcutils_logging_location))) {
 
 /**
  * \def RCUTILS_LOG_CONDITION_THROTTLE_AFTER
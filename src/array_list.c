@@ -17,6 +17,7 @@ extern "C"
 {
 #endif
 
+#include <stdint.h>
 #include <string.h>
 
 #include "rcutils/allocator.h"
@@ -101,15 +102,21 @@ rcutils_array_list_fini(rcutils_array_list_t * array_list)
   return RCUTILS_RET_OK;
 }
 
-static rcutils_ret_t rcutils_array_list_increase_capacity(rcutils_array_list_t * array_list)
+static rcutils_ret_t rcutils_array_list_set_capacity(
+  rcutils_array_list_t * array_list,
+  size_t new_capacity)
 {
-  size_t new_capacity = 2 * array_list->impl->capacity;
+  if (new_capacity > SIZE_MAX / array_list->impl->data_size) {
+    RCUTILS_SET_ERROR_MSG("array list capacity would overflow");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
   size_t new_size = array_list->impl->data_size * new_capacity;
   void * new_list = array_list->impl->allocator.reallocate(
     array_list->impl->list,
     new_size,
     array_list->impl->allocator.state);
   if (NULL == new_list) {
+    RCUTILS_SET_ERROR_MSG("failed to reallocate memory for array list data");
     return RCUTILS_RET_BAD_ALLOC;
   }
   array_list->impl->list = new_list;
@@ -117,6 +124,20 @@ static rcutils_ret_t rcutils_array_list_increase_capacity(rcutils_array_list_t *
   return RCUTILS_RET_OK;
 }
 
+// Grow the capacity to at least min_capacity, at least doubling it so that adding elements one
+// at a time stays amortized O(1).
+static rcutils_ret_t rcutils_array_list_increase_capacity(
+  rcutils_array_list_t * array_list,
+  size_t min_capacity)
+{
+  size_t new_capacity = array_list->impl->capacity > SIZE_MAX / 2 ?
+    SIZE_MAX : 2 * array_list->impl->capacity;
+  if (new_capacity < min_capacity) {
+    new_capacity = min_capacity;
+  }
+  return rcutils_array_list_set_capacity(array_list, new_capacity);
+}
+
 static uint8_t * rcutils_array_list_get_pointer_for_index(
   const rcutils_array_list_t * array_list,
   size_t index)
@@ -134,7 +155,7 @@ rcutils_array_list_add(rcutils_array_list_t * array_list, const void * data)
   rcutils_ret_t ret = RCUTILS_RET_OK;
 
   if (array_list->impl->size + 1 > array_list->impl->capacity) {
-    ret = rcutils_array_list_increase_capacity(array_list);
+    ret = rcutils_array_list_increase_capacity(array_list, array_list->impl->size + 1);
     if (RCUTILS_RET_OK != ret) {
       return ret;
     }
@@ -148,6 +169,57 @@ rcutils_array_list_add(rcutils_array_list_t * array_list, const void * data)
   return ret;
 }
 
+rcutils_ret_t
+rcutils_array_list_add_n(rcutils_array_list_t * array_list, const void * data, size_t count)
+{
+  ARRAY_LIST_VALIDATE_ARRAY_LIST(array_list);
+  if (0 == count) {
+    return RCUTILS_RET_OK;
+  }
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
+  if (count > SIZE_MAX - array_list->impl->size) {
+    RCUTILS_SET_ERROR_MSG("count would overflow the size of the list");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  size_t new_size = array_list->impl->size + count;
+  if (new_size > array_list->impl->capacity) {
+    rcutils_ret_t ret = rcutils_array_list_increase_capacity(array_list, new_size);
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+  }
+
+  uint8_t * index_ptr =
+    rcutils_array_list_get_pointer_for_index(array_list, array_list->impl->size);
+  memcpy(index_ptr, data, array_list->impl->data_size * count);
+
+  array_list->impl->size = new_size;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_array_list_reserve(rcutils_array_list_t * array_list, size_t capacity)
+{
+  ARRAY_LIST_VALIDATE_ARRAY_LIST(array_list);
+  if (capacity <= array_list->impl->capacity) {
+    return RCUTILS_RET_OK;
+  }
+  return rcutils_array_list_set_capacity(array_list, capacity);
+}
+
+rcutils_ret_t
+rcutils_array_list_shrink_to_fit(rcutils_array_list_t * array_list)
+{
+  ARRAY_LIST_VALIDATE_ARRAY_LIST(array_list);
+  // The capacity is never less than 1, like in rcutils_array_list_init().
+  size_t new_capacity = array_list->impl->size > 0 ? array_list->impl->size : 1;
+  if (new_capacity == array_list->impl->capacity) {
+    return RCUTILS_RET_OK;
+  }
+  return rcutils_array_list_set_capacity(array_list, new_capacity);
+}
+
 rcutils_ret_t
 rcutils_array_list_set(rcutils_array_list_t * array_list, size_t index, const void * data)
 {
@@ -183,6 +255,25 @@ rcutils_array_list_remove(rcutils_array_list_t * array_list, size_t index)
   return RCUTILS_RET_OK;
 }
 
+rcutils_ret_t
+rcutils_array_list_swap_remove(rcutils_array_list_t * array_list, size_t index)
+{
+  ARRAY_LIST_VALIDATE_ARRAY_LIST(array_list);
+  ARRAY_LIST_VALIDATE_INDEX_IN_BOUNDS(array_list, index);
+
+  // Move the last entry in place of the removed one
+  size_t last_index = array_list->impl->size - 1;
+  if (index != last_index) {
+    memcpy(
+      rcutils_array_list_get_pointer_for_index(array_list, index),
+      rcutils_array_list_get_pointer_for_index(array_list, last_index),
+      array_list->impl->data_size);
+  }
+
+  array_list->impl->size--;
+  return RCUTILS_RET_OK;
+}
+
 rcutils_ret_t
 rcutils_array_list_get(const rcutils_array_list_t * array_list, size_t index, void * data)
 {
@@ -205,6 +296,26 @@ rcutils_array_list_get_size(const rcutils_array_list_t * array_list, size_t * si
   return RCUTILS_RET_OK;
 }
 
+rcutils_ret_t
+rcutils_array_list_get_capacity(const rcutils_array_list_t * array_list, size_t * capacity)
+{
+  ARRAY_LIST_VALIDATE_ARRAY_LIST(array_list);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(capacity, RCUTILS_RET_INVALID_ARGUMENT);
+  *capacity = array_list->impl->capacity;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_array_list_get_data(const rcutils_array_list_t * array_list, void ** data, size_t * size)
+{
+  ARRAY_LIST_VALIDATE_ARRAY_LIST(array_list);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(size, RCUTILS_RET_INVALID_ARGUMENT);
+  *data = array_list->impl->list;
+  *size = array_list->impl->size;
+  return RCUTILS_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
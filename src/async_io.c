@@ -0,0 +1,952 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rcutils/async_io.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#else
+// When building with MSVC 19.28.29333.0 on Windows 10 (as of 2020-11-11),
+// there appears to be a problem with winbase.h (which is included by
+// Windows.h).  In particular, warnings of the form:
+//
+// warning C5105: macro expansion producing 'defined' has undefined behavior
+//
+// See https://developercommunity.visualstudio.com/content/problem/695656/wdk-and-sdk-are-not-compatible-with-experimentalpr.html
+// for more information.  For now disable that warning when including windows.h
+#pragma warning(push)
+#pragma warning(disable : 5105)
+#include <windows.h>
+#pragma warning(pop)
+#include <fcntl.h>
+#include <io.h>
+#endif  // _WIN32
+
+// io_uring is used through its system calls, as liburing isn't required.
+// Waiting with a timeout needs IORING_FEAT_EXT_ARG, from Linux 5.11.
+#if defined(__linux__) && defined(__has_include)
+# if __has_include(<linux/io_uring.h>) && __has_include(<linux/stat.h>)
+#  include <linux/io_uring.h>
+#  include <linux/stat.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <sys/sysmacros.h>
+#  ifdef IORING_FEAT_EXT_ARG
+#   define RCUTILS_ASYNC_IO_HAVE_IO_URING
+#  endif
+# endif
+#endif
+
+#include "rcutils/error_handling.h"
+#include "rcutils/time.h"
+
+#include "./filesystem_helpers.h"
+#include "./thread_helpers.h"
+
+#ifdef RCUTILS_ASYNC_IO_HAVE_IO_URING
+// The C library may be older than the kernel headers.
+# ifndef __NR_io_uring_setup
+#  define __NR_io_uring_setup 425
+# endif
+# ifndef __NR_io_uring_enter
+#  define __NR_io_uring_enter 426
+# endif
+# ifndef __NR_io_uring_register
+#  define __NR_io_uring_register 427
+# endif
+#endif
+
+#define RCUTILS_ASYNC_IO_DEFAULT_QUEUE_DEPTH 256
+#define RCUTILS_ASYNC_IO_MAX_QUEUE_DEPTH 32768
+#define RCUTILS_ASYNC_IO_DEFAULT_THREAD_COUNT 4
+// Reads and writes are limited to this, like read() and write() on Linux.
+#define RCUTILS_ASYNC_IO_MAX_LENGTH ((size_t)0x7ffff000)
+
+#define NO_SLOT SIZE_MAX
+
+// A request in progress.
+typedef struct async_io_slot_s
+{
+  rcutils_async_io_request_t request;
+  int64_t result;
+  // The next slot of the list the slot is in.
+  size_t next;
+#ifdef RCUTILS_ASYNC_IO_HAVE_IO_URING
+  struct statx statx_buffer;
+#endif
+} async_io_slot_t;
+
+typedef struct async_io_list_s
+{
+  size_t first;
+  size_t last;
+} async_io_list_t;
+
+#ifdef RCUTILS_ASYNC_IO_HAVE_IO_URING
+typedef struct async_io_uring_s
+{
+  int fd;
+  void * sq_ring;
+  size_t sq_ring_size;
+  void * cq_ring;
+  size_t cq_ring_size;
+  struct io_uring_sqe * sqes;
+  size_t sqes_size;
+  uint32_t * sq_tail;
+  uint32_t * sq_array;
+  uint32_t sq_mask;
+  uint32_t * cq_head;
+  uint32_t * cq_tail;
+  uint32_t cq_mask;
+  struct io_uring_cqe * cqes;
+  // The tail of the submission queue, up to which entries are written but not submitted.
+  uint32_t sq_local_tail;
+  uint32_t unsubmitted;
+} async_io_uring_t;
+#endif
+
+typedef struct rcutils_async_io_impl_s
+{
+  rcutils_allocator_t allocator;
+  rcutils_async_io_backend_t backend;
+  size_t queue_depth;
+  async_io_slot_t * slots;
+  // The slots of no request, only used by the thread using the engine.
+  async_io_list_t free_slots;
+  size_t in_flight;
+#ifdef RCUTILS_ASYNC_IO_HAVE_IO_URING
+  async_io_uring_t ring;
+#endif
+  // The pool of threads, with the slots it hasn't done yet, and the ones it has, guarded by
+  // the mutex.
+  rcutils_mutex_t mutex;
+  rcutils_cond_t request_cond;
+  rcutils_cond_t completion_cond;
+  async_io_list_t pending;
+  async_io_list_t completed;
+  bool stopping;
+  rcutils_thread_t * threads;
+  size_t thread_count;
+} rcutils_async_io_impl_t;
+
+static void list_push(async_io_slot_t * slots, async_io_list_t * list, size_t index)
+{
+  slots[index].next = NO_SLOT;
+  if (NO_SLOT == list->last) {
+    list->first = index;
+  } else {
+    slots[list->last].next = index;
+  }
+  list->last = index;
+}
+
+static size_t list_pop(async_io_slot_t * slots, async_io_list_t * list)
+{
+  size_t index = list->first;
+  if (NO_SLOT != index) {
+    list->first = slots[index].next;
+    if (NO_SLOT == list->first) {
+      list->last = NO_SLOT;
+    }
+  }
+  return index;
+}
+
+static const async_io_list_t empty_list = {NO_SLOT, NO_SLOT};
+
+// Call the callback of a completed request, and free its slot.
+static void complete_slot(rcutils_async_io_impl_t * impl, size_t index)
+{
+  async_io_slot_t * slot = &impl->slots[index];
+  --impl->in_flight;
+  if (NULL != slot->request.callback) {
+    slot->request.callback(&slot->request, slot->result);
+  }
+  list_push(impl->slots, &impl->free_slots, index);
+}
+
+static int get_open_flags(uint32_t flags)
+{
+#ifdef _WIN32
+  int open_flags = _O_BINARY | _O_NOINHERIT;
+  if ((flags & RCUTILS_ASYNC_IO_OPEN_READ) && (flags & RCUTILS_ASYNC_IO_OPEN_WRITE)) {
+    open_flags |= _O_RDWR;
+  } else if (flags & RCUTILS_ASYNC_IO_OPEN_WRITE) {
+    open_flags |= _O_WRONLY;
+  } else {
+    open_flags |= _O_RDONLY;
+  }
+  open_flags |= (flags & RCUTILS_ASYNC_IO_OPEN_CREATE) ? _O_CREAT : 0;
+  open_flags |= (flags & RCUTILS_ASYNC_IO_OPEN_TRUNCATE) ? _O_TRUNC : 0;
+  open_flags |= (flags & RCUTILS_ASYNC_IO_OPEN_APPEND) ? _O_APPEND : 0;
+#else
+  int open_flags = O_CLOEXEC;
+  if ((flags & RCUTILS_ASYNC_IO_OPEN_READ) && (flags & RCUTILS_ASYNC_IO_OPEN_WRITE)) {
+    open_flags |= O_RDWR;
+  } else if (flags & RCUTILS_ASYNC_IO_OPEN_WRITE) {
+    open_flags |= O_WRONLY;
+  } else {
+    open_flags |= O_RDONLY;
+  }
+  open_flags |= (flags & RCUTILS_ASYNC_IO_OPEN_CREATE) ? O_CREAT : 0;
+  open_flags |= (flags & RCUTILS_ASYNC_IO_OPEN_TRUNCATE) ? O_TRUNC : 0;
+  open_flags |= (flags & RCUTILS_ASYNC_IO_OPEN_APPEND) ? O_APPEND : 0;
+#endif
+  return open_flags;
+}
+
+static size_t get_length(const rcutils_async_io_request_t * request)
+{
+  return request->length < RCUTILS_ASYNC_IO_MAX_LENGTH ?
+         request->length : RCUTILS_ASYNC_IO_MAX_LENGTH;
+}
+
+// Do a request with the blocking functions, for the pool of threads.
+static int64_t do_request(const rcutils_async_io_request_t * request)
+{
+#ifdef _WIN32
+  HANDLE handle = INVALID_HANDLE_VALUE;
+  OVERLAPPED overlapped;
+  DWORD done = 0;
+  if (RCUTILS_ASYNC_IO_READ == request->operation ||
+    RCUTILS_ASYNC_IO_WRITE == request->operation)
+  {
+    handle = (HANDLE)_get_osfhandle(request->fd);
+    if (INVALID_HANDLE_VALUE == handle) {
+      return -EBADF;
+    }
+    memset(&overlapped, 0, sizeof(overlapped));
+    overlapped.Offset = (DWORD)request->offset;
+    overlapped.OffsetHigh = (DWORD)(request->offset >> 32);
+  }
+  switch (request->operation) {
+    case RCUTILS_ASYNC_IO_READ:
+      if (!ReadFile(handle, request->buffer, (DWORD)get_length(request), &done, &overlapped)) {
+        return ERROR_HANDLE_EOF == GetLastError() ? 0 : -EIO;
+      }
+      return (int64_t)done;
+    case RCUTILS_ASYNC_IO_WRITE:
+      if (!WriteFile(handle, request->buffer, (DWORD)get_length(request), &done, &overlapped)) {
+        return -EIO;
+      }
+      return (int64_t)done;
+    case RCUTILS_ASYNC_IO_FSYNC:
+      return 0 == _commit(request->fd) ? 0 : -errno;
+    case RCUTILS_ASYNC_IO_STAT:
+      {
+        WIN32_FIND_DATA data;
+        HANDLE find_handle = FindFirstFile(request->path, &data);
+        if (INVALID_HANDLE_VALUE == find_handle) {
+          return -ENOENT;
+        }
+        FindClose(find_handle);
+        const bool follow = !(request->flags & RCUTILS_ASYNC_IO_STAT_NO_FOLLOW);
+        file_stat_from_find_data(
+          &data, file_type_from_attributes(data.dwFileAttributes, follow), request->stat);
+        return 0;
+      }
+    case RCUTILS_ASYNC_IO_OPEN:
+      {
+        int fd = _open(request->path, get_open_flags(request->flags), _S_IREAD | _S_IWRITE);
+        return fd < 0 ? -errno : fd;
+      }
+    case RCUTILS_ASYNC_IO_CLOSE:
+      return 0 == _close(request->fd) ? 0 : -errno;
+    default:
+      return -EINVAL;
+  }
+#else
+  ssize_t done = 0;
+  switch (request->operation) {
+    case RCUTILS_ASYNC_IO_READ:
+      do {
+        done = pread(request->fd, request->buffer, get_length(request), (off_t)request->offset);
+      } while (done < 0 && EINTR == errno);
+      return done < 0 ? -errno : done;
+    case RCUTILS_ASYNC_IO_WRITE:
+      do {
+        done = pwrite(request->fd, request->buffer, get_length(request), (off_t)request->offset);
+      } while (done < 0 && EINTR == errno);
+      return done < 0 ? -errno : done;
+    case RCUTILS_ASYNC_IO_FSYNC:
+# ifdef __APPLE__
+      return 0 == fsync(request->fd) ? 0 : -errno;
+# else
+      if (request->flags & RCUTILS_ASYNC_IO_FSYNC_DATA_ONLY) {
+        return 0 == fdatasync(request->fd) ? 0 : -errno;
+      }
+      return 0 == fsync(request->fd) ? 0 : -errno;
+# endif
+    case RCUTILS_ASYNC_IO_STAT:
+      {
+        struct stat stat_buffer;
+        int flags = (request->flags & RCUTILS_ASYNC_IO_STAT_NO_FOLLOW) ? AT_SYMLINK_NOFOLLOW : 0;
+        if (0 != fstatat(AT_FDCWD, request->path, &stat_buffer, flags)) {
+          return -errno;
+        }
+        file_stat_from_stat(&stat_buffer, request->stat);
+        return 0;
+      }
+    case RCUTILS_ASYNC_IO_OPEN:
+      {
+        int fd = open(request->path, get_open_flags(request->flags), 0666);
+        return fd < 0 ? -errno : fd;
+      }
+    case RCUTILS_ASYNC_IO_CLOSE:
+      return 0 == close(request->fd) ? 0 : -errno;
+    default:
+      return -EINVAL;
+  }
+#endif
+}
+
+static void thread_pool_run(rcutils_async_io_impl_t * impl)
+{
+  mutex_lock(&impl->mutex);
+  for (;;) {
+    while (NO_SLOT == impl->pending.first && !impl->stopping) {
+      cond_wait(&impl->request_cond, &impl->mutex);
+    }
+    size_t index = list_pop(impl->slots, &impl->pending);
+    if (NO_SLOT == index) {
+      break;
+    }
+    mutex_unlock(&impl->mutex);
+
+    int64_t result = do_request(&impl->slots[index].request);
+
+    mutex_lock(&impl->mutex);
+    impl->slots[index].result = result;
+    list_push(impl->slots, &impl->completed, index);
+    cond_signal(&impl->completion_cond);
+  }
+  mutex_unlock(&impl->mutex);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI thread_pool_main(LPVOID impl)
+{
+  thread_pool_run((rcutils_async_io_impl_t *)impl);
+  return 0;
+}
+#else
+static void * thread_pool_main(void * impl)
+{
+  thread_pool_run((rcutils_async_io_impl_t *)impl);
+  return NULL;
+}
+#endif
+
+static void thread_pool_fini(rcutils_async_io_impl_t * impl)
+{
+  mutex_lock(&impl->mutex);
+  impl->stopping = true;
+  cond_broadcast(&impl->request_cond);
+  mutex_unlock(&impl->mutex);
+  for (size_t i = 0; i < impl->thread_count; ++i) {
+#ifdef _WIN32
+    WaitForSingleObject(impl->threads[i], INFINITE);
+    CloseHandle(impl->threads[i]);
+#else
+    pthread_join(impl->threads[i], NULL);
+#endif
+  }
+  impl->allocator.deallocate(impl->threads, impl->allocator.state);
+  cond_fini(&impl->completion_cond);
+  cond_fini(&impl->request_cond);
+  mutex_fini(&impl->mutex);
+}
+
+static rcutils_ret_t thread_pool_init(rcutils_async_io_impl_t * impl, size_t thread_count)
+{
+  impl->threads = impl->allocator.allocate(
+    thread_count * sizeof(rcutils_thread_t), impl->allocator.state);
+  if (NULL == impl->threads) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory.");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  mutex_init(&impl->mutex);
+  cond_init(&impl->request_cond);
+  cond_init(&impl->completion_cond);
+  impl->pending = empty_list;
+  impl->completed = empty_list;
+  impl->stopping = false;
+  for (impl->thread_count = 0; impl->thread_count < thread_count; ++impl->thread_count) {
+#ifdef _WIN32
+    impl->threads[impl->thread_count] = CreateThread(NULL, 0, thread_pool_main, impl, 0, NULL);
+    const bool started = NULL != impl->threads[impl->thread_count];
+#else
+    const bool started =
+      0 == pthread_create(&impl->threads[impl->thread_count], NULL, thread_pool_main, impl);
+#endif
+    if (!started) {
+      thread_pool_fini(impl);
+      RCUTILS_SET_ERROR_MSG("Failed to start the threads.");
+      return RCUTILS_RET_ERROR;
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+
+static void thread_pool_submit(rcutils_async_io_impl_t * impl, size_t index)
+{
+  mutex_lock(&impl->mutex);
+  list_push(impl->slots, &impl->pending, index);
+  cond_signal(&impl->request_cond);
+  mutex_unlock(&impl->mutex);
+}
+
+// Get the time left before a deadline, which is 0 if it passed, or -1 if there is none.
+static int64_t get_remaining_time(rcutils_time_point_value_t deadline)
+{
+  if (deadline < 0) {
+    return -1;
+  }
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    return 0;
+  }
+  return deadline > now ? deadline - now : 0;
+}
+
+static size_t thread_pool_wait(
+  rcutils_async_io_impl_t * impl, size_t target, rcutils_time_point_value_t deadline)
+{
+  size_t completions = 0;
+  for (;;) {
+    mutex_lock(&impl->mutex);
+    bool timed_out = false;
+    while (NO_SLOT == impl->completed.first && completions < target && !timed_out) {
+      int64_t remaining = get_remaining_time(deadline);
+      if (remaining < 0) {
+        cond_wait(&impl->completion_cond, &impl->mutex);
+      } else {
+        timed_out = 0 == remaining ||
+          (!cond_timed_wait(&impl->completion_cond, &impl->mutex, remaining) &&
+          NO_SLOT == impl->completed.first);
+      }
+    }
+    async_io_list_t completed = impl->completed;
+    impl->completed = empty_list;
+    mutex_unlock(&impl->mutex);
+
+    if (NO_SLOT == completed.first) {
+      return completions;
+    }
+    // The slots are freed once their callback is called.
+    for (size_t index = completed.first; NO_SLOT != index; ) {
+      size_t next = impl->slots[index].next;
+      complete_slot(impl, index);
+      ++completions;
+      index = next;
+    }
+    if (completions >= target) {
+      return completions;
+    }
+  }
+}
+
+#ifdef RCUTILS_ASYNC_IO_HAVE_IO_URING
+static void uring_fini(async_io_uring_t * ring)
+{
+  if (NULL != ring->sqes) {
+    munmap(ring->sqes, ring->sqes_size);
+  }
+  if (NULL != ring->cq_ring && ring->cq_ring != ring->sq_ring) {
+    munmap(ring->cq_ring, ring->cq_ring_size);
+  }
+  if (NULL != ring->sq_ring) {
+    munmap(ring->sq_ring, ring->sq_ring_size);
+  }
+  if (ring->fd >= 0) {
+    close(ring->fd);
+  }
+}
+
+// Check that the kernel supports all the operations.
+static bool uring_probe(async_io_uring_t * ring, rcutils_allocator_t allocator)
+{
+  const unsigned int op_count = 256;
+  struct io_uring_probe * probe = allocator.zero_allocate(
+    1, sizeof(struct io_uring_probe) + op_count * sizeof(struct io_uring_probe_op),
+    allocator.state);
+  if (NULL == probe) {
+    return false;
+  }
+  bool supported =
+    syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_PROBE, probe, op_count) >= 0;
+  const uint8_t ops[] = {
+    IORING_OP_READ, IORING_OP_WRITE, IORING_OP_FSYNC, IORING_OP_STATX, IORING_OP_OPENAT,
+    IORING_OP_CLOSE,
+  };
+  for (size_t i = 0; supported && i < sizeof(ops) / sizeof(ops[0]); ++i) {
+    supported = ops[i] < probe->ops_len && (probe->ops[ops[i]].flags & IO_URING_OP_SUPPORTED);
+  }
+  allocator.deallocate(probe, allocator.state);
+  return supported;
+}
+
+static bool uring_init(async_io_uring_t * ring, size_t queue_depth, rcutils_allocator_t allocator)
+{
+  memset(ring, 0, sizeof(*ring));
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring->fd = (int)syscall(__NR_io_uring_setup, (unsigned int)queue_depth, &params);
+  if (ring->fd < 0) {
+    return false;
+  }
+  if (!(params.features & IORING_FEAT_EXT_ARG) || !uring_probe(ring, allocator)) {
+    uring_fini(ring);
+    return false;
+  }
+
+  ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    if (ring->cq_ring_size > ring->sq_ring_size) {
+      ring->sq_ring_size = ring->cq_ring_size;
+    }
+    ring->cq_ring_size = ring->sq_ring_size;
+  }
+  void * sq_ring = mmap(
+    NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd,
+    IORING_OFF_SQ_RING);
+  ring->sq_ring = MAP_FAILED == sq_ring ? NULL : sq_ring;
+  if (single_mmap) {
+    ring->cq_ring = ring->sq_ring;
+  } else if (NULL != ring->sq_ring) {
+    void * cq_ring = mmap(
+      NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd,
+      IORING_OFF_CQ_RING);
+    ring->cq_ring = MAP_FAILED == cq_ring ? NULL : cq_ring;
+  }
+  if (NULL != ring->cq_ring) {
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    void * sqes = mmap(
+      NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd,
+      IORING_OFF_SQES);
+    ring->sqes = MAP_FAILED == sqes ? NULL : sqes;
+  }
+  if (NULL == ring->sqes) {
+    uring_fini(ring);
+    return false;
+  }
+
+  char * sq = ring->sq_ring;
+  char * cq = ring->cq_ring;
+  ring->sq_tail = (uint32_t *)(sq + params.sq_off.tail);
+  ring->sq_array = (uint32_t *)(sq + params.sq_off.array);
+  ring->sq_mask = *(uint32_t *)(sq + params.sq_off.ring_mask);
+  ring->cq_head = (uint32_t *)(cq + params.cq_off.head);
+  ring->cq_tail = (uint32_t *)(cq + params.cq_off.tail);
+  ring->cq_mask = *(uint32_t *)(cq + params.cq_off.ring_mask);
+  ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+  ring->sq_local_tail = *ring->sq_tail;
+  return true;
+}
+
+static void uring_prepare(async_io_uring_t * ring, async_io_slot_t * slot, size_t index)
+{
+  const rcutils_async_io_request_t * request = &slot->request;
+  const uint32_t tail = ring->sq_local_tail & ring->sq_mask;
+  struct io_uring_sqe * sqe = &ring->sqes[tail];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->user_data = index;
+  switch (request->operation) {
+    case RCUTILS_ASYNC_IO_READ:
+    case RCUTILS_ASYNC_IO_WRITE:
+      sqe->opcode = RCUTILS_ASYNC_IO_READ == request->operation ?
+        IORING_OP_READ : IORING_OP_WRITE;
+      sqe->fd = request->fd;
+      sqe->addr = (uint64_t)(uintptr_t)request->buffer;
+      sqe->len = (uint32_t)get_length(request);
+      sqe->off = request->offset;
+      break;
+    case RCUTILS_ASYNC_IO_FSYNC:
+      sqe->opcode = IORING_OP_FSYNC;
+      sqe->fd = request->fd;
+      sqe->fsync_flags =
+        (request->flags & RCUTILS_ASYNC_IO_FSYNC_DATA_ONLY) ? IORING_FSYNC_DATASYNC : 0;
+      break;
+    case RCUTILS_ASYNC_IO_STAT:
+      sqe->opcode = IORING_OP_STATX;
+      sqe->fd = AT_FDCWD;
+      sqe->addr = (uint64_t)(uintptr_t)request->path;
+      sqe->len = STATX_BASIC_STATS;
+      sqe->off = (uint64_t)(uintptr_t)&slot->statx_buffer;
+      sqe->statx_flags =
+        (request->flags & RCUTILS_ASYNC_IO_STAT_NO_FOLLOW) ? AT_SYMLINK_NOFOLLOW : 0;
+      break;
+    case RCUTILS_ASYNC_IO_OPEN:
+      sqe->opcode = IORING_OP_OPENAT;
+      sqe->fd = AT_FDCWD;
+      sqe->addr = (uint64_t)(uintptr_t)request->path;
+      sqe->len = 0666;
+      sqe->open_flags = (uint32_t)get_open_flags(request->flags);
+      break;
+    case RCUTILS_ASYNC_IO_CLOSE:
+      sqe->opcode = IORING_OP_CLOSE;
+      sqe->fd = request->fd;
+      break;
+  }
+  ring->sq_array[tail] = tail;
+  ++ring->sq_local_tail;
+  ++ring->unsubmitted;
+}
+
+// Submit the prepared entries, and wait for min_complete completions, or until the timeout
+// expires if it isn't negative.
+// Return 0 if successful, or a negative errno value, -ETIME when the timeout expired.
+static int uring_enter(async_io_uring_t * ring, uint32_t min_complete, int64_t timeout)
+{
+  __atomic_store_n(ring->sq_tail, ring->sq_local_tail, __ATOMIC_RELEASE);
+  for (;;) {
+    unsigned int flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+    struct __kernel_timespec timespec;
+    struct io_uring_getevents_arg arg;
+    void * argument = NULL;
+    size_t argument_size = 0;
+    if (min_complete > 0 && timeout >= 0) {
+      timespec.tv_sec = timeout / 1000000000;
+      timespec.tv_nsec = timeout % 1000000000;
+      memset(&arg, 0, sizeof(arg));
+      arg.ts = (uint64_t)(uintptr_t)&timespec;
+      argument = &arg;
+      argument_size = sizeof(arg);
+      flags |= IORING_ENTER_EXT_ARG;
+    }
+    long submitted = syscall(
+      __NR_io_uring_enter, ring->fd, ring->unsubmitted, min_complete, flags, argument,
+      argument_size);
+    if (submitted < 0) {
+      // EINTR is returned when interrupted by a signal before waiting enough.
+      return EINTR == errno ? 0 : -errno;
+    }
+    ring->unsubmitted -= (uint32_t)submitted;
+    // Entries are left if the kernel couldn't allocate memory for them, like with EAGAIN.
+    if (0 == ring->unsubmitted || 0 == submitted) {
+      return 0 == ring->unsubmitted ? 0 : -EAGAIN;
+    }
+  }
+}
+
+static void uring_set_stat(const struct statx * statx_buffer, rcutils_file_stat_t * stat)
+{
+  stat->type = file_type_from_mode((mode_t)statx_buffer->stx_mode);
+  stat->size = statx_buffer->stx_size;
+  stat->allocated_size = statx_buffer->stx_blocks * 512u;
+  stat->device = (uint64_t)makedev(statx_buffer->stx_dev_major, statx_buffer->stx_dev_minor);
+  stat->inode = statx_buffer->stx_ino;
+  stat->modification_time =
+    statx_buffer->stx_mtime.tv_sec * 1000000000LL + statx_buffer->stx_mtime.tv_nsec;
+}
+
+// Call the callbacks of the completed requests.
+static size_t uring_complete(rcutils_async_io_impl_t * impl)
+{
+  async_io_uring_t * ring = &impl->ring;
+  size_t completions = 0;
+  uint32_t head = *ring->cq_head;
+  uint32_t tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+  while (head != tail) {
+    const struct io_uring_cqe * cqe = &ring->cqes[head & ring->cq_mask];
+    const size_t index = (size_t)cqe->user_data;
+    async_io_slot_t * slot = &impl->slots[index];
+    slot->result = cqe->res;
+    // The entry may be reused by the kernel once the head is past it.
+    __atomic_store_n(ring->cq_head, ++head, __ATOMIC_RELEASE);
+    if (RCUTILS_ASYNC_IO_STAT == slot->request.operation && 0 == slot->result) {
+      uring_set_stat(&slot->statx_buffer, slot->request.stat);
+    }
+    complete_slot(impl, index);
+    ++completions;
+    // The callback may have submitted and completed more requests.
+    head = *ring->cq_head;
+    tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+  }
+  return completions;
+}
+
+static rcutils_ret_t uring_wait(
+  rcutils_async_io_impl_t * impl, size_t target, rcutils_time_point_value_t deadline,
+  size_t * completions)
+{
+  *completions = uring_complete(impl);
+  while (*completions < target) {
+    const int64_t remaining = get_remaining_time(deadline);
+    if (0 == remaining) {
+      break;
+    }
+    const size_t left = target - *completions;
+    int result = uring_enter(
+      &impl->ring, left < UINT32_MAX ? (uint32_t)left : UINT32_MAX, remaining);
+    *completions += uring_complete(impl);
+    if (-ETIME == result) {
+      break;
+    }
+    if (result < 0) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Failed to wait for io_uring: %d", -result);
+      return RCUTILS_RET_ERROR;
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+#endif  // RCUTILS_ASYNC_IO_HAVE_IO_URING
+
+rcutils_async_io_t
+rcutils_get_zero_initialized_async_io(void)
+{
+  static rcutils_async_io_t io = {0};
+  return io;
+}
+
+rcutils_async_io_options_t
+rcutils_get_default_async_io_options(void)
+{
+  rcutils_async_io_options_t options;
+  options.backend = RCUTILS_ASYNC_IO_BACKEND_AUTO;
+  options.queue_depth = RCUTILS_ASYNC_IO_DEFAULT_QUEUE_DEPTH;
+  options.thread_count = RCUTILS_ASYNC_IO_DEFAULT_THREAD_COUNT;
+  return options;
+}
+
+rcutils_ret_t
+rcutils_async_io_init(
+  rcutils_async_io_t * io,
+  const rcutils_async_io_options_t * options,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(io, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator is invalid", return RCUTILS_RET_INVALID_ARGUMENT);
+  if (NULL != io->impl) {
+    RCUTILS_SET_ERROR_MSG("io is already initialized");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  rcutils_async_io_options_t default_options = rcutils_get_default_async_io_options();
+  if (NULL == options) {
+    options = &default_options;
+  }
+  if (options->backend > RCUTILS_ASYNC_IO_BACKEND_THREAD_POOL) {
+    RCUTILS_SET_ERROR_MSG("backend is invalid");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (options->queue_depth > RCUTILS_ASYNC_IO_MAX_QUEUE_DEPTH) {
+    RCUTILS_SET_ERROR_MSG("queue_depth is larger than 32768");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  rcutils_async_io_impl_t * impl = allocator->zero_allocate(
+    1, sizeof(rcutils_async_io_impl_t), allocator->state);
+  if (NULL == impl) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory.");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->allocator = *allocator;
+  impl->queue_depth = 0 == options->queue_depth ?
+    RCUTILS_ASYNC_IO_DEFAULT_QUEUE_DEPTH : options->queue_depth;
+  impl->slots = allocator->allocate(
+    impl->queue_depth * sizeof(async_io_slot_t), allocator->state);
+  if (NULL == impl->slots) {
+    allocator->deallocate(impl, allocator->state);
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory.");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl->free_slots = empty_list;
+  for (size_t i = 0; i < impl->queue_depth; ++i) {
+    list_push(impl->slots, &impl->free_slots, i);
+  }
+
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+#ifdef RCUTILS_ASYNC_IO_HAVE_IO_URING
+  if (RCUTILS_ASYNC_IO_BACKEND_THREAD_POOL != options->backend &&
+    uring_init(&impl->ring, impl->queue_depth, *allocator))
+  {
+    impl->backend = RCUTILS_ASYNC_IO_BACKEND_IO_URING;
+  }
+#endif
+  if (RCUTILS_ASYNC_IO_BACKEND_IO_URING != impl->backend) {
+    if (RCUTILS_ASYNC_IO_BACKEND_IO_URING == options->backend) {
+      RCUTILS_SET_ERROR_MSG("io_uring isn't available");
+      ret = RCUTILS_RET_ERROR;
+    } else {
+      impl->backend = RCUTILS_ASYNC_IO_BACKEND_THREAD_POOL;
+      ret = thread_pool_init(
+        impl, 0 == options->thread_count ?
+        RCUTILS_ASYNC_IO_DEFAULT_THREAD_COUNT : options->thread_count);
+    }
+  }
+  if (RCUTILS_RET_OK != ret) {
+    allocator->deallocate(impl->slots, allocator->state);
+    allocator->deallocate(impl, allocator->state);
+    return ret;
+  }
+
+  io->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_async_io_fini(rcutils_async_io_t * io)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(io, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_async_io_impl_t * impl = io->impl;
+  if (NULL == impl) {
+    return RCUTILS_RET_OK;
+  }
+
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  while (impl->in_flight > 0 && RCUTILS_RET_OK == ret) {
+    ret = rcutils_async_io_wait(io, SIZE_MAX, -1, NULL);
+  }
+  if (RCUTILS_ASYNC_IO_BACKEND_THREAD_POOL == impl->backend) {
+    thread_pool_fini(impl);
+  }
+#ifdef RCUTILS_ASYNC_IO_HAVE_IO_URING
+  if (RCUTILS_ASYNC_IO_BACKEND_IO_URING == impl->backend) {
+    uring_fini(&impl->ring);
+  }
+#endif
+  impl->allocator.deallocate(impl->slots, impl->allocator.state);
+  impl->allocator.deallocate(impl, impl->allocator.state);
+  io->impl = NULL;
+  return ret;
+}
+
+rcutils_async_io_backend_t
+rcutils_async_io_get_backend(const rcutils_async_io_t * io)
+{
+  if (NULL == io || NULL == io->impl) {
+    return RCUTILS_ASYNC_IO_BACKEND_AUTO;
+  }
+  return io->impl->backend;
+}
+
+static bool is_request_valid(const rcutils_async_io_request_t * request)
+{
+  switch (request->operation) {
+    case RCUTILS_ASYNC_IO_READ:
+    case RCUTILS_ASYNC_IO_WRITE:
+      return NULL != request->buffer || 0 == request->length;
+    case RCUTILS_ASYNC_IO_FSYNC:
+    case RCUTILS_ASYNC_IO_CLOSE:
+      return true;
+    case RCUTILS_ASYNC_IO_STAT:
+      return NULL != request->path && NULL != request->stat;
+    case RCUTILS_ASYNC_IO_OPEN:
+      return NULL != request->path;
+    default:
+      return false;
+  }
+}
+
+rcutils_ret_t
+rcutils_async_io_submit(
+  rcutils_async_io_t * io,
+  const rcutils_async_io_request_t * requests,
+  size_t count)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(io, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    io->impl, "io is not initialized", return RCUTILS_RET_INVALID_ARGUMENT);
+  if (count > 0) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(requests, RCUTILS_RET_INVALID_ARGUMENT);
+  }
+  rcutils_async_io_impl_t * impl = io->impl;
+
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  for (size_t i = 0; i < count && RCUTILS_RET_OK == ret; ++i) {
+    if (!is_request_valid(&requests[i])) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("request %zu is invalid", i);
+      ret = RCUTILS_RET_INVALID_ARGUMENT;
+      break;
+    }
+    if (NO_SLOT == impl->free_slots.first) {
+      // Waiting submits the requests prepared so far.
+      ret = rcutils_async_io_wait(io, 1, -1, NULL);
+      if (RCUTILS_RET_OK != ret) {
+        break;
+      }
+    }
+    size_t index = list_pop(impl->slots, &impl->free_slots);
+    impl->slots[index].request = requests[i];
+    ++impl->in_flight;
+#ifdef RCUTILS_ASYNC_IO_HAVE_IO_URING
+    if (RCUTILS_ASYNC_IO_BACKEND_IO_URING == impl->backend) {
+      uring_prepare(&impl->ring, &impl->slots[index], index);
+      continue;
+    }
+#endif
+    thread_pool_submit(impl, index);
+  }
+
+#ifdef RCUTILS_ASYNC_IO_HAVE_IO_URING
+  if (RCUTILS_ASYNC_IO_BACKEND_IO_URING == impl->backend && impl->ring.unsubmitted > 0) {
+    int result = uring_enter(&impl->ring, 0, -1);
+    if (result < 0 && RCUTILS_RET_OK == ret) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Failed to submit to io_uring: %d", -result);
+      ret = RCUTILS_RET_ERROR;
+    }
+  }
+#endif
+  return ret;
+}
+
+rcutils_ret_t
+rcutils_async_io_wait(
+  rcutils_async_io_t * io,
+  size_t min_completions,
+  int64_t timeout,
+  size_t * completions)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(io, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    io->impl, "io is not initialized", return RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_async_io_impl_t * impl = io->impl;
+
+  const size_t target = min_completions < impl->in_flight ? min_completions : impl->in_flight;
+  rcutils_time_point_value_t deadline = -1;
+  if (timeout >= 0 && target > 0) {
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&deadline)) {
+      return RCUTILS_RET_ERROR;
+    }
+    deadline += timeout;
+  } else if (timeout >= 0) {
+    deadline = 0;
+  }
+
+  size_t completed = 0;
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+#ifdef RCUTILS_ASYNC_IO_HAVE_IO_URING
+  if (RCUTILS_ASYNC_IO_BACKEND_IO_URING == impl->backend) {
+    ret = uring_wait(impl, target, deadline, &completed);
+  } else {
+    completed = thread_pool_wait(impl, target, deadline);
+  }
+#else
+  completed = thread_pool_wait(impl, target, deadline);
+#endif
+  if (NULL != completions) {
+    *completions = completed;
+  }
+  return ret;
+}
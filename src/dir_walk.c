@@ -0,0 +1,683 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#else
+// When building with MSVC 19.28.29333.0 on Windows 10 (as of 2020-11-11),
+// there appears to be a problem with winbase.h (which is included by
+// Windows.h).  In particular, warnings of the form:
+//
+// warning C5105: macro expansion producing 'defined' has undefined behavior
+//
+// See https://developercommunity.visualstudio.com/content/problem/695656/wdk-and-sdk-are-not-compatible-with-experimentalpr.html
+// for more information.  For now disable that warning when including windows.h
+#pragma warning(push)
+#pragma warning(disable : 5105)
+#include <windows.h>
+#pragma warning(pop)
+#endif  // _WIN32
+
+#include "rcutils/dir_walk.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/hash.h"
+#include "rcutils/snprintf.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rcutils/types/hash_map.h"
+
+#include "./filesystem_helpers.h"
+#include "./thread_helpers.h"
+
+#ifdef _WIN32
+# define RCUTILS_PATH_DELIMITER '\\'
+#else
+# define RCUTILS_PATH_DELIMITER '/'
+#endif  // _WIN32
+
+// The number of threads walking by default is the number of processors, up to this.
+#define RCUTILS_DIR_WALK_MAX_DEFAULT_THREADS 16
+
+// A directory left to walk.
+typedef struct dir_walk_job_s
+{
+  // The depth of the entries of the directory.
+  size_t depth;
+  size_t path_length;
+  // The path of the directory relative to the walked one, which is empty for it.
+  char path[];
+} dir_walk_job_t;
+
+// The directories left to walk by a thread, which it takes from the end, and other threads
+// steal from the beginning.
+typedef struct dir_walk_deque_s
+{
+  rcutils_mutex_t mutex;
+  dir_walk_job_t ** jobs;
+  size_t begin;
+  size_t end;
+  size_t capacity;
+  // The number of jobs, to check if there are any without locking the mutex.
+  atomic_uint_least64_t size;
+} dir_walk_deque_t;
+
+typedef struct dir_walk_worker_s
+{
+  struct dir_walk_s * walk;
+  size_t index;
+  dir_walk_deque_t deque;
+  rcutils_thread_t thread;
+  bool thread_started;
+#ifdef _WIN32
+  // The buffer of the pattern given to FindFirstFile().
+  char * search_path;
+  size_t search_path_capacity;
+#endif
+} dir_walk_worker_t;
+
+typedef struct dir_walk_s
+{
+  const char * top_path;
+  rcutils_dir_walk_options_t options;
+  rcutils_dir_walk_callback_t callback;
+  void * user_data;
+  rcutils_allocator_t allocator;
+#ifndef _WIN32
+  int top_fd;
+#endif
+  dir_walk_worker_t * workers;
+  size_t worker_count;
+  // The number of directories queued or being walked.
+  atomic_uint_least64_t pending;
+  // The number of threads waiting for directories to walk.
+  atomic_uint_least64_t waiting;
+  // Whether the walk is over, because it completed, the callback stopped it, or it failed.
+  atomic_bool stopped;
+  // Protects the members below, and is used by waiting threads.
+  rcutils_mutex_t mutex;
+  rcutils_cond_t cond;
+  // The first failure, and its error message.
+  rcutils_ret_t ret;
+  char error_message[RCUTILS_ERROR_MESSAGE_MAX_LENGTH];
+  // The identifiers of the directories walked, when following symbolic links.
+  rcutils_hash_map_t visited;
+} dir_walk_t;
+
+struct rcutils_dir_walk_entry_impl_s
+{
+  dir_walk_t * walk;
+#ifdef _WIN32
+  const WIN32_FIND_DATA * data;
+#else
+  int dir_fd;
+  bool has_stat;
+  struct stat stat;
+#endif
+};
+
+typedef struct dir_walk_visited_key_s
+{
+  uint64_t device;
+  uint64_t inode;
+} dir_walk_visited_key_t;
+
+static size_t dir_walk_visited_hash(const void * key)
+{
+  return (size_t)rcutils_hash64(key, sizeof(dir_walk_visited_key_t), 0);
+}
+
+static int dir_walk_visited_cmp(const void * key1, const void * key2)
+{
+  return memcmp(key1, key2, sizeof(dir_walk_visited_key_t));
+}
+
+static void dir_walk_stop(dir_walk_t * walk)
+{
+  rcutils_atomic_store(&walk->stopped, true);
+  mutex_lock(&walk->mutex);
+  cond_broadcast(&walk->cond);
+  mutex_unlock(&walk->mutex);
+}
+
+// Stop the walk because of a failure, which is reported if it is the first one.
+static void dir_walk_fail(dir_walk_t * walk, rcutils_ret_t ret, const char * format, ...)
+{
+  mutex_lock(&walk->mutex);
+  if (RCUTILS_RET_OK == walk->ret) {
+    walk->ret = ret;
+    va_list args;
+    va_start(args, format);
+    int written =
+      rcutils_vsnprintf(walk->error_message, sizeof(walk->error_message), format, args);
+    (void)written;
+    va_end(args);
+  }
+  mutex_unlock(&walk->mutex);
+  dir_walk_stop(walk);
+}
+
+static bool deque_push(
+  dir_walk_deque_t * deque, dir_walk_job_t * job, rcutils_allocator_t allocator)
+{
+  mutex_lock(&deque->mutex);
+  if (deque->end == deque->capacity) {
+    if (deque->begin >= deque->capacity / 2 && deque->begin > 0) {
+      memmove(
+        deque->jobs, deque->jobs + deque->begin,
+        (deque->end - deque->begin) * sizeof(dir_walk_job_t *));
+      deque->end -= deque->begin;
+      deque->begin = 0;
+    } else {
+      size_t capacity = deque->capacity > 0 ? deque->capacity * 2 : 64;
+      dir_walk_job_t ** jobs = allocator.reallocate(
+        deque->jobs, capacity * sizeof(dir_walk_job_t *), allocator.state);
+      if (NULL == jobs) {
+        mutex_unlock(&deque->mutex);
+        return false;
+      }
+      deque->jobs = jobs;
+      deque->capacity = capacity;
+    }
+  }
+  deque->jobs[deque->end++] = job;
+  rcutils_atomic_store(&deque->size, deque->end - deque->begin);
+  mutex_unlock(&deque->mutex);
+  return true;
+}
+
+// Take the last job, or the first one when stealing it from another thread.
+static dir_walk_job_t * deque_pop(dir_walk_deque_t * deque, bool first)
+{
+  if (0 == rcutils_atomic_load_uint64_t(&deque->size)) {
+    return NULL;
+  }
+  dir_walk_job_t * job = NULL;
+  mutex_lock(&deque->mutex);
+  if (deque->end > deque->begin) {
+    job = first ? deque->jobs[deque->begin++] : deque->jobs[--deque->end];
+    if (deque->begin == deque->end) {
+      deque->begin = 0;
+      deque->end = 0;
+    }
+    rcutils_atomic_store(&deque->size, deque->end - deque->begin);
+  }
+  mutex_unlock(&deque->mutex);
+  return job;
+}
+
+// Queue a subdirectory of a directory to walk.
+static bool dir_walk_push(
+  dir_walk_worker_t * worker, const dir_walk_job_t * parent, const char * name)
+{
+  dir_walk_t * walk = worker->walk;
+  rcutils_allocator_t allocator = walk->allocator;
+  size_t name_length = strlen(name);
+  size_t path_length = parent->path_length + (parent->path_length > 0 ? 1 : 0) + name_length;
+  dir_walk_job_t * job =
+    allocator.allocate(sizeof(dir_walk_job_t) + path_length + 1, allocator.state);
+  if (NULL == job) {
+    dir_walk_fail(walk, RCUTILS_RET_BAD_ALLOC, "Failed to allocate memory.");
+    return false;
+  }
+  job->depth = parent->depth + 1;
+  job->path_length = path_length;
+  char * path = job->path;
+  if (parent->path_length > 0) {
+    memcpy(path, parent->path, parent->path_length);
+    path += parent->path_length;
+    *path++ = RCUTILS_PATH_DELIMITER;
+  }
+  memcpy(path, name, name_length + 1);
+
+  rcutils_atomic_fetch_add_uint64_t(&walk->pending, 1);
+  if (!deque_push(&worker->deque, job, allocator)) {
+    allocator.deallocate(job, allocator.state);
+    rcutils_atomic_fetch_add_uint64_t(&walk->pending, UINT64_MAX);
+    dir_walk_fail(walk, RCUTILS_RET_BAD_ALLOC, "Failed to allocate memory.");
+    return false;
+  }
+  // A thread checks the deques after it counts itself as waiting, so either it finds this job,
+  // or it is counted here, and woken.
+  if (rcutils_atomic_load_uint64_t(&walk->waiting) > 0) {
+    mutex_lock(&walk->mutex);
+    cond_signal(&walk->cond);
+    mutex_unlock(&walk->mutex);
+  }
+  return true;
+}
+
+// Return whether a directory was already walked, and mark it as walked otherwise.
+static bool dir_walk_was_visited(dir_walk_t * walk, uint64_t device, uint64_t inode)
+{
+  dir_walk_visited_key_t key;
+  memset(&key, 0, sizeof(key));
+  key.device = device;
+  key.inode = inode;
+  const uint8_t value = 1;
+  bool visited = false;
+  mutex_lock(&walk->mutex);
+  if (rcutils_hash_map_key_exists(&walk->visited, &key)) {
+    visited = true;
+  } else if (RCUTILS_RET_OK != rcutils_hash_map_set(&walk->visited, &key, &value)) {
+    mutex_unlock(&walk->mutex);
+    dir_walk_fail(walk, RCUTILS_RET_BAD_ALLOC, "Failed to allocate memory.");
+    return true;
+  }
+  mutex_unlock(&walk->mutex);
+  return visited;
+}
+
+// Return whether a subdirectory should be walked after its entry was given to the callback.
+static bool dir_walk_should_descend(
+  dir_walk_t * walk, const rcutils_dir_walk_entry_t * entry, rcutils_dir_walk_action_t action)
+{
+  if (RCUTILS_DIR_WALK_STOP == action) {
+    dir_walk_stop(walk);
+    return false;
+  }
+  return RCUTILS_FILE_TYPE_DIRECTORY == entry->type && RCUTILS_DIR_WALK_CONTINUE == action &&
+         (0 == walk->options.max_depth || entry->depth < walk->options.max_depth);
+}
+
+#ifndef _WIN32
+static bool dir_walk_entry_query(const rcutils_dir_walk_entry_t * entry)
+{
+  struct rcutils_dir_walk_entry_impl_s * impl = entry->impl;
+  if (!impl->has_stat) {
+    int flags =
+      RCUTILS_DIR_WALK_SYMLINKS_FOLLOW == impl->walk->options.symlinks ? 0 : AT_SYMLINK_NOFOLLOW;
+    impl->has_stat = 0 == fstatat(impl->dir_fd, entry->name, &impl->stat, flags);
+  }
+  return impl->has_stat;
+}
+
+static void dir_walk_directory(dir_walk_worker_t * worker, const dir_walk_job_t * job)
+{
+  dir_walk_t * walk = worker->walk;
+  const char * separator = job->path_length > 0 ? "/" : "";
+  int dir_fd = openat(
+    walk->top_fd, job->path_length > 0 ? job->path : ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  DIR * dir = dir_fd >= 0 ? fdopendir(dir_fd) : NULL;
+  if (NULL == dir) {
+    int error = errno;
+    if (dir_fd >= 0) {
+      close(dir_fd);
+    }
+    dir_walk_fail(
+      walk, RCUTILS_RET_ERROR, "Can't open directory %s%s%s. Error code: %d",
+      walk->top_path, separator, job->path, error);
+    return;
+  }
+
+  if (RCUTILS_DIR_WALK_SYMLINKS_FOLLOW == walk->options.symlinks) {
+    struct stat dir_stat;
+    if (fstat(dir_fd, &dir_stat) != 0 ||
+      dir_walk_was_visited(walk, (uint64_t)dir_stat.st_dev, (uint64_t)dir_stat.st_ino))
+    {
+      closedir(dir);
+      return;
+    }
+  }
+
+  struct rcutils_dir_walk_entry_impl_s impl;
+  impl.walk = walk;
+  impl.dir_fd = dir_fd;
+  rcutils_dir_walk_entry_t entry;
+  entry.directory = job->path;
+  entry.depth = job->depth;
+  entry.impl = &impl;
+  const bool follow = RCUTILS_DIR_WALK_SYMLINKS_FOLLOW == walk->options.symlinks;
+
+  while (!rcutils_atomic_load_bool(&walk->stopped)) {
+    errno = 0;
+    struct dirent * dirent = readdir(dir);
+    if (NULL == dirent) {
+      if (0 != errno) {
+        dir_walk_fail(
+          walk, RCUTILS_RET_ERROR, "Can't iterate directory %s%s%s. Error code: %d",
+          walk->top_path, separator, job->path, errno);
+      }
+      break;
+    }
+    const char * name = dirent->d_name;
+    if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+      continue;
+    }
+    entry.name = name;
+    entry.type = file_type_from_dirent(RCUTILS_DIRENT_TYPE(dirent));
+    impl.has_stat = false;
+    if (RCUTILS_FILE_TYPE_UNKNOWN == entry.type ||
+      (follow && RCUTILS_FILE_TYPE_SYMLINK == entry.type))
+    {
+      if (dir_walk_entry_query(&entry)) {
+        entry.type = file_type_from_mode(impl.stat.st_mode);
+      } else if (RCUTILS_FILE_TYPE_UNKNOWN == entry.type) {
+        // The entry was removed since it was read.
+        continue;
+      }
+    }
+
+    rcutils_dir_walk_action_t action = walk->callback(&entry, walk->user_data);
+    if (dir_walk_should_descend(walk, &entry, action) && !dir_walk_push(worker, job, name)) {
+      break;
+    }
+  }
+  closedir(dir);
+}
+#else
+static void dir_walk_directory(dir_walk_worker_t * worker, const dir_walk_job_t * job)
+{
+  dir_walk_t * walk = worker->walk;
+  rcutils_allocator_t allocator = walk->allocator;
+  size_t top_length = strlen(walk->top_path);
+  size_t length = top_length + 1 + job->path_length + 3;
+  if (length > worker->search_path_capacity) {
+    char * search_path = allocator.reallocate(worker->search_path, length, allocator.state);
+    if (NULL == search_path) {
+      dir_walk_fail(walk, RCUTILS_RET_BAD_ALLOC, "Failed to allocate memory.");
+      return;
+    }
+    worker->search_path = search_path;
+    worker->search_path_capacity = length;
+  }
+  char * search_path = worker->search_path;
+  memcpy(search_path, walk->top_path, top_length);
+  if (job->path_length > 0) {
+    search_path[top_length] = '\\';
+    memcpy(search_path + top_length + 1, job->path, job->path_length);
+    memcpy(search_path + top_length + 1 + job->path_length, "\\*", 3);
+  } else {
+    memcpy(search_path + top_length, "\\*", 3);
+  }
+
+  WIN32_FIND_DATA data;
+  HANDLE handle = FindFirstFile(search_path, &data);
+  if (INVALID_HANDLE_VALUE == handle) {
+    DWORD error = GetLastError();
+    if (ERROR_FILE_NOT_FOUND != error) {
+      search_path[strlen(search_path) - 2] = '\0';
+      dir_walk_fail(
+        walk, RCUTILS_RET_ERROR, "Can't open directory %s. Error code: %d", search_path, error);
+    }
+    return;
+  }
+
+  struct rcutils_dir_walk_entry_impl_s impl;
+  impl.walk = walk;
+  impl.data = &data;
+  rcutils_dir_walk_entry_t entry;
+  entry.directory = job->path;
+  entry.depth = job->depth;
+  entry.impl = &impl;
+  const bool follow = RCUTILS_DIR_WALK_SYMLINKS_FOLLOW == walk->options.symlinks;
+
+  do {
+    const char * name = data.cFileName;
+    if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+      continue;
+    }
+    entry.name = name;
+    entry.type = file_type_from_attributes(data.dwFileAttributes, follow);
+    rcutils_dir_walk_action_t action = walk->callback(&entry, walk->user_data);
+    if (dir_walk_should_descend(walk, &entry, action) && !dir_walk_push(worker, job, name)) {
+      break;
+    }
+  } while (!rcutils_atomic_load_bool(&walk->stopped) && FindNextFile(handle, &data));
+  FindClose(handle);
+}
+#endif  // _WIN32
+
+// Wait until there is a directory to walk, and return false if the walk is over instead.
+static bool dir_walk_wait(dir_walk_t * walk)
+{
+  bool has_job = false;
+  mutex_lock(&walk->mutex);
+  rcutils_atomic_fetch_add_uint64_t(&walk->waiting, 1);
+  while (!rcutils_atomic_load_bool(&walk->stopped)) {
+    for (size_t i = 0; i < walk->worker_count && !has_job; ++i) {
+      has_job = rcutils_atomic_load_uint64_t(&walk->workers[i].deque.size) > 0;
+    }
+    if (has_job) {
+      break;
+    }
+    cond_wait(&walk->cond, &walk->mutex);
+  }
+  rcutils_atomic_fetch_add_uint64_t(&walk->waiting, UINT64_MAX);
+  mutex_unlock(&walk->mutex);
+  return has_job;
+}
+
+static void dir_walk_run(dir_walk_worker_t * worker)
+{
+  dir_walk_t * walk = worker->walk;
+  while (!rcutils_atomic_load_bool(&walk->stopped)) {
+    dir_walk_job_t * job = deque_pop(&worker->deque, false);
+    // Steal the oldest job of another thread, which is the closest to the top of the tree.
+    for (size_t i = 1; NULL == job && i < walk->worker_count; ++i) {
+      job = deque_pop(&walk->workers[(worker->index + i) % walk->worker_count].deque, true);
+    }
+    if (NULL == job) {
+      if (!dir_walk_wait(walk)) {
+        break;
+      }
+      continue;
+    }
+
+    dir_walk_directory(worker, job);
+    walk->allocator.deallocate(job, walk->allocator.state);
+    if (1 == rcutils_atomic_fetch_add_uint64_t(&walk->pending, UINT64_MAX)) {
+      dir_walk_stop(walk);
+    }
+  }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI dir_walk_thread_main(LPVOID worker)
+{
+  dir_walk_run((dir_walk_worker_t *)worker);
+  return 0;
+}
+#else
+static void * dir_walk_thread_main(void * worker)
+{
+  dir_walk_run((dir_walk_worker_t *)worker);
+  return NULL;
+}
+#endif
+
+static size_t get_default_thread_count(void)
+{
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  long count = (long)info.dwNumberOfProcessors;
+#else
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+  if (count < 1) {
+    return 1;
+  }
+  return count < RCUTILS_DIR_WALK_MAX_DEFAULT_THREADS ?
+         (size_t)count : RCUTILS_DIR_WALK_MAX_DEFAULT_THREADS;
+}
+
+rcutils_dir_walk_options_t
+rcutils_get_default_dir_walk_options(void)
+{
+  rcutils_dir_walk_options_t options;
+  options.thread_count = 0;
+  options.max_depth = 0;
+  options.symlinks = RCUTILS_DIR_WALK_SYMLINKS_NO_FOLLOW;
+  return options;
+}
+
+rcutils_ret_t
+rcutils_dir_walk(
+  const char * directory_path,
+  const rcutils_dir_walk_options_t * options,
+  rcutils_dir_walk_callback_t callback,
+  void * user_data,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(directory_path, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(callback, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "allocator is invalid", return RCUTILS_RET_INVALID_ARGUMENT);
+
+  dir_walk_t walk;
+  memset(&walk, 0, sizeof(walk));
+  walk.top_path = directory_path;
+  walk.options = NULL != options ? *options : rcutils_get_default_dir_walk_options();
+  walk.callback = callback;
+  walk.user_data = user_data;
+  walk.allocator = allocator;
+  walk.visited = rcutils_get_zero_initialized_hash_map();
+  walk.worker_count =
+    walk.options.thread_count > 0 ? walk.options.thread_count : get_default_thread_count();
+  rcutils_atomic_store(&walk.pending, 1);
+  rcutils_atomic_store(&walk.waiting, 0);
+  rcutils_atomic_store(&walk.stopped, false);
+
+#ifndef _WIN32
+  walk.top_fd = open(directory_path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (walk.top_fd < 0) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Can't open directory %s. Error code: %d", directory_path, errno);
+    return RCUTILS_RET_ERROR;
+  }
+  if (RCUTILS_DIR_WALK_SYMLINKS_FOLLOW == walk.options.symlinks &&
+    RCUTILS_RET_OK != rcutils_hash_map_init(
+      &walk.visited, 64, sizeof(dir_walk_visited_key_t), sizeof(uint8_t),
+      dir_walk_visited_hash, dir_walk_visited_cmp, &allocator))
+  {
+    close(walk.top_fd);
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+#endif
+
+  dir_walk_job_t * job = allocator.allocate(sizeof(dir_walk_job_t) + 1, allocator.state);
+  walk.workers = allocator.zero_allocate(
+    walk.worker_count, sizeof(dir_walk_worker_t), allocator.state);
+  if (NULL == job || NULL == walk.workers) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory.");
+    allocator.deallocate(job, allocator.state);
+    allocator.deallocate(walk.workers, allocator.state);
+#ifndef _WIN32
+    close(walk.top_fd);
+    if (RCUTILS_DIR_WALK_SYMLINKS_FOLLOW == walk.options.symlinks) {
+      rcutils_ret_t fini_ret = rcutils_hash_map_fini(&walk.visited);
+      (void)fini_ret;
+    }
+#endif
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  job->depth = 1;
+  job->path_length = 0;
+  job->path[0] = '\0';
+
+  mutex_init(&walk.mutex);
+  cond_init(&walk.cond);
+  for (size_t i = 0; i < walk.worker_count; ++i) {
+    walk.workers[i].walk = &walk;
+    walk.workers[i].index = i;
+    mutex_init(&walk.workers[i].deque.mutex);
+    rcutils_atomic_store(&walk.workers[i].deque.size, 0);
+  }
+
+  if (!deque_push(&walk.workers[0].deque, job, allocator)) {
+    allocator.deallocate(job, allocator.state);
+    dir_walk_fail(&walk, RCUTILS_RET_BAD_ALLOC, "Failed to allocate memory.");
+  } else {
+    // The calling thread walks too, along with the ones which can be started.
+    for (size_t i = 1; i < walk.worker_count; ++i) {
+      dir_walk_worker_t * worker = &walk.workers[i];
+#ifdef _WIN32
+      worker->thread = CreateThread(NULL, 0, dir_walk_thread_main, worker, 0, NULL);
+      worker->thread_started = NULL != worker->thread;
+#else
+      worker->thread_started =
+        0 == pthread_create(&worker->thread, NULL, dir_walk_thread_main, worker);
+#endif
+    }
+    dir_walk_run(&walk.workers[0]);
+  }
+
+  for (size_t i = 0; i < walk.worker_count; ++i) {
+    dir_walk_worker_t * worker = &walk.workers[i];
+    if (worker->thread_started) {
+#ifdef _WIN32
+      WaitForSingleObject(worker->thread, INFINITE);
+      CloseHandle(worker->thread);
+#else
+      pthread_join(worker->thread, NULL);
+#endif
+    }
+  }
+
+  // The jobs left when the walk is stopped early.
+  for (size_t i = 0; i < walk.worker_count; ++i) {
+    dir_walk_deque_t * deque = &walk.workers[i].deque;
+    for (size_t j = deque->begin; j < deque->end; ++j) {
+      allocator.deallocate(deque->jobs[j], allocator.state);
+    }
+    allocator.deallocate(deque->jobs, allocator.state);
+    mutex_fini(&deque->mutex);
+#ifdef _WIN32
+    allocator.deallocate(walk.workers[i].search_path, allocator.state);
+#endif
+  }
+  allocator.deallocate(walk.workers, allocator.state);
+  cond_fini(&walk.cond);
+  mutex_fini(&walk.mutex);
+#ifndef _WIN32
+  close(walk.top_fd);
+  if (RCUTILS_DIR_WALK_SYMLINKS_FOLLOW == walk.options.symlinks) {
+    rcutils_ret_t fini_ret = rcutils_hash_map_fini(&walk.visited);
+    (void)fini_ret;
+  }
+#endif
+
+  if (RCUTILS_RET_OK != walk.ret) {
+    RCUTILS_SET_ERROR_MSG(walk.error_message);
+  }
+  return walk.ret;
+}
+
+rcutils_ret_t
+rcutils_dir_walk_entry_stat(const rcutils_dir_walk_entry_t * entry, rcutils_file_stat_t * stat)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(entry, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(entry->impl, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(stat, RCUTILS_RET_INVALID_ARGUMENT);
+
+#ifdef _WIN32
+  file_stat_from_find_data(entry->impl->data, entry->type, stat);
+#else
+  if (!dir_walk_entry_query(entry)) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Can't query %s. Error code: %d", entry->name, errno);
+    return RCUTILS_RET_ERROR;
+  }
+  file_stat_from_stat(&entry->impl->stat, stat);
+#endif
+  return RCUTILS_RET_OK;
+}
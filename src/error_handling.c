@@ -27,6 +27,23 @@ extern "C"
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef _WIN32
+#include <pthread.h>
+#else
+// When building with MSVC 19.28.29333.0 on Windows 10 (as of 2020-11-11),
+// there appears to be a problem with winbase.h (which is included by
+// Windows.h).  In particular, warnings of the form:
+//
+// warning C5105: macro expansion producing 'defined' has undefined behavior
+//
+// See https://developercommunity.visualstudio.com/content/problem/695656/wdk-and-sdk-are-not-compatible-with-experimentalpr.html
+// for more information.  For now disable that warning when including windows.h
+#pragma warning(push)
+#pragma warning(disable : 5105)
+#include <windows.h>
+#pragma warning(pop)
+#endif
+
 #include <rcutils/allocator.h>
 #include <rcutils/macros.h>
 #include <rcutils/strdup.h>
@@ -34,17 +51,184 @@ extern "C"
 // RCUTILS_REPORT_ERROR_HANDLING_ERRORS and RCUTILS_WARN_ON_TRUNCATION are set in the header below
 #include "./error_handling_helpers.h"
 
+// The error state, the formatted error string and the error chain of a thread.
+// It is allocated on the first error which needs it, or by
+// rcutils_initialize_error_handling_thread_local_storage(), and deallocated when the thread exits,
+// so that threads which never set an error only pay for the few thread-local variables below.
+typedef struct rcutils_error_storage_s
+{
+  rcutils_error_state_t error_state;
+  rcutils_error_string_t error_string;
+  bool error_string_is_formatted;
+  // The first frame is always the root cause, the following ones are a ring of the most recent
+  // frames, see __error_frame_slot().
+  rcutils_error_frame_t frames[RCUTILS_ERROR_CHAIN_MAX_FRAMES];
+  size_t frames_pushed;
+  // The allocator with which this storage was allocated.
+  rcutils_allocator_t allocator;
+} rcutils_error_storage_t;
+
 // g_ is to global variable, as gtls_ is to global thread-local storage variable
-RCUTILS_THREAD_LOCAL bool gtls_rcutils_thread_local_initialized = false;
-RCUTILS_THREAD_LOCAL rcutils_error_state_t gtls_rcutils_error_state;
-RCUTILS_THREAD_LOCAL bool gtls_rcutils_error_string_is_formatted = false;
-RCUTILS_THREAD_LOCAL rcutils_error_string_t gtls_rcutils_error_string;
+RCUTILS_THREAD_LOCAL rcutils_error_storage_t * gtls_rcutils_error_storage = NULL;
 RCUTILS_THREAD_LOCAL bool gtls_rcutils_error_is_set = false;
+// When true, the message and file of the error state were set by reference with
+// rcutils_set_error_state_static() and are not copied into the error storage yet,
+// which may not even be allocated.
+RCUTILS_THREAD_LOCAL bool gtls_rcutils_error_state_is_reference = false;
+RCUTILS_THREAD_LOCAL const char * gtls_rcutils_error_message_reference = NULL;
+RCUTILS_THREAD_LOCAL const char * gtls_rcutils_error_file_reference = NULL;
+RCUTILS_THREAD_LOCAL size_t gtls_rcutils_error_line_number_reference = 0;
+
+// Returned by rcutils_get_error_state() when no error storage is allocated.
+static const rcutils_error_state_t g_rcutils_empty_error_state = {"", "", 0};
+static const rcutils_error_state_t g_rcutils_unavailable_error_state = {
+  "failed to allocate the thread-local error storage, the error state is unavailable",
+  __FILE__,
+  __LINE__
+};
+
+// The storage is deallocated at thread exit through a thread-specific key with a destructor,
+// which RCUTILS_THREAD_LOCAL variables do not provide.
+// The error state is reset along with it, as the destructors of other keys may still use
+// the error handling of the exiting thread.
+static
+void
+__deallocate_error_storage(rcutils_error_storage_t * storage)
+{
+  if (gtls_rcutils_error_storage == storage) {
+    gtls_rcutils_error_storage = NULL;
+    gtls_rcutils_error_is_set = false;
+    gtls_rcutils_error_state_is_reference = false;
+    gtls_rcutils_error_message_reference = NULL;
+    gtls_rcutils_error_file_reference = NULL;
+    gtls_rcutils_error_line_number_reference = 0;
+  }
+  rcutils_allocator_t allocator = storage->allocator;
+  allocator.deallocate(storage, allocator.state);
+}
+
+#ifndef _WIN32
+static pthread_once_t g_rcutils_error_storage_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_rcutils_error_storage_key;
+static bool g_rcutils_error_storage_key_is_valid = false;
+
+static
+void
+__error_storage_key_destructor(void * storage)
+{
+  __deallocate_error_storage((rcutils_error_storage_t *)storage);
+}
+
+static
+void
+__create_error_storage_key(void)
+{
+  g_rcutils_error_storage_key_is_valid =
+    0 == pthread_key_create(&g_rcutils_error_storage_key, __error_storage_key_destructor);
+}
+
+static
+bool
+__register_error_storage(rcutils_error_storage_t * storage)
+{
+  if (
+    0 != pthread_once(&g_rcutils_error_storage_key_once, __create_error_storage_key) ||
+    !g_rcutils_error_storage_key_is_valid)
+  {
+    return false;
+  }
+  return 0 == pthread_setspecific(g_rcutils_error_storage_key, storage);
+}
+#else
+static INIT_ONCE g_rcutils_error_storage_key_once = INIT_ONCE_STATIC_INIT;
+static DWORD g_rcutils_error_storage_key = FLS_OUT_OF_INDEXES;
+
+static
+void
+WINAPI
+__error_storage_key_destructor(void * storage)
+{
+  if (NULL != storage) {
+    __deallocate_error_storage((rcutils_error_storage_t *)storage);
+  }
+}
+
+static
+BOOL
+CALLBACK
+__create_error_storage_key(PINIT_ONCE init_once, void * parameter, void ** context)
+{
+  (void)init_once;
+  (void)parameter;
+  (void)context;
+  g_rcutils_error_storage_key = FlsAlloc(__error_storage_key_destructor);
+  return TRUE;
+}
+
+static
+bool
+__register_error_storage(rcutils_error_storage_t * storage)
+{
+  if (
+    !InitOnceExecuteOnce(
+      &g_rcutils_error_storage_key_once, __create_error_storage_key, NULL, NULL) ||
+    FLS_OUT_OF_INDEXES == g_rcutils_error_storage_key)
+  {
+    return false;
+  }
+  return FlsSetValue(g_rcutils_error_storage_key, storage);
+}
+#endif
+
+// Allocate the error storage of the calling thread with the given allocator.
+static
+rcutils_error_storage_t *
+__allocate_error_storage(rcutils_allocator_t allocator)
+{
+  assert(NULL == gtls_rcutils_error_storage);
+  rcutils_error_storage_t * storage = allocator.allocate(sizeof(*storage), allocator.state);
+  if (NULL == storage) {
+    return NULL;
+  }
+  storage->error_state.message[0] = '\0';
+  storage->error_state.file[0] = '\0';
+  storage->error_state.line_number = 0;
+  storage->error_string.str[0] = '\0';
+  storage->error_string_is_formatted = false;
+  storage->frames_pushed = 0;
+  storage->allocator = allocator;
+  if (!__register_error_storage(storage)) {
+    allocator.deallocate(storage, allocator.state);
+    return NULL;
+  }
+  gtls_rcutils_error_storage = storage;
+  return storage;
+}
+
+// Return the error storage of the calling thread, allocating it with the default allocator
+// if needed, or NULL if that fails.
+static
+rcutils_error_storage_t *
+__get_error_storage(void)
+{
+  if (NULL != gtls_rcutils_error_storage) {
+    return gtls_rcutils_error_storage;
+  }
+  rcutils_error_storage_t * storage = __allocate_error_storage(rcutils_get_default_allocator());
+#if RCUTILS_REPORT_ERROR_HANDLING_ERRORS
+  if (NULL == storage) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR(
+      "[rcutils|error_handling.c:" RCUTILS_STRINGIFY(__LINE__)
+      "] failed to allocate the thread-local error storage\n");
+  }
+#endif
+  return storage;
+}
 
 rcutils_ret_t
 rcutils_initialize_error_handling_thread_local_storage(rcutils_allocator_t allocator)
 {
-  if (gtls_rcutils_thread_local_initialized) {
+  if (NULL != gtls_rcutils_error_storage) {
     return RCUTILS_RET_OK;
   }
 
@@ -57,21 +241,17 @@ rcutils_initialize_error_handling_thread_local_storage(rcutils_allocator_t alloc
 #endif
     return RCUTILS_RET_INVALID_ARGUMENT;
   }
-  // right now the allocator is not used for anything
-  // but other future implementations may need to use it
-  // e.g. pthread which could only provide thread-local pointers would need to
-  // allocate memory to which those pointers would point
-
-  // forcing the values back to their initial state should force the thread-local storage
-  // to initialize and do any required memory allocation
-  gtls_rcutils_thread_local_initialized = true;
-  rcutils_reset_error();
-  RCUTILS_SET_ERROR_MSG("no error - initializing thread-local storage");
-  rcutils_error_string_t throw_away = rcutils_get_error_string();
-  (void)throw_away;
-  rcutils_reset_error();
-
-  // at this point the thread-local allocator, error state, and error string are all initialized
+
+  // Allocate the error storage now, so that setting and getting errors in this thread
+  // never allocates memory.
+  if (NULL == __allocate_error_storage(allocator)) {
+#if RCUTILS_REPORT_ERROR_HANDLING_ERRORS
+    RCUTILS_SAFE_FWRITE_TO_STDERR(
+      "[rcutils|error_handling.c:" RCUTILS_STRINGIFY(__LINE__)
+      "] rcutils_initialize_error_handling_thread_local_storage() failed to allocate memory\n");
+#endif
+    return RCUTILS_RET_BAD_ALLOC;
+  }
   return RCUTILS_RET_OK;
 }
 
@@ -114,8 +294,7 @@ __format_overwriting_error_state_message(
     if (0 >= bytes_left) {break;}
 
     // write the old error string
-    rcutils_error_string_t old_error_string = rcutils_get_error_string();
-    written = __rcutils_copy_string(offset, sizeof(old_error_string.str), old_error_string.str);
+    written = __rcutils_copy_string(offset, (size_t)bytes_left, rcutils_get_error_c_str());
     offset += written;
     bytes_left -= (int64_t)written;
     if (0 >= bytes_left) {break;}
@@ -167,21 +346,17 @@ __format_overwriting_error_state_message(
 #endif
 }
 
-void
-rcutils_set_error_state(
-  const char * error_string,
-  const char * file,
-  size_t line_number)
+static
+bool
+__check_error_state_arguments(const char * error_string, const char * file)
 {
-  rcutils_error_state_t error_state;
-
   if (NULL == error_string) {
 #if RCUTILS_REPORT_ERROR_HANDLING_ERRORS
     RCUTILS_SAFE_FWRITE_TO_STDERR(
       "[rcutils|error_handling.c:" RCUTILS_STRINGIFY(__LINE__)
       "] rcutils_set_error_state() given null pointer for error_string, error was not set\n");
 #endif
-    return;
+    return false;
   }
 
   if (NULL == file) {
@@ -190,37 +365,142 @@ rcutils_set_error_state(
       "[rcutils|error_handling.c:" RCUTILS_STRINGIFY(__LINE__)
       "] rcutils_set_error_state() given null pointer for file string, error was not set\n");
 #endif
-    return;
+    return false;
   }
+  return true;
+}
 
-  __rcutils_copy_string(error_state.message, sizeof(error_state.message), error_string);
-  __rcutils_copy_string(error_state.file, sizeof(error_state.file), file);
-  error_state.line_number = line_number;
 #if RCUTILS_REPORT_ERROR_HANDLING_ERRORS
+static
+void
+__warn_on_overwriting_error_state(const char * error_string, const char * file, size_t line_number)
+{
+  if (!gtls_rcutils_error_is_set) {
+    return;
+  }
   // Only warn of overwritting if the new error is different from the old ones.
   size_t characters_to_compare = strnlen(error_string, RCUTILS_ERROR_MESSAGE_MAX_LENGTH);
   // assumption is that message length is <= max error string length
   static_assert(
-    sizeof(gtls_rcutils_error_state.message) <= sizeof(gtls_rcutils_error_string.str),
+    sizeof(((rcutils_error_state_t *)NULL)->message) <= sizeof(rcutils_error_string_t),
     "expected error state's max message length to be less than or equal to error string max");
-  if (
-    gtls_rcutils_error_is_set &&
-    !__same_string(error_string, gtls_rcutils_error_string.str, characters_to_compare) &&
-    !__same_string(error_string, gtls_rcutils_error_state.message, characters_to_compare))
-  {
-    char output_buffer[4096];
-    __format_overwriting_error_state_message(output_buffer, sizeof(output_buffer), &error_state);
-    RCUTILS_SAFE_FWRITE_TO_STDERR(output_buffer);
+  rcutils_error_storage_t * storage = gtls_rcutils_error_storage;
+  if (gtls_rcutils_error_state_is_reference) {
+    if (__same_string(error_string, gtls_rcutils_error_message_reference, characters_to_compare)) {
+      return;
+    }
+  } else if (NULL != storage) {
+    if (
+      __same_string(error_string, storage->error_string.str, characters_to_compare) ||
+      __same_string(error_string, storage->error_state.message, characters_to_compare))
+    {
+      return;
+    }
   }
+  rcutils_error_state_t error_state;
+  __rcutils_copy_string(error_state.message, sizeof(error_state.message), error_string);
+  __rcutils_copy_string(error_state.file, sizeof(error_state.file), file);
+  error_state.line_number = line_number;
+  char output_buffer[4096];
+  __format_overwriting_error_state_message(output_buffer, sizeof(output_buffer), &error_state);
+  RCUTILS_SAFE_FWRITE_TO_STDERR(output_buffer);
+}
 #endif
-  gtls_rcutils_error_state = error_state;
-  gtls_rcutils_error_string_is_formatted = false;
-  gtls_rcutils_error_string = (const rcutils_error_string_t) {
-    .str = "\0"
-  };
+
+// Mark the error as set, the formatted error string being computed on demand.
+static
+void
+__set_error_is_set(void)
+{
+  if (NULL != gtls_rcutils_error_storage) {
+    gtls_rcutils_error_storage->error_string_is_formatted = false;
+    gtls_rcutils_error_storage->error_string.str[0] = '\0';
+  }
   gtls_rcutils_error_is_set = true;
 }
 
+// Record the error state by reference, see rcutils_set_error_state_static().
+static
+void
+__set_error_state_references(const char * error_string, const char * file, size_t line_number)
+{
+  gtls_rcutils_error_message_reference = error_string;
+  gtls_rcutils_error_file_reference = file;
+  gtls_rcutils_error_line_number_reference = line_number;
+  gtls_rcutils_error_state_is_reference = true;
+  __set_error_is_set();
+}
+
+void
+rcutils_set_error_state(
+  const char * error_string,
+  const char * file,
+  size_t line_number)
+{
+  if (!__check_error_state_arguments(error_string, file)) {
+    return;
+  }
+#if RCUTILS_REPORT_ERROR_HANDLING_ERRORS
+  __warn_on_overwriting_error_state(error_string, file, line_number);
+#endif
+  rcutils_error_storage_t * storage = __get_error_storage();
+  if (NULL == storage) {
+    // The error is still set, so that the caller's error handling proceeds as usual.
+    __set_error_state_references(
+      g_rcutils_unavailable_error_state.message, g_rcutils_unavailable_error_state.file,
+      (size_t)g_rcutils_unavailable_error_state.line_number);
+    return;
+  }
+  // The strings are copied with memmove, so they may come from the current error state.
+  __rcutils_copy_string(
+    storage->error_state.message, sizeof(storage->error_state.message), error_string);
+  __rcutils_copy_string(storage->error_state.file, sizeof(storage->error_state.file), file);
+  storage->error_state.line_number = line_number;
+  gtls_rcutils_error_state_is_reference = false;
+  __set_error_is_set();
+}
+
+void
+rcutils_set_error_state_static(
+  const char * error_string,
+  const char * file,
+  size_t line_number)
+{
+  if (!__check_error_state_arguments(error_string, file)) {
+    return;
+  }
+#if RCUTILS_REPORT_ERROR_HANDLING_ERRORS
+  __warn_on_overwriting_error_state(error_string, file, line_number);
+#endif
+  __set_error_state_references(error_string, file, line_number);
+}
+
+// Copy an error state set by reference into the given error state.
+static
+void
+__copy_error_state_references(rcutils_error_state_t * error_state)
+{
+  __rcutils_copy_string(
+    error_state->message, sizeof(error_state->message), gtls_rcutils_error_message_reference);
+  __rcutils_copy_string(
+    error_state->file, sizeof(error_state->file), gtls_rcutils_error_file_reference);
+  error_state->line_number = gtls_rcutils_error_line_number_reference;
+}
+
+// Return the error storage, with an error state set by reference copied into it,
+// or NULL if it could not be allocated.
+static
+rcutils_error_storage_t *
+__get_error_storage_with_error_state(void)
+{
+  rcutils_error_storage_t * storage = __get_error_storage();
+  if (NULL != storage && gtls_rcutils_error_state_is_reference) {
+    __copy_error_state_references(&storage->error_state);
+    gtls_rcutils_error_state_is_reference = false;
+  }
+  return storage;
+}
+
 bool
 rcutils_error_is_set(void)
 {
@@ -230,7 +510,30 @@ rcutils_error_is_set(void)
 const rcutils_error_state_t *
 rcutils_get_error_state(void)
 {
-  return &gtls_rcutils_error_state;
+  if (NULL == gtls_rcutils_error_storage && !gtls_rcutils_error_is_set) {
+    return &g_rcutils_empty_error_state;
+  }
+  rcutils_error_storage_t * storage = __get_error_storage_with_error_state();
+  if (NULL == storage) {
+    return &g_rcutils_unavailable_error_state;
+  }
+  return &storage->error_state;
+}
+
+// Return the error string of the error storage, formatting it if needed.
+static
+const rcutils_error_string_t *
+__get_formatted_error_string(rcutils_error_storage_t * storage)
+{
+  if (!storage->error_string_is_formatted) {
+    if (gtls_rcutils_error_state_is_reference) {
+      __copy_error_state_references(&storage->error_state);
+      gtls_rcutils_error_state_is_reference = false;
+    }
+    __rcutils_format_error_string(&storage->error_string, &storage->error_state);
+    storage->error_string_is_formatted = true;
+  }
+  return &storage->error_string;
 }
 
 rcutils_error_string_t
@@ -239,26 +542,179 @@ rcutils_get_error_string(void)
   if (!gtls_rcutils_error_is_set) {
     return (rcutils_error_string_t) {"error not set"};  // NOLINT(readability/braces)
   }
-  if (!gtls_rcutils_error_string_is_formatted) {
-    __rcutils_format_error_string(&gtls_rcutils_error_string, &gtls_rcutils_error_state);
-    gtls_rcutils_error_string_is_formatted = true;
+  rcutils_error_storage_t * storage = gtls_rcutils_error_storage;
+  if (NULL == storage) {
+    // The error was set by reference, it is formatted without allocating the error storage.
+    assert(gtls_rcutils_error_state_is_reference);
+    rcutils_error_state_t error_state;
+    __copy_error_state_references(&error_state);
+    rcutils_error_string_t error_string;
+    __rcutils_format_error_string(&error_string, &error_state);
+    return error_string;
+  }
+  return *__get_formatted_error_string(storage);
+}
+
+const char *
+rcutils_get_error_c_str(void)
+{
+  if (!gtls_rcutils_error_is_set) {
+    return "error not set";
+  }
+  rcutils_error_storage_t * storage = __get_error_storage();
+  if (NULL == storage) {
+    return g_rcutils_unavailable_error_state.message;
   }
-  return gtls_rcutils_error_string;
+  return __get_formatted_error_string(storage)->str;
 }
 
 void
 rcutils_reset_error(void)
 {
-  gtls_rcutils_error_state = (const rcutils_error_state_t) {
-    .message = {0}, .file = {0}, .line_number = 0
-  };  // NOLINT(readability/braces)
-  gtls_rcutils_error_string_is_formatted = false;
-  gtls_rcutils_error_string = (const rcutils_error_string_t) {
-    .str = "\0"
-  };
+  rcutils_error_storage_t * storage = gtls_rcutils_error_storage;
+  if (NULL != storage) {
+    // Only the terminating characters are reset, everything past them is never read.
+    storage->error_state.message[0] = '\0';
+    storage->error_state.file[0] = '\0';
+    storage->error_state.line_number = 0;
+    storage->error_string_is_formatted = false;
+    storage->error_string.str[0] = '\0';
+    storage->frames_pushed = 0;
+  }
+  gtls_rcutils_error_state_is_reference = false;
   gtls_rcutils_error_is_set = false;
 }
 
+// Return the slot of the frames of the error storage in which the n-th pushed frame is stored.
+static
+size_t
+__error_frame_slot(size_t frame_number)
+{
+  if (0 == frame_number) {
+    return 0;
+  }
+  return 1 + (frame_number - 1) % (RCUTILS_ERROR_CHAIN_MAX_FRAMES - 1);
+}
+
+void
+rcutils_push_error_frame(
+  rcutils_ret_t code, const char * message, const char * file, size_t line_number)
+{
+  if (NULL == message || NULL == file) {
+#if RCUTILS_REPORT_ERROR_HANDLING_ERRORS
+    RCUTILS_SAFE_FWRITE_TO_STDERR(
+      "[rcutils|error_handling.c:" RCUTILS_STRINGIFY(__LINE__)
+      "] rcutils_push_error_frame() given null pointer for message or file, "
+      "frame was not pushed\n");
+#endif
+    return;
+  }
+  rcutils_error_storage_t * storage = __get_error_storage();
+  if (NULL == storage) {
+    return;
+  }
+  rcutils_error_frame_t * frame = &storage->frames[__error_frame_slot(storage->frames_pushed)];
+  frame->message = message;
+  frame->file = file;
+  frame->line_number = line_number;
+  frame->code = code;
+  if (SIZE_MAX != storage->frames_pushed) {
+    ++storage->frames_pushed;
+  }
+}
+
+size_t
+rcutils_get_error_chain_size(void)
+{
+  if (NULL == gtls_rcutils_error_storage) {
+    return 0;
+  }
+  size_t frames_pushed = gtls_rcutils_error_storage->frames_pushed;
+  return frames_pushed < RCUTILS_ERROR_CHAIN_MAX_FRAMES ?
+         frames_pushed : RCUTILS_ERROR_CHAIN_MAX_FRAMES;
+}
+
+size_t
+rcutils_get_error_chain_dropped_frame_count(void)
+{
+  if (NULL == gtls_rcutils_error_storage) {
+    return 0;
+  }
+  return gtls_rcutils_error_storage->frames_pushed - rcutils_get_error_chain_size();
+}
+
+const rcutils_error_frame_t *
+rcutils_get_error_chain_frame(size_t index)
+{
+  size_t size = rcutils_get_error_chain_size();
+  if (index >= size) {
+    return NULL;
+  }
+  rcutils_error_storage_t * storage = gtls_rcutils_error_storage;
+  if (0 == index) {
+    return &storage->frames[0];
+  }
+  return &storage->frames[__error_frame_slot(storage->frames_pushed - size + index)];
+}
+
+// Append to a string, silently truncating it, unlike __rcutils_copy_string().
+static
+void
+__append_to_error_chain_string(
+  rcutils_error_string_t * error_string, size_t * length, const char * str)
+{
+  size_t available = sizeof(error_string->str) - 1 - *length;
+  size_t str_length = strlen(str);
+  if (str_length > available) {
+    str_length = available;
+  }
+  memcpy(error_string->str + *length, str, str_length);
+  *length += str_length;
+  error_string->str[*length] = '\0';
+}
+
+rcutils_error_string_t
+rcutils_get_error_chain_string(void)
+{
+  size_t size = rcutils_get_error_chain_size();
+  if (0 == size) {
+    return (rcutils_error_string_t) {"error chain empty"};  // NOLINT(readability/braces)
+  }
+  rcutils_error_string_t error_string;
+  error_string.str[0] = '\0';
+  size_t length = 0;
+  char number_buffer[21];
+  for (size_t i = size; i > 0; --i) {
+    const rcutils_error_frame_t * frame = rcutils_get_error_chain_frame(i - 1);
+    if (i != size) {
+      __append_to_error_chain_string(&error_string, &length, "\n  caused by: ");
+    }
+    if (1 == i && 0 != rcutils_get_error_chain_dropped_frame_count()) {
+      __rcutils_convert_uint64_t_into_c_str(
+        rcutils_get_error_chain_dropped_frame_count(), number_buffer, sizeof(number_buffer));
+      __append_to_error_chain_string(&error_string, &length, "[");
+      __append_to_error_chain_string(&error_string, &length, number_buffer);
+      __append_to_error_chain_string(&error_string, &length, " frames dropped]\n  caused by: ");
+    }
+    __append_to_error_chain_string(&error_string, &length, frame->message);
+    __append_to_error_chain_string(&error_string, &length, " (error code ");
+    if (frame->code < 0) {
+      __append_to_error_chain_string(&error_string, &length, "-");
+    }
+    __rcutils_convert_uint64_t_into_c_str(
+      frame->code < 0 ? (uint64_t)0 - (uint64_t)frame->code : (uint64_t)frame->code,
+      number_buffer, sizeof(number_buffer));
+    __append_to_error_chain_string(&error_string, &length, number_buffer);
+    __append_to_error_chain_string(&error_string, &length, "), at ");
+    __append_to_error_chain_string(&error_string, &length, frame->file);
+    __append_to_error_chain_string(&error_string, &length, ":");
+    __rcutils_convert_uint64_t_into_c_str(
+      frame->line_number, number_buffer, sizeof(number_buffer));
+    __append_to_error_chain_string(&error_string, &length, number_buffer);
+  }
+  return error_string;
+}
+
 #ifdef __cplusplus
 }
 #endif
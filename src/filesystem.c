@@ -14,6 +14,7 @@
 
 #include "rcutils/filesystem.h"
 
+#include <assert.h>
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -21,7 +22,12 @@
 #include <sys/stat.h>
 #ifndef _WIN32
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 #else
 // When building with MSVC 19.28.29333.0 on Windows 10 (as of 2020-11-11),
 // there appears to be a problem with winbase.h (which is included by
@@ -36,13 +42,18 @@
 #include <windows.h>
 #pragma warning(pop)
 #include <direct.h>
+#include <fcntl.h>
+#include <io.h>
 #endif  // _WIN32
 
+#include "rcutils/dir_walk.h"
 #include "rcutils/env.h"
 #include "rcutils/error_handling.h"
-#include "rcutils/format_string.h"
-#include "rcutils/repl_str.h"
-#include "rcutils/strdup.h"
+#include "rcutils/path_builder.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rcutils/strerror.h"
+
+#include "./filesystem_helpers.h"
 
 #ifdef _WIN32
 # define RCUTILS_PATH_DELIMITER "\\"
@@ -56,7 +67,16 @@ typedef struct rcutils_dir_iter_state_s
   HANDLE handle;
   WIN32_FIND_DATA data;
 #else
+  // Without a buffer, the directory is read with readdir(), and with getdents64() otherwise.
   DIR * dir;
+  int fd;
+  char * buffer;
+  size_t buffer_size;
+  size_t offset;
+  size_t length;
+  // The information about the current entry, once queried.
+  bool has_stat;
+  struct stat stat;
 #endif
 } rcutils_dir_iter_state_t;
 
@@ -169,6 +189,16 @@ rcutils_is_readable_and_writable(const char * abs_path)
   return true;
 }
 
+// Return the path of the builder as a newly allocated string, and finalize it.
+static char *
+detach_path(rcutils_path_builder_t * builder, rcutils_ret_t ret)
+{
+  char * path = RCUTILS_RET_OK == ret ? rcutils_path_builder_detach(builder) : NULL;
+  ret = rcutils_path_builder_fini(builder);
+  (void)ret;
+  return path;
+}
+
 char *
 rcutils_join_path(
   const char * left_hand_path,
@@ -182,10 +212,25 @@ rcutils_join_path(
     return NULL;
   }
 
-  return rcutils_format_string(
-    allocator,
-    "%s%s%s",
-    left_hand_path, RCUTILS_PATH_DELIMITER, right_hand_path);
+  rcutils_path_builder_t builder = rcutils_get_zero_initialized_path_builder();
+  rcutils_ret_t ret = rcutils_path_builder_init(&builder, &allocator);
+  if (RCUTILS_RET_OK != ret) {
+    return NULL;
+  }
+  // The delimiter is always added, unlike with rcutils_path_builder_push().
+  const size_t left_hand_length = strlen(left_hand_path);
+  const size_t right_hand_length = strlen(right_hand_path);
+  ret = rcutils_path_builder_reserve(&builder, left_hand_length + 1 + right_hand_length);
+  if (RCUTILS_RET_OK == ret) {
+    ret = rcutils_path_builder_append(&builder, left_hand_path, left_hand_length);
+  }
+  if (RCUTILS_RET_OK == ret) {
+    ret = rcutils_path_builder_append(&builder, RCUTILS_PATH_DELIMITER, 1);
+  }
+  if (RCUTILS_RET_OK == ret) {
+    ret = rcutils_path_builder_append(&builder, right_hand_path, right_hand_length);
+  }
+  return detach_path(&builder, ret);
 }
 
 char *
@@ -197,7 +242,16 @@ rcutils_to_native_path(
     return NULL;
   }
 
-  return rcutils_repl_str(path, "/", RCUTILS_PATH_DELIMITER, &allocator);
+  rcutils_path_builder_t builder = rcutils_get_zero_initialized_path_builder();
+  rcutils_ret_t ret = rcutils_path_builder_init(&builder, &allocator);
+  if (RCUTILS_RET_OK != ret) {
+    return NULL;
+  }
+  ret = rcutils_path_builder_set(&builder, path);
+  if (RCUTILS_RET_OK == ret) {
+    ret = rcutils_path_builder_to_native(&builder);
+  }
+  return detach_path(&builder, ret);
 }
 
 char *
@@ -207,20 +261,28 @@ rcutils_expand_user(const char * path, rcutils_allocator_t allocator)
     return NULL;
   }
 
-  if ('~' != path[0]) {
-    return rcutils_strdup(path, allocator);
+  const char * homedir = NULL;
+  if ('~' == path[0]) {
+    homedir = rcutils_get_home_dir();
+    if (NULL == homedir) {
+      return NULL;
+    }
   }
 
-  const char * homedir = rcutils_get_home_dir();
-  if (NULL == homedir) {
+  rcutils_path_builder_t builder = rcutils_get_zero_initialized_path_builder();
+  rcutils_ret_t ret = rcutils_path_builder_init(&builder, &allocator);
+  if (RCUTILS_RET_OK != ret) {
     return NULL;
   }
-  return rcutils_format_string_limit(
-    allocator,
-    strlen(homedir) + strlen(path),
-    "%s%s",
-    homedir,
-    path + 1);
+  if (NULL == homedir) {
+    ret = rcutils_path_builder_set(&builder, path);
+  } else {
+    ret = rcutils_path_builder_set(&builder, homedir);
+    if (RCUTILS_RET_OK == ret) {
+      ret = rcutils_path_builder_append(&builder, path + 1, strlen(path + 1));
+    }
+  }
+  return detach_path(&builder, ret);
 }
 
 bool
@@ -264,74 +326,127 @@ rcutils_calculate_directory_size(
   return rcutils_calculate_directory_size_with_recursion(directory_path, 1, size, allocator);
 }
 
-typedef struct dir_list_t
+typedef struct dir_size_state_s
 {
-  char * path;
-  uint32_t depth;  // Compare with base path
-  struct dir_list_t * next;
-} dir_list_t;
+  const char * directory_path;
+  size_t max_depth;
+  rcutils_directory_size_mode_t mode;
+  rcutils_allocator_t allocator;
+  atomic_uint_least64_t size;
+  // The first error of the walker threads, as an rcutils_ret_t.
+  atomic_uint_least64_t ret;
+} dir_size_state_t;
+
+static rcutils_ret_t
+calculate_directory_size(
+  const char * directory_path,
+  size_t max_depth,
+  rcutils_directory_size_mode_t mode,
+  size_t thread_count,
+  uint64_t * size,
+  rcutils_allocator_t allocator);
 
-static void free_dir_list(dir_list_t * dir_list, rcutils_allocator_t allocator)
+// Count the file or the directory a symbolic link points to, like the entries of the walked
+// directory, so that a directory is counted as many times as links point to it.
+// Cycles end when the path has too many links to be resolved.
+static rcutils_ret_t
+add_linked_size(const rcutils_dir_walk_entry_t * entry, dir_size_state_t * state)
 {
-  dir_list_t * next_dir;
-  do {
-    next_dir = dir_list->next;
-    allocator.deallocate(dir_list->path, allocator.state);
-    allocator.deallocate(dir_list, allocator.state);
-    dir_list = next_dir;
-  } while (dir_list);
+  rcutils_path_builder_t builder = rcutils_get_zero_initialized_path_builder();
+  rcutils_ret_t ret = rcutils_path_builder_init(&builder, &state->allocator);
+  if (RCUTILS_RET_OK == ret) {
+    ret = rcutils_path_builder_set(&builder, state->directory_path);
+  }
+  if (RCUTILS_RET_OK == ret && '\0' != entry->directory[0]) {
+    ret = rcutils_path_builder_push(&builder, entry->directory);
+  }
+  if (RCUTILS_RET_OK == ret) {
+    ret = rcutils_path_builder_push(&builder, entry->name);
+  }
+  if (RCUTILS_RET_OK != ret) {
+    rcutils_ret_t fini_ret = rcutils_path_builder_fini(&builder);
+    (void)fini_ret;
+    return ret;
+  }
+
+  const char * path = rcutils_path_builder_get_path(&builder);
+  uint64_t size = 0;
+  if (rcutils_is_directory(path)) {
+    if (0 == state->max_depth || entry->depth < state->max_depth) {
+      // The linked directory is walked by the thread which found the link, so that the number
+      // of threads doesn't grow with the number of links.
+      ret = calculate_directory_size(
+        path, 0 == state->max_depth ? 0 : state->max_depth - entry->depth, state->mode, 1,
+        &size, state->allocator);
+    }
+  } else {
+#ifdef _WIN32
+    size = rcutils_get_file_size(path);
+#else
+    struct stat stat_buffer;
+    if (0 == stat(path, &stat_buffer) && S_ISREG(stat_buffer.st_mode)) {
+      rcutils_file_stat_t stat;
+      file_stat_from_stat(&stat_buffer, &stat);
+      size = RCUTILS_DIRECTORY_SIZE_ALLOCATED == state->mode ? stat.allocated_size : stat.size;
+    }
+#endif
+  }
+  rcutils_atomic_fetch_add_uint64_t(&state->size, size);
+  rcutils_ret_t fini_ret = rcutils_path_builder_fini(&builder);
+  (void)fini_ret;
+  return ret;
 }
 
-static void remove_first_dir_from_list(dir_list_t ** dir_list, rcutils_allocator_t allocator)
+static rcutils_dir_walk_action_t add_file_size(
+  const rcutils_dir_walk_entry_t * entry, void * user_data)
 {
-  dir_list_t * next_dir = (*dir_list)->next;
-  allocator.deallocate((*dir_list)->path, allocator.state);
-  allocator.deallocate(*dir_list, allocator.state);
-  *dir_list = next_dir;
+  dir_size_state_t * state = (dir_size_state_t *)user_data;
+  rcutils_file_stat_t stat;
+  if (RCUTILS_FILE_TYPE_REGULAR == entry->type) {
+    if (RCUTILS_RET_OK == rcutils_dir_walk_entry_stat(entry, &stat)) {
+      rcutils_atomic_fetch_add_uint64_t(
+        &state->size,
+        RCUTILS_DIRECTORY_SIZE_ALLOCATED == state->mode ? stat.allocated_size : stat.size);
+    }
+  } else if (RCUTILS_FILE_TYPE_SYMLINK == entry->type) {
+    rcutils_ret_t ret = add_linked_size(entry, state);
+    if (RCUTILS_RET_OK != ret) {
+      uint64_t expected = RCUTILS_RET_OK;
+      bool recorded = rcutils_atomic_compare_exchange_strong_uint_least64_t(
+        &state->ret, &expected, (uint64_t)ret);
+      (void)recorded;
+      return RCUTILS_DIR_WALK_STOP;
+    }
+  }
+  return RCUTILS_DIR_WALK_CONTINUE;
 }
 
-static rcutils_ret_t check_and_calculate_size(
-  const char * filename,
-  uint64_t * dir_size,
-  const size_t max_depth,
-  dir_list_t * dir_list,
+static rcutils_ret_t
+calculate_directory_size(
+  const char * directory_path,
+  size_t max_depth,
+  rcutils_directory_size_mode_t mode,
+  size_t thread_count,
+  uint64_t * size,
   rcutils_allocator_t allocator)
 {
-  // Skip over local folder handle (`.`) and parent folder (`..`)
-  if (strcmp(filename, ".") == 0 || strcmp(filename, "..") == 0) {
-    return RCUTILS_RET_OK;
-  }
-
-  char * file_path = rcutils_join_path(dir_list->path, filename, allocator);
-  if (NULL == file_path) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR("rcutils_join_path return NULL !\n");
-    return RCUTILS_RET_BAD_ALLOC;
-  }
-
-  if (rcutils_is_directory(file_path)) {
-    if ((max_depth == 0) || ((dir_list->depth + 1) <= max_depth)) {
-      // Add new directory to dir_list
-      dir_list_t * found_new_dir =
-        allocator.allocate(sizeof(dir_list_t), allocator.state);
-      if (NULL == found_new_dir) {
-        RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
-          "Failed to allocate memory for path %s !\n", file_path);
-        allocator.deallocate(file_path, allocator.state);
-        return RCUTILS_RET_BAD_ALLOC;
-      }
-      found_new_dir->path = file_path;
-      found_new_dir->depth = dir_list->depth + 1;
-      found_new_dir->next = dir_list->next;
-      dir_list->next = found_new_dir;
-      return RCUTILS_RET_OK;
-    }
-  } else {
-    *dir_size += rcutils_get_file_size(file_path);
-  }
-
-  allocator.deallocate(file_path, allocator.state);
-
-  return RCUTILS_RET_OK;
+  dir_size_state_t state;
+  state.directory_path = directory_path;
+  state.max_depth = max_depth;
+  state.mode = mode;
+  state.allocator = allocator;
+  rcutils_atomic_store(&state.size, 0);
+  rcutils_atomic_store(&state.ret, RCUTILS_RET_OK);
+  rcutils_dir_walk_options_t options = rcutils_get_default_dir_walk_options();
+  options.max_depth = max_depth;
+  // The files of a single directory are counted by a single thread anyway.
+  options.thread_count = 1 == max_depth ? 1 : thread_count;
+  rcutils_ret_t ret = rcutils_dir_walk(directory_path, &options, add_file_size, &state, allocator);
+  if (RCUTILS_RET_OK == ret) {
+    ret = (rcutils_ret_t)rcutils_atomic_load_uint64_t(&state.ret);
+  }
+  *size = RCUTILS_RET_OK == ret ? rcutils_atomic_load_uint64_t(&state.size) : 0;
+  return ret;
 }
 
 rcutils_ret_t
@@ -341,10 +456,32 @@ rcutils_calculate_directory_size_with_recursion(
   uint64_t * size,
   rcutils_allocator_t allocator)
 {
-  dir_list_t * dir_list = NULL;
-  rcutils_ret_t ret = RCUTILS_RET_OK;
-  rcutils_dir_iter_t * iter = NULL;
+  return rcutils_calculate_directory_size_with_mode(
+    directory_path, max_depth, RCUTILS_DIRECTORY_SIZE_APPARENT, size, allocator);
+}
 
+rcutils_ret_t
+rcutils_calculate_directory_size_with_mode(
+  const char * directory_path,
+  size_t max_depth,
+  rcutils_directory_size_mode_t mode,
+  uint64_t * size,
+  rcutils_allocator_t allocator)
+{
+  // The allocator may not be usable from several threads, so the walk is done by this one.
+  return rcutils_calculate_directory_size_parallel(
+    directory_path, max_depth, mode, 1, size, allocator);
+}
+
+rcutils_ret_t
+rcutils_calculate_directory_size_parallel(
+  const char * directory_path,
+  size_t max_depth,
+  rcutils_directory_size_mode_t mode,
+  size_t thread_count,
+  uint64_t * size,
+  rcutils_allocator_t allocator)
+{
   if (NULL == directory_path) {
     RCUTILS_SAFE_FWRITE_TO_STDERR("directory_path is NULL !");
     return RCUTILS_RET_INVALID_ARGUMENT;
@@ -362,57 +499,70 @@ rcutils_calculate_directory_size_with_recursion(
   }
 
   RCUTILS_CHECK_ALLOCATOR(&allocator, return RCUTILS_RET_INVALID_ARGUMENT);
-  dir_list = allocator.zero_allocate(1, sizeof(dir_list_t), allocator.state);
-  if (NULL == dir_list) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to allocate memory !\n");
-    return RCUTILS_RET_BAD_ALLOC;
-  }
-
-  dir_list->depth = 1;
-
-  dir_list->path = rcutils_strdup(directory_path, allocator);
-  if (NULL == dir_list->path) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to duplicate directory path !\n");
-    allocator.deallocate(dir_list, allocator.state);
-    return RCUTILS_RET_BAD_ALLOC;
-  }
-
-  *size = 0;
 
-  do {
-    iter = rcutils_dir_iter_start(dir_list->path, allocator);
-    if (NULL == iter) {
-      ret = RCUTILS_RET_ERROR;
-      goto fail;
-    }
+  return calculate_directory_size(directory_path, max_depth, mode, thread_count, size, allocator);
+}
 
-    do {
-      ret = check_and_calculate_size(iter->entry_name, size, max_depth, dir_list, allocator);
-      if (RCUTILS_RET_OK != ret) {
-        goto fail;
+#ifdef _WIN32
+static void
+dir_iter_set_entry(rcutils_dir_iter_t * iter)
+{
+  iter->entry_name = iter->state->data.cFileName;
+  iter->entry_type = file_type_from_attributes(iter->state->data.dwFileAttributes, false);
+  iter->entry_inode = 0;
+}
+#else
+// Move to the next entry of the directory.
+// At the end of the directory, errno is 0, and otherwise the error code.
+static bool
+dir_iter_read(rcutils_dir_iter_t * iter)
+{
+  rcutils_dir_iter_state_t * state = iter->state;
+  state->has_stat = false;
+  errno = 0;
+#ifdef __linux__
+  if (NULL != state->buffer) {
+    if (state->offset >= state->length) {
+      long length = syscall(SYS_getdents64, state->fd, state->buffer, state->buffer_size);
+      if (length <= 0) {
+        return false;
       }
-    } while (rcutils_dir_iter_next(iter));
-
-    rcutils_dir_iter_end(iter);
-
-    remove_first_dir_from_list(&dir_list, allocator);
-  } while (dir_list);
-
-  return ret;
-
-fail:
-  rcutils_dir_iter_end(iter);
-  free_dir_list(dir_list, allocator);
-  return ret;
+      state->offset = 0;
+      state->length = (size_t)length;
+    }
+    // The records are struct linux_dirent64, which glibc doesn't declare, with the fields
+    // d_ino (8 bytes), d_off (8 bytes), d_reclen (2 bytes), d_type and d_name.
+    // The buffer isn't necessarily aligned, so the fields are copied.
+    const char * record = state->buffer + state->offset;
+    uint64_t inode;
+    uint16_t record_length;
+    memcpy(&inode, record, sizeof(inode));
+    memcpy(&record_length, record + 16, sizeof(record_length));
+    state->offset += record_length;
+    iter->entry_name = record + 19;
+    iter->entry_type = file_type_from_dirent((unsigned char)record[18]);
+    iter->entry_inode = inode;
+    return true;
+  }
+#endif
+  struct dirent * entry = readdir(state->dir);
+  if (NULL == entry) {
+    return false;
+  }
+  iter->entry_name = entry->d_name;
+  iter->entry_type = file_type_from_dirent(RCUTILS_DIRENT_TYPE(entry));
+  iter->entry_inode = (uint64_t)entry->d_ino;
+  return true;
 }
+#endif
 
-rcutils_dir_iter_t *
-rcutils_dir_iter_start(const char * directory_path, const rcutils_allocator_t allocator)
+static rcutils_dir_iter_t *
+dir_iter_start(
+  const char * directory_path,
+  void * buffer,
+  size_t buffer_size,
+  const rcutils_allocator_t allocator)
 {
-  RCUTILS_CHECK_ARGUMENT_FOR_NULL(directory_path, NULL);
-  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
-    &allocator, "allocator is invalid", return NULL);
-
   rcutils_dir_iter_t * iter = allocator.zero_allocate(
     1, sizeof(rcutils_dir_iter_t), allocator.state);
   if (NULL == iter) {
@@ -429,6 +579,8 @@ rcutils_dir_iter_start(const char * directory_path, const rcutils_allocator_t al
   }
 
 #ifdef _WIN32
+  (void)buffer;
+  (void)buffer_size;
   char * search_path = rcutils_join_path(directory_path, "*", allocator);
   if (NULL == search_path) {
     goto rcutils_dir_iter_start_fail;
@@ -443,21 +595,24 @@ rcutils_dir_iter_start(const char * directory_path, const rcutils_allocator_t al
       goto rcutils_dir_iter_start_fail;
     }
   } else {
-    iter->entry_name = iter->state->data.cFileName;
+    dir_iter_set_entry(iter);
   }
 #else
-  iter->state->dir = opendir(directory_path);
-  if (NULL == iter->state->dir) {
+  iter->state->fd = -1;
+  if (NULL != buffer) {
+    iter->state->buffer = buffer;
+    iter->state->buffer_size = buffer_size;
+    iter->state->fd = open(directory_path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  } else {
+    iter->state->dir = opendir(directory_path);
+  }
+  if (NULL == iter->state->dir && -1 == iter->state->fd) {
     RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
       "Can't open directory %s. Error code: %d\n", directory_path, errno);
     goto rcutils_dir_iter_start_fail;
   }
 
-  errno = 0;
-  struct dirent * entry = readdir(iter->state->dir);
-  if (NULL != entry) {
-    iter->entry_name = entry->d_name;
-  } else if (0 != errno) {
+  if (!dir_iter_read(iter) && 0 != errno) {
     RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
       "Can't iterate directory %s. Error code: %d\n", directory_path, errno);
     goto rcutils_dir_iter_start_fail;
@@ -471,6 +626,39 @@ rcutils_dir_iter_start_fail:
   return NULL;
 }
 
+rcutils_dir_iter_t *
+rcutils_dir_iter_start(const char * directory_path, const rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(directory_path, NULL);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "allocator is invalid", return NULL);
+
+  return dir_iter_start(directory_path, NULL, 0, allocator);
+}
+
+rcutils_dir_iter_t *
+rcutils_dir_iter_start_with_buffer(
+  const char * directory_path,
+  void * buffer,
+  size_t buffer_size,
+  const rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(directory_path, NULL);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(buffer, NULL);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "allocator is invalid", return NULL);
+  if (buffer_size < RCUTILS_DIR_ITER_MIN_BUFFER_SIZE) {
+    RCUTILS_SET_ERROR_MSG("buffer_size is smaller than RCUTILS_DIR_ITER_MIN_BUFFER_SIZE");
+    return NULL;
+  }
+
+#ifdef __linux__
+  return dir_iter_start(directory_path, buffer, buffer_size, allocator);
+#else
+  return dir_iter_start(directory_path, NULL, 0, allocator);
+#endif
+}
+
 bool
 rcutils_dir_iter_next(rcutils_dir_iter_t * iter)
 {
@@ -479,21 +667,54 @@ rcutils_dir_iter_next(rcutils_dir_iter_t * iter)
 
 #ifdef _WIN32
   if (FindNextFile(iter->state->handle, &iter->state->data)) {
-    iter->entry_name = iter->state->data.cFileName;
+    dir_iter_set_entry(iter);
     return true;
   }
 #else
-  struct dirent * entry = readdir(iter->state->dir);
-  if (NULL != entry) {
-    iter->entry_name = entry->d_name;
+  if (dir_iter_read(iter)) {
     return true;
   }
 #endif
 
   iter->entry_name = NULL;
+  iter->entry_type = RCUTILS_FILE_TYPE_UNKNOWN;
+  iter->entry_inode = 0;
   return false;
 }
 
+rcutils_ret_t
+rcutils_dir_iter_stat(rcutils_dir_iter_t * iter, rcutils_file_stat_t * stat)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(iter, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(stat, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    iter->state, "iter is invalid", return RCUTILS_RET_INVALID_ARGUMENT);
+  if (NULL == iter->entry_name) {
+    RCUTILS_SET_ERROR_MSG("iter isn't on an entry");
+    return RCUTILS_RET_ERROR;
+  }
+
+#ifdef _WIN32
+  file_stat_from_find_data(&iter->state->data, iter->entry_type, stat);
+#else
+  rcutils_dir_iter_state_t * state = iter->state;
+  if (!state->has_stat) {
+    int fd = NULL != state->dir ? dirfd(state->dir) : state->fd;
+    if (0 != fstatat(fd, iter->entry_name, &state->stat, AT_SYMLINK_NOFOLLOW)) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Can't query %s. Error code: %d", iter->entry_name, errno);
+      return RCUTILS_RET_ERROR;
+    }
+    state->has_stat = true;
+    if (RCUTILS_FILE_TYPE_UNKNOWN == iter->entry_type) {
+      iter->entry_type = file_type_from_mode(state->stat.st_mode);
+    }
+  }
+  file_stat_from_stat(&state->stat, stat);
+#endif
+  return RCUTILS_RET_OK;
+}
+
 void
 rcutils_dir_iter_end(rcutils_dir_iter_t * iter)
 {
@@ -511,6 +732,8 @@ rcutils_dir_iter_end(rcutils_dir_iter_t * iter)
 #else
     if (NULL != iter->state->dir) {
       closedir(iter->state->dir);
+    } else if (-1 != iter->state->fd) {
+      close(iter->state->fd);
     }
 #endif
 
@@ -533,3 +756,142 @@ rcutils_get_file_size(const char * file_path)
   int rc = stat(file_path, &stat_buffer);
   return rc == 0 ? (size_t)(stat_buffer.st_size) : 0;
 }
+
+// Files are mapped this much at a time, so that huge files fit in the address space.
+#define RCUTILS_DIGEST_FILE_MAP_SIZE ((size_t)64 * 1024 * 1024)
+// Files which can't be mapped are read this much at a time, into a page aligned buffer.
+#define RCUTILS_DIGEST_FILE_READ_SIZE ((size_t)1024 * 1024)
+#define RCUTILS_DIGEST_FILE_READ_ALIGNMENT ((size_t)4096)
+
+static void set_file_error_msg(const char * message, const char * file_path)
+{
+  char error_string[1024];
+  rcutils_strerror(error_string, sizeof(error_string));
+  RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("%s '%s': %s", message, file_path, error_string);
+}
+
+#ifndef _WIN32
+// Files of 2 GiB or more are mapped at offsets which only fit a 64-bit off_t.
+static_assert(sizeof(off_t) >= sizeof(int64_t), "expected a 64-bit off_t for large files");
+
+// Feed the file to update one mapped window at a time, with the offset up to which it was
+// fed returned in digested_size.
+// RCUTILS_RET_NOT_FOUND is returned if it can't be mapped from there on, like pipes and
+// files of special file systems which report an empty size.
+static rcutils_ret_t digest_mapped_file(
+  int fd, rcutils_file_digest_update_t update, void * state, uint64_t * digested_size)
+{
+  struct stat stat_buffer;
+  *digested_size = 0;
+  if (0 != fstat(fd, &stat_buffer) || !S_ISREG(stat_buffer.st_mode) || stat_buffer.st_size <= 0) {
+    return RCUTILS_RET_NOT_FOUND;
+  }
+
+  const uint64_t file_size = (uint64_t)stat_buffer.st_size;
+  while (*digested_size < file_size) {
+    const uint64_t remaining = file_size - *digested_size;
+    const size_t window_size =
+      remaining < RCUTILS_DIGEST_FILE_MAP_SIZE ? (size_t)remaining : RCUTILS_DIGEST_FILE_MAP_SIZE;
+    void * window = mmap(NULL, window_size, PROT_READ, MAP_PRIVATE, fd, (off_t)*digested_size);
+    if (MAP_FAILED == window) {
+      return RCUTILS_RET_NOT_FOUND;
+    }
+    // The pages are read once in order, so read ahead aggressively and drop them early.
+    (void)madvise(window, window_size, MADV_SEQUENTIAL);
+    update((const uint8_t *)window, window_size, state);
+    munmap(window, window_size);
+    *digested_size += window_size;
+  }
+  return RCUTILS_RET_OK;
+}
+#endif
+
+// Feed the file to update from the given offset with large reads.
+static rcutils_ret_t digest_read_file(
+  int fd, uint64_t offset, const char * file_path, rcutils_file_digest_update_t update,
+  void * state, rcutils_allocator_t allocator)
+{
+#ifdef _WIN32
+  if (offset > 0 && _lseeki64(fd, (__int64)offset, SEEK_SET) < 0) {
+#else
+  if (offset > 0 && lseek(fd, (off_t)offset, SEEK_SET) < 0) {
+#endif
+    set_file_error_msg("Failed to seek in file", file_path);
+    return RCUTILS_RET_ERROR;
+  }
+#if !defined(_WIN32) && defined(POSIX_FADV_SEQUENTIAL)
+  (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+  uint8_t * allocation = allocator.allocate(
+    RCUTILS_DIGEST_FILE_READ_SIZE + RCUTILS_DIGEST_FILE_READ_ALIGNMENT, allocator.state);
+  if (NULL == allocation) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for reading the file");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  uint8_t * buffer = allocation + RCUTILS_DIGEST_FILE_READ_ALIGNMENT -
+    (uintptr_t)allocation % RCUTILS_DIGEST_FILE_READ_ALIGNMENT;
+
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  for (;;) {
+#ifdef _WIN32
+    int read_size = _read(fd, buffer, (unsigned int)RCUTILS_DIGEST_FILE_READ_SIZE);
+#else
+    ssize_t read_size = read(fd, buffer, RCUTILS_DIGEST_FILE_READ_SIZE);
+    if (read_size < 0 && EINTR == errno) {
+      continue;
+    }
+#endif
+    if (read_size < 0) {
+      set_file_error_msg("Failed to read file", file_path);
+      ret = RCUTILS_RET_ERROR;
+      break;
+    }
+    if (0 == read_size) {
+      break;
+    }
+    update(buffer, (size_t)read_size, state);
+  }
+
+  allocator.deallocate(allocation, allocator.state);
+  return ret;
+}
+
+rcutils_ret_t
+rcutils_digest_file(
+  const char * file_path,
+  rcutils_file_digest_update_t update,
+  void * state,
+  rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file_path, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(update, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "allocator is invalid", return RCUTILS_RET_INVALID_ARGUMENT);
+
+  uint64_t digested_size = 0;
+  rcutils_ret_t ret = RCUTILS_RET_NOT_FOUND;
+#ifdef _WIN32
+  int fd = _open(file_path, _O_RDONLY | _O_BINARY);
+#else
+  int fd = open(file_path, O_RDONLY | O_CLOEXEC);
+#endif
+  if (fd < 0) {
+    set_file_error_msg("Failed to open file", file_path);
+    return RCUTILS_RET_ERROR;
+  }
+
+#ifndef _WIN32
+  ret = digest_mapped_file(fd, update, state, &digested_size);
+#endif
+  if (RCUTILS_RET_NOT_FOUND == ret) {
+    ret = digest_read_file(fd, digested_size, file_path, update, state, allocator);
+  }
+
+#ifdef _WIN32
+  _close(fd);
+#else
+  close(fd);
+#endif
+  return ret;
+}
@@ -0,0 +1,131 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FILESYSTEM_HELPERS_H_
+#define FILESYSTEM_HELPERS_H_
+
+// Conversions to the types of rcutils/filesystem.h, shared by filesystem.c and dir_walk.c.
+// On Windows, windows.h must be included before.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <dirent.h>
+#endif
+
+#include "rcutils/filesystem.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#ifndef _WIN32
+# ifdef DT_UNKNOWN
+#  define RCUTILS_DIRENT_TYPE(entry) ((entry)->d_type)
+# else
+// The type of the entries isn't given by readdir(), so it is always queried.
+#  define DT_UNKNOWN 0
+#  define DT_DIR 4
+#  define DT_REG 8
+#  define DT_LNK 10
+#  define RCUTILS_DIRENT_TYPE(entry) DT_UNKNOWN
+# endif
+
+static inline
+rcutils_file_type_t
+file_type_from_mode(mode_t mode)
+{
+  if (S_ISREG(mode)) {
+    return RCUTILS_FILE_TYPE_REGULAR;
+  } else if (S_ISDIR(mode)) {
+    return RCUTILS_FILE_TYPE_DIRECTORY;
+  } else if (S_ISLNK(mode)) {
+    return RCUTILS_FILE_TYPE_SYMLINK;
+  }
+  return RCUTILS_FILE_TYPE_OTHER;
+}
+
+static inline
+rcutils_file_type_t
+file_type_from_dirent(unsigned char type)
+{
+  switch (type) {
+    case DT_UNKNOWN:
+      return RCUTILS_FILE_TYPE_UNKNOWN;
+    case DT_REG:
+      return RCUTILS_FILE_TYPE_REGULAR;
+    case DT_DIR:
+      return RCUTILS_FILE_TYPE_DIRECTORY;
+    case DT_LNK:
+      return RCUTILS_FILE_TYPE_SYMLINK;
+    default:
+      return RCUTILS_FILE_TYPE_OTHER;
+  }
+}
+
+static inline
+void
+file_stat_from_stat(const struct stat * stat_buffer, rcutils_file_stat_t * stat)
+{
+  stat->type = file_type_from_mode(stat_buffer->st_mode);
+  stat->size = (uint64_t)stat_buffer->st_size;
+  stat->allocated_size = (uint64_t)stat_buffer->st_blocks * 512u;
+  stat->device = (uint64_t)stat_buffer->st_dev;
+  stat->inode = (uint64_t)stat_buffer->st_ino;
+# ifdef __APPLE__
+  const struct timespec * time = &stat_buffer->st_mtimespec;
+# else
+  const struct timespec * time = &stat_buffer->st_mtim;
+# endif
+  stat->modification_time = (int64_t)time->tv_sec * 1000000000LL + time->tv_nsec;
+}
+#else
+static inline
+rcutils_file_type_t
+file_type_from_attributes(DWORD attributes, bool follow_reparse_points)
+{
+  if ((attributes & FILE_ATTRIBUTE_REPARSE_POINT) && !follow_reparse_points) {
+    return RCUTILS_FILE_TYPE_SYMLINK;
+  } else if (attributes & FILE_ATTRIBUTE_DIRECTORY) {
+    return RCUTILS_FILE_TYPE_DIRECTORY;
+  } else if (attributes & FILE_ATTRIBUTE_DEVICE) {
+    return RCUTILS_FILE_TYPE_OTHER;
+  }
+  return RCUTILS_FILE_TYPE_REGULAR;
+}
+
+static inline
+void
+file_stat_from_find_data(
+  const WIN32_FIND_DATA * data, rcutils_file_type_t type, rcutils_file_stat_t * stat)
+{
+  stat->type = type;
+  stat->size = ((uint64_t)data->nFileSizeHigh << 32) | data->nFileSizeLow;
+  stat->allocated_size = stat->size;
+  stat->device = 0;
+  stat->inode = 0;
+  // The time is given in 100 nanoseconds since 1601.
+  int64_t time = (int64_t)(((uint64_t)data->ftLastWriteTime.dwHighDateTime << 32) |
+    data->ftLastWriteTime.dwLowDateTime);
+  stat->modification_time = (time - 116444736000000000LL) * 100;
+}
+#endif  // _WIN32
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FILESYSTEM_HELPERS_H_
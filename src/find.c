@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -20,6 +22,386 @@
 #include "rcutils/find.h"
 #include "rcutils/types.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <emmintrin.h>
+# define RCUTILS_FIND_USE_SSE2
+# if (defined(__GNUC__) || defined(__clang__)) && !defined(_WIN32)
+// The AVX2 functions are compiled for it with a target attribute, and only called if the
+// processor supports it.
+#  include <immintrin.h>
+#  include "rcutils/stdatomic_helper.h"
+#  define RCUTILS_FIND_USE_AVX2
+# endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+# include <arm_neon.h>
+# define RCUTILS_FIND_USE_NEON
+#endif
+#if defined(_MSC_VER)
+# include <intrin.h>
+#endif
+
+// The delimiters are compared one by one, so larger sets are searched with a lookup table
+// instead, without vector instructions.
+#define RCUTILS_FIND_MAX_VECTOR_DELIMITERS 8
+
+#if defined(RCUTILS_FIND_USE_SSE2) || defined(RCUTILS_FIND_USE_NEON)
+// Return the index of the lowest bit set in a mask which isn't zero.
+static inline size_t
+__lowest_bit_index(uint64_t mask)
+{
+  assert(0 != mask);
+#if defined(_MSC_VER)
+  unsigned long index;
+# if defined(_M_X64) || defined(_M_ARM64)
+  _BitScanForward64(&index, mask);
+# else
+  if (!_BitScanForward(&index, (unsigned long)mask)) {
+    _BitScanForward(&index, (unsigned long)(mask >> 32));
+    index += 32;
+  }
+# endif
+  return index;
+#else
+  return (size_t)__builtin_ctzll(mask);
+#endif
+}
+
+// Return the index of the highest bit set in a mask which isn't zero.
+static inline size_t
+__highest_bit_index(uint64_t mask)
+{
+  assert(0 != mask);
+#if defined(_MSC_VER)
+  unsigned long index;
+# if defined(_M_X64) || defined(_M_ARM64)
+  _BitScanReverse64(&index, mask);
+# else
+  if (_BitScanReverse(&index, (unsigned long)(mask >> 32))) {
+    index += 32;
+  } else {
+    _BitScanReverse(&index, (unsigned long)mask);
+  }
+# endif
+  return index;
+#else
+  return 63u - (size_t)__builtin_clzll(mask);
+#endif
+}
+#endif
+
+static inline bool
+__is_any_of(char c, const char * delimiters, size_t delimiters_length)
+{
+  for (size_t d = 0; d < delimiters_length; ++d) {
+    if (c == delimiters[d]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static size_t
+__find_first_scalar(
+  const char * str, size_t length, const char * delimiters, size_t delimiters_length)
+{
+  if (1 == delimiters_length) {
+    const char delimiter = delimiters[0];
+    for (size_t i = 0; i < length; ++i) {
+      if (str[i] == delimiter) {
+        return i;
+      }
+    }
+    return SIZE_MAX;
+  }
+  if (delimiters_length <= RCUTILS_FIND_MAX_VECTOR_DELIMITERS) {
+    for (size_t i = 0; i < length; ++i) {
+      if (__is_any_of(str[i], delimiters, delimiters_length)) {
+        return i;
+      }
+    }
+    return SIZE_MAX;
+  }
+  bool is_delimiter[256] = {false};
+  for (size_t d = 0; d < delimiters_length; ++d) {
+    is_delimiter[(unsigned char)delimiters[d]] = true;
+  }
+  for (size_t i = 0; i < length; ++i) {
+    if (is_delimiter[(unsigned char)str[i]]) {
+      return i;
+    }
+  }
+  return SIZE_MAX;
+}
+
+static size_t
+__find_last_scalar(
+  const char * str, size_t length, const char * delimiters, size_t delimiters_length)
+{
+  if (1 == delimiters_length) {
+    const char delimiter = delimiters[0];
+    for (size_t i = length; i > 0; --i) {
+      if (str[i - 1] == delimiter) {
+        return i - 1;
+      }
+    }
+    return SIZE_MAX;
+  }
+  if (delimiters_length <= RCUTILS_FIND_MAX_VECTOR_DELIMITERS) {
+    for (size_t i = length; i > 0; --i) {
+      if (__is_any_of(str[i - 1], delimiters, delimiters_length)) {
+        return i - 1;
+      }
+    }
+    return SIZE_MAX;
+  }
+  bool is_delimiter[256] = {false};
+  for (size_t d = 0; d < delimiters_length; ++d) {
+    is_delimiter[(unsigned char)delimiters[d]] = true;
+  }
+  for (size_t i = length; i > 0; --i) {
+    if (is_delimiter[(unsigned char)str[i - 1]]) {
+      return i - 1;
+    }
+  }
+  return SIZE_MAX;
+}
+
+// The vector functions below search strings of at least one block, with at most
+// RCUTILS_FIND_MAX_VECTOR_DELIMITERS delimiters. The last block is loaded so that it ends
+// with the string, overlapping the previous one rather than leaving a scalar tail: there is
+// no match in the overlap, since it was already searched.
+
+#if defined(RCUTILS_FIND_USE_SSE2)
+static inline uint64_t
+__match_mask_sse2(const char * block, const __m128i * delimiters, size_t delimiters_length)
+{
+  __m128i data = _mm_loadu_si128((const __m128i *)block);
+  __m128i matches = _mm_cmpeq_epi8(data, delimiters[0]);
+  for (size_t d = 1; d < delimiters_length; ++d) {
+    matches = _mm_or_si128(matches, _mm_cmpeq_epi8(data, delimiters[d]));
+  }
+  return (uint32_t)_mm_movemask_epi8(matches);
+}
+
+static size_t
+__find_first_sse2(
+  const char * str, size_t length, const char * delimiters, size_t delimiters_length)
+{
+  assert(length >= 16 && delimiters_length <= RCUTILS_FIND_MAX_VECTOR_DELIMITERS);
+  __m128i delimiter_vectors[RCUTILS_FIND_MAX_VECTOR_DELIMITERS];
+  for (size_t d = 0; d < delimiters_length; ++d) {
+    delimiter_vectors[d] = _mm_set1_epi8(delimiters[d]);
+  }
+  for (size_t i = 0; i < length; i += 16) {
+    if (i > length - 16) {
+      i = length - 16;
+    }
+    uint64_t mask = __match_mask_sse2(str + i, delimiter_vectors, delimiters_length);
+    if (0 != mask) {
+      return i + __lowest_bit_index(mask);
+    }
+  }
+  return SIZE_MAX;
+}
+
+static size_t
+__find_last_sse2(
+  const char * str, size_t length, const char * delimiters, size_t delimiters_length)
+{
+  assert(length >= 16 && delimiters_length <= RCUTILS_FIND_MAX_VECTOR_DELIMITERS);
+  __m128i delimiter_vectors[RCUTILS_FIND_MAX_VECTOR_DELIMITERS];
+  for (size_t d = 0; d < delimiters_length; ++d) {
+    delimiter_vectors[d] = _mm_set1_epi8(delimiters[d]);
+  }
+  for (size_t i = length; i > 0; i -= 16) {
+    if (i < 16) {
+      i = 16;
+    }
+    uint64_t mask = __match_mask_sse2(str + i - 16, delimiter_vectors, delimiters_length);
+    if (0 != mask) {
+      return i - 16 + __highest_bit_index(mask);
+    }
+  }
+  return SIZE_MAX;
+}
+#endif
+
+#if defined(RCUTILS_FIND_USE_AVX2)
+__attribute__((target("avx2")))
+static inline uint64_t
+__match_mask_avx2(const char * block, const __m256i * delimiters, size_t delimiters_length)
+{
+  __m256i data = _mm256_loadu_si256((const __m256i *)block);
+  __m256i matches = _mm256_cmpeq_epi8(data, delimiters[0]);
+  for (size_t d = 1; d < delimiters_length; ++d) {
+    matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(data, delimiters[d]));
+  }
+  return (uint32_t)_mm256_movemask_epi8(matches);
+}
+
+__attribute__((target("avx2")))
+static size_t
+__find_first_avx2(
+  const char * str, size_t length, const char * delimiters, size_t delimiters_length)
+{
+  assert(length >= 32 && delimiters_length <= RCUTILS_FIND_MAX_VECTOR_DELIMITERS);
+  __m256i delimiter_vectors[RCUTILS_FIND_MAX_VECTOR_DELIMITERS];
+  for (size_t d = 0; d < delimiters_length; ++d) {
+    delimiter_vectors[d] = _mm256_set1_epi8(delimiters[d]);
+  }
+  for (size_t i = 0; i < length; i += 32) {
+    if (i > length - 32) {
+      i = length - 32;
+    }
+    uint64_t mask = __match_mask_avx2(str + i, delimiter_vectors, delimiters_length);
+    if (0 != mask) {
+      return i + __lowest_bit_index(mask);
+    }
+  }
+  return SIZE_MAX;
+}
+
+__attribute__((target("avx2")))
+static size_t
+__find_last_avx2(
+  const char * str, size_t length, const char * delimiters, size_t delimiters_length)
+{
+  assert(length >= 32 && delimiters_length <= RCUTILS_FIND_MAX_VECTOR_DELIMITERS);
+  __m256i delimiter_vectors[RCUTILS_FIND_MAX_VECTOR_DELIMITERS];
+  for (size_t d = 0; d < delimiters_length; ++d) {
+    delimiter_vectors[d] = _mm256_set1_epi8(delimiters[d]);
+  }
+  for (size_t i = length; i > 0; i -= 32) {
+    if (i < 32) {
+      i = 32;
+    }
+    uint64_t mask = __match_mask_avx2(str + i - 32, delimiter_vectors, delimiters_length);
+    if (0 != mask) {
+      return i - 32 + __highest_bit_index(mask);
+    }
+  }
+  return SIZE_MAX;
+}
+#endif
+
+#if defined(RCUTILS_FIND_USE_NEON)
+// Return a mask with 4 bits set for every character of the block matching a delimiter.
+static inline uint64_t
+__match_mask_neon(const char * block, const uint8x16_t * delimiters, size_t delimiters_length)
+{
+  uint8x16_t data = vld1q_u8((const uint8_t *)block);
+  uint8x16_t matches = vceqq_u8(data, delimiters[0]);
+  for (size_t d = 1; d < delimiters_length; ++d) {
+    matches = vorrq_u8(matches, vceqq_u8(data, delimiters[d]));
+  }
+  return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+}
+
+static size_t
+__find_first_neon(
+  const char * str, size_t length, const char * delimiters, size_t delimiters_length)
+{
+  assert(length >= 16 && delimiters_length <= RCUTILS_FIND_MAX_VECTOR_DELIMITERS);
+  uint8x16_t delimiter_vectors[RCUTILS_FIND_MAX_VECTOR_DELIMITERS];
+  for (size_t d = 0; d < delimiters_length; ++d) {
+    delimiter_vectors[d] = vdupq_n_u8((uint8_t)delimiters[d]);
+  }
+  for (size_t i = 0; i < length; i += 16) {
+    if (i > length - 16) {
+      i = length - 16;
+    }
+    uint64_t mask = __match_mask_neon(str + i, delimiter_vectors, delimiters_length);
+    if (0 != mask) {
+      return i + __lowest_bit_index(mask) / 4;
+    }
+  }
+  return SIZE_MAX;
+}
+
+static size_t
+__find_last_neon(
+  const char * str, size_t length, const char * delimiters, size_t delimiters_length)
+{
+  assert(length >= 16 && delimiters_length <= RCUTILS_FIND_MAX_VECTOR_DELIMITERS);
+  uint8x16_t delimiter_vectors[RCUTILS_FIND_MAX_VECTOR_DELIMITERS];
+  for (size_t d = 0; d < delimiters_length; ++d) {
+    delimiter_vectors[d] = vdupq_n_u8((uint8_t)delimiters[d]);
+  }
+  for (size_t i = length; i > 0; i -= 16) {
+    if (i < 16) {
+      i = 16;
+    }
+    uint64_t mask = __match_mask_neon(str + i - 16, delimiter_vectors, delimiters_length);
+    if (0 != mask) {
+      return i - 16 + __highest_bit_index(mask) / 4;
+    }
+  }
+  return SIZE_MAX;
+}
+#endif
+
+#if defined(RCUTILS_FIND_USE_AVX2)
+// 0 until the processor is checked, then 1 if it supports AVX2, or -1 otherwise.
+static atomic_int g_rcutils_find_has_avx2 = ATOMIC_VAR_INIT(0);
+
+static bool
+__has_avx2(void)
+{
+  int has_avx2 = 0;
+  rcutils_atomic_load(&g_rcutils_find_has_avx2, has_avx2);
+  if (0 == has_avx2) {
+    __builtin_cpu_init();
+    has_avx2 = __builtin_cpu_supports("avx2") ? 1 : -1;
+    rcutils_atomic_store(&g_rcutils_find_has_avx2, has_avx2);
+  }
+  return 1 == has_avx2;
+}
+#endif
+
+static size_t
+__find_first(const char * str, size_t length, const char * delimiters, size_t delimiters_length)
+{
+  if (delimiters_length <= RCUTILS_FIND_MAX_VECTOR_DELIMITERS) {
+#if defined(RCUTILS_FIND_USE_AVX2)
+    if (length >= 32 && __has_avx2()) {
+      return __find_first_avx2(str, length, delimiters, delimiters_length);
+    }
+#endif
+#if defined(RCUTILS_FIND_USE_SSE2)
+    if (length >= 16) {
+      return __find_first_sse2(str, length, delimiters, delimiters_length);
+    }
+#elif defined(RCUTILS_FIND_USE_NEON)
+    if (length >= 16) {
+      return __find_first_neon(str, length, delimiters, delimiters_length);
+    }
+#endif
+  }
+  return __find_first_scalar(str, length, delimiters, delimiters_length);
+}
+
+static size_t
+__find_last(const char * str, size_t length, const char * delimiters, size_t delimiters_length)
+{
+  if (delimiters_length <= RCUTILS_FIND_MAX_VECTOR_DELIMITERS) {
+#if defined(RCUTILS_FIND_USE_AVX2)
+    if (length >= 32 && __has_avx2()) {
+      return __find_last_avx2(str, length, delimiters, delimiters_length);
+    }
+#endif
+#if defined(RCUTILS_FIND_USE_SSE2)
+    if (length >= 16) {
+      return __find_last_sse2(str, length, delimiters, delimiters_length);
+    }
+#elif defined(RCUTILS_FIND_USE_NEON)
+    if (length >= 16) {
+      return __find_last_neon(str, length, delimiters, delimiters_length);
+    }
+#endif
+  }
+  return __find_last_scalar(str, length, delimiters, delimiters_length);
+}
+
 size_t
 rcutils_find(const char * str, char delimiter)
 {
@@ -35,13 +417,7 @@ rcutils_findn(const char * str, char delimiter, size_t string_length)
   if (NULL == str || 0 == string_length) {
     return SIZE_MAX;
   }
-
-  for (size_t i = 0; i < string_length; ++i) {
-    if (str[i] == delimiter) {
-      return i;
-    }
-  }
-  return SIZE_MAX;
+  return __find_first(str, string_length, &delimiter, 1);
 }
 
 size_t
@@ -59,20 +435,41 @@ rcutils_find_lastn(const char * str, char delimiter, size_t string_length)
   if (NULL == str || 0 == string_length) {
     return SIZE_MAX;
   }
+  return __find_last(str, string_length, &delimiter, 1);
+}
 
-#if defined(_GNU_SOURCE)
-  const char * ptr = memrchr(str, delimiter, string_length);
-  if (ptr == NULL) {
+size_t
+rcutils_find_any(const char * str, const char * delimiters)
+{
+  if (NULL == str) {
     return SIZE_MAX;
   }
+  return rcutils_find_anyn(str, delimiters, strlen(str));
+}
 
-  return ptr - str;
-#else
-  for (size_t i = string_length - 1; i > 0; --i) {
-    if (str[i] == delimiter) {
-      return i;
-    }
+size_t
+rcutils_find_anyn(const char * str, const char * delimiters, size_t string_length)
+{
+  if (NULL == str || NULL == delimiters || 0 == string_length || '\0' == delimiters[0]) {
+    return SIZE_MAX;
   }
-  return str[0] == delimiter ? 0 : SIZE_MAX;
-#endif
+  return __find_first(str, string_length, delimiters, strlen(delimiters));
+}
+
+size_t
+rcutils_find_last_any(const char * str, const char * delimiters)
+{
+  if (NULL == str) {
+    return SIZE_MAX;
+  }
+  return rcutils_find_last_anyn(str, delimiters, strlen(str));
+}
+
+size_t
+rcutils_find_last_anyn(const char * str, const char * delimiters, size_t string_length)
+{
+  if (NULL == str || NULL == delimiters || 0 == string_length || '\0' == delimiters[0]) {
+    return SIZE_MAX;
+  }
+  return __find_last(str, string_length, delimiters, strlen(delimiters));
 }
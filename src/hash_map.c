@@ -124,14 +124,12 @@ static rcutils_ret_t hash_map_deallocate_map(
     if (NULL != bucket->impl) {
       // if selected then deallocate the memory for the actual entries as well
       if (dealloc_map_entries) {
+        void * bucket_data = NULL;
         size_t bucket_size = 0;
-        ret = rcutils_array_list_get_size(bucket, &bucket_size);
+        ret = rcutils_array_list_get_data(bucket, &bucket_data, &bucket_size);
+        rcutils_hash_map_entry_t ** entries = bucket_data;
         for (size_t b_i = 0; b_i < bucket_size && RCUTILS_RET_OK == ret; ++b_i) {
-          rcutils_hash_map_entry_t * entry;
-          ret = rcutils_array_list_get(bucket, b_i, &entry);
-          if (RCUTILS_RET_OK == ret) {
-            hash_map_deallocate_entry(allocator, entry);
-          }
+          hash_map_deallocate_entry(allocator, entries[b_i]);
         }
       }
 
@@ -193,22 +191,21 @@ static rcutils_ret_t hash_map_check_and_grow_map(rcutils_hash_map_t * hash_map)
       rcutils_array_list_t * bucket = &(hash_map->impl->map[map_index]);
       // Is this a valid bucket with entries
       if (NULL != bucket->impl) {
+        void * bucket_data = NULL;
         size_t bucket_size = 0;
-        ret = rcutils_array_list_get_size(bucket, &bucket_size);
+        ret = rcutils_array_list_get_data(bucket, &bucket_data, &bucket_size);
         if (RCUTILS_RET_OK != ret) {
           return ret;
         }
+        rcutils_hash_map_entry_t ** entries = bucket_data;
 
         for (size_t bucket_index = 0;
           bucket_index < bucket_size && RCUTILS_RET_OK == ret;
           ++bucket_index)
         {
-          rcutils_hash_map_entry_t * entry = NULL;
-          ret = rcutils_array_list_get(bucket, bucket_index, &entry);
-          if (RCUTILS_RET_OK == ret) {
-            size_t new_index = entry->hashed_key % new_capacity;
-            ret = hash_map_insert_entry(new_map, new_index, entry, &hash_map->impl->allocator);
-          }
+          rcutils_hash_map_entry_t * entry = entries[bucket_index];
+          size_t new_index = entry->hashed_key % new_capacity;
+          ret = hash_map_insert_entry(new_map, new_index, entry, &hash_map->impl->allocator);
         }
       }
     }
@@ -335,42 +332,40 @@ rcutils_hash_map_get_size(const rcutils_hash_map_t * hash_map, size_t * size)
 }
 
 /// Returns true if found or false if it doesn't exist.
-/// key_hash and map_index will always be set correctly
-static bool hash_map_find(
+/// map_index will always be set correctly
+static bool hash_map_find_with_hash(
   const rcutils_hash_map_t * hash_map,   // [in] The hash_map to look up in
   const void * key,   // [in] The key to lookup
-  size_t * key_hash,   // [out] The key's hashed value
+  size_t key_hash,   // [in] The key's hashed value
   size_t * map_index,   // [out] The index into the array of buckets
   size_t * bucket_index,   // [out] The index of the entry in its bucket
   rcutils_hash_map_entry_t ** entry)   // [out] Will be set to a pointer to the entry's data
 {
   size_t bucket_size = 0;
-  rcutils_hash_map_entry_t * bucket_entry = NULL;
+  void * bucket_data = NULL;
 
-  *key_hash = hash_map->impl->key_hashing_func(key);
   // The below is equivalent to:
   //
-  // *map_index = (*key_hash) % hash_map->impl->capacity;
+  // *map_index = key_hash % hash_map->impl->capacity;
   //
   // This implementation is significantly faster since it avoids a divide, but
   // only works when the capacity is a power of two.  We enforce that in the
   // rcutils_hash_map_init() function.
-  *map_index = (*key_hash) & (hash_map->impl->capacity - 1);
+  *map_index = key_hash & (hash_map->impl->capacity - 1);
 
   // Find the bucket the entry should be in check that it's valid
   rcutils_array_list_t * bucket = &(hash_map->impl->map[*map_index]);
   if (NULL == bucket->impl) {
     return false;
   }
-  if (RCUTILS_RET_OK != rcutils_array_list_get_size(bucket, &bucket_size)) {
+  if (RCUTILS_RET_OK != rcutils_array_list_get_data(bucket, &bucket_data, &bucket_size)) {
     return false;
   }
+  rcutils_hash_map_entry_t ** bucket_entries = bucket_data;
   for (size_t i = 0; i < bucket_size; ++i) {
-    if (RCUTILS_RET_OK != rcutils_array_list_get(bucket, i, &bucket_entry)) {
-      return false;
-    }
+    rcutils_hash_map_entry_t * bucket_entry = bucket_entries[i];
     // Check that the hashes match first as that will be the quicker comparison to quick fail on
-    if (bucket_entry->hashed_key == *key_hash &&
+    if (bucket_entry->hashed_key == key_hash &&
       (0 == hash_map->impl->key_cmp_func(bucket_entry->key, key)))
     {
       *bucket_index = i;
@@ -382,6 +377,20 @@ static bool hash_map_find(
   return false;
 }
 
+/// Returns true if found or false if it doesn't exist.
+/// key_hash and map_index will always be set correctly
+static bool hash_map_find(
+  const rcutils_hash_map_t * hash_map,   // [in] The hash_map to look up in
+  const void * key,   // [in] The key to lookup
+  size_t * key_hash,   // [out] The key's hashed value
+  size_t * map_index,   // [out] The index into the array of buckets
+  size_t * bucket_index,   // [out] The index of the entry in its bucket
+  rcutils_hash_map_entry_t ** entry)   // [out] Will be set to a pointer to the entry's data
+{
+  *key_hash = hash_map->impl->key_hashing_func(key);
+  return hash_map_find_with_hash(hash_map, key, *key_hash, map_index, bucket_index, entry);
+}
+
 rcutils_ret_t
 rcutils_hash_map_set(rcutils_hash_map_t * hash_map, const void * key, const void * value)
 {
@@ -467,6 +476,8 @@ rcutils_hash_map_unset(rcutils_hash_map_t * hash_map, const void * key)
 
   // Remove the entry from its bucket and deallocate it
   rcutils_array_list_t * bucket = &(hash_map->impl->map[map_index]);
+  // The following entries keep their order, so that unsetting the key given to
+  // rcutils_hash_map_get_next_key_and_data() while iterating doesn't skip any.
   if (RCUTILS_RET_OK == rcutils_array_list_remove(bucket, bucket_index)) {
     hash_map->impl->size--;
     hash_map_deallocate_entry(&hash_map->impl->allocator, entry);
@@ -527,6 +538,29 @@ rcutils_hash_map_get(const rcutils_hash_map_t * hash_map, const void * key, void
   return RCUTILS_RET_NOT_FOUND;
 }
 
+rcutils_ret_t
+rcutils_hash_map_get_with_hash(
+  const rcutils_hash_map_t * hash_map, const void * key, size_t key_hash, void * data)
+{
+  HASH_MAP_VALIDATE_HASH_MAP(hash_map);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(key, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(data, RCUTILS_RET_INVALID_ARGUMENT);
+
+  size_t map_index = 0, bucket_index = 0;
+  rcutils_hash_map_entry_t * entry = NULL;
+
+  if (hash_map->impl->size == 0) {
+    return RCUTILS_RET_NOT_FOUND;
+  }
+
+  if (hash_map_find_with_hash(hash_map, key, key_hash, &map_index, &bucket_index, &entry)) {
+    memcpy(data, entry->value, hash_map->impl->data_size);
+    return RCUTILS_RET_OK;
+  }
+
+  return RCUTILS_RET_NOT_FOUND;
+}
+
 rcutils_ret_t
 rcutils_hash_map_get_next_key_and_data(
   const rcutils_hash_map_t * hash_map,
@@ -564,22 +598,20 @@ rcutils_hash_map_get_next_key_and_data(
   for (; map_index < hash_map->impl->capacity; ++map_index) {
     rcutils_array_list_t * bucket = &(hash_map->impl->map[map_index]);
     if (NULL != bucket->impl) {
+      void * bucket_data = NULL;
       size_t bucket_size = 0;
-      ret = rcutils_array_list_get_size(bucket, &bucket_size);
+      ret = rcutils_array_list_get_data(bucket, &bucket_data, &bucket_size);
       if (RCUTILS_RET_OK != ret) {
         return ret;
       }
+      rcutils_hash_map_entry_t ** bucket_entries = bucket_data;
 
       // Check if the next index in this bucket is valid and if so we've found the next item
       if (bucket_index < bucket_size) {
-        rcutils_hash_map_entry_t * bucket_entry = NULL;
-        ret = rcutils_array_list_get(bucket, bucket_index, &bucket_entry);
-        if (RCUTILS_RET_OK == ret) {
-          memcpy(key, bucket_entry->key, hash_map->impl->key_size);
-          memcpy(data, bucket_entry->value, hash_map->impl->data_size);
-        }
-
-        return ret;
+        rcutils_hash_map_entry_t * bucket_entry = bucket_entries[bucket_index];
+        memcpy(key, bucket_entry->key, hash_map->impl->key_size);
+        memcpy(data, bucket_entry->value, hash_map->impl->data_size);
+        return RCUTILS_RET_OK;
       }
     }
     // After the first bucket the next entry must be at the start of the next bucket with entries
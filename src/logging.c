@@ -44,6 +44,7 @@
 #include "rcutils/format_string.h"
 #include "rcutils/logging.h"
 #include "rcutils/snprintf.h"
+#include "rcutils/stdatomic_helper.h"
 #include "rcutils/strdup.h"
 #include "rcutils/strerror.h"
 #include "rcutils/time.h"
@@ -104,6 +105,8 @@ static bool g_rcutils_logging_severities_map_valid = false;
 static int g_rcutils_logging_default_logger_level = 0;
 
 static FILE * g_output_stream = NULL;
+// The file descriptor of g_output_stream, since fileno() is not async-signal-safe.
+static int g_output_fd = 2;
 
 static enum rcutils_colorized_output g_colorized_output = RCUTILS_COLORIZED_OUTPUT_AUTO;
 
@@ -131,6 +134,81 @@ typedef struct log_msg_part_s
 static size_t g_num_log_msg_handlers = 0;
 static log_msg_part_t g_handlers[1024];
 
+// Statistics counters; these are only ever added to, so no ordering is needed between them.
+static atomic_uint_least64_t g_records[RCUTILS_LOGGING_STATISTICS_SEVERITY_SLOTS];
+static atomic_uint_least64_t g_bytes_emitted = ATOMIC_VAR_INIT(0);
+static atomic_uint_least64_t g_format_failures = ATOMIC_VAR_INIT(0);
+static atomic_uint_least64_t g_handler_latency[RCUTILS_LOGGING_STATISTICS_LATENCY_BUCKETS];
+
+// The suppressed messages are counted on the path of disabled log calls, which must stay cheap
+// when many threads log at once, so each thread counts them in its own shard, and the shards
+// are summed when read.
+// Threads only share a shard once there are more of them than shards.
+#define SUPPRESSED_SHARD_COUNT 64
+
+typedef struct suppressed_shard_s
+{
+  atomic_uint_least64_t counters[RCUTILS_LOGGING_STATISTICS_SEVERITY_SLOTS];
+  // Keep the counters of different shards on different cache lines.
+  char padding[64];
+} suppressed_shard_t;
+
+static suppressed_shard_t g_suppressed[SUPPRESSED_SHARD_COUNT];
+static atomic_uint_least64_t g_next_suppressed_shard = ATOMIC_VAR_INIT(0);
+// The shard of the thread plus one, or 0 until it first counts a suppressed message.
+static RCUTILS_THREAD_LOCAL size_t gtls_suppressed_shard = 0;
+
+static inline void add_to_counter(atomic_uint_least64_t * counter, uint64_t value)
+{
+#ifdef _WIN32
+  // The Windows shim has no explicit memory orders, and its additions are full barriers anyway.
+  (void)rcutils_atomic_fetch_add_uint64_t(counter, value);
+#else
+  (void)atomic_fetch_add_explicit(counter, value, memory_order_relaxed);
+#endif
+}
+
+static inline bool get_severity_slot(int severity, size_t * slot)
+{
+  if (severity < RCUTILS_LOG_SEVERITY_UNSET || severity > RCUTILS_LOG_SEVERITY_FATAL) {
+    return false;
+  }
+  *slot = (size_t)(severity / 10);
+  return true;
+}
+
+static inline void count_record(int severity)
+{
+  size_t slot;
+  if (get_severity_slot(severity, &slot)) {
+    add_to_counter(&g_records[slot], 1);
+  }
+}
+
+static inline void count_suppressed(int severity)
+{
+  size_t slot;
+  if (!get_severity_slot(severity, &slot)) {
+    return;
+  }
+  if (0 == gtls_suppressed_shard) {
+    const uint64_t next_shard = rcutils_atomic_fetch_add_uint64_t(&g_next_suppressed_shard, 1);
+    gtls_suppressed_shard = (size_t)(next_shard % SUPPRESSED_SHARD_COUNT) + 1;
+  }
+  add_to_counter(&g_suppressed[gtls_suppressed_shard - 1].counters[slot], 1);
+}
+
+static inline void count_handler_latency(rcutils_duration_value_t latency)
+{
+  size_t bucket = 0;
+  rcutils_duration_value_t upper_bound = RCUTILS_LOGGING_STATISTICS_LATENCY_FIRST_BUCKET_NS;
+  while (bucket < RCUTILS_LOGGING_STATISTICS_LATENCY_BUCKETS - 1 && latency >= upper_bound) {
+    upper_bound *= 2;
+    ++bucket;
+  }
+  add_to_counter(&g_handler_latency[bucket], 1);
+}
+
 rcutils_ret_t rcutils_logging_initialize(void)
 {
   return rcutils_logging_initialize_with_allocator(rcutils_get_default_allocator());
@@ -196,14 +274,14 @@ static const char * expand_time(
       &logging_input->timestamp, numeric_storage,
       sizeof(numeric_storage)) != RCUTILS_RET_OK)
   {
-    RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
+    RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_c_str());
     rcutils_reset_error();
     RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
     return NULL;
   }
 
   if (rcutils_char_array_strcat(logging_output, numeric_storage) != RCUTILS_RET_OK) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
+    RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_c_str());
     rcutils_reset_error();
     RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
     return NULL;
@@ -268,7 +346,7 @@ static const char * expand_line_number(
     }
 
     if (rcutils_char_array_strcat(logging_output, line_number_expansion) != RCUTILS_RET_OK) {
-      RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
+      RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_c_str());
       rcutils_reset_error();
       RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
       return NULL;
@@ -288,7 +366,7 @@ static const char * expand_severity(
 
   const char * severity_string = g_rcutils_log_severity_names[logging_input->severity];
   if (rcutils_char_array_strcat(logging_output, severity_string) != RCUTILS_RET_OK) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
+    RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_c_str());
     rcutils_reset_error();
     RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
     return NULL;
@@ -307,7 +385,7 @@ static const char * expand_name(
 
   if (NULL != logging_input->name) {
     if (rcutils_char_array_strcat(logging_output, logging_input->name) != RCUTILS_RET_OK) {
-      RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
+      RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_c_str());
       rcutils_reset_error();
       RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
       return NULL;
@@ -326,7 +404,7 @@ static const char * expand_message(
   (void)end_offset;
 
   if (rcutils_char_array_strcat(logging_output, logging_input->msg) != RCUTILS_RET_OK) {
-    RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
+    RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_c_str());
     rcutils_reset_error();
     RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
     return NULL;
@@ -348,7 +426,7 @@ static const char * expand_function_name(
         logging_output,
         logging_input->location->function_name) != RCUTILS_RET_OK)
     {
-      RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
+      RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_c_str());
       rcutils_reset_error();
       RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
       return NULL;
@@ -371,7 +449,7 @@ static const char * expand_file_name(
         logging_output,
         logging_input->location->file_name) != RCUTILS_RET_OK)
     {
-      RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
+      RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_c_str());
       rcutils_reset_error();
       RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
       return NULL;
@@ -422,7 +500,7 @@ static const char * copy_from_orig(
       g_rcutils_logging_output_format_string + start_offset,
       end_offset - start_offset) != RCUTILS_RET_OK)
   {
-    RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
+    RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_c_str());
     rcutils_reset_error();
     RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
     return NULL;
@@ -677,6 +755,11 @@ rcutils_ret_t rcutils_logging_initialize_with_allocator(rcutils_allocator_t allo
         "Invalid return from environment fetch");
       return RCUTILS_RET_ERROR;
   }
+#ifdef _WIN32
+  g_output_fd = _fileno(g_output_stream);
+#else
+  g_output_fd = fileno(g_output_stream);
+#endif
 
   // Allow the user to choose how buffering on the stream works by setting
   // RCUTILS_LOGGING_BUFFERED_STREAM.
@@ -751,7 +834,7 @@ rcutils_ret_t rcutils_logging_initialize_with_allocator(rcutils_allocator_t allo
     // If an error message was set it will have been overwritten by rcutils_hash_map_init.
     RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
       "Failed to initialize map for logger severities [%s]. Severities will not be configurable.",
-      rcutils_get_error_string().str);
+      rcutils_get_error_c_str());
     g_rcutils_logging_severities_map_valid = false;
     return RCUTILS_RET_ERROR;
   }
@@ -783,7 +866,7 @@ rcutils_ret_t rcutils_logging_shutdown(void)
       if (hash_map_ret != RCUTILS_RET_OK) {
         RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
           "Failed to clear out logger severities [%s] during shutdown; memory will be leaked.",
-          rcutils_get_error_string().str);
+          rcutils_get_error_c_str());
         break;
       }
       g_rcutils_logging_allocator.deallocate(key, g_rcutils_logging_allocator.state);
@@ -796,12 +879,13 @@ rcutils_ret_t rcutils_logging_shutdown(void)
     if (hash_map_ret != RCUTILS_RET_OK) {
       RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
         "Failed to finalize map for logger severities: %s",
-        rcutils_get_error_string().str);
+        rcutils_get_error_c_str());
       ret = RCUTILS_RET_LOGGING_SEVERITY_MAP_INVALID;
     }
     g_rcutils_logging_severities_map_valid = false;
   }
   g_num_log_msg_handlers = 0;
+  g_output_fd = 2;
   g_rcutils_logging_initialized = false;
 
   #ifdef _WIN32
@@ -916,17 +1000,20 @@ static rcutils_ret_t add_key_to_hash_map(const char * name, int level, bool set_
   if (hash_map_ret != RCUTILS_RET_OK) {
     RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
       "Error setting severity level for logger named '%s': %s",
-      name, rcutils_get_error_string().str);
+      name, rcutils_get_error_c_str());
     return RCUTILS_RET_ERROR;
   }
 
   return RCUTILS_RET_OK;
 }
 
-static rcutils_ret_t get_severity_level(const char * name, int * severity)
+// The name_hash is optional, if NULL the hash of the name is computed by the hash map.
+static rcutils_ret_t get_severity_level(
+  const char * name, const size_t * name_hash, int * severity)
 {
-  rcutils_ret_t ret =
-    rcutils_hash_map_get(&g_rcutils_logging_severities_map, &name, severity);
+  rcutils_ret_t ret = NULL == name_hash ?
+    rcutils_hash_map_get(&g_rcutils_logging_severities_map, &name, severity) :
+    rcutils_hash_map_get_with_hash(&g_rcutils_logging_severities_map, &name, *name_hash, severity);
   if (ret != RCUTILS_RET_OK) {
     // One possible response is RCUTILS_RET_NOT_FOUND, but the higher layers may be OK with that.
     return ret;
@@ -962,7 +1049,7 @@ int rcutils_logging_get_logger_leveln(const char * name, size_t name_length)
   }
 
   int severity;
-  rcutils_ret_t ret = get_severity_level(short_name, &severity);
+  rcutils_ret_t ret = get_severity_level(short_name, NULL, &severity);
   g_rcutils_logging_allocator.deallocate(short_name, g_rcutils_logging_allocator.state);
   if (ret != RCUTILS_RET_OK) {
     // The error message was already set by get_severity_level
@@ -972,20 +1059,15 @@ int rcutils_logging_get_logger_leveln(const char * name, size_t name_length)
   return severity;
 }
 
-int rcutils_logging_get_logger_effective_level(const char * name)
+static int get_logger_effective_level(const char * name, const size_t * name_hash)
 {
-  RCUTILS_LOGGING_AUTOINIT;
-  if (NULL == name) {
-    return -1;
-  }
-
   size_t hash_map_size;
   rcutils_ret_t hash_map_ret = rcutils_hash_map_get_size(
     &g_rcutils_logging_severities_map, &hash_map_size);
   if (hash_map_ret != RCUTILS_RET_OK) {
     RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
       "Error getting severity level for logger named '%s': %s",
-      name, rcutils_get_error_string().str);
+      name, rcutils_get_error_c_str());
     return -1;
   }
 
@@ -1002,7 +1084,7 @@ int rcutils_logging_get_logger_effective_level(const char * name)
 
   // Start by trying to find the exact name.
   int severity;
-  rcutils_ret_t ret = get_severity_level(name, &severity);
+  rcutils_ret_t ret = get_severity_level(name, name_hash, &severity);
   if (ret == RCUTILS_RET_OK) {
     if (severity != RCUTILS_LOG_SEVERITY_UNSET) {
       return severity;
@@ -1041,7 +1123,7 @@ int rcutils_logging_get_logger_effective_level(const char * name)
     // Shorten the substring to be the name of the ancestor (excluding the separator).
     tmp_name[index_last_separator] = '\0';
 
-    rcutils_ret_t ret = get_severity_level(tmp_name, &severity);
+    rcutils_ret_t ret = get_severity_level(tmp_name, NULL, &severity);
     if (ret == RCUTILS_RET_OK) {
       if (severity != RCUTILS_LOG_SEVERITY_UNSET) {
         break;
@@ -1078,6 +1160,24 @@ int rcutils_logging_get_logger_effective_level(const char * name)
   return severity;
 }
 
+int rcutils_logging_get_logger_effective_level(const char * name)
+{
+  RCUTILS_LOGGING_AUTOINIT;
+  if (NULL == name) {
+    return -1;
+  }
+  return get_logger_effective_level(name, NULL);
+}
+
+int rcutils_logging_get_logger_effective_level_with_hash(const char * name, size_t name_hash)
+{
+  RCUTILS_LOGGING_AUTOINIT;
+  if (NULL == name) {
+    return -1;
+  }
+  return get_logger_effective_level(name, &name_hash);
+}
+
 rcutils_ret_t rcutils_logging_set_logger_level(const char * name, int level)
 {
   RCUTILS_LOGGING_AUTOINIT;
@@ -1145,7 +1245,7 @@ rcutils_ret_t rcutils_logging_set_logger_level(const char * name, int level)
       {
         RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
           "Error accessing hash map when setting logger level for '%s': %s",
-          name, rcutils_get_error_string().str);
+          name, rcutils_get_error_c_str());
         return hash_map_ret;
       }
 
@@ -1158,7 +1258,7 @@ rcutils_ret_t rcutils_logging_set_logger_level(const char * name, int level)
           // error and return.
           RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
             "Error clearing old severity level for logger named '%s': %s",
-            name, rcutils_get_error_string().str);
+            name, rcutils_get_error_c_str());
           return unset_ret;
         }
         g_rcutils_logging_allocator.deallocate(previous_key, g_rcutils_logging_allocator.state);
@@ -1170,7 +1270,7 @@ rcutils_ret_t rcutils_logging_set_logger_level(const char * name, int level)
   if (add_key_ret != RCUTILS_RET_OK) {
     RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
       "Error setting severity level for logger named '%s': %s",
-      name, rcutils_get_error_string().str);
+      name, rcutils_get_error_c_str());
   }
 
   if (name_length == 0) {
@@ -1181,12 +1281,12 @@ rcutils_ret_t rcutils_logging_set_logger_level(const char * name, int level)
   return add_key_ret;
 }
 
-bool rcutils_logging_logger_is_enabled_for(const char * name, int severity)
+static bool logger_is_enabled_for(const char * name, const size_t * name_hash, int severity)
 {
   RCUTILS_LOGGING_AUTOINIT;
   int logger_level = g_rcutils_logging_default_logger_level;
   if (name) {
-    logger_level = rcutils_logging_get_logger_effective_level(name);
+    logger_level = get_logger_effective_level(name, name_hash);
     if (-1 == logger_level) {
       RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
         "Error determining if logger '%s' is enabled for severity '%d'\n",
@@ -1194,7 +1294,22 @@ bool rcutils_logging_logger_is_enabled_for(const char * name, int severity)
       return false;
     }
   }
-  return severity >= logger_level;
+  if (severity < logger_level) {
+    count_suppressed(severity);
+    return false;
+  }
+  return true;
+}
+
+bool rcutils_logging_logger_is_enabled_for(const char * name, int severity)
+{
+  return logger_is_enabled_for(name, NULL, severity);
+}
+
+bool rcutils_logging_logger_is_enabled_for_with_hash(
+  const char * name, size_t name_hash, int severity)
+{
+  return logger_is_enabled_for(name, &name_hash, severity);
 }
 
 static void vrcutils_log_internal(
@@ -1207,9 +1322,16 @@ static void vrcutils_log_internal(
     RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to get timestamp while doing a console logging.\n");
     return;
   }
+  count_record(severity);
   rcutils_logging_output_handler_t output_handler = g_rcutils_logging_output_handler;
   if (output_handler != NULL) {
+    rcutils_time_point_value_t handler_start;
+    rcutils_time_point_value_t handler_end;
+    bool is_timed = rcutils_steady_time_now(&handler_start) == RCUTILS_RET_OK;
     (*output_handler)(location, severity, name ? name : "", now, format, args);
+    if (is_timed && rcutils_steady_time_now(&handler_end) == RCUTILS_RET_OK) {
+      count_handler_latency(handler_end - handler_start);
+    }
   }
 }
 
@@ -1237,6 +1359,268 @@ void rcutils_log_internal(
   va_end(args);
 }
 
+// A fixed size output buffer for rcutils_log_signal_safe(), which silently truncates.
+typedef struct signal_safe_buffer_s
+{
+  char data[RCUTILS_LOGGING_SIGNAL_SAFE_MAX_MESSAGE_LENGTH];
+  size_t length;
+} signal_safe_buffer_t;
+
+static void signal_safe_append(signal_safe_buffer_t * buffer, const char * str, size_t length)
+{
+  // Keep the last byte for the newline.
+  size_t available = sizeof(buffer->data) - 1 - buffer->length;
+  if (length > available) {
+    length = available;
+  }
+  memcpy(buffer->data + buffer->length, str, length);
+  buffer->length += length;
+}
+
+// Append at most max_length characters of a string, which needn't be null terminated past them.
+static void signal_safe_append_string(
+  signal_safe_buffer_t * buffer, const char * str, size_t max_length)
+{
+  if (NULL == str) {
+    str = "(null)";
+  }
+  size_t length = 0;
+  while (length < max_length && '\0' != str[length]) {
+    ++length;
+  }
+  signal_safe_append(buffer, str, length);
+}
+
+static void signal_safe_append_unsigned(
+  signal_safe_buffer_t * buffer, uintmax_t value, unsigned int base, bool upper_case)
+{
+  const char * digits = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+  char reversed[sizeof(uintmax_t) * 8];
+  size_t length = 0;
+  do {
+    reversed[length++] = digits[value % base];
+    value /= base;
+  } while (0 != value);
+  char str[sizeof(reversed)];
+  for (size_t i = 0; i < length; ++i) {
+    str[i] = reversed[length - 1 - i];
+  }
+  signal_safe_append(buffer, str, length);
+}
+
+static void signal_safe_append_signed(signal_safe_buffer_t * buffer, intmax_t value)
+{
+  if (value < 0) {
+    signal_safe_append(buffer, "-", 1);
+    // Negate in unsigned arithmetic to support INTMAX_MIN.
+    signal_safe_append_unsigned(buffer, (uintmax_t)0 - (uintmax_t)value, 10, false);
+  } else {
+    signal_safe_append_unsigned(buffer, (uintmax_t)value, 10, false);
+  }
+}
+
+// A minimal printf-like formatter, see rcutils_log_signal_safe() for what it supports.
+static void signal_safe_format(
+  signal_safe_buffer_t * buffer, const char * format, va_list * args)
+{
+  while ('\0' != *format) {
+    const char * conversion_start = format;
+    if ('%' != *format) {
+      const char * next = strchr(format, '%');
+      size_t length = NULL == next ? strlen(format) : (size_t)(next - format);
+      signal_safe_append(buffer, format, length);
+      format += length;
+      continue;
+    }
+    ++format;
+    while ('\0' != *format && NULL != strchr("-+ #0'", *format)) {
+      ++format;
+    }
+    // Field width and precision, which may consume int arguments.
+    // Only the precision is used, to bound the length of strings, and SIZE_MAX means none.
+    size_t precision = SIZE_MAX;
+    for (int field = 0; field < 2; ++field) {
+      if (1 == field) {
+        if ('.' != *format) {
+          break;
+        }
+        ++format;
+        precision = 0;
+      }
+      if ('*' == *format) {
+        int value = va_arg(*args, int);
+        if (1 == field) {
+          // A negative precision is taken as if it were omitted.
+          precision = value < 0 ? SIZE_MAX : (size_t)value;
+        }
+        ++format;
+      } else {
+        while (*format >= '0' && *format <= '9') {
+          if (1 == field && precision < SIZE_MAX / 10) {
+            precision = precision * 10 + (size_t)(*format - '0');
+          }
+          ++format;
+        }
+      }
+    }
+    char length = '\0';
+    if ('h' == *format || 'l' == *format) {
+      length = *(format++);
+      if (length == *format) {
+        // Upper case marks the doubled hh and ll modifiers.
+        length = 'h' == length ? 'H' : 'L';
+        ++format;
+      }
+    } else if ('j' == *format || 'z' == *format || 't' == *format) {
+      length = *(format++);
+    }
+    switch (*format) {
+      case 'd':
+      case 'i':
+        {
+          intmax_t value;
+          if ('l' == length) {
+            value = va_arg(*args, long);  // NOLINT(runtime/int)
+          } else if ('L' == length) {
+            value = va_arg(*args, long long);  // NOLINT(runtime/int)
+          } else if ('j' == length) {
+            value = va_arg(*args, intmax_t);
+          } else if ('z' == length || 't' == length) {
+            value = va_arg(*args, ptrdiff_t);
+          } else {
+            value = va_arg(*args, int);
+          }
+          signal_safe_append_signed(buffer, value);
+        }
+        break;
+      case 'u':
+      case 'x':
+      case 'X':
+        {
+          uintmax_t value;
+          if ('l' == length) {
+            value = va_arg(*args, unsigned long);  // NOLINT(runtime/int)
+          } else if ('L' == length) {
+            value = va_arg(*args, unsigned long long);  // NOLINT(runtime/int)
+          } else if ('j' == length) {
+            value = va_arg(*args, uintmax_t);
+          } else if ('z' == length || 't' == length) {
+            value = va_arg(*args, size_t);
+          } else {
+            value = va_arg(*args, unsigned int);
+          }
+          signal_safe_append_unsigned(buffer, value, 'u' == *format ? 10 : 16, 'X' == *format);
+        }
+        break;
+      case 'c':
+        {
+          char c = (char)va_arg(*args, int);
+          signal_safe_append(buffer, &c, 1);
+        }
+        break;
+      case 's':
+        signal_safe_append_string(buffer, va_arg(*args, const char *), precision);
+        break;
+      case 'p':
+        signal_safe_append(buffer, "0x", 2);
+        signal_safe_append_unsigned(buffer, (uintptr_t)va_arg(*args, void *), 16, false);
+        break;
+      case '%':
+        signal_safe_append(buffer, "%", 1);
+        break;
+      default:
+        // The arguments can't be consumed past an unknown conversion, so stop formatting.
+        signal_safe_append_string(buffer, conversion_start, SIZE_MAX);
+        return;
+    }
+    ++format;
+  }
+}
+
+rcutils_ret_t rcutils_log_signal_safe(int severity, const char * name, const char * format, ...)
+{
+  if (NULL == format || severity < RCUTILS_LOG_SEVERITY_DEBUG ||
+    severity > RCUTILS_LOG_SEVERITY_FATAL || NULL == g_rcutils_log_severity_names[severity])
+  {
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  int logger_level = g_rcutils_logging_initialized ?
+    g_rcutils_logging_default_logger_level : RCUTILS_DEFAULT_LOGGER_DEFAULT_LEVEL;
+  if (severity < logger_level) {
+    return RCUTILS_RET_OK;
+  }
+
+  signal_safe_buffer_t buffer;
+  buffer.length = 0;
+  signal_safe_append(&buffer, "[", 1);
+  signal_safe_append_string(&buffer, g_rcutils_log_severity_names[severity], SIZE_MAX);
+  signal_safe_append(&buffer, "] [", 3);
+  signal_safe_append_string(&buffer, NULL == name ? "" : name, SIZE_MAX);
+  signal_safe_append(&buffer, "]: ", 3);
+  va_list args;
+  va_start(args, format);
+  signal_safe_format(&buffer, format, &args);
+  va_end(args);
+  buffer.data[buffer.length++] = '\n';
+
+  int saved_errno = errno;
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  size_t written = 0;
+  while (written < buffer.length) {
+#ifdef _WIN32
+    int result = _write(
+      g_output_fd, buffer.data + written, (unsigned int)(buffer.length - written));
+#else
+    ssize_t result = write(g_output_fd, buffer.data + written, buffer.length - written);
+#endif
+    if (result < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      ret = RCUTILS_RET_ERROR;
+      break;
+    }
+    written += (size_t)result;
+  }
+  errno = saved_errno;
+  return ret;
+}
+
+void rcutils_logging_autoinit_with_allocator(
+  rcutils_allocator_t allocator, const char * file, size_t line)
+{
+  if (g_rcutils_logging_initialized) {
+    return;
+  }
+  if (rcutils_logging_initialize_with_allocator(allocator) != RCUTILS_RET_OK) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
+      "[rcutils|%s:%zu] error initializing logging: ", file, line);
+    RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_c_str());
+    RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+    rcutils_reset_error();
+  }
+}
+
+bool rcutils_logging_throttle_is_due(
+  rcutils_ret_t time_ret,
+  rcutils_time_point_value_t now,
+  rcutils_duration_value_t duration,
+  rcutils_time_point_value_t * last_logged,
+  const rcutils_log_location_t * location)
+{
+  if (RCUTILS_UNLIKELY(time_ret != RCUTILS_RET_OK)) {
+    rcutils_log(
+      location, RCUTILS_LOG_SEVERITY_ERROR, "",
+      "%s() at %s:%zu getting current steady time failed\n",
+      location->function_name, location->file_name, location->line_number);
+    // Let the message through, as if the throttle interval had elapsed.
+  } else if (now < *last_logged + duration) {
+    return false;
+  }
+  *last_logged = now;
+  return true;
+}
+
 rcutils_ret_t rcutils_logging_format_message(
   const rcutils_log_location_t * location,
   int severity, const char * name, rcutils_time_point_value_t timestamp,
@@ -1255,6 +1639,7 @@ rcutils_ret_t rcutils_logging_format_message(
         &logging_input, logging_output,
         g_handlers[i].start_offset, g_handlers[i].end_offset) == NULL)
     {
+      add_to_counter(&g_format_failures, 1);
       return RCUTILS_RET_ERROR;
     }
   }
@@ -1430,6 +1815,7 @@ void rcutils_logging_console_output_handler(
   if (RCUTILS_RET_OK == status) {
     status = rcutils_char_array_vsprintf(&msg_array, format, *args);
     if (RCUTILS_RET_OK != status) {
+      add_to_counter(&g_format_failures, 1);
       RCUTILS_SAFE_FWRITE_TO_STDERR_WITH_FORMAT_STRING(
         "Error: rcutils_char_array_vsprintf failed with: %d\n", status);
     }
@@ -1448,7 +1834,10 @@ void rcutils_logging_console_output_handler(
   SET_STANDARD_COLOR_IN_BUFFER(is_colorized, status, output_array)
 
   if (RCUTILS_RET_OK == status) {
-    fprintf(g_output_stream, "%s\n", output_array.buffer);
+    int written = fprintf(g_output_stream, "%s\n", output_array.buffer);
+    if (written > 0) {
+      add_to_counter(&g_bytes_emitted, (uint64_t)written);
+    }
   }
 
   // Only does something in windows
@@ -1464,3 +1853,38 @@ void rcutils_logging_console_output_handler(
     RCUTILS_SAFE_FWRITE_TO_STDERR("Failed to fini array.\n");
   }
 }
+
+rcutils_ret_t rcutils_logging_get_statistics(rcutils_logging_statistics_t * statistics)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(statistics, RCUTILS_RET_INVALID_ARGUMENT);
+
+  for (size_t i = 0; i < RCUTILS_LOGGING_STATISTICS_SEVERITY_SLOTS; ++i) {
+    statistics->records[i] = rcutils_atomic_load_uint64_t(&g_records[i]);
+    statistics->suppressed[i] = 0;
+    for (size_t j = 0; j < SUPPRESSED_SHARD_COUNT; ++j) {
+      statistics->suppressed[i] += rcutils_atomic_load_uint64_t(&g_suppressed[j].counters[i]);
+    }
+  }
+  statistics->bytes_emitted = rcutils_atomic_load_uint64_t(&g_bytes_emitted);
+  statistics->format_failures = rcutils_atomic_load_uint64_t(&g_format_failures);
+  for (size_t i = 0; i < RCUTILS_LOGGING_STATISTICS_LATENCY_BUCKETS; ++i) {
+    statistics->handler_latency[i] = rcutils_atomic_load_uint64_t(&g_handler_latency[i]);
+  }
+
+  return RCUTILS_RET_OK;
+}
+
+void rcutils_logging_reset_statistics(void)
+{
+  for (size_t i = 0; i < RCUTILS_LOGGING_STATISTICS_SEVERITY_SLOTS; ++i) {
+    rcutils_atomic_store(&g_records[i], 0);
+    for (size_t j = 0; j < SUPPRESSED_SHARD_COUNT; ++j) {
+      rcutils_atomic_store(&g_suppressed[j].counters[i], 0);
+    }
+  }
+  rcutils_atomic_store(&g_bytes_emitted, 0);
+  rcutils_atomic_store(&g_format_failures, 0);
+  for (size_t i = 0; i < RCUTILS_LOGGING_STATISTICS_LATENCY_BUCKETS; ++i) {
+    rcutils_atomic_store(&g_handler_latency[i], 0);
+  }
+}
@@ -0,0 +1,395 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rcutils/mapped_file.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+// When building with MSVC 19.28.29333.0 on Windows 10 (as of 2020-11-11),
+// there appears to be a problem with winbase.h (which is included by
+// Windows.h).  In particular, warnings of the form:
+//
+// warning C5105: macro expansion producing 'defined' has undefined behavior
+//
+// See https://developercommunity.visualstudio.com/content/problem/695656/wdk-and-sdk-are-not-compatible-with-experimentalpr.html
+// for more information.  For now disable that warning when including windows.h
+#pragma warning(push)
+#pragma warning(disable : 5105)
+#include <windows.h>
+#pragma warning(pop)
+#include <fcntl.h>
+#include <io.h>
+#endif  // _WIN32
+
+#include "rcutils/error_handling.h"
+#include "rcutils/strerror.h"
+
+#if defined(__linux__) && !defined(MADV_POPULATE_READ)
+// Older C libraries don't define it, but the kernel may still support it, since Linux 5.14.
+# define MADV_POPULATE_READ 22
+#endif
+
+// Files which can't be mapped, and don't tell their size, are read with a buffer starting
+// this large, and doubled as needed.
+#define RCUTILS_MAPPED_FILE_READ_SIZE ((size_t)64 * 1024)
+
+static void set_file_error_msg(const char * message, const char * file_path)
+{
+  char error_string[1024];
+  rcutils_strerror(error_string, sizeof(error_string));
+  RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("%s '%s': %s", message, file_path, error_string);
+}
+
+static size_t get_page_size(void)
+{
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return (size_t)info.dwPageSize;
+#else
+  long page_size = sysconf(_SC_PAGESIZE);
+  return page_size > 0 ? (size_t)page_size : 4096u;
+#endif
+}
+
+rcutils_mapped_file_t
+rcutils_get_zero_initialized_mapped_file(void)
+{
+  static rcutils_mapped_file_t mapped_file = {0};
+  return mapped_file;
+}
+
+// Map the whole file, or return RCUTILS_RET_NOT_FOUND if it can't be, like pipes, empty
+// files, and files of special file systems which report an empty size.
+// The size of the file is returned in file_size when known, or 0.
+static rcutils_ret_t map_file(
+  rcutils_mapped_file_t * file, int fd, const char * file_path, uint32_t flags,
+  uint64_t * file_size)
+{
+  *file_size = 0;
+#ifdef _WIN32
+  struct _stat64 stat_buffer;
+  if (0 != _fstat64(fd, &stat_buffer) || !(stat_buffer.st_mode & _S_IFREG) ||
+    stat_buffer.st_size <= 0)
+  {
+    return RCUTILS_RET_NOT_FOUND;
+  }
+#else
+  struct stat stat_buffer;
+  if (0 != fstat(fd, &stat_buffer) || !S_ISREG(stat_buffer.st_mode) || stat_buffer.st_size <= 0) {
+    return RCUTILS_RET_NOT_FOUND;
+  }
+#endif
+  *file_size = (uint64_t)stat_buffer.st_size;
+  if (*file_size > SIZE_MAX) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "File '%s' is too large to fit in memory", file_path);
+    return RCUTILS_RET_ERROR;
+  }
+  const size_t size = (size_t)*file_size;
+
+#ifdef _WIN32
+  HANDLE mapping = CreateFileMapping(
+    (HANDLE)_get_osfhandle(fd), NULL, PAGE_READONLY, 0, 0, NULL);
+  if (NULL == mapping) {
+    return RCUTILS_RET_NOT_FOUND;
+  }
+  // The view keeps the mapping alive until it is unmapped.
+  void * data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (NULL == data) {
+    return RCUTILS_RET_NOT_FOUND;
+  }
+#else
+  int mmap_flags = MAP_PRIVATE;
+# ifdef MAP_POPULATE
+  // With huge pages, the pages are only read once the mapping is advised to use them.
+  if ((flags & RCUTILS_MAPPED_FILE_POPULATE) && !(flags & RCUTILS_MAPPED_FILE_HUGE_PAGES)) {
+    mmap_flags |= MAP_POPULATE;
+  }
+# endif
+  void * data = mmap(NULL, size, PROT_READ, mmap_flags, fd, 0);
+  if (MAP_FAILED == data) {
+    return RCUTILS_RET_NOT_FOUND;
+  }
+# ifdef MADV_HUGEPAGE
+  if (flags & RCUTILS_MAPPED_FILE_HUGE_PAGES) {
+    (void)madvise(data, size, MADV_HUGEPAGE);
+  }
+# endif
+#endif
+
+  file->data = (const uint8_t *)data;
+  file->size = size;
+  file->is_mapped = true;
+
+#if defined(_WIN32) || !defined(MAP_POPULATE)
+  const bool populated = false;
+#else
+  const bool populated = !(flags & RCUTILS_MAPPED_FILE_HUGE_PAGES);
+#endif
+  if ((flags & RCUTILS_MAPPED_FILE_POPULATE) && !populated) {
+    rcutils_ret_t ret = rcutils_mapped_file_prefetch(file, 0, 0);
+    if (RCUTILS_RET_OK != ret) {
+      rcutils_ret_t close_ret = rcutils_mapped_file_close(file);
+      (void)close_ret;
+      return ret;
+    }
+  }
+  return RCUTILS_RET_OK;
+}
+
+// Read the whole file into the contents of the mapped file.
+static rcutils_ret_t read_file(
+  rcutils_mapped_file_t * file, int fd, const char * file_path, uint64_t file_size,
+  const rcutils_allocator_t * allocator)
+{
+  // One more byte than the size is read, to find the end of the file without growing.
+  size_t capacity = file_size > 0 ? (size_t)file_size + 1 : RCUTILS_MAPPED_FILE_READ_SIZE;
+  rcutils_ret_t ret = rcutils_uint8_array_init(&file->contents, capacity, allocator);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+
+  size_t length = 0;
+  for (;;) {
+    if (length == capacity) {
+      if (capacity > SIZE_MAX / 2) {
+        RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "File '%s' is too large to fit in memory", file_path);
+        ret = RCUTILS_RET_ERROR;
+        break;
+      }
+      capacity *= 2;
+      ret = rcutils_uint8_array_resize(&file->contents, capacity);
+      if (RCUTILS_RET_OK != ret) {
+        break;
+      }
+    }
+    size_t read_size = capacity - length;
+#ifdef _WIN32
+    if (read_size > INT_MAX) {
+      read_size = INT_MAX;
+    }
+    int result = _read(fd, file->contents.buffer + length, (unsigned int)read_size);
+#else
+    ssize_t result = read(fd, file->contents.buffer + length, read_size);
+    if (result < 0 && EINTR == errno) {
+      continue;
+    }
+#endif
+    if (result < 0) {
+      set_file_error_msg("Failed to read file", file_path);
+      ret = RCUTILS_RET_ERROR;
+      break;
+    }
+    if (0 == result) {
+      break;
+    }
+    length += (size_t)result;
+  }
+
+  if (RCUTILS_RET_OK != ret) {
+    if (NULL != file->contents.buffer) {
+      rcutils_ret_t fini_ret = rcutils_uint8_array_fini(&file->contents);
+      (void)fini_ret;
+    }
+    file->contents = rcutils_get_zero_initialized_uint8_array();
+    return ret;
+  }
+  file->contents.buffer_length = length;
+  file->data = length > 0 ? file->contents.buffer : NULL;
+  file->size = length;
+  file->is_mapped = false;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_mapped_file_open(
+  rcutils_mapped_file_t * file,
+  const char * file_path,
+  uint32_t flags,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file_path, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator is invalid", return RCUTILS_RET_INVALID_ARGUMENT);
+  if (file->is_mapped || NULL != file->contents.buffer) {
+    RCUTILS_SET_ERROR_MSG("file is already open");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+#ifdef _WIN32
+  int fd = _open(file_path, _O_RDONLY | _O_BINARY);
+#else
+  int fd = open(file_path, O_RDONLY | O_CLOEXEC);
+#endif
+  if (fd < 0) {
+    set_file_error_msg("Failed to open file", file_path);
+    return RCUTILS_RET_ERROR;
+  }
+
+  uint64_t file_size = 0;
+  rcutils_ret_t ret = map_file(file, fd, file_path, flags, &file_size);
+  if (RCUTILS_RET_NOT_FOUND == ret) {
+    ret = read_file(file, fd, file_path, file_size, allocator);
+  }
+
+#ifdef _WIN32
+  _close(fd);
+#else
+  close(fd);
+#endif
+  return ret;
+}
+
+// Get the range of whole pages holding the given range of a mapped file.
+static rcutils_ret_t get_page_range(
+  const rcutils_mapped_file_t * file, size_t offset, size_t length,
+  size_t * begin, size_t * end)
+{
+  if (offset > file->size) {
+    RCUTILS_SET_ERROR_MSG("offset is past the end of the file");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (0 == length || length > file->size - offset) {
+    length = file->size - offset;
+  }
+  const size_t page_size = get_page_size();
+  *begin = offset - offset % page_size;
+  *end = offset + length;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_mapped_file_advise(
+  rcutils_mapped_file_t * file,
+  size_t offset,
+  size_t length,
+  rcutils_mapped_file_advice_t advice)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file, RCUTILS_RET_INVALID_ARGUMENT);
+  size_t begin = 0;
+  size_t end = 0;
+  rcutils_ret_t ret = get_page_range(file, offset, length, &begin, &end);
+  if (RCUTILS_RET_OK != ret || !file->is_mapped || begin == end) {
+    return ret;
+  }
+
+#ifdef _WIN32
+  (void)advice;
+#else
+  int madvise_advice = MADV_NORMAL;
+  switch (advice) {
+    case RCUTILS_MAPPED_FILE_ADVICE_NORMAL:
+      madvise_advice = MADV_NORMAL;
+      break;
+    case RCUTILS_MAPPED_FILE_ADVICE_SEQUENTIAL:
+      madvise_advice = MADV_SEQUENTIAL;
+      break;
+    case RCUTILS_MAPPED_FILE_ADVICE_RANDOM:
+      madvise_advice = MADV_RANDOM;
+      break;
+    case RCUTILS_MAPPED_FILE_ADVICE_WILL_NEED:
+      madvise_advice = MADV_WILLNEED;
+      break;
+    case RCUTILS_MAPPED_FILE_ADVICE_DONT_NEED:
+      madvise_advice = MADV_DONTNEED;
+      break;
+    default:
+      RCUTILS_SET_ERROR_MSG("advice is invalid");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (0 != madvise((void *)(file->data + begin), end - begin, madvise_advice)) {
+    char error_string[1024];
+    rcutils_strerror(error_string, sizeof(error_string));
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Failed to advise mapped file: %s", error_string);
+    return RCUTILS_RET_ERROR;
+  }
+#endif
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_mapped_file_prefetch(rcutils_mapped_file_t * file, size_t offset, size_t length)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file, RCUTILS_RET_INVALID_ARGUMENT);
+  size_t begin = 0;
+  size_t end = 0;
+  rcutils_ret_t ret = get_page_range(file, offset, length, &begin, &end);
+  if (RCUTILS_RET_OK != ret || !file->is_mapped || begin == end) {
+    return ret;
+  }
+
+#ifdef __linux__
+  // The kernel reads and maps the pages in one call, rather than on a fault for each.
+  if (0 == madvise((void *)(file->data + begin), end - begin, MADV_POPULATE_READ)) {
+    return RCUTILS_RET_OK;
+  }
+  // EINVAL is returned by kernels which don't support it.
+  if (EINVAL != errno) {
+    char error_string[1024];
+    rcutils_strerror(error_string, sizeof(error_string));
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Failed to prefetch mapped file: %s", error_string);
+    return RCUTILS_RET_ERROR;
+  }
+#endif
+  const size_t page_size = get_page_size();
+  const volatile uint8_t * data = file->data;
+  for (size_t position = begin; position < end; position += page_size) {
+    (void)data[position];
+  }
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_mapped_file_close(rcutils_mapped_file_t * file)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file, RCUTILS_RET_INVALID_ARGUMENT);
+
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  if (file->is_mapped) {
+#ifdef _WIN32
+    if (!UnmapViewOfFile(file->data)) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Failed to unmap file. Error code: %lu", GetLastError());
+      return RCUTILS_RET_ERROR;
+    }
+#else
+    if (0 != munmap((void *)file->data, file->size)) {
+      char error_string[1024];
+      rcutils_strerror(error_string, sizeof(error_string));
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("Failed to unmap file: %s", error_string);
+      return RCUTILS_RET_ERROR;
+    }
+#endif
+  } else if (NULL != file->contents.buffer) {
+    ret = rcutils_uint8_array_fini(&file->contents);
+    if (RCUTILS_RET_OK != ret) {
+      return ret;
+    }
+  }
+
+  *file = rcutils_get_zero_initialized_mapped_file();
+  return ret;
+}
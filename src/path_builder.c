@@ -0,0 +1,370 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rcutils/path_builder.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "rcutils/error_handling.h"
+
+#ifdef _WIN32
+# define RCUTILS_PATH_DELIMITER '\\'
+#else
+# define RCUTILS_PATH_DELIMITER '/'
+#endif
+
+#define RCUTILS_CHECK_PATH_BUILDER(builder) \
+  do { \
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(builder, RCUTILS_RET_INVALID_ARGUMENT); \
+    RCUTILS_CHECK_ALLOCATOR_WITH_MSG( \
+      &(builder)->allocator, "path builder is not initialized", \
+      return RCUTILS_RET_INVALID_ARGUMENT); \
+  } while (0)
+
+static inline bool
+is_separator(char c)
+{
+#ifdef _WIN32
+  return '/' == c || '\\' == c;
+#else
+  return '/' == c;
+#endif
+}
+
+static inline char *
+get_buffer(rcutils_path_builder_t * builder)
+{
+  return NULL != builder->allocated_buffer ? builder->allocated_buffer : builder->inline_buffer;
+}
+
+// Return the length of the root of a path, like `/`, or `C:\` on Windows, which is kept when
+// popping or normalizing.
+// The length of its drive prefix, like `C:`, is returned in prefix_length.
+static size_t
+get_root_length(const char * path, size_t length, size_t * prefix_length)
+{
+  size_t prefix = 0;
+#ifdef _WIN32
+  if (length >= 2 && ':' == path[1] &&
+    (('a' <= path[0] && path[0] <= 'z') || ('A' <= path[0] && path[0] <= 'Z')))
+  {
+    prefix = 2;
+  }
+#endif
+  size_t root = prefix;
+  while (root < length && is_separator(path[root])) {
+    ++root;
+  }
+  *prefix_length = prefix;
+  return root;
+}
+
+rcutils_path_builder_t
+rcutils_get_zero_initialized_path_builder(void)
+{
+  static rcutils_path_builder_t builder = {0};
+  return builder;
+}
+
+rcutils_ret_t
+rcutils_path_builder_init(
+  rcutils_path_builder_t * builder,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(builder, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator is invalid", return RCUTILS_RET_INVALID_ARGUMENT);
+
+  builder->length = 0;
+  builder->capacity = 0;
+  builder->allocated_buffer = NULL;
+  builder->inline_buffer[0] = '\0';
+  builder->allocator = *allocator;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_path_builder_fini(rcutils_path_builder_t * builder)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(builder, RCUTILS_RET_INVALID_ARGUMENT);
+
+  if (NULL != builder->allocated_buffer) {
+    builder->allocator.deallocate(builder->allocated_buffer, builder->allocator.state);
+  }
+  *builder = rcutils_get_zero_initialized_path_builder();
+  return RCUTILS_RET_OK;
+}
+
+const char *
+rcutils_path_builder_get_path(const rcutils_path_builder_t * builder)
+{
+  if (NULL == builder) {
+    return NULL;
+  }
+  return NULL != builder->allocated_buffer ? builder->allocated_buffer : builder->inline_buffer;
+}
+
+rcutils_ret_t
+rcutils_path_builder_reserve(rcutils_path_builder_t * builder, size_t length)
+{
+  RCUTILS_CHECK_PATH_BUILDER(builder);
+  if (length >= SIZE_MAX / 2) {
+    RCUTILS_SET_ERROR_MSG("path is too long");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+
+  const size_t size = length + 1;
+  if (NULL == builder->allocated_buffer) {
+    if (size <= RCUTILS_PATH_BUILDER_INLINE_SIZE) {
+      return RCUTILS_RET_OK;
+    }
+  } else if (size <= builder->capacity) {
+    return RCUTILS_RET_OK;
+  }
+
+  // Grow geometrically, so that pushing components one at a time stays linear.
+  size_t capacity = NULL == builder->allocated_buffer ?
+    2 * RCUTILS_PATH_BUILDER_INLINE_SIZE : 2 * builder->capacity;
+  if (capacity < size) {
+    capacity = size;
+  }
+  char * buffer = NULL == builder->allocated_buffer ?
+    (char *)builder->allocator.allocate(capacity, builder->allocator.state) :
+    (char *)builder->allocator.reallocate(
+    builder->allocated_buffer, capacity, builder->allocator.state);
+  if (NULL == buffer) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for path");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  if (NULL == builder->allocated_buffer) {
+    memcpy(buffer, builder->inline_buffer, builder->length + 1);
+  }
+  builder->allocated_buffer = buffer;
+  builder->capacity = capacity;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_path_builder_set(rcutils_path_builder_t * builder, const char * path)
+{
+  RCUTILS_CHECK_PATH_BUILDER(builder);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(path, RCUTILS_RET_INVALID_ARGUMENT);
+
+  const size_t length = strlen(path);
+  rcutils_ret_t ret = rcutils_path_builder_reserve(builder, length);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  char * buffer = get_buffer(builder);
+  memcpy(buffer, path, length);
+  buffer[length] = '\0';
+  builder->length = length;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_path_builder_append(
+  rcutils_path_builder_t * builder,
+  const char * string,
+  size_t length)
+{
+  RCUTILS_CHECK_PATH_BUILDER(builder);
+  if (0 == length) {
+    return RCUTILS_RET_OK;
+  }
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(string, RCUTILS_RET_INVALID_ARGUMENT);
+  if (length > SIZE_MAX / 2 - builder->length) {
+    RCUTILS_SET_ERROR_MSG("path is too long");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+
+  rcutils_ret_t ret = rcutils_path_builder_reserve(builder, builder->length + length);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  char * buffer = get_buffer(builder);
+  memcpy(buffer + builder->length, string, length);
+  builder->length += length;
+  buffer[builder->length] = '\0';
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_path_builder_push(rcutils_path_builder_t * builder, const char * component)
+{
+  RCUTILS_CHECK_PATH_BUILDER(builder);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(component, RCUTILS_RET_INVALID_ARGUMENT);
+
+  const size_t length = strlen(component);
+  const bool needs_separator =
+    builder->length > 0 && !is_separator(get_buffer(builder)[builder->length - 1]);
+  const size_t added = length + (needs_separator ? 1 : 0);
+  if (added > SIZE_MAX / 2 - builder->length) {
+    RCUTILS_SET_ERROR_MSG("path is too long");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+
+  rcutils_ret_t ret = rcutils_path_builder_reserve(builder, builder->length + added);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  char * buffer = get_buffer(builder);
+  if (needs_separator) {
+    buffer[builder->length++] = RCUTILS_PATH_DELIMITER;
+  }
+  memcpy(buffer + builder->length, component, length);
+  builder->length += length;
+  buffer[builder->length] = '\0';
+  return RCUTILS_RET_OK;
+}
+
+bool
+rcutils_path_builder_pop(rcutils_path_builder_t * builder)
+{
+  if (NULL == builder) {
+    return false;
+  }
+
+  char * buffer = get_buffer(builder);
+  size_t prefix_length;
+  const size_t root_length = get_root_length(buffer, builder->length, &prefix_length);
+  size_t length = builder->length;
+  while (length > root_length && is_separator(buffer[length - 1])) {
+    --length;
+  }
+  if (length == root_length) {
+    return false;
+  }
+  while (length > root_length && !is_separator(buffer[length - 1])) {
+    --length;
+  }
+  while (length > root_length && is_separator(buffer[length - 1])) {
+    --length;
+  }
+  buffer[length] = '\0';
+  builder->length = length;
+  return true;
+}
+
+rcutils_ret_t
+rcutils_path_builder_normalize(rcutils_path_builder_t * builder)
+{
+  RCUTILS_CHECK_PATH_BUILDER(builder);
+
+  // The path is rewritten in place, as it can only get shorter, except an empty one.
+  char * buffer = get_buffer(builder);
+  const size_t length = builder->length;
+  size_t prefix_length;
+  size_t read = get_root_length(buffer, length, &prefix_length);
+  const bool is_absolute = read > prefix_length;
+
+  size_t write = prefix_length;
+  if (is_absolute) {
+#ifdef _WIN32
+    // UNC paths, like `\\server\share`, start with exactly two separators.
+    if (0 == prefix_length && 2 == read) {
+      buffer[write++] = RCUTILS_PATH_DELIMITER;
+    }
+#endif
+    buffer[write++] = RCUTILS_PATH_DELIMITER;
+  }
+  const size_t root_length = write;
+
+  // The number of components written which a `..` can remove.
+  size_t removable_count = 0;
+  while (read < length) {
+    const size_t start = read;
+    while (read < length && !is_separator(buffer[read])) {
+      ++read;
+    }
+    const size_t component_length = read - start;
+    while (read < length && is_separator(buffer[read])) {
+      ++read;
+    }
+
+    if (1 == component_length && '.' == buffer[start]) {
+      continue;
+    }
+    if (2 == component_length && '.' == buffer[start] && '.' == buffer[start + 1]) {
+      if (removable_count > 0) {
+        while (write > root_length && !is_separator(buffer[write - 1])) {
+          --write;
+        }
+        if (write > root_length) {
+          --write;
+        }
+        --removable_count;
+        continue;
+      }
+      if (is_absolute) {
+        continue;
+      }
+    } else {
+      ++removable_count;
+    }
+    if (write > root_length) {
+      buffer[write++] = RCUTILS_PATH_DELIMITER;
+    }
+    memmove(buffer + write, buffer + start, component_length);
+    write += component_length;
+  }
+
+  if (0 == write) {
+    // An empty result becomes `.`, which always fits in the inline buffer.
+    return rcutils_path_builder_set(builder, ".");
+  }
+  buffer[write] = '\0';
+  builder->length = write;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_path_builder_to_native(rcutils_path_builder_t * builder)
+{
+  RCUTILS_CHECK_PATH_BUILDER(builder);
+
+#ifdef _WIN32
+  char * buffer = get_buffer(builder);
+  for (size_t i = 0; i < builder->length; ++i) {
+    if ('/' == buffer[i]) {
+      buffer[i] = RCUTILS_PATH_DELIMITER;
+    }
+  }
+#endif
+  return RCUTILS_RET_OK;
+}
+
+char *
+rcutils_path_builder_detach(rcutils_path_builder_t * builder)
+{
+  if (NULL == builder || !rcutils_allocator_is_valid(&builder->allocator)) {
+    return NULL;
+  }
+
+  char * path = builder->allocated_buffer;
+  if (NULL == path) {
+    path = (char *)builder->allocator.allocate(builder->length + 1, builder->allocator.state);
+    if (NULL == path) {
+      RCUTILS_SET_ERROR_MSG("failed to allocate memory for path");
+      return NULL;
+    }
+    memcpy(path, builder->inline_buffer, builder->length + 1);
+  }
+  builder->length = 0;
+  builder->capacity = 0;
+  builder->allocated_buffer = NULL;
+  builder->inline_buffer[0] = '\0';
+  return path;
+}
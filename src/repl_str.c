@@ -30,7 +30,9 @@ extern "C"
 {
 #endif
 
+#include <assert.h>
 #include <string.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <stddef.h>
 
@@ -38,6 +40,8 @@ extern "C"
 #include <stdint.h>
 #endif
 
+#include "rcutils/error_handling.h"
+#include "rcutils/find.h"
 #include "rcutils/repl_str.h"
 
 // *INDENT-OFF* (prevent uncrustify from messing with the original style)
@@ -145,6 +149,372 @@ end_repl_str:
 
 // *INDENT-ON*
 
+// The strings to replace are matched with an Aho-Corasick automaton, stored as a table with a
+// row per state. Each row holds the offset of the next row for every class of characters,
+// followed by the output and the depth of the state. Characters which don't appear in any
+// string to replace share one class, which keeps the table small.
+
+#define RCUTILS_REPL_STR_NO_STATE UINT32_MAX
+// The characters which can start a match are skipped to with rcutils_find_anyn(), when there
+// are few enough of them for it to search with vector instructions.
+#define RCUTILS_REPL_STR_MAX_FIRST_CHARACTERS 8
+// The number of matches kept while computing the size of the result.
+#define RCUTILS_REPL_STR_MATCH_CACHE_SIZE 32
+
+typedef struct rcutils_repl_str_set_impl_s
+{
+  rcutils_allocator_t allocator;
+  size_t count;
+  uint32_t class_count;
+  uint32_t row_size;
+  uint8_t classes[256];
+  // The characters which can start a match, if there are few enough of them, or "".
+  char first_characters[RCUTILS_REPL_STR_MAX_FIRST_CHARACTERS + 1];
+  // Length of each string to replace.
+  size_t * from_lengths;
+  // Offset and length of each replacement in to_data.
+  size_t * to_offsets;
+  size_t * to_lengths;
+  // The rows of the states, the first one being the initial state. The output of a state is
+  // 1 + the index of the longest string to replace it ends with, or 0, and its depth is the
+  // length of the prefix of a string to replace it matches.
+  uint32_t * states;
+  char * to_data;
+} rcutils_repl_str_set_impl_t;
+
+rcutils_repl_str_set_t
+rcutils_get_zero_initialized_repl_str_set(void)
+{
+  static rcutils_repl_str_set_t zero_initialized_repl_str_set = {0};
+  return zero_initialized_repl_str_set;
+}
+
+// Build the automaton in impl->states, with the given scratch space for two uint32_t per state.
+static void
+__repl_str_build_automaton(
+  rcutils_repl_str_set_impl_t * impl,
+  const char * const * from,
+  uint32_t * scratch)
+{
+  const uint32_t row_size = impl->row_size;
+  const uint32_t class_count = impl->class_count;
+  uint32_t * states = impl->states;
+
+  // Build the trie of the strings to replace, with the row offsets of the states.
+  uint32_t next_row = row_size;
+  for (uint32_t k = 0; k < row_size; ++k) {
+    states[k] = RCUTILS_REPL_STR_NO_STATE;
+  }
+  states[class_count] = 0;
+  states[class_count + 1] = 0;
+  for (size_t i = 0; i < impl->count; ++i) {
+    uint32_t row = 0;
+    for (const char * c = from[i]; '\0' != *c; ++c) {
+      uint32_t * transition = &states[row + impl->classes[(uint8_t)*c]];
+      if (RCUTILS_REPL_STR_NO_STATE == *transition) {
+        for (uint32_t k = 0; k < class_count; ++k) {
+          states[next_row + k] = RCUTILS_REPL_STR_NO_STATE;
+        }
+        states[next_row + class_count] = 0;
+        states[next_row + class_count + 1] = states[row + class_count + 1] + 1;
+        *transition = next_row;
+        next_row += row_size;
+      }
+      row = *transition;
+    }
+    if (0 == states[row + class_count]) {
+      states[row + class_count] = (uint32_t)(i + 1);
+    }
+    impl->from_lengths[i] = states[row + class_count + 1];
+  }
+
+  // Complete the transitions with the failure links, breadth first, so that each state
+  // falls back to the longest suffix it ends with which is a prefix of a string to replace.
+  uint32_t * failures = scratch;
+  uint32_t * queue = scratch + next_row / row_size;
+  size_t queue_begin = 0;
+  size_t queue_end = 0;
+  for (uint32_t c = 0; c < class_count; ++c) {
+    if (RCUTILS_REPL_STR_NO_STATE == states[c]) {
+      states[c] = 0;
+    } else {
+      failures[states[c] / row_size] = 0;
+      queue[queue_end++] = states[c];
+    }
+  }
+  while (queue_begin != queue_end) {
+    uint32_t row = queue[queue_begin++];
+    uint32_t failure = failures[row / row_size];
+    // A state matching a whole string matches it as the longest one.
+    if (0 == states[row + class_count]) {
+      states[row + class_count] = states[failure + class_count];
+    }
+    for (uint32_t c = 0; c < class_count; ++c) {
+      if (RCUTILS_REPL_STR_NO_STATE == states[row + c]) {
+        states[row + c] = states[failure + c];
+      } else {
+        failures[states[row + c] / row_size] = states[failure + c];
+        queue[queue_end++] = states[row + c];
+      }
+    }
+  }
+}
+
+rcutils_ret_t
+rcutils_repl_str_set_init(
+  rcutils_repl_str_set_t * set,
+  const char * const * from,
+  const char * const * to,
+  size_t count,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(set, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RCUTILS_RET_INVALID_ARGUMENT);
+  if (NULL != set->impl) {
+    RCUTILS_SET_ERROR_MSG("set is already initialized");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (count > 0) {
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(from, RCUTILS_RET_INVALID_ARGUMENT);
+    RCUTILS_CHECK_ARGUMENT_FOR_NULL(to, RCUTILS_RET_INVALID_ARGUMENT);
+  }
+
+  rcutils_repl_str_set_impl_t impl;
+  memset(&impl, 0, sizeof(impl));
+  impl.allocator = *allocator;
+  impl.count = count;
+  impl.class_count = 1;
+
+  size_t state_count = 1;
+  size_t to_data_size = 0;
+  size_t first_character_count = 0;
+  bool is_first_character[256] = {false};
+  for (size_t i = 0; i < count; ++i) {
+    if (NULL == from[i] || NULL == to[i]) {
+      RCUTILS_SET_ERROR_MSG("strings to replace cannot be null");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+    size_t from_length = strlen(from[i]);
+    if (0 == from_length) {
+      RCUTILS_SET_ERROR_MSG("strings to replace cannot be empty");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+    for (size_t j = 0; j < from_length; ++j) {
+      uint8_t c = (uint8_t)from[i][j];
+      if (0 == impl.classes[c]) {
+        impl.classes[c] = (uint8_t)impl.class_count;
+        ++impl.class_count;
+      }
+    }
+    uint8_t first_character = (uint8_t)from[i][0];
+    if (!is_first_character[first_character]) {
+      is_first_character[first_character] = true;
+      if (first_character_count < RCUTILS_REPL_STR_MAX_FIRST_CHARACTERS) {
+        impl.first_characters[first_character_count] = from[i][0];
+      }
+      ++first_character_count;
+    }
+    if (from_length >= SIZE_MAX - state_count) {
+      RCUTILS_SET_ERROR_MSG("strings to replace are too long");
+      return RCUTILS_RET_INVALID_ARGUMENT;
+    }
+    state_count += from_length;
+    to_data_size += strlen(to[i]);
+  }
+  if (first_character_count > RCUTILS_REPL_STR_MAX_FIRST_CHARACTERS) {
+    impl.first_characters[0] = '\0';
+  }
+  impl.row_size = impl.class_count + 2;
+
+  // All of the tables are stored in a single allocation, the largest types first.
+  if (
+    state_count >= RCUTILS_REPL_STR_NO_STATE / impl.row_size ||
+    count > SIZE_MAX / sizeof(size_t) / 3)
+  {
+    RCUTILS_SET_ERROR_MSG("strings to replace are too long");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  size_t sizes_size = 3 * count * sizeof(size_t);
+  size_t states_size = state_count * impl.row_size * sizeof(uint32_t);
+  if (to_data_size > SIZE_MAX - 1 - sizes_size - states_size) {
+    RCUTILS_SET_ERROR_MSG("strings to replace are too long");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  char * data = allocator->allocate(
+    sizes_size + states_size + to_data_size + 1, allocator->state);
+  if (NULL == data) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for the strings to replace");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  impl.from_lengths = (size_t *)data;
+  impl.to_offsets = impl.from_lengths + count;
+  impl.to_lengths = impl.to_offsets + count;
+  impl.states = (uint32_t *)(data + sizes_size);
+  impl.to_data = data + sizes_size + states_size;
+
+  size_t to_offset = 0;
+  for (size_t i = 0; i < count; ++i) {
+    impl.to_lengths[i] = strlen(to[i]);
+    impl.to_offsets[i] = to_offset;
+    memcpy(impl.to_data + to_offset, to[i], impl.to_lengths[i]);
+    to_offset += impl.to_lengths[i];
+  }
+  impl.to_data[to_offset] = '\0';
+
+  // The failure links and the queue of states are only needed to build the automaton.
+  uint32_t * scratch = allocator->allocate(2 * state_count * sizeof(uint32_t), allocator->state);
+  if (NULL == scratch) {
+    allocator->deallocate(data, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for the strings to replace");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  __repl_str_build_automaton(&impl, from, scratch);
+  allocator->deallocate(scratch, allocator->state);
+
+  set->impl = allocator->allocate(sizeof(rcutils_repl_str_set_impl_t), allocator->state);
+  if (NULL == set->impl) {
+    allocator->deallocate(data, allocator->state);
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for the strings to replace");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  *set->impl = impl;
+  return RCUTILS_RET_OK;
+}
+
+rcutils_ret_t
+rcutils_repl_str_set_fini(rcutils_repl_str_set_t * set)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(set, RCUTILS_RET_INVALID_ARGUMENT);
+  if (NULL == set->impl) {
+    RCUTILS_SET_ERROR_MSG("set is not initialized");
+    return RCUTILS_RET_NOT_INITIALIZED;
+  }
+  rcutils_allocator_t allocator = set->impl->allocator;
+  allocator.deallocate(set->impl->from_lengths, allocator.state);
+  allocator.deallocate(set->impl, allocator.state);
+  set->impl = NULL;
+  return RCUTILS_RET_OK;
+}
+
+// Find the first match at or after *position, preferring the longest of the ones starting
+// first. The scan restarts after each match, so that matches never overlap.
+static bool
+__repl_str_next_match(
+  const rcutils_repl_str_set_impl_t * impl,
+  const char * str,
+  size_t length,
+  size_t * position,
+  size_t * match_start,
+  size_t * match_index)
+{
+  const uint32_t * states = impl->states;
+  const uint32_t output_offset = impl->class_count;
+  const uint32_t depth_offset = impl->class_count + 1;
+  const bool skip = '\0' != impl->first_characters[0];
+  uint32_t row = 0;
+  bool found = false;
+  size_t start = 0;
+  size_t index = 0;
+  for (size_t i = *position; i < length; ++i) {
+    if (0 == row && skip) {
+      // Without a partial match, skip to the next character which can start one.
+      size_t skipped = rcutils_find_anyn(str + i, impl->first_characters, length - i);
+      if (SIZE_MAX == skipped) {
+        break;
+      }
+      i += skipped;
+    }
+    row = states[row + impl->classes[(uint8_t)str[i]]];
+    uint32_t output = states[row + output_offset];
+    if (0 != output) {
+      size_t output_start = i + 1 - impl->from_lengths[output - 1];
+      if (!found || output_start <= start) {
+        // Ending later, a match starting at the same position is longer.
+        found = true;
+        start = output_start;
+        index = output - 1;
+      }
+    }
+    // No later match can start at or before the current one.
+    if (found && i + 1 - states[row + depth_offset] > start) {
+      break;
+    }
+  }
+  if (found) {
+    *match_start = start;
+    *match_index = index;
+    *position = start + impl->from_lengths[index];
+  }
+  return found;
+}
+
+char *
+rcutils_repl_str_multi(
+  const char * str,
+  const rcutils_repl_str_set_t * set,
+  const rcutils_allocator_t * allocator)
+{
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(str, "str is null", return NULL);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(set, "set is null", return NULL);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(set->impl, "set is not initialized", return NULL);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is invalid", return NULL);
+  const rcutils_repl_str_set_impl_t * impl = set->impl;
+
+  // Compute the size of the result first, so that it is allocated once. The first matches
+  // are kept, so that the string is only scanned again if there are more of them.
+  size_t match_starts[RCUTILS_REPL_STR_MATCH_CACHE_SIZE];
+  size_t match_indices[RCUTILS_REPL_STR_MATCH_CACHE_SIZE];
+  size_t cached_position = 0;
+  size_t match_count = 0;
+  const size_t str_length = strlen(str);
+  size_t length = str_length;
+  size_t position = 0;
+  size_t match_start = 0;
+  size_t match_index = 0;
+  while (__repl_str_next_match(impl, str, str_length, &position, &match_start, &match_index)) {
+    if (match_count < RCUTILS_REPL_STR_MATCH_CACHE_SIZE) {
+      match_starts[match_count] = match_start;
+      match_indices[match_count] = match_index;
+      cached_position = position;
+    }
+    ++match_count;
+    length -= impl->from_lengths[match_index];
+    if (impl->to_lengths[match_index] > SIZE_MAX - 1 - length) {
+      RCUTILS_SET_ERROR_MSG("replaced string is too long");
+      return NULL;
+    }
+    length += impl->to_lengths[match_index];
+  }
+
+  char * ret = allocator->allocate(length + 1, allocator->state);
+  if (NULL == ret) {
+    RCUTILS_SET_ERROR_MSG("failed to allocate memory for the replaced string");
+    return NULL;
+  }
+  char * out = ret;
+  size_t copied = 0;
+  position = cached_position;
+  for (size_t i = 0; i < match_count; ++i) {
+    if (i < RCUTILS_REPL_STR_MATCH_CACHE_SIZE) {
+      match_start = match_starts[i];
+      match_index = match_indices[i];
+    } else {
+      bool found =
+        __repl_str_next_match(impl, str, str_length, &position, &match_start, &match_index);
+      assert(found);
+      (void)found;
+    }
+    memcpy(out, str + copied, match_start - copied);
+    out += match_start - copied;
+    memcpy(out, impl->to_data + impl->to_offsets[match_index], impl->to_lengths[match_index]);
+    out += impl->to_lengths[match_index];
+    copied = match_start + impl->from_lengths[match_index];
+  }
+  memcpy(out, str + copied, str_length - copied);
+  ret[length] = '\0';
+  return ret;
+}
+
 #ifdef __cplusplus
 }
 #endif
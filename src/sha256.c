@@ -13,9 +13,37 @@
 // limitations under the License.
 
 #include <assert.h>
+#include <stdbool.h>
 #include <string.h>
 
+#include "rcutils/error_handling.h"
+#include "rcutils/filesystem.h"
 #include "rcutils/sha256.h"
+#include "rcutils/testing/sha256.h"
+
+// The hardware accelerated transforms are compiled for their instructions with a target
+// attribute, and only called if the processor supports them.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(_WIN32) && \
+  (defined(__x86_64__) || defined(__i386__))
+# include <cpuid.h>
+# include <immintrin.h>
+# include "rcutils/stdatomic_helper.h"
+# define RCUTILS_SHA256_USE_X86
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+# if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+#  include <arm_neon.h>
+#  include "rcutils/stdatomic_helper.h"
+#  define RCUTILS_SHA256_USE_ARMV8
+#  define RCUTILS_SHA256_ARMV8_TARGET
+# elif defined(__linux__) && !defined(__clang__)
+#  include <arm_neon.h>
+#  include <asm/hwcap.h>
+#  include <sys/auxv.h>
+#  include "rcutils/stdatomic_helper.h"
+#  define RCUTILS_SHA256_USE_ARMV8
+#  define RCUTILS_SHA256_ARMV8_TARGET __attribute__((target("+crypto")))
+# endif
+#endif
 
 static inline size_t min(size_t a, size_t b)
 {
@@ -69,29 +97,21 @@ static const uint32_t k[64] = {
   0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
 };
 
-static void sha256_transform(rcutils_sha256_ctx_t * ctx)
+static inline void sha256_rounds(uint32_t state[8], const uint32_t wk[64])
 {
-  uint32_t a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
-  uint8_t * data = ctx->data;
-
-  for (i = 0, j = 0; i < 16; ++i, j += 4) {
-    m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
-  }
-  for ( ; i < 64; ++i) {
-    m[i] = sig1(m[i - 2]) + m[i - 7] + sig0(m[i - 15]) + m[i - 16];
-  }
+  uint32_t a, b, c, d, e, f, g, h, i, t1, t2;
 
-  a = ctx->state[0];
-  b = ctx->state[1];
-  c = ctx->state[2];
-  d = ctx->state[3];
-  e = ctx->state[4];
-  f = ctx->state[5];
-  g = ctx->state[6];
-  h = ctx->state[7];
+  a = state[0];
+  b = state[1];
+  c = state[2];
+  d = state[3];
+  e = state[4];
+  f = state[5];
+  g = state[6];
+  h = state[7];
 
   for (i = 0; i < 64; ++i) {
-    t1 = h + ep1(e) + ch(e, f, g) + k[i] + m[i];
+    t1 = h + ep1(e) + ch(e, f, g) + wk[i];
     t2 = ep0(a) + maj(a, b, c);
     h = g;
     g = f;
@@ -103,49 +123,364 @@ static void sha256_transform(rcutils_sha256_ctx_t * ctx)
     a = t1 + t2;
   }
 
-  ctx->state[0] += a;
-  ctx->state[1] += b;
-  ctx->state[2] += c;
-  ctx->state[3] += d;
-  ctx->state[4] += e;
-  ctx->state[5] += f;
-  ctx->state[6] += g;
-  ctx->state[7] += h;
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+static void sha256_transform_scalar(uint32_t state[8], const uint8_t * data, size_t block_count)
+{
+  uint32_t i, j, m[64];
+
+  for ( ; block_count > 0; --block_count, data += 64) {
+    for (i = 0, j = 0; i < 16; ++i, j += 4) {
+      m[i] = ((uint32_t)data[j] << 24) | ((uint32_t)data[j + 1] << 16) |
+        ((uint32_t)data[j + 2] << 8) | ((uint32_t)data[j + 3]);
+    }
+    for ( ; i < 64; ++i) {
+      m[i] = sig1(m[i - 2]) + m[i - 7] + sig0(m[i - 15]) + m[i - 16];
+    }
+    for (i = 0; i < 64; ++i) {
+      m[i] += k[i];
+    }
+    sha256_rounds(state, m);
+  }
+}
+
+#if defined(RCUTILS_SHA256_USE_X86)
+// SHA-NI keeps the state as ABEF and CDGH vectors, and does two rounds per sha256rnds2.
+// Group g hashes rounds 4 * g to 4 * g + 3 with the message words in m; while doing so, it
+// finishes the message words of group g + 1 in m_next, and starts the ones of group g + 3 in
+// m_previous, which holds the words of group g - 1 until then.
+#define RCUTILS_SHA256_NI_ROUNDS(g, m, m_next, m_previous, finish_next, start_next) \
+  do { \
+    __m128i wk = _mm_add_epi32(m, _mm_loadu_si128((const __m128i *)&k[4 * (g)])); \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, wk); \
+    if (finish_next) { \
+      m_next = _mm_add_epi32(m_next, _mm_alignr_epi8(m, m_previous, 4)); \
+      m_next = _mm_sha256msg2_epu32(m_next, m); \
+    } \
+    wk = _mm_shuffle_epi32(wk, 0x0e); \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, wk); \
+    if (start_next) { \
+      m_previous = _mm_sha256msg1_epu32(m_previous, m); \
+    } \
+  } while (0)
+
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sha256_transform_shani(uint32_t state[8], const uint8_t * data, size_t block_count)
+{
+  const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+  __m128i state0 = _mm_loadu_si128((const __m128i *)&state[0]);
+  __m128i state1 = _mm_loadu_si128((const __m128i *)&state[4]);
+  __m128i m0, m1, m2, m3;
+
+  // Turn the ABCD and EFGH state into ABEF and CDGH.
+  __m128i tmp = _mm_shuffle_epi32(state0, 0xb1);
+  state1 = _mm_shuffle_epi32(state1, 0x1b);
+  state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+  for ( ; block_count > 0; --block_count, data += 64) {
+    const __m128i abef = state0;
+    const __m128i cdgh = state1;
+
+    m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 0)), byte_swap);
+    m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16)), byte_swap);
+    m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 32)), byte_swap);
+    m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 48)), byte_swap);
+
+    RCUTILS_SHA256_NI_ROUNDS(0, m0, m1, m3, false, false);
+    RCUTILS_SHA256_NI_ROUNDS(1, m1, m2, m0, false, true);
+    RCUTILS_SHA256_NI_ROUNDS(2, m2, m3, m1, false, true);
+    RCUTILS_SHA256_NI_ROUNDS(3, m3, m0, m2, true, true);
+    RCUTILS_SHA256_NI_ROUNDS(4, m0, m1, m3, true, true);
+    RCUTILS_SHA256_NI_ROUNDS(5, m1, m2, m0, true, true);
+    RCUTILS_SHA256_NI_ROUNDS(6, m2, m3, m1, true, true);
+    RCUTILS_SHA256_NI_ROUNDS(7, m3, m0, m2, true, true);
+    RCUTILS_SHA256_NI_ROUNDS(8, m0, m1, m3, true, true);
+    RCUTILS_SHA256_NI_ROUNDS(9, m1, m2, m0, true, true);
+    RCUTILS_SHA256_NI_ROUNDS(10, m2, m3, m1, true, true);
+    RCUTILS_SHA256_NI_ROUNDS(11, m3, m0, m2, true, true);
+    RCUTILS_SHA256_NI_ROUNDS(12, m0, m1, m3, true, true);
+    RCUTILS_SHA256_NI_ROUNDS(13, m1, m2, m0, true, false);
+    RCUTILS_SHA256_NI_ROUNDS(14, m2, m3, m1, true, false);
+    RCUTILS_SHA256_NI_ROUNDS(15, m3, m0, m2, false, false);
+
+    state0 = _mm_add_epi32(state0, abef);
+    state1 = _mm_add_epi32(state1, cdgh);
+  }
+
+  // Turn the ABEF and CDGH state back into ABCD and EFGH.
+  tmp = _mm_shuffle_epi32(state0, 0x1b);
+  state1 = _mm_shuffle_epi32(state1, 0xb1);
+  state0 = _mm_blend_epi16(tmp, state1, 0xf0);
+  state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+  _mm_storeu_si128((__m128i *)&state[0], state0);
+  _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+
+__attribute__((target("avx2,bmi2")))
+static inline __m256i sha256_rotright_avx2(__m256i x, const int b)
+{
+  return _mm256_or_si256(_mm256_srli_epi32(x, b), _mm256_slli_epi32(x, 32 - b));
+}
+
+// The message schedule of two blocks is computed at once, one in each 128-bit lane, and
+// the rounds are done with the BMI2 rotations.
+__attribute__((target("avx2,bmi2")))
+static void sha256_transform_avx2(uint32_t state[8], const uint8_t * data, size_t block_count)
+{
+  const __m256i byte_swap = _mm256_broadcastsi128_si256(
+    _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL));
+  const __m256i low_words = _mm256_set_epi32(0, 0, -1, -1, 0, 0, -1, -1);
+  uint32_t wk[2][64];
+  size_t i;
+
+  while (block_count > 0) {
+    // With a single block left, its schedule is computed in both lanes.
+    const uint8_t * second_block = block_count > 1 ? data + 64 : data;
+    __m256i m[4];
+    for (i = 0; i < 4; ++i) {
+      __m256i words = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(data + 16 * i))),
+        _mm_loadu_si128((const __m128i *)(second_block + 16 * i)), 1);
+      m[i] = _mm256_shuffle_epi8(words, byte_swap);
+    }
+    __m256i m0 = m[0], m1 = m[1], m2 = m[2], m3 = m[3];
+
+    for (i = 0; i < 64; i += 4) {
+      const __m256i wk_words = _mm256_add_epi32(
+        m0, _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)&k[i])));
+      _mm_storeu_si128((__m128i *)&wk[0][i], _mm256_castsi256_si128(wk_words));
+      _mm_storeu_si128((__m128i *)&wk[1][i], _mm256_extracti128_si256(wk_words, 1));
+      if (i >= 48) {
+        m0 = m1;
+        m1 = m2;
+        m2 = m3;
+        continue;
+      }
+
+      // Words i + 16 to i + 19, where the last two depend on the first two through sig1.
+      const __m256i w15 = _mm256_alignr_epi8(m1, m0, 4);
+      const __m256i w7 = _mm256_alignr_epi8(m3, m2, 4);
+      const __m256i s0 = _mm256_xor_si256(
+        _mm256_xor_si256(sha256_rotright_avx2(w15, 7), sha256_rotright_avx2(w15, 18)),
+        _mm256_srli_epi32(w15, 3));
+      __m256i next = _mm256_add_epi32(_mm256_add_epi32(m0, w7), s0);
+      __m256i w2 = _mm256_shuffle_epi32(m3, 0x0e);
+      __m256i s1 = _mm256_xor_si256(
+        _mm256_xor_si256(sha256_rotright_avx2(w2, 17), sha256_rotright_avx2(w2, 19)),
+        _mm256_srli_epi32(w2, 10));
+      next = _mm256_add_epi32(next, _mm256_and_si256(s1, low_words));
+      w2 = _mm256_shuffle_epi32(next, 0x40);
+      s1 = _mm256_xor_si256(
+        _mm256_xor_si256(sha256_rotright_avx2(w2, 17), sha256_rotright_avx2(w2, 19)),
+        _mm256_srli_epi32(w2, 10));
+      next = _mm256_add_epi32(next, _mm256_andnot_si256(low_words, s1));
+
+      m0 = m1;
+      m1 = m2;
+      m2 = m3;
+      m3 = next;
+    }
+
+    sha256_rounds(state, wk[0]);
+    if (block_count > 1) {
+      sha256_rounds(state, wk[1]);
+      block_count -= 2;
+      data += 128;
+    } else {
+      block_count = 0;
+    }
+  }
+}
+#endif  // defined(RCUTILS_SHA256_USE_X86)
+
+#if defined(RCUTILS_SHA256_USE_ARMV8)
+// Group g hashes rounds 4 * g to 4 * g + 3 with the message words in m, and then replaces
+// them with the ones of group g + 4 if needed.
+#define RCUTILS_SHA256_ARMV8_ROUNDS(g, m, m1, m2, m3, schedule) \
+  do { \
+    const uint32x4_t wk = vaddq_u32(m, vld1q_u32(&k[4 * (g)])); \
+    const uint32x4_t abcd = state0; \
+    if (schedule) { \
+      m = vsha256su0q_u32(m, m1); \
+    } \
+    state0 = vsha256hq_u32(state0, state1, wk); \
+    state1 = vsha256h2q_u32(state1, abcd, wk); \
+    if (schedule) { \
+      m = vsha256su1q_u32(m, m2, m3); \
+    } \
+  } while (0)
+
+RCUTILS_SHA256_ARMV8_TARGET
+static void sha256_transform_armv8(uint32_t state[8], const uint8_t * data, size_t block_count)
+{
+  uint32x4_t state0 = vld1q_u32(&state[0]);
+  uint32x4_t state1 = vld1q_u32(&state[4]);
+  uint32x4_t m0, m1, m2, m3;
+
+  for ( ; block_count > 0; --block_count, data += 64) {
+    const uint32x4_t abcd = state0;
+    const uint32x4_t efgh = state1;
+
+    m0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 0)));
+    m1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16)));
+    m2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 32)));
+    m3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 48)));
+
+    RCUTILS_SHA256_ARMV8_ROUNDS(0, m0, m1, m2, m3, true);
+    RCUTILS_SHA256_ARMV8_ROUNDS(1, m1, m2, m3, m0, true);
+    RCUTILS_SHA256_ARMV8_ROUNDS(2, m2, m3, m0, m1, true);
+    RCUTILS_SHA256_ARMV8_ROUNDS(3, m3, m0, m1, m2, true);
+    RCUTILS_SHA256_ARMV8_ROUNDS(4, m0, m1, m2, m3, true);
+    RCUTILS_SHA256_ARMV8_ROUNDS(5, m1, m2, m3, m0, true);
+    RCUTILS_SHA256_ARMV8_ROUNDS(6, m2, m3, m0, m1, true);
+    RCUTILS_SHA256_ARMV8_ROUNDS(7, m3, m0, m1, m2, true);
+    RCUTILS_SHA256_ARMV8_ROUNDS(8, m0, m1, m2, m3, true);
+    RCUTILS_SHA256_ARMV8_ROUNDS(9, m1, m2, m3, m0, true);
+    RCUTILS_SHA256_ARMV8_ROUNDS(10, m2, m3, m0, m1, true);
+    RCUTILS_SHA256_ARMV8_ROUNDS(11, m3, m0, m1, m2, true);
+    RCUTILS_SHA256_ARMV8_ROUNDS(12, m0, m1, m2, m3, false);
+    RCUTILS_SHA256_ARMV8_ROUNDS(13, m1, m2, m3, m0, false);
+    RCUTILS_SHA256_ARMV8_ROUNDS(14, m2, m3, m0, m1, false);
+    RCUTILS_SHA256_ARMV8_ROUNDS(15, m3, m0, m1, m2, false);
+
+    state0 = vaddq_u32(state0, abcd);
+    state1 = vaddq_u32(state1, efgh);
+  }
+
+  vst1q_u32(&state[0], state0);
+  vst1q_u32(&state[4], state1);
 }
+#endif  // defined(RCUTILS_SHA256_USE_ARMV8)
+
+static bool sha256_implementation_is_supported(rcutils_sha256_implementation_t implementation)
+{
+  switch (implementation) {
+    case RCUTILS_SHA256_IMPLEMENTATION_AUTO:
+    case RCUTILS_SHA256_IMPLEMENTATION_SCALAR:
+      return true;
+#if defined(RCUTILS_SHA256_USE_X86)
+    case RCUTILS_SHA256_IMPLEMENTATION_SHANI:
+      {
+        unsigned int eax, ebx, ecx, edx;
+        return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSE4_1) &&
+               (ecx & bit_SSSE3) && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+               (ebx & bit_SHA);
+      }
+    case RCUTILS_SHA256_IMPLEMENTATION_AVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2");
+#elif defined(RCUTILS_SHA256_USE_ARMV8)
+    case RCUTILS_SHA256_IMPLEMENTATION_ARMV8:
+# if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+      return true;
+# else
+      return 0 != (getauxval(AT_HWCAP) & HWCAP_SHA2);
+# endif
+#endif
+    default:
+      return false;
+  }
+}
+
+#if defined(RCUTILS_SHA256_USE_X86) || defined(RCUTILS_SHA256_USE_ARMV8)
+// The implementation picked for the processor, or forced by the tests,
+// RCUTILS_SHA256_IMPLEMENTATION_AUTO until it is checked.
+static atomic_int g_rcutils_sha256_implementation =
+  ATOMIC_VAR_INIT(RCUTILS_SHA256_IMPLEMENTATION_AUTO);
+
+static rcutils_sha256_implementation_t sha256_detect_implementation(void)
+{
+  if (sha256_implementation_is_supported(RCUTILS_SHA256_IMPLEMENTATION_SHANI)) {
+    return RCUTILS_SHA256_IMPLEMENTATION_SHANI;
+  }
+  if (sha256_implementation_is_supported(RCUTILS_SHA256_IMPLEMENTATION_AVX2)) {
+    return RCUTILS_SHA256_IMPLEMENTATION_AVX2;
+  }
+  if (sha256_implementation_is_supported(RCUTILS_SHA256_IMPLEMENTATION_ARMV8)) {
+    return RCUTILS_SHA256_IMPLEMENTATION_ARMV8;
+  }
+  return RCUTILS_SHA256_IMPLEMENTATION_SCALAR;
+}
+#endif
+
+static void sha256_transform(uint32_t state[8], const uint8_t * data, size_t block_count)
+{
+#if defined(RCUTILS_SHA256_USE_X86) || defined(RCUTILS_SHA256_USE_ARMV8)
+  int implementation = RCUTILS_SHA256_IMPLEMENTATION_AUTO;
+  rcutils_atomic_load(&g_rcutils_sha256_implementation, implementation);
+  if (RCUTILS_SHA256_IMPLEMENTATION_AUTO == implementation) {
+    implementation = sha256_detect_implementation();
+    rcutils_atomic_store(&g_rcutils_sha256_implementation, implementation);
+  }
+  switch (implementation) {
+#if defined(RCUTILS_SHA256_USE_X86)
+    case RCUTILS_SHA256_IMPLEMENTATION_SHANI:
+      sha256_transform_shani(state, data, block_count);
+      return;
+    case RCUTILS_SHA256_IMPLEMENTATION_AVX2:
+      sha256_transform_avx2(state, data, block_count);
+      return;
+#else
+    case RCUTILS_SHA256_IMPLEMENTATION_ARMV8:
+      sha256_transform_armv8(state, data, block_count);
+      return;
+#endif
+    default:
+      break;
+  }
+#endif
+  sha256_transform_scalar(state, data, block_count);
+}
+
+static const uint32_t g_sha256_initial_state[8] = {
+  0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
 
 void rcutils_sha256_init(rcutils_sha256_ctx_t * ctx)
 {
   ctx->datalen = 0;
   ctx->bitlen = 0;
-  ctx->state[0] = 0x6a09e667;
-  ctx->state[1] = 0xbb67ae85;
-  ctx->state[2] = 0x3c6ef372;
-  ctx->state[3] = 0xa54ff53a;
-  ctx->state[4] = 0x510e527f;
-  ctx->state[5] = 0x9b05688c;
-  ctx->state[6] = 0x1f83d9ab;
-  ctx->state[7] = 0x5be0cd19;
+  memcpy(ctx->state, g_sha256_initial_state, sizeof(ctx->state));
 }
 
 void rcutils_sha256_update(rcutils_sha256_ctx_t * ctx, const uint8_t * data, size_t len)
 {
-  size_t i, data_remaining, block_remaining, copy_len;
-  i = 0;
-
-  while (i < len) {
-    data_remaining = len - i;
-    block_remaining = 64 - ctx->datalen;
-    copy_len = min(min(block_remaining, data_remaining), 64);
+  size_t i = 0;
+  size_t block_count;
 
-    memcpy(ctx->data + ctx->datalen, data + i, copy_len);
-    ctx->datalen += copy_len;
-    i += copy_len;
-
-    if (ctx->datalen >= 64) {
-      sha256_transform(ctx);
-      ctx->bitlen += 512;
-      ctx->datalen = 0;
+  // Complete the block buffered by a previous update first.
+  if (ctx->datalen > 0) {
+    i = min(64 - ctx->datalen, len);
+    memcpy(ctx->data + ctx->datalen, data, i);
+    ctx->datalen += i;
+    if (ctx->datalen < 64) {
+      return;
     }
+    sha256_transform(ctx->state, ctx->data, 1);
+    ctx->bitlen += 512;
+    ctx->datalen = 0;
+  }
+
+  // Hash the full blocks directly from the input, and only buffer what is left.
+  block_count = (len - i) / 64;
+  if (block_count > 0) {
+    sha256_transform(ctx->state, data + i, block_count);
+    ctx->bitlen += (uint64_t)block_count * 512;
+    i += block_count * 64;
+  }
+  if (i < len) {
+    memcpy(ctx->data, data + i, len - i);
+    ctx->datalen = len - i;
   }
 }
 
@@ -163,7 +498,7 @@ void rcutils_sha256_final(
     if (i < 64) {
       memset(ctx->data + i, 0x00, 64 - i);
     }
-    sha256_transform(ctx);
+    sha256_transform(ctx->state, ctx->data, 1);
     memset(ctx->data, 0, 56);
   }
 
@@ -177,7 +512,7 @@ void rcutils_sha256_final(
   ctx->data[58] = (uint8_t)(ctx->bitlen >> 40);
   ctx->data[57] = (uint8_t)(ctx->bitlen >> 48);
   ctx->data[56] = (uint8_t)(ctx->bitlen >> 56);
-  sha256_transform(ctx);
+  sha256_transform(ctx->state, ctx->data, 1);
 
   // Since this implementation uses little endian byte ordering and SHA uses big endian,
   // reverse all the bytes when copying the final state to the output hash.
@@ -192,3 +527,571 @@ void rcutils_sha256_final(
     output_hash[i + 28] = (ctx->state[7] >> (24 - i * 8)) & 0x000000ff;
   }
 }
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+  (defined(RCUTILS_SHA256_USE_X86) || defined(__aarch64__))
+# if !defined(RCUTILS_SHA256_USE_X86) && !defined(RCUTILS_SHA256_USE_ARMV8)
+#  include <arm_neon.h>
+#  include "rcutils/stdatomic_helper.h"
+# endif
+# define RCUTILS_SHA256_USE_LANES
+#endif
+
+#if defined(RCUTILS_SHA256_USE_LANES)
+#define RCUTILS_SHA256_MAX_LANES 16
+
+#define RCUTILS_SHA256_LANES_ROTRIGHT(x, b) (((x) >> (b)) | ((x) << (32 - (b))))
+#define RCUTILS_SHA256_LANES_EP0(x) (RCUTILS_SHA256_LANES_ROTRIGHT(x, 2) ^ \
+  RCUTILS_SHA256_LANES_ROTRIGHT(x, 13) ^ RCUTILS_SHA256_LANES_ROTRIGHT(x, 22))
+#define RCUTILS_SHA256_LANES_EP1(x) (RCUTILS_SHA256_LANES_ROTRIGHT(x, 6) ^ \
+  RCUTILS_SHA256_LANES_ROTRIGHT(x, 11) ^ RCUTILS_SHA256_LANES_ROTRIGHT(x, 25))
+#define RCUTILS_SHA256_LANES_SIG0(x) (RCUTILS_SHA256_LANES_ROTRIGHT(x, 7) ^ \
+  RCUTILS_SHA256_LANES_ROTRIGHT(x, 18) ^ ((x) >> 3))
+#define RCUTILS_SHA256_LANES_SIG1(x) (RCUTILS_SHA256_LANES_ROTRIGHT(x, 17) ^ \
+  RCUTILS_SHA256_LANES_ROTRIGHT(x, 19) ^ ((x) >> 10))
+
+// Instead of moving the state words along, each round of eight uses them in a rotated order.
+#define RCUTILS_SHA256_LANES_ROUND(a, b, c, d, e, f, g, h, i) \
+  do { \
+    t1 = \
+      h + RCUTILS_SHA256_LANES_EP1(e) + ((e & f) ^ (~e & g)) + k[i] + m[i]; \
+    d += t1; \
+    h = t1 + RCUTILS_SHA256_LANES_EP0(a) + ((a & b) ^ (a & c) ^ (b & c)); \
+  } while (0)
+
+#define RCUTILS_SHA256_LANES_BYTE_SWAP(x) \
+  (((x) << 24) | (((x) << 8) & 0xff0000) | (((x) >> 8) & 0xff00) | ((x) >> 24))
+
+// Hash one block of each lane, with the state and message words of all the lanes side by side
+// in vectors, so that every instruction does the same step of the rounds for each lane.
+// Each row of the state has one word of every lane, and m has the first 16 message words of
+// each lane already loaded in the same way.
+#define RCUTILS_SHA256_LANES_TRANSFORM(vector_t, state, m) \
+  do { \
+    vector_t a, b, c, d, e, f, g, h, t1; \
+    size_t i; \
+    for (i = 0; i < 16; ++i) { \
+      m[i] = RCUTILS_SHA256_LANES_BYTE_SWAP(m[i]); \
+    } \
+    for ( ; i < 64; ++i) { \
+      m[i] = RCUTILS_SHA256_LANES_SIG1(m[i - 2]) + m[i - 7] + \
+        RCUTILS_SHA256_LANES_SIG0(m[i - 15]) + m[i - 16]; \
+    } \
+    a = *(vector_t *)(state)[0]; \
+    b = *(vector_t *)(state)[1]; \
+    c = *(vector_t *)(state)[2]; \
+    d = *(vector_t *)(state)[3]; \
+    e = *(vector_t *)(state)[4]; \
+    f = *(vector_t *)(state)[5]; \
+    g = *(vector_t *)(state)[6]; \
+    h = *(vector_t *)(state)[7]; \
+    for (i = 0; i < 64; i += 8) { \
+      RCUTILS_SHA256_LANES_ROUND(a, b, c, d, e, f, g, h, i + 0); \
+      RCUTILS_SHA256_LANES_ROUND(h, a, b, c, d, e, f, g, i + 1); \
+      RCUTILS_SHA256_LANES_ROUND(g, h, a, b, c, d, e, f, i + 2); \
+      RCUTILS_SHA256_LANES_ROUND(f, g, h, a, b, c, d, e, i + 3); \
+      RCUTILS_SHA256_LANES_ROUND(e, f, g, h, a, b, c, d, i + 4); \
+      RCUTILS_SHA256_LANES_ROUND(d, e, f, g, h, a, b, c, i + 5); \
+      RCUTILS_SHA256_LANES_ROUND(c, d, e, f, g, h, a, b, i + 6); \
+      RCUTILS_SHA256_LANES_ROUND(b, c, d, e, f, g, h, a, i + 7); \
+    } \
+    *(vector_t *)(state)[0] += a; \
+    *(vector_t *)(state)[1] += b; \
+    *(vector_t *)(state)[2] += c; \
+    *(vector_t *)(state)[3] += d; \
+    *(vector_t *)(state)[4] += e; \
+    *(vector_t *)(state)[5] += f; \
+    *(vector_t *)(state)[6] += g; \
+    *(vector_t *)(state)[7] += h; \
+  } while (0)
+
+// The state words of the lanes, which is aligned for the widest vectors.
+typedef uint32_t sha256_lanes_state_t[8][RCUTILS_SHA256_MAX_LANES] __attribute__((aligned(64)));
+
+typedef void (* sha256_lanes_transform_t)(
+  sha256_lanes_state_t state, const uint8_t * const * blocks);
+
+// NEON is always available on the processors this is built for, and so is SSE2 on x86-64,
+// while it is checked for on 32-bit x86 processors unless the compiler may assume it.
+// The words of the blocks are loaded 4 at a time from 4 lanes, and transposed, so that each
+// vector then has one word of every lane.
+typedef uint32_t sha256_vector4_t __attribute__((vector_size(16)));
+
+#if defined(RCUTILS_SHA256_USE_X86)
+__attribute__((target("sse2")))
+#endif
+static void sha256_transform_lanes4(sha256_lanes_state_t state, const uint8_t * const * blocks)
+{
+  sha256_vector4_t m[64];
+  size_t i;
+
+  for (i = 0; i < 16; i += 4) {
+#if defined(RCUTILS_SHA256_USE_X86)
+    const __m128i r0 = _mm_loadu_si128((const __m128i *)(blocks[0] + 4 * i));
+    const __m128i r1 = _mm_loadu_si128((const __m128i *)(blocks[1] + 4 * i));
+    const __m128i r2 = _mm_loadu_si128((const __m128i *)(blocks[2] + 4 * i));
+    const __m128i r3 = _mm_loadu_si128((const __m128i *)(blocks[3] + 4 * i));
+    const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+    const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+    const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+    const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+    m[i + 0] = (sha256_vector4_t)_mm_unpacklo_epi64(t0, t1);
+    m[i + 1] = (sha256_vector4_t)_mm_unpackhi_epi64(t0, t1);
+    m[i + 2] = (sha256_vector4_t)_mm_unpacklo_epi64(t2, t3);
+    m[i + 3] = (sha256_vector4_t)_mm_unpackhi_epi64(t2, t3);
+#else
+    const uint32x4x2_t t0 = vtrnq_u32(
+      vld1q_u32((const uint32_t *)(blocks[0] + 4 * i)),
+      vld1q_u32((const uint32_t *)(blocks[1] + 4 * i)));
+    const uint32x4x2_t t1 = vtrnq_u32(
+      vld1q_u32((const uint32_t *)(blocks[2] + 4 * i)),
+      vld1q_u32((const uint32_t *)(blocks[3] + 4 * i)));
+    m[i + 0] = (sha256_vector4_t)vcombine_u32(vget_low_u32(t0.val[0]), vget_low_u32(t1.val[0]));
+    m[i + 1] = (sha256_vector4_t)vcombine_u32(vget_low_u32(t0.val[1]), vget_low_u32(t1.val[1]));
+    m[i + 2] =
+      (sha256_vector4_t)vcombine_u32(vget_high_u32(t0.val[0]), vget_high_u32(t1.val[0]));
+    m[i + 3] =
+      (sha256_vector4_t)vcombine_u32(vget_high_u32(t0.val[1]), vget_high_u32(t1.val[1]));
+#endif
+  }
+  RCUTILS_SHA256_LANES_TRANSFORM(sha256_vector4_t, state, m);
+}
+
+#if defined(RCUTILS_SHA256_USE_X86)
+// The same as with 4 lanes, with lanes 4 to 7 in the upper halves of the vectors.
+typedef uint32_t sha256_vector8_t __attribute__((vector_size(32)));
+
+__attribute__((target("avx2")))
+static inline __m256i sha256_load_lanes8(const uint8_t * const * blocks, size_t lane, size_t i)
+{
+  return _mm256_inserti128_si256(
+    _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(blocks[lane] + 4 * i))),
+    _mm_loadu_si128((const __m128i *)(blocks[lane + 4] + 4 * i)), 1);
+}
+
+__attribute__((target("avx2")))
+static void sha256_transform_lanes8(sha256_lanes_state_t state, const uint8_t * const * blocks)
+{
+  sha256_vector8_t m[64];
+  size_t i;
+
+  for (i = 0; i < 16; i += 4) {
+    const __m256i r0 = sha256_load_lanes8(blocks, 0, i);
+    const __m256i r1 = sha256_load_lanes8(blocks, 1, i);
+    const __m256i r2 = sha256_load_lanes8(blocks, 2, i);
+    const __m256i r3 = sha256_load_lanes8(blocks, 3, i);
+    const __m256i t0 = _mm256_unpacklo_epi32(r0, r1);
+    const __m256i t1 = _mm256_unpacklo_epi32(r2, r3);
+    const __m256i t2 = _mm256_unpackhi_epi32(r0, r1);
+    const __m256i t3 = _mm256_unpackhi_epi32(r2, r3);
+    m[i + 0] = (sha256_vector8_t)_mm256_unpacklo_epi64(t0, t1);
+    m[i + 1] = (sha256_vector8_t)_mm256_unpackhi_epi64(t0, t1);
+    m[i + 2] = (sha256_vector8_t)_mm256_unpacklo_epi64(t2, t3);
+    m[i + 3] = (sha256_vector8_t)_mm256_unpackhi_epi64(t2, t3);
+  }
+  RCUTILS_SHA256_LANES_TRANSFORM(sha256_vector8_t, state, m);
+}
+
+// The same as with 4 lanes, with lanes 4 * j to 4 * j + 3 in the 128-bit part j of the vectors.
+typedef uint32_t sha256_vector16_t __attribute__((vector_size(64)));
+
+__attribute__((target("avx512f")))
+static inline __m512i sha256_load_lanes16(const uint8_t * const * blocks, size_t lane, size_t i)
+{
+  __m512i words = _mm512_castsi128_si512(
+    _mm_loadu_si128((const __m128i *)(blocks[lane] + 4 * i)));
+  words = _mm512_inserti32x4(
+    words, _mm_loadu_si128((const __m128i *)(blocks[lane + 4] + 4 * i)), 1);
+  words = _mm512_inserti32x4(
+    words, _mm_loadu_si128((const __m128i *)(blocks[lane + 8] + 4 * i)), 2);
+  return _mm512_inserti32x4(
+    words, _mm_loadu_si128((const __m128i *)(blocks[lane + 12] + 4 * i)), 3);
+}
+
+__attribute__((target("avx512f")))
+static void sha256_transform_lanes16(sha256_lanes_state_t state, const uint8_t * const * blocks)
+{
+  sha256_vector16_t m[64];
+  size_t i;
+
+  for (i = 0; i < 16; i += 4) {
+    const __m512i r0 = sha256_load_lanes16(blocks, 0, i);
+    const __m512i r1 = sha256_load_lanes16(blocks, 1, i);
+    const __m512i r2 = sha256_load_lanes16(blocks, 2, i);
+    const __m512i r3 = sha256_load_lanes16(blocks, 3, i);
+    const __m512i t0 = _mm512_unpacklo_epi32(r0, r1);
+    const __m512i t1 = _mm512_unpacklo_epi32(r2, r3);
+    const __m512i t2 = _mm512_unpackhi_epi32(r0, r1);
+    const __m512i t3 = _mm512_unpackhi_epi32(r2, r3);
+    m[i + 0] = (sha256_vector16_t)_mm512_unpacklo_epi64(t0, t1);
+    m[i + 1] = (sha256_vector16_t)_mm512_unpackhi_epi64(t0, t1);
+    m[i + 2] = (sha256_vector16_t)_mm512_unpacklo_epi64(t2, t3);
+    m[i + 3] = (sha256_vector16_t)_mm512_unpackhi_epi64(t2, t3);
+  }
+  RCUTILS_SHA256_LANES_TRANSFORM(sha256_vector16_t, state, m);
+}
+#endif
+
+// A message being hashed in a lane: its full blocks are read directly from it, and the rest
+// of it is copied with the padding into final_blocks.
+typedef struct sha256_lane_s
+{
+  size_t message;
+  const uint8_t * data;
+  size_t block_count;
+  size_t final_block_index;
+  size_t final_block_count;
+  uint8_t final_blocks[128];
+} sha256_lane_t;
+
+static void sha256_lane_start(
+  sha256_lane_t * lane, size_t message, const uint8_t * data, size_t len)
+{
+  size_t remaining = len % 64;
+  size_t i;
+  uint64_t bitlen = (uint64_t)len * 8;
+
+  lane->message = message;
+  lane->data = data;
+  lane->block_count = len / 64;
+  lane->final_block_index = 0;
+  lane->final_block_count = remaining < 56 ? 1 : 2;
+  if (remaining > 0) {
+    memcpy(lane->final_blocks, data + len - remaining, remaining);
+  }
+  lane->final_blocks[remaining] = 0x80;
+  memset(
+    lane->final_blocks + remaining + 1, 0, 64 * lane->final_block_count - 8 - remaining - 1);
+  for (i = 0; i < 8; ++i) {
+    lane->final_blocks[64 * lane->final_block_count - 1 - i] = (uint8_t)(bitlen >> (8 * i));
+  }
+}
+
+static const uint8_t * sha256_lane_next_block(sha256_lane_t * lane)
+{
+  const uint8_t * block;
+  if (lane->block_count > 0) {
+    block = lane->data;
+    lane->data += 64;
+    --lane->block_count;
+  } else {
+    block = lane->final_blocks + 64 * lane->final_block_index++;
+  }
+  return block;
+}
+
+// Write the big endian hash of the state words, which are stride words apart.
+static void sha256_write_hash(uint8_t * output_hash, const uint32_t * state, size_t stride)
+{
+  size_t i;
+  for (i = 0; i < 8; ++i) {
+    uint32_t word = state[i * stride];
+    output_hash[4 * i + 0] = (uint8_t)(word >> 24);
+    output_hash[4 * i + 1] = (uint8_t)(word >> 16);
+    output_hash[4 * i + 2] = (uint8_t)(word >> 8);
+    output_hash[4 * i + 3] = (uint8_t)(word);
+  }
+}
+
+static void sha256_hash_lanes(
+  const uint8_t * const * data, const size_t * data_lengths, size_t count,
+  uint8_t * output_hashes, sha256_lanes_transform_t transform, size_t lane_count)
+{
+  static const uint8_t idle_block[64] = {0};
+  sha256_lane_t lanes[RCUTILS_SHA256_MAX_LANES];
+  sha256_lanes_state_t state;
+  const uint8_t * blocks[RCUTILS_SHA256_MAX_LANES];
+  size_t next_message = 0;
+  size_t active_lanes = 0;
+  size_t lane, i;
+
+  for (lane = 0; lane < lane_count; ++lane) {
+    lanes[lane].message = SIZE_MAX;
+  }
+
+  for (;;) {
+    // Refill the lanes whose message is done with the next ones.
+    for (lane = 0; lane < lane_count && next_message < count; ++lane) {
+      if (SIZE_MAX != lanes[lane].message) {
+        continue;
+      }
+      sha256_lane_start(
+        &lanes[lane], next_message, data[next_message], data_lengths[next_message]);
+      for (i = 0; i < 8; ++i) {
+        state[i][lane] = g_sha256_initial_state[i];
+      }
+      ++next_message;
+      ++active_lanes;
+    }
+    if (0 == active_lanes) {
+      break;
+    }
+    if (next_message == count && active_lanes * 4 <= lane_count) {
+      // The vectors would be mostly idle, so finish the last messages one by one.
+      for (lane = 0; lane < lane_count; ++lane) {
+        sha256_lane_t * job = &lanes[lane];
+        uint32_t lane_state[8];
+        if (SIZE_MAX == job->message) {
+          continue;
+        }
+        for (i = 0; i < 8; ++i) {
+          lane_state[i] = state[i][lane];
+        }
+        if (job->block_count > 0) {
+          sha256_transform(lane_state, job->data, job->block_count);
+        }
+        sha256_transform(
+          lane_state, job->final_blocks + 64 * job->final_block_index,
+          job->final_block_count - job->final_block_index);
+        sha256_write_hash(
+          output_hashes + job->message * RCUTILS_SHA256_BLOCK_SIZE, lane_state, 1);
+      }
+      break;
+    }
+
+    for (lane = 0; lane < lane_count; ++lane) {
+      blocks[lane] = SIZE_MAX == lanes[lane].message ?
+        idle_block : sha256_lane_next_block(&lanes[lane]);
+    }
+    transform(state, blocks);
+
+    for (lane = 0; lane < lane_count; ++lane) {
+      sha256_lane_t * job = &lanes[lane];
+      if (SIZE_MAX == job->message || job->block_count > 0 ||
+        job->final_block_index < job->final_block_count)
+      {
+        continue;
+      }
+      sha256_write_hash(
+        output_hashes + job->message * RCUTILS_SHA256_BLOCK_SIZE, &state[0][lane],
+        RCUTILS_SHA256_MAX_LANES);
+      job->message = SIZE_MAX;
+      --active_lanes;
+    }
+  }
+}
+
+#endif  // defined(RCUTILS_SHA256_USE_LANES)
+
+static bool sha256_lane_count_is_supported(size_t lane_count)
+{
+  switch (lane_count) {
+    case 0:
+    case 1:
+      return true;
+#if defined(RCUTILS_SHA256_USE_LANES)
+    case 4:
+# if defined(RCUTILS_SHA256_USE_X86) && !defined(__SSE2__)
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("sse2");
+# else
+      return true;
+# endif
+#endif
+#if defined(RCUTILS_SHA256_USE_X86)
+    case 8:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+    case 16:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+      return false;
+  }
+}
+
+#if defined(RCUTILS_SHA256_USE_LANES)
+// The number of lanes used for batches, 0 until the processor is checked, or 1 if the
+// messages are better hashed one by one.
+static atomic_int g_rcutils_sha256_lane_count = ATOMIC_VAR_INIT(0);
+
+static int sha256_detect_lane_count(void)
+{
+  if (sha256_lane_count_is_supported(16)) {
+    return 16;
+  }
+#if defined(RCUTILS_SHA256_USE_X86) || defined(RCUTILS_SHA256_USE_ARMV8)
+  // The SHA instructions hash a single message faster than the narrower vectors do.
+  rcutils_sha256_implementation_t implementation = sha256_detect_implementation();
+  if (RCUTILS_SHA256_IMPLEMENTATION_SHANI == implementation ||
+    RCUTILS_SHA256_IMPLEMENTATION_ARMV8 == implementation)
+  {
+    return 1;
+  }
+#endif
+  if (sha256_lane_count_is_supported(8)) {
+    return 8;
+  }
+  return sha256_lane_count_is_supported(4) ? 4 : 1;
+}
+#endif  // defined(RCUTILS_SHA256_USE_LANES)
+
+void rcutils_sha256_batch(
+  const uint8_t * const * data, const size_t * data_lengths, size_t count,
+  uint8_t * output_hashes)
+{
+#if defined(RCUTILS_SHA256_USE_LANES)
+  int lane_count = 0;
+  if (count < 2) {
+    lane_count = 1;
+  } else {
+    rcutils_atomic_load(&g_rcutils_sha256_lane_count, lane_count);
+  }
+  if (0 == lane_count) {
+    lane_count = sha256_detect_lane_count();
+    rcutils_atomic_store(&g_rcutils_sha256_lane_count, lane_count);
+  }
+  switch (lane_count) {
+#if defined(RCUTILS_SHA256_USE_X86)
+    case 16:
+      sha256_hash_lanes(data, data_lengths, count, output_hashes, sha256_transform_lanes16, 16);
+      return;
+    case 8:
+      sha256_hash_lanes(data, data_lengths, count, output_hashes, sha256_transform_lanes8, 8);
+      return;
+#endif
+    case 4:
+      sha256_hash_lanes(data, data_lengths, count, output_hashes, sha256_transform_lanes4, 4);
+      return;
+    default:
+      break;
+  }
+#endif
+  for (size_t i = 0; i < count; ++i) {
+    rcutils_sha256_ctx_t ctx;
+    rcutils_sha256_init(&ctx);
+    rcutils_sha256_update(&ctx, data[i], data_lengths[i]);
+    rcutils_sha256_final(&ctx, output_hashes + i * RCUTILS_SHA256_BLOCK_SIZE);
+  }
+}
+
+bool rcutils_sha256_force_implementation(rcutils_sha256_implementation_t implementation)
+{
+  if (!sha256_implementation_is_supported(implementation)) {
+    return false;
+  }
+#if defined(RCUTILS_SHA256_USE_X86) || defined(RCUTILS_SHA256_USE_ARMV8)
+  rcutils_atomic_store(&g_rcutils_sha256_implementation, implementation);
+#endif
+  return true;
+}
+
+bool rcutils_sha256_force_lane_count(size_t lane_count)
+{
+  if (!sha256_lane_count_is_supported(lane_count)) {
+    return false;
+  }
+#if defined(RCUTILS_SHA256_USE_LANES)
+  rcutils_atomic_store(&g_rcutils_sha256_lane_count, (int)lane_count);
+#endif
+  return true;
+}
+
+static void sha256_file_update(const uint8_t * data, size_t size, void * state)
+{
+  rcutils_sha256_update((rcutils_sha256_ctx_t *)state, data, size);
+}
+
+rcutils_ret_t rcutils_sha256_file(
+  const char * file_path, rcutils_allocator_t allocator,
+  uint8_t output_hash[RCUTILS_SHA256_BLOCK_SIZE])
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(output_hash, RCUTILS_RET_INVALID_ARGUMENT);
+
+  rcutils_sha256_ctx_t ctx;
+  rcutils_sha256_init(&ctx);
+  rcutils_ret_t ret = rcutils_digest_file(file_path, sha256_file_update, &ctx, allocator);
+  if (RCUTILS_RET_OK == ret) {
+    rcutils_sha256_final(&ctx, output_hash);
+  }
+  return ret;
+}
+
+// The chunks are hashed this many at a time.
+#define RCUTILS_SHA256_TREE_BATCH_SIZE 16
+
+typedef struct sha256_tree_state_s
+{
+  // The digest of the chunk digests.
+  rcutils_sha256_ctx_t root;
+  // The chunk which the last piece of the file ended in the middle of.
+  rcutils_sha256_ctx_t chunk;
+  size_t chunk_size;
+  size_t chunk_filled;
+} sha256_tree_state_t;
+
+static void sha256_tree_finish_chunk(sha256_tree_state_t * tree)
+{
+  uint8_t chunk_hash[RCUTILS_SHA256_BLOCK_SIZE];
+  rcutils_sha256_final(&tree->chunk, chunk_hash);
+  rcutils_sha256_update(&tree->root, chunk_hash, sizeof(chunk_hash));
+  tree->chunk_filled = 0;
+}
+
+static void sha256_tree_update(const uint8_t * data, size_t size, void * state)
+{
+  sha256_tree_state_t * tree = (sha256_tree_state_t *)state;
+  const uint8_t * chunks[RCUTILS_SHA256_TREE_BATCH_SIZE];
+  size_t chunk_sizes[RCUTILS_SHA256_TREE_BATCH_SIZE];
+  uint8_t chunk_hashes[RCUTILS_SHA256_TREE_BATCH_SIZE * RCUTILS_SHA256_BLOCK_SIZE];
+  size_t chunk_count = 0;
+
+  // Complete the chunk left unfinished by the previous piece.
+  if (tree->chunk_filled > 0) {
+    size_t copy_size = min(tree->chunk_size - tree->chunk_filled, size);
+    rcutils_sha256_update(&tree->chunk, data, copy_size);
+    tree->chunk_filled += copy_size;
+    data += copy_size;
+    size -= copy_size;
+    if (tree->chunk_filled == tree->chunk_size) {
+      sha256_tree_finish_chunk(tree);
+    }
+  }
+
+  // Hash the chunks which are whole in this piece together.
+  while (size >= tree->chunk_size) {
+    chunks[chunk_count] = data;
+    chunk_sizes[chunk_count] = tree->chunk_size;
+    ++chunk_count;
+    data += tree->chunk_size;
+    size -= tree->chunk_size;
+    if (RCUTILS_SHA256_TREE_BATCH_SIZE == chunk_count || size < tree->chunk_size) {
+      rcutils_sha256_batch(chunks, chunk_sizes, chunk_count, chunk_hashes);
+      rcutils_sha256_update(
+        &tree->root, chunk_hashes, chunk_count * RCUTILS_SHA256_BLOCK_SIZE);
+      chunk_count = 0;
+    }
+  }
+
+  if (size > 0) {
+    rcutils_sha256_init(&tree->chunk);
+    rcutils_sha256_update(&tree->chunk, data, size);
+    tree->chunk_filled = size;
+  }
+}
+
+rcutils_ret_t rcutils_sha256_file_tree(
+  const char * file_path, size_t chunk_size, rcutils_allocator_t allocator,
+  uint8_t output_hash[RCUTILS_SHA256_BLOCK_SIZE])
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(output_hash, RCUTILS_RET_INVALID_ARGUMENT);
+  if (0 == chunk_size) {
+    RCUTILS_SET_ERROR_MSG("chunk_size must not be 0");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+
+  sha256_tree_state_t tree;
+  rcutils_sha256_init(&tree.root);
+  tree.chunk_size = chunk_size;
+  tree.chunk_filled = 0;
+  rcutils_ret_t ret = rcutils_digest_file(file_path, sha256_tree_update, &tree, allocator);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+  if (tree.chunk_filled > 0) {
+    sha256_tree_finish_chunk(&tree);
+  }
+  rcutils_sha256_final(&tree.root, output_hash);
+  return RCUTILS_RET_OK;
+}
@@ -17,11 +17,15 @@ extern "C"
 {
 #endif
 
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "rcutils/error_handling.h"
+#include "rcutils/find.h"
 #include "rcutils/format_string.h"
 #include "rcutils/logging_macros.h"
 #include "rcutils/split.h"
@@ -112,7 +116,7 @@ rcutils_split(
 fail:
   if (rcutils_string_array_fini(string_array) != RCUTILS_RET_OK) {
     RCUTILS_SAFE_FWRITE_TO_STDERR("failed to finalize string array during error handling: ");
-    RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_string().str);
+    RCUTILS_SAFE_FWRITE_TO_STDERR(rcutils_get_error_c_str());
     RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
     rcutils_reset_error();
   }
@@ -122,17 +126,114 @@ fail:
 }
 
 rcutils_ret_t
-rcutils_split_last(
+rcutils_split_tokenizer_init(
+  rcutils_split_tokenizer_t * tokenizer,
+  const char * str,
+  char delimiter)
+{
+  if (NULL == tokenizer) {
+    RCUTILS_SET_ERROR_MSG("tokenizer is null");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (NULL == str) {
+    str = "";
+  }
+  tokenizer->position = str;
+  tokenizer->end = str + strlen(str);
+  tokenizer->delimiter = delimiter;
+  return RCUTILS_RET_OK;
+}
+
+bool
+rcutils_split_tokenizer_next(
+  rcutils_split_tokenizer_t * tokenizer,
+  const char ** token,
+  size_t * token_length)
+{
+  if (NULL == tokenizer || NULL == token || NULL == token_length) {
+    return false;
+  }
+  const char * position = tokenizer->position;
+  const char * end = tokenizer->end;
+  // Delimiters are mostly single, so they are skipped one at a time.
+  while (position != end && *position == tokenizer->delimiter) {
+    ++position;
+  }
+  if (position == end) {
+    tokenizer->position = end;
+    return false;
+  }
+  size_t length = (size_t)(end - position);
+  size_t delimiter_index = rcutils_findn(position, tokenizer->delimiter, length);
+  if (SIZE_MAX != delimiter_index) {
+    length = delimiter_index;
+  }
+  *token = position;
+  *token_length = length;
+  tokenizer->position = position + length;
+  return true;
+}
+
+rcutils_ret_t
+rcutils_split_packed(
   const char * str,
   char delimiter,
   rcutils_allocator_t allocator,
   rcutils_string_array_t * string_array)
 {
-  if (NULL == str || strlen(str) == 0) {
+  if (NULL == string_array) {
+    RCUTILS_SET_ERROR_MSG("string_array is null");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (NULL == str || '\0' == *str) {
     *string_array = rcutils_get_zero_initialized_string_array();
     return RCUTILS_RET_OK;
   }
 
+  // Count the tokens and their characters first, so that they are allocated at once.
+  rcutils_split_tokenizer_t tokenizer;
+  rcutils_ret_t ret = rcutils_split_tokenizer_init(&tokenizer, str, delimiter);
+  assert(RCUTILS_RET_OK == ret);
+  const rcutils_split_tokenizer_t first_tokenizer = tokenizer;
+  size_t token_count = 0;
+  size_t characters_size = 0;
+  const char * token = NULL;
+  size_t token_length = 0;
+  while (rcutils_split_tokenizer_next(&tokenizer, &token, &token_length)) {
+    ++token_count;
+    characters_size += token_length + 1;
+  }
+
+  char * characters = NULL;
+  ret = rcutils_string_array_init_packed(
+    string_array, token_count, characters_size, &allocator, &characters);
+  if (RCUTILS_RET_OK != ret) {
+    // rcutils_string_array_init_packed should have already set an error message
+    return ret;
+  }
+
+  tokenizer = first_tokenizer;
+  for (size_t i = 0; i < token_count; ++i) {
+    bool found = rcutils_split_tokenizer_next(&tokenizer, &token, &token_length);
+    assert(found);
+    (void)found;
+    memcpy(characters, token, token_length);
+    characters[token_length] = '\0';
+    string_array->data[i] = characters;
+    characters += token_length + 1;
+  }
+
+  return RCUTILS_RET_OK;
+}
+
+// Compute the one or two tokens of rcutils_split_last(), as offsets and lengths into str.
+static size_t
+__split_last_tokens(
+  const char * str,
+  char delimiter,
+  size_t token_starts[2],
+  size_t token_lengths[2])
+{
   size_t string_size = strlen(str);
 
   // does it start with a delimiter?
@@ -154,54 +255,53 @@ rcutils_split_last(
     }
   }
 
-  rcutils_ret_t result_error;
   if (found_last == string_size) {
-    rcutils_ret_t ret = rcutils_string_array_init(string_array, 1, &allocator);
-    if (ret != RCUTILS_RET_OK) {
-      result_error = ret;
-      goto fail;
-    }
-    string_array->data[0] =
-      allocator.allocate((found_last - lhs_offset + 2) * sizeof(char), allocator.state);
-    if (NULL == string_array->data[0]) {
-      result_error = RCUTILS_RET_BAD_ALLOC;
-      goto fail;
-    }
-    snprintf(string_array->data[0], found_last - lhs_offset + 1, "%s", str + lhs_offset);
-  } else {
-    rcutils_ret_t ret = rcutils_string_array_init(string_array, 2, &allocator);
-    if (ret != RCUTILS_RET_OK) {
-      result_error = ret;
-      goto fail;
-    }
+    token_starts[0] = lhs_offset;
+    token_lengths[0] = string_size - lhs_offset;
+    return 1;
+  }
 
-    /*
-     * The extra +1 after 'found_last' is to compensate its position
-     * found_last is the index of the the last position the delimiter was found
-     * and not the actual position in terms of counting from 1
-     */
-    size_t inner_rhs_offset = (str[found_last - 1] == delimiter) ? 1 : 0;
-    string_array->data[0] = allocator.allocate(
-      (found_last + 1 - lhs_offset - inner_rhs_offset + 1) * sizeof(char),
-      allocator.state);
-    if (NULL == string_array->data[0]) {
-      result_error = RCUTILS_RET_BAD_ALLOC;
-      goto fail;
-    }
-    snprintf(
-      string_array->data[0], found_last + 1 - lhs_offset - inner_rhs_offset,
-      "%s", str + lhs_offset);
-
-    string_array->data[1] = allocator.allocate(
-      (string_size - found_last - rhs_offset + 1) * sizeof(char),
-      allocator.state);
-    if (NULL == string_array->data[1]) {
+  // Skip a delimiter right before the last one.
+  size_t inner_rhs_offset = (str[found_last - 1] == delimiter) ? 1 : 0;
+  token_starts[0] = lhs_offset;
+  token_lengths[0] = found_last > lhs_offset + inner_rhs_offset ?
+    found_last - lhs_offset - inner_rhs_offset : 0;
+  token_starts[1] = found_last + 1;
+  token_lengths[1] = string_size - found_last - 1 - rhs_offset;
+  return 2;
+}
+
+rcutils_ret_t
+rcutils_split_last(
+  const char * str,
+  char delimiter,
+  rcutils_allocator_t allocator,
+  rcutils_string_array_t * string_array)
+{
+  if (NULL == str || strlen(str) == 0) {
+    *string_array = rcutils_get_zero_initialized_string_array();
+    return RCUTILS_RET_OK;
+  }
+
+  size_t token_starts[2];
+  size_t token_lengths[2];
+  size_t token_count = __split_last_tokens(str, delimiter, token_starts, token_lengths);
+
+  rcutils_ret_t result_error;
+  rcutils_ret_t ret = rcutils_string_array_init(string_array, token_count, &allocator);
+  if (ret != RCUTILS_RET_OK) {
+    result_error = ret;
+    goto fail;
+  }
+  for (size_t i = 0; i < token_count; ++i) {
+    string_array->data[i] = allocator.allocate(
+      (token_lengths[i] + 1) * sizeof(char), allocator.state);
+    if (NULL == string_array->data[i]) {
       result_error = RCUTILS_RET_BAD_ALLOC;
       goto fail;
     }
-    snprintf(
-      string_array->data[1], string_size - found_last - rhs_offset, "%s",
-      str + found_last + 1);
+    memcpy(string_array->data[i], str + token_starts[i], token_lengths[i]);
+    string_array->data[i][token_lengths[i]] = '\0';
   }
 
   return RCUTILS_RET_OK;
@@ -209,11 +309,52 @@ rcutils_split_last(
 fail:
   if (rcutils_string_array_fini(string_array) != RCUTILS_RET_OK) {
     RCUTILS_LOG_ERROR(
-      "failed to clean up on error (leaking memory): '%s'", rcutils_get_error_string().str);
+      "failed to clean up on error (leaking memory): '%s'", rcutils_get_error_c_str());
   }
   return result_error;
 }
 
+rcutils_ret_t
+rcutils_split_last_packed(
+  const char * str,
+  char delimiter,
+  rcutils_allocator_t allocator,
+  rcutils_string_array_t * string_array)
+{
+  if (NULL == string_array) {
+    RCUTILS_SET_ERROR_MSG("string_array is null");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (NULL == str || '\0' == *str) {
+    *string_array = rcutils_get_zero_initialized_string_array();
+    return RCUTILS_RET_OK;
+  }
+
+  size_t token_starts[2];
+  size_t token_lengths[2];
+  size_t token_count = __split_last_tokens(str, delimiter, token_starts, token_lengths);
+  size_t characters_size = 0;
+  for (size_t i = 0; i < token_count; ++i) {
+    characters_size += token_lengths[i] + 1;
+  }
+
+  char * characters = NULL;
+  rcutils_ret_t ret = rcutils_string_array_init_packed(
+    string_array, token_count, characters_size, &allocator, &characters);
+  if (RCUTILS_RET_OK != ret) {
+    // rcutils_string_array_init_packed should have already set an error message
+    return ret;
+  }
+  for (size_t i = 0; i < token_count; ++i) {
+    memcpy(characters, str + token_starts[i], token_lengths[i]);
+    characters[token_lengths[i]] = '\0';
+    string_array->data[i] = characters;
+    characters += token_lengths[i] + 1;
+  }
+
+  return RCUTILS_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
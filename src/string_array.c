@@ -17,11 +17,13 @@ extern "C"
 {
 #endif
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "rcutils/allocator.h"
 #include "rcutils/error_handling.h"
+#include "rcutils/strdup.h"
 #include "rcutils/types/string_array.h"
 #include "rcutils/types/rcutils_ret.h"
 
@@ -59,6 +61,121 @@ rcutils_string_array_init(
   return RCUTILS_RET_OK;
 }
 
+// A packed string array is a single allocation starting with this header, followed by the
+// array of strings and then by the characters of the strings.
+// The allocator of the string array is replaced by one forwarding to the allocator given to
+// rcutils_string_array_init_packed(), whose state is the header, so that packed string arrays
+// are told apart by their allocator without a field in rcutils_string_array_t.
+typedef struct packed_string_array_header_s
+{
+  rcutils_allocator_t allocator;
+} packed_string_array_header_t;
+
+static
+void *
+__packed_allocate(size_t size, void * state)
+{
+  rcutils_allocator_t * allocator = &((packed_string_array_header_t *)state)->allocator;
+  return allocator->allocate(size, allocator->state);
+}
+
+static
+void
+__packed_deallocate(void * pointer, void * state)
+{
+  rcutils_allocator_t * allocator = &((packed_string_array_header_t *)state)->allocator;
+  allocator->deallocate(pointer, allocator->state);
+}
+
+static
+void *
+__packed_reallocate(void * pointer, size_t size, void * state)
+{
+  rcutils_allocator_t * allocator = &((packed_string_array_header_t *)state)->allocator;
+  return allocator->reallocate(pointer, size, allocator->state);
+}
+
+static
+void *
+__packed_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  rcutils_allocator_t * allocator = &((packed_string_array_header_t *)state)->allocator;
+  return allocator->zero_allocate(number_of_elements, size_of_element, allocator->state);
+}
+
+// Return the header of a packed string array, or NULL if it isn't packed.
+static
+packed_string_array_header_t *
+__get_packed_header(const rcutils_string_array_t * string_array)
+{
+  if (__packed_allocate != string_array->allocator.allocate) {
+    return NULL;
+  }
+  return (packed_string_array_header_t *)string_array->allocator.state;
+}
+
+rcutils_ret_t
+rcutils_string_array_init_packed(
+  rcutils_string_array_t * string_array,
+  size_t size,
+  size_t characters_size,
+  const rcutils_allocator_t * allocator,
+  char ** characters)
+{
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CAN_RETURN_WITH_ERROR_OF(RCUTILS_RET_BAD_ALLOC);
+
+  if (NULL == allocator) {
+    RCUTILS_SET_ERROR_MSG("allocator is null");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (NULL == string_array) {
+    RCUTILS_SET_ERROR_MSG("string_array is null");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  if (NULL == characters) {
+    RCUTILS_SET_ERROR_MSG("characters is null");
+    return RCUTILS_RET_INVALID_ARGUMENT;
+  }
+  const size_t header_size = sizeof(packed_string_array_header_t);
+  if (size > (SIZE_MAX - characters_size - header_size) / sizeof(char *)) {
+    RCUTILS_SET_ERROR_MSG("string array size overflows");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  string_array->data = NULL;
+  string_array->size = size;
+  string_array->allocator = *allocator;
+  *characters = NULL;
+  if (0 == size && 0 == characters_size) {
+    // An empty string array needs no allocation, and is finalized like any other one.
+    return RCUTILS_RET_OK;
+  }
+
+  // The array of strings and then the characters are placed after the header, which keeps
+  // them all aligned.
+  packed_string_array_header_t * header = allocator->allocate(
+    header_size + size * sizeof(char *) + characters_size, allocator->state);
+  if (NULL == header) {
+    string_array->size = 0;
+    RCUTILS_SET_ERROR_MSG("failed to allocate string array");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  header->allocator = *allocator;
+  string_array->data = (char **)(header + 1);
+  for (size_t i = 0; i < size; ++i) {
+    string_array->data[i] = NULL;
+  }
+  if (0 != characters_size) {
+    *characters = (char *)(string_array->data + size);
+  }
+  string_array->allocator.allocate = __packed_allocate;
+  string_array->allocator.deallocate = __packed_deallocate;
+  string_array->allocator.reallocate = __packed_reallocate;
+  string_array->allocator.zero_allocate = __packed_zero_allocate;
+  string_array->allocator.state = header;
+  return RCUTILS_RET_OK;
+}
+
 rcutils_ret_t
 rcutils_string_array_fini(rcutils_string_array_t * string_array)
 {
@@ -78,6 +195,16 @@ rcutils_string_array_fini(rcutils_string_array_t * string_array)
     RCUTILS_SET_ERROR_MSG("allocator is invalid");
     return RCUTILS_RET_INVALID_ARGUMENT;
   }
+  packed_string_array_header_t * header = __get_packed_header(string_array);
+  if (NULL != header) {
+    // The string array gets back the allocator it was initialized with.
+    string_array->allocator = header->allocator;
+    allocator->deallocate(header, allocator->state);
+    string_array->data = NULL;
+    string_array->size = 0;
+    return RCUTILS_RET_OK;
+  }
+
   size_t i;
   for (i = 0; i < string_array->size; ++i) {
     allocator->deallocate(string_array->data[i], allocator->state);
@@ -138,6 +265,39 @@ rcutils_string_array_cmp(
   return RCUTILS_RET_OK;
 }
 
+// Resize a packed string array by copying the remaining strings into separate allocations.
+static
+rcutils_ret_t
+__string_array_resize_packed(
+  rcutils_string_array_t * string_array,
+  packed_string_array_header_t * header,
+  size_t new_size)
+{
+  rcutils_allocator_t * allocator = &header->allocator;
+  rcutils_string_array_t unpacked = rcutils_get_zero_initialized_string_array();
+  rcutils_ret_t ret = rcutils_string_array_init(&unpacked, new_size, allocator);
+  if (RCUTILS_RET_OK != ret) {
+    // rcutils_string_array_init should have already set an error message
+    return ret;
+  }
+  size_t copied_size = new_size < string_array->size ? new_size : string_array->size;
+  for (size_t i = 0; i < copied_size; ++i) {
+    if (NULL == string_array->data[i]) {
+      continue;
+    }
+    unpacked.data[i] = rcutils_strdup(string_array->data[i], *allocator);
+    if (NULL == unpacked.data[i]) {
+      ret = rcutils_string_array_fini(&unpacked);
+      (void)ret;
+      RCUTILS_SET_ERROR_MSG("failed to allocate string array");
+      return RCUTILS_RET_BAD_ALLOC;
+    }
+  }
+  allocator->deallocate(header, allocator->state);
+  *string_array = unpacked;
+  return RCUTILS_RET_OK;
+}
+
 rcutils_ret_t
 rcutils_string_array_resize(
   rcutils_string_array_t * string_array,
@@ -154,6 +314,11 @@ rcutils_string_array_resize(
   RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
     allocator, "allocator is invalid", return RCUTILS_RET_INVALID_ARGUMENT);
 
+  packed_string_array_header_t * header = __get_packed_header(string_array);
+  if (NULL != header) {
+    return __string_array_resize_packed(string_array, header, new_size);
+  }
+
   // Stash entries being removed
   rcutils_string_array_t to_reclaim = rcutils_get_zero_initialized_string_array();
   if (new_size < string_array->size) {
@@ -0,0 +1,158 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THREAD_HELPERS_H_
+#define THREAD_HELPERS_H_
+
+// Mutexes and condition variables on top of the threads of the platform.
+// On Windows, windows.h must be included before.
+
+#include <stdbool.h>
+#include <stdint.h>
+#ifndef _WIN32
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#ifdef _WIN32
+typedef SRWLOCK rcutils_mutex_t;
+typedef CONDITION_VARIABLE rcutils_cond_t;
+typedef HANDLE rcutils_thread_t;
+
+static inline void mutex_init(rcutils_mutex_t * mutex)
+{
+  InitializeSRWLock(mutex);
+}
+
+static inline void mutex_fini(rcutils_mutex_t * mutex)
+{
+  (void)mutex;
+}
+
+static inline void mutex_lock(rcutils_mutex_t * mutex)
+{
+  AcquireSRWLockExclusive(mutex);
+}
+
+static inline void mutex_unlock(rcutils_mutex_t * mutex)
+{
+  ReleaseSRWLockExclusive(mutex);
+}
+
+static inline void cond_init(rcutils_cond_t * cond)
+{
+  InitializeConditionVariable(cond);
+}
+
+static inline void cond_fini(rcutils_cond_t * cond)
+{
+  (void)cond;
+}
+
+static inline void cond_signal(rcutils_cond_t * cond)
+{
+  WakeConditionVariable(cond);
+}
+
+static inline void cond_broadcast(rcutils_cond_t * cond)
+{
+  WakeAllConditionVariable(cond);
+}
+
+static inline void cond_wait(rcutils_cond_t * cond, rcutils_mutex_t * mutex)
+{
+  SleepConditionVariableSRW(cond, mutex, INFINITE, 0);
+}
+
+// Wait for the condition to be signaled, or for the timeout to expire, returning false then.
+static inline bool cond_timed_wait(rcutils_cond_t * cond, rcutils_mutex_t * mutex, int64_t timeout)
+{
+  DWORD milliseconds = (DWORD)((timeout + 999999) / 1000000);
+  return SleepConditionVariableSRW(cond, mutex, milliseconds, 0);
+}
+#else
+typedef pthread_mutex_t rcutils_mutex_t;
+typedef pthread_cond_t rcutils_cond_t;
+typedef pthread_t rcutils_thread_t;
+
+static inline void mutex_init(rcutils_mutex_t * mutex)
+{
+  pthread_mutex_init(mutex, NULL);
+}
+
+static inline void mutex_fini(rcutils_mutex_t * mutex)
+{
+  pthread_mutex_destroy(mutex);
+}
+
+static inline void mutex_lock(rcutils_mutex_t * mutex)
+{
+  pthread_mutex_lock(mutex);
+}
+
+static inline void mutex_unlock(rcutils_mutex_t * mutex)
+{
+  pthread_mutex_unlock(mutex);
+}
+
+static inline void cond_init(rcutils_cond_t * cond)
+{
+  pthread_cond_init(cond, NULL);
+}
+
+static inline void cond_fini(rcutils_cond_t * cond)
+{
+  pthread_cond_destroy(cond);
+}
+
+static inline void cond_signal(rcutils_cond_t * cond)
+{
+  pthread_cond_signal(cond);
+}
+
+static inline void cond_broadcast(rcutils_cond_t * cond)
+{
+  pthread_cond_broadcast(cond);
+}
+
+static inline void cond_wait(rcutils_cond_t * cond, rcutils_mutex_t * mutex)
+{
+  pthread_cond_wait(cond, mutex);
+}
+
+// Wait for the condition to be signaled, or for the timeout to expire, returning false then.
+static inline bool cond_timed_wait(rcutils_cond_t * cond, rcutils_mutex_t * mutex, int64_t timeout)
+{
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += (time_t)(timeout / 1000000000);
+  deadline.tv_nsec += (long)(timeout % 1000000000);
+  if (deadline.tv_nsec >= 1000000000) {
+    deadline.tv_sec += 1;
+    deadline.tv_nsec -= 1000000000;
+  }
+  return 0 == pthread_cond_timedwait(cond, mutex, &deadline);
+}
+#endif  // _WIN32
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // THREAD_HELPERS_H_
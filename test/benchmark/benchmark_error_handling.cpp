@@ -13,13 +13,117 @@
 // limitations under the License.
 
 #include <benchmark/benchmark.h>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <atomic>
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
 #include <string>
+#include <thread>
 
 #include "rcutils/error_handling.h"
 
+// The benchmarks report the number of allocations done per iteration through the allocator
+// given to rcutils_initialize_error_handling_thread_local_storage(), which is the only one
+// error_handling.c allocates with once a thread is initialized.
+
+static std::atomic<size_t> g_allocations{0};
+
+static void * counting_allocate(size_t size, void * state)
+{
+  (void)state;
+  ++g_allocations;
+  return malloc(size);
+}
+
+static void counting_deallocate(void * pointer, void * state)
+{
+  (void)state;
+  free(pointer);
+}
+
+static rcutils_allocator_t get_counting_allocator()
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  allocator.allocate = counting_allocate;
+  allocator.deallocate = counting_deallocate;
+  return allocator;
+}
+
+// Initialize the error handling of the calling thread with the counting allocator, and report
+// the number of allocations per iteration when destroyed.
+class ScopedAllocationCounter
+{
+public:
+  explicit ScopedAllocationCounter(benchmark::State & state)
+  : state_(state)
+  {
+    rcutils_ret_t ret =
+      rcutils_initialize_error_handling_thread_local_storage(get_counting_allocator());
+    assert(ret == RCUTILS_RET_OK);
+    (void)ret;
+    rcutils_reset_error();
+    initial_allocations_ = g_allocations;
+  }
+
+  ~ScopedAllocationCounter()
+  {
+    rcutils_reset_error();
+    state_.counters["allocations"] = benchmark::Counter(
+      static_cast<double>(g_allocations - initial_allocations_),
+      benchmark::Counter::kAvgIterations);
+  }
+
+private:
+  benchmark::State & state_;
+  size_t initial_allocations_;
+};
+
+// Redirect stderr to the null device, so that error handling reports don't flood the output.
+class ScopedNullStderr
+{
+public:
+  ScopedNullStderr()
+  {
+    fflush(stderr);
+#ifdef _WIN32
+    original_fd_ = _dup(_fileno(stderr));
+    int null_fd = _open("NUL", _O_WRONLY);
+    _dup2(null_fd, _fileno(stderr));
+    _close(null_fd);
+#else
+    original_fd_ = dup(fileno(stderr));
+    int null_fd = open("/dev/null", O_WRONLY);
+    dup2(null_fd, fileno(stderr));
+    close(null_fd);
+#endif
+  }
+
+  ~ScopedNullStderr()
+  {
+    fflush(stderr);
+#ifdef _WIN32
+    _dup2(original_fd_, _fileno(stderr));
+    _close(original_fd_);
+#else
+    dup2(original_fd_, fileno(stderr));
+    close(original_fd_);
+#endif
+  }
+
+private:
+  int original_fd_;
+};
+
 static void benchmark_err_handling(benchmark::State & state)
 {
+  ScopedAllocationCounter allocation_counter(state);
   for (auto _ : state) {
     rcutils_ret_t ret =
       rcutils_initialize_error_handling_thread_local_storage(rcutils_get_default_allocator());
@@ -32,3 +136,152 @@ static void benchmark_err_handling(benchmark::State & state)
 }
 
 BENCHMARK(benchmark_err_handling);
+
+// The error is set and reset without ever being read, like in a retry loop.
+static void benchmark_err_handling_set_literal(benchmark::State & state)
+{
+  ScopedAllocationCounter allocation_counter(state);
+  for (auto _ : state) {
+    RCUTILS_SET_ERROR_MSG_STATIC("no data");
+    rcutils_reset_error();
+  }
+}
+
+BENCHMARK(benchmark_err_handling_set_literal);
+
+static void benchmark_err_handling_set_copied(benchmark::State & state)
+{
+  ScopedAllocationCounter allocation_counter(state);
+  const std::string message = "no data";
+  for (auto _ : state) {
+    RCUTILS_SET_ERROR_MSG(message.c_str());
+    rcutils_reset_error();
+  }
+}
+
+BENCHMARK(benchmark_err_handling_set_copied);
+
+static void benchmark_err_handling_set_formatted(benchmark::State & state)
+{
+  ScopedAllocationCounter allocation_counter(state);
+  int i = 0;
+  for (auto _ : state) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING("failed to take sample %d from '%s'", i, "topic");
+    rcutils_reset_error();
+    ++i;
+  }
+}
+
+BENCHMARK(benchmark_err_handling_set_formatted);
+
+// Arg: whether the new message differs from the one being overwritten, in which case the
+// overwrite is reported to stderr if RCUTILS_REPORT_ERROR_HANDLING_ERRORS is enabled, the
+// default; build with it disabled to compare.
+static void benchmark_err_handling_overwrite(benchmark::State & state)
+{
+  ScopedAllocationCounter allocation_counter(state);
+  ScopedNullStderr null_stderr;
+  const std::string messages[] = {"first message", "second message"};
+  const size_t message_mask = state.range(0) ? 1u : 0u;
+  size_t i = 0;
+  rcutils_set_error_state(messages[0].c_str(), "file.c", 1);
+  for (auto _ : state) {
+    rcutils_set_error_state(messages[++i & message_mask].c_str(), "file.c", 1);
+  }
+}
+
+BENCHMARK(benchmark_err_handling_overwrite)->Arg(0)->Arg(1);
+
+// Arg: whether the error string was already formatted by a previous call.
+static void benchmark_err_handling_get_error_string(benchmark::State & state)
+{
+  ScopedAllocationCounter allocation_counter(state);
+  const std::string message = "no data";
+  RCUTILS_SET_ERROR_MSG(message.c_str());
+  const bool formatted = state.range(0) != 0;
+  for (auto _ : state) {
+    if (!formatted) {
+      RCUTILS_SET_ERROR_MSG(message.c_str());
+    }
+    rcutils_error_string_t error_string = rcutils_get_error_string();
+    benchmark::DoNotOptimize(error_string);
+  }
+}
+
+BENCHMARK(benchmark_err_handling_get_error_string)->Arg(0)->Arg(1);
+
+// Arg: whether the error string was already formatted by a previous call.
+static void benchmark_err_handling_get_error_c_str(benchmark::State & state)
+{
+  ScopedAllocationCounter allocation_counter(state);
+  const std::string message = "no data";
+  RCUTILS_SET_ERROR_MSG(message.c_str());
+  const bool formatted = state.range(0) != 0;
+  for (auto _ : state) {
+    if (!formatted) {
+      RCUTILS_SET_ERROR_MSG(message.c_str());
+    }
+    const char * error_string = rcutils_get_error_c_str();
+    benchmark::DoNotOptimize(error_string);
+  }
+}
+
+BENCHMARK(benchmark_err_handling_get_error_c_str)->Arg(0)->Arg(1);
+
+// Arg: 0 for RCUTILS_SET_ERROR_MSG_AND_APPEND_PREV_ERROR, 1 for the format string variant.
+static void benchmark_err_handling_append_prev_error(benchmark::State & state)
+{
+  ScopedAllocationCounter allocation_counter(state);
+  int i = 0;
+  if (state.range(0)) {
+    for (auto _ : state) {
+      RCUTILS_SET_ERROR_MSG("no data");
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING_AND_APPEND_PREV_ERROR("failed to take %d", i);
+      rcutils_reset_error();
+      ++i;
+    }
+  } else {
+    for (auto _ : state) {
+      RCUTILS_SET_ERROR_MSG("no data");
+      RCUTILS_SET_ERROR_MSG_AND_APPEND_PREV_ERROR("failed to take");
+      rcutils_reset_error();
+    }
+  }
+}
+
+BENCHMARK(benchmark_err_handling_append_prev_error)->Arg(0)->Arg(1);
+
+// Each iteration spawns a thread which uses error handling for the first time.
+// Arg: 0 for a thread which doesn't use error handling, as a baseline, 1 for a literal error
+// set by reference and read, and 2 for initializing the thread-local storage and copying an
+// error. Only the last one allocates with the counting allocator, so only it reports the
+// allocations.
+static void benchmark_err_handling_first_use_in_thread(benchmark::State & state)
+{
+  const int64_t use = state.range(0);
+  auto thread_function = [use]() {
+      if (1 == use) {
+        RCUTILS_SET_ERROR_MSG_STATIC("no data");
+        rcutils_error_string_t error_string = rcutils_get_error_string();
+        benchmark::DoNotOptimize(error_string);
+      } else if (2 == use) {
+        rcutils_ret_t ret =
+          rcutils_initialize_error_handling_thread_local_storage(get_counting_allocator());
+        assert(ret == RCUTILS_RET_OK);
+        (void)ret;
+        const std::string message = "no data";
+        RCUTILS_SET_ERROR_MSG(message.c_str());
+      }
+    };
+  const size_t initial_allocations = g_allocations;
+  for (auto _ : state) {
+    std::thread(thread_function).join();
+  }
+  if (2 == use) {
+    state.counters["allocations"] = benchmark::Counter(
+      static_cast<double>(g_allocations - initial_allocations),
+      benchmark::Counter::kAvgIterations);
+  }
+}
+
+BENCHMARK(benchmark_err_handling_first_use_in_thread)->Arg(0)->Arg(1)->Arg(2);
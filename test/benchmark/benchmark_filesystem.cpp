@@ -0,0 +1,359 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "rcutils/async_io.h"
+#include "rcutils/dir_walk.h"
+#include "rcutils/filesystem.h"
+#include "rcutils/mapped_file.h"
+#include "rcutils/path_builder.h"
+
+// A tree of directories, each holding small files, created for the duration of a benchmark.
+class ScopedBenchmarkTree
+{
+public:
+  ScopedBenchmarkTree(size_t dir_count, size_t files_per_dir)
+  : dir_count_(dir_count), files_per_dir_(files_per_dir)
+  {
+    char cwd[1024];
+    bool got_cwd = rcutils_get_cwd(cwd, sizeof(cwd));
+    assert(got_cwd);
+    (void)got_cwd;
+    root_ = std::string(cwd) + "/benchmark_filesystem_tree";
+    bool made = rcutils_mkdir(root_.c_str());
+    assert(made);
+    for (size_t dir = 0; dir < dir_count_; ++dir) {
+      made = rcutils_mkdir(dir_path(dir).c_str());
+      assert(made);
+      for (size_t file = 0; file < files_per_dir_; ++file) {
+        FILE * f = fopen(file_path(dir, file).c_str(), "wb");
+        assert(NULL != f);
+        fputs("some file content", f);
+        fclose(f);
+      }
+    }
+    (void)made;
+  }
+
+  ~ScopedBenchmarkTree()
+  {
+    for (size_t dir = 0; dir < dir_count_; ++dir) {
+      for (size_t file = 0; file < files_per_dir_; ++file) {
+        remove(file_path(dir, file).c_str());
+      }
+      remove_dir(dir_path(dir));
+    }
+    remove_dir(root_);
+  }
+
+  const char * path() const
+  {
+    return root_.c_str();
+  }
+
+  size_t file_count() const
+  {
+    return dir_count_ * files_per_dir_;
+  }
+
+  std::string dir_path(size_t dir) const
+  {
+    return root_ + "/dir" + std::to_string(dir);
+  }
+
+  std::string file_path(size_t dir, size_t file) const
+  {
+    return dir_path(dir) + "/file" + std::to_string(file) + ".txt";
+  }
+
+private:
+  static void remove_dir(const std::string & path)
+  {
+#ifdef _WIN32
+    _rmdir(path.c_str());
+#else
+    rmdir(path.c_str());
+#endif
+  }
+
+  std::string root_;
+  size_t dir_count_;
+  size_t files_per_dir_;
+};
+
+// Arg: the size counted, as a rcutils_directory_size_mode_t.
+static void benchmark_calculate_directory_size(benchmark::State & state)
+{
+  ScopedBenchmarkTree tree(100, 100);
+  const rcutils_directory_size_mode_t mode =
+    static_cast<rcutils_directory_size_mode_t>(state.range(0));
+  for (auto _ : state) {
+    uint64_t size = 0;
+    rcutils_ret_t ret = rcutils_calculate_directory_size_parallel(
+      tree.path(), 0, mode, 0, &size, rcutils_get_default_allocator());
+    assert(RCUTILS_RET_OK == ret);
+    (void)ret;
+    benchmark::DoNotOptimize(size);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tree.file_count()));
+}
+
+BENCHMARK(benchmark_calculate_directory_size)
+->Arg(RCUTILS_DIRECTORY_SIZE_APPARENT)->Arg(RCUTILS_DIRECTORY_SIZE_ALLOCATED)
+->Unit(benchmark::kMillisecond);
+
+static rcutils_dir_walk_action_t count_entry(
+  const rcutils_dir_walk_entry_t * entry, void * user_data)
+{
+  (void)entry;
+  ++*static_cast<std::atomic<size_t> *>(user_data);
+  return RCUTILS_DIR_WALK_CONTINUE;
+}
+
+// Arg: the number of threads walking.
+static void benchmark_dir_walk(benchmark::State & state)
+{
+  ScopedBenchmarkTree tree(100, 100);
+  rcutils_dir_walk_options_t options = rcutils_get_default_dir_walk_options();
+  options.thread_count = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    std::atomic<size_t> count{0};
+    rcutils_ret_t ret = rcutils_dir_walk(
+      tree.path(), &options, count_entry, &count, rcutils_get_default_allocator());
+    assert(RCUTILS_RET_OK == ret);
+    (void)ret;
+    benchmark::DoNotOptimize(count.load());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tree.file_count()));
+}
+
+BENCHMARK(benchmark_dir_walk)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Arg: the size of the buffer the entries are read into, or 0 for rcutils_dir_iter_start().
+static void benchmark_dir_iter(benchmark::State & state)
+{
+  ScopedBenchmarkTree tree(1, 10000);
+  const std::string dir = std::string(tree.path()) + "/dir0";
+  std::string buffer(static_cast<size_t>(state.range(0)), '\0');
+  for (auto _ : state) {
+    rcutils_dir_iter_t * iter = buffer.empty() ?
+      rcutils_dir_iter_start(dir.c_str(), rcutils_get_default_allocator()) :
+      rcutils_dir_iter_start_with_buffer(
+      dir.c_str(), &buffer[0], buffer.size(), rcutils_get_default_allocator());
+    assert(NULL != iter);
+    size_t count = 0;
+    do {
+      count += RCUTILS_FILE_TYPE_REGULAR == iter->entry_type;
+    } while (rcutils_dir_iter_next(iter));
+    rcutils_dir_iter_end(iter);
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tree.file_count()));
+}
+
+BENCHMARK(benchmark_dir_iter)->Arg(0)->Arg(4096)->Arg(65536)->Unit(benchmark::kMicrosecond);
+
+// A file of the given size, created for the duration of a benchmark.
+class ScopedBenchmarkFile
+{
+public:
+  explicit ScopedBenchmarkFile(size_t size)
+  : path_("benchmark_filesystem_file"), size_(size)
+  {
+    FILE * f = fopen(path_.c_str(), "wb");
+    assert(NULL != f);
+    std::string chunk(1024 * 1024, 'x');
+    for (size_t written = 0; written < size_; written += chunk.size()) {
+      fwrite(chunk.data(), 1, chunk.size(), f);
+    }
+    fclose(f);
+  }
+
+  ~ScopedBenchmarkFile()
+  {
+    remove(path_.c_str());
+  }
+
+  const char * path() const
+  {
+    return path_.c_str();
+  }
+
+  size_t size() const
+  {
+    return size_;
+  }
+
+private:
+  std::string path_;
+  size_t size_;
+};
+
+// Read a 64 MiB file into memory with fread(), to compare with mapping it.
+static void benchmark_read_file(benchmark::State & state)
+{
+  ScopedBenchmarkFile file(64 * 1024 * 1024);
+  std::string contents(file.size(), '\0');
+  for (auto _ : state) {
+    FILE * f = fopen(file.path(), "rb");
+    assert(NULL != f);
+    size_t read_size = fread(&contents[0], 1, contents.size(), f);
+    assert(read_size == contents.size());
+    (void)read_size;
+    fclose(f);
+    benchmark::DoNotOptimize(contents[contents.size() - 1]);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(file.size()));
+}
+
+BENCHMARK(benchmark_read_file)->Unit(benchmark::kMillisecond);
+
+// Map a 64 MiB file and read a byte of each page.
+// Arg: the flags given to rcutils_mapped_file_open().
+static void benchmark_mapped_file(benchmark::State & state)
+{
+  ScopedBenchmarkFile file(64 * 1024 * 1024);
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  const uint32_t flags = static_cast<uint32_t>(state.range(0));
+  for (auto _ : state) {
+    rcutils_mapped_file_t mapped_file = rcutils_get_zero_initialized_mapped_file();
+    rcutils_ret_t ret = rcutils_mapped_file_open(&mapped_file, file.path(), flags, &allocator);
+    assert(RCUTILS_RET_OK == ret);
+    uint8_t sum = 0;
+    for (size_t offset = 0; offset < mapped_file.size; offset += 4096) {
+      sum = static_cast<uint8_t>(sum + mapped_file.data[offset]);
+    }
+    benchmark::DoNotOptimize(sum);
+    ret = rcutils_mapped_file_close(&mapped_file);
+    assert(RCUTILS_RET_OK == ret);
+    (void)ret;
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(file.size()));
+}
+
+BENCHMARK(benchmark_mapped_file)
+->Arg(RCUTILS_MAPPED_FILE_DEFAULT)->Arg(RCUTILS_MAPPED_FILE_POPULATE)
+->Unit(benchmark::kMillisecond);
+
+// Get the information about 10000 files with rcutils_async_io_t, submitting them 256 at a time.
+// Arg: the rcutils_async_io_backend_t used, or -1 to call stat() on the calling thread instead.
+static void benchmark_async_io_stat(benchmark::State & state)
+{
+  ScopedBenchmarkTree tree(10, 1000);
+  std::vector<std::string> paths;
+  for (size_t dir = 0; dir < 10; ++dir) {
+    for (size_t file = 0; file < 1000; ++file) {
+      paths.push_back(tree.file_path(dir, file));
+    }
+  }
+  std::vector<rcutils_file_stat_t> stats(paths.size());
+
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_async_io_t io = rcutils_get_zero_initialized_async_io();
+  if (state.range(0) >= 0) {
+    rcutils_async_io_options_t options = rcutils_get_default_async_io_options();
+    options.backend = static_cast<rcutils_async_io_backend_t>(state.range(0));
+    if (RCUTILS_RET_OK != rcutils_async_io_init(&io, &options, &allocator)) {
+      state.SkipWithError("The backend isn't available");
+      return;
+    }
+  }
+  std::vector<rcutils_async_io_request_t> requests(paths.size());
+  for (size_t i = 0; i < paths.size(); ++i) {
+    requests[i] = rcutils_async_io_request_t();
+    requests[i].operation = RCUTILS_ASYNC_IO_STAT;
+    requests[i].path = paths[i].c_str();
+    requests[i].stat = &stats[i];
+  }
+
+  for (auto _ : state) {
+    if (state.range(0) < 0) {
+      for (size_t i = 0; i < paths.size(); ++i) {
+        struct stat stat_buffer;
+        stat(paths[i].c_str(), &stat_buffer);
+        stats[i].size = static_cast<uint64_t>(stat_buffer.st_size);
+      }
+    } else {
+      for (size_t i = 0; i < requests.size(); i += 256) {
+        size_t count = requests.size() - i < 256 ? requests.size() - i : 256;
+        rcutils_ret_t ret = rcutils_async_io_submit(&io, &requests[i], count);
+        assert(RCUTILS_RET_OK == ret);
+        (void)ret;
+      }
+      rcutils_ret_t ret = rcutils_async_io_wait(&io, SIZE_MAX, -1, NULL);
+      assert(RCUTILS_RET_OK == ret);
+      (void)ret;
+    }
+    benchmark::DoNotOptimize(stats[stats.size() - 1].size);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(paths.size()));
+  rcutils_ret_t ret = rcutils_async_io_fini(&io);
+  (void)ret;
+}
+
+BENCHMARK(benchmark_async_io_stat)
+->Arg(-1)->Arg(RCUTILS_ASYNC_IO_BACKEND_IO_URING)->Arg(RCUTILS_ASYNC_IO_BACKEND_THREAD_POOL)
+->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Arg: 0 to join the paths with rcutils_join_path(), or 1 with a reused rcutils_path_builder_t.
+static void benchmark_join_path(benchmark::State & state)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  const char * base = "/opt/ros/rolling/share/rcutils/cmake";
+  std::vector<std::string> names;
+  for (size_t i = 0; i < 1000; ++i) {
+    names.push_back("entry" + std::to_string(i) + ".txt");
+  }
+  rcutils_path_builder_t builder = rcutils_get_zero_initialized_path_builder();
+  rcutils_ret_t ret = rcutils_path_builder_init(&builder, &allocator);
+  assert(RCUTILS_RET_OK == ret);
+  ret = rcutils_path_builder_set(&builder, base);
+  assert(RCUTILS_RET_OK == ret);
+  for (auto _ : state) {
+    size_t length = 0;
+    for (const std::string & name : names) {
+      if (0 == state.range(0)) {
+        char * path = rcutils_join_path(base, name.c_str(), allocator);
+        assert(NULL != path);
+        length += strlen(path);
+        allocator.deallocate(path, allocator.state);
+      } else {
+        ret = rcutils_path_builder_push(&builder, name.c_str());
+        assert(RCUTILS_RET_OK == ret);
+        length += builder.length;
+        rcutils_path_builder_pop(&builder);
+      }
+    }
+    benchmark::DoNotOptimize(length);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(names.size()));
+  ret = rcutils_path_builder_fini(&builder);
+  (void)ret;
+}
+
+BENCHMARK(benchmark_join_path)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
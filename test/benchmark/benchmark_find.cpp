@@ -0,0 +1,77 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "rcutils/find.h"
+
+// Every benchmark searches a string of the length given as argument, which has a single
+// delimiter in its middle, like the separator of a logger name.
+
+static std::string make_string(benchmark::State & state, char delimiter)
+{
+  std::string str(static_cast<size_t>(state.range(0)), 'a');
+  str[str.size() / 2] = delimiter;
+  return str;
+}
+
+static void benchmark_findn(benchmark::State & state)
+{
+  const std::string str = make_string(state, '.');
+  for (auto _ : state) {
+    size_t index = rcutils_findn(str.c_str(), '.', str.size());
+    benchmark::DoNotOptimize(index);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) / 2);
+}
+
+BENCHMARK(benchmark_findn)->Arg(8)->Arg(32)->Arg(256)->Arg(4096);
+
+static void benchmark_find_lastn(benchmark::State & state)
+{
+  const std::string str = make_string(state, '.');
+  for (auto _ : state) {
+    size_t index = rcutils_find_lastn(str.c_str(), '.', str.size());
+    benchmark::DoNotOptimize(index);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) / 2);
+}
+
+BENCHMARK(benchmark_find_lastn)->Arg(8)->Arg(32)->Arg(256)->Arg(4096);
+
+static void benchmark_find_anyn(benchmark::State & state)
+{
+  const std::string str = make_string(state, ':');
+  for (auto _ : state) {
+    size_t index = rcutils_find_anyn(str.c_str(), "/.:", str.size());
+    benchmark::DoNotOptimize(index);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) / 2);
+}
+
+BENCHMARK(benchmark_find_anyn)->Arg(8)->Arg(32)->Arg(256)->Arg(4096);
+
+static void benchmark_find_last_anyn(benchmark::State & state)
+{
+  const std::string str = make_string(state, ':');
+  for (auto _ : state) {
+    size_t index = rcutils_find_last_anyn(str.c_str(), "/.:", str.size());
+    benchmark::DoNotOptimize(index);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) / 2);
+}
+
+BENCHMARK(benchmark_find_last_anyn)->Arg(8)->Arg(32)->Arg(256)->Arg(4096);
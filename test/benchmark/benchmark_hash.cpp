@@ -0,0 +1,86 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rcutils/hash.h"
+#include "rcutils/types/hash_map.h"
+
+static std::vector<uint8_t> get_data(size_t size)
+{
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<uint8_t>(i * 31 + 7);
+  }
+  return data;
+}
+
+// Arg: the size of the data.
+static void benchmark_hash64(benchmark::State & state)
+{
+  const std::vector<uint8_t> data = get_data(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rcutils_hash64(data.data(), data.size(), 0));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(benchmark_hash64)->Arg(8)->Arg(32)->Arg(256)->Arg(4096)->Arg(65536);
+
+// Arg: the size of each update, for 64 KiB of data fed in pieces.
+static void benchmark_hash64_updates(benchmark::State & state)
+{
+  const std::vector<uint8_t> data = get_data(65536);
+  const size_t update_size = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    rcutils_hash64_state_t hash_state;
+    rcutils_hash64_init(&hash_state, 0);
+    for (size_t i = 0; i < data.size(); i += update_size) {
+      rcutils_hash64_update(&hash_state, data.data() + i, update_size);
+    }
+    benchmark::DoNotOptimize(rcutils_hash64_final(&hash_state));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+
+BENCHMARK(benchmark_hash64_updates)->Arg(16)->Arg(256)->Arg(4096);
+
+// The string hash of rcutils_hash_map_t, as a baseline for short keys.
+// Arg: the length of the string.
+static void benchmark_hash_map_string_hash(benchmark::State & state)
+{
+  const std::string key(static_cast<size_t>(state.range(0)), 'k');
+  const char * key_pointer = key.c_str();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rcutils_hash_map_string_hash_func(&key_pointer));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(benchmark_hash_map_string_hash)->Arg(8)->Arg(32)->Arg(256);
+
+// Arg: the size of the data.
+static void benchmark_crc32c(benchmark::State & state)
+{
+  const std::vector<uint8_t> data = get_data(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rcutils_crc32c(0, data.data(), data.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(benchmark_crc32c)->Arg(8)->Arg(64)->Arg(1024)->Arg(65536);
@@ -14,12 +14,17 @@
 
 #include <benchmark/benchmark.h>
 #include <cassert>
+#include <cstdarg>
+#include <cstdio>
 #include <string>
 #include <vector>
 
 #include "../allocator_testing_utils.h"
 #include "osrf_testing_tools_cpp/scope_exit.hpp"
+#include "rcutils/env.h"
 #include "rcutils/logging.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/types/char_array.h"
 
 size_t g_log_calls = 0;
 struct LogEvent
@@ -32,6 +37,62 @@ struct LogEvent
 };
 LogEvent g_last_log_event;
 
+// Output handler which does the same formatting work as the console output handler,
+// but discards the result instead of writing it to a stream.
+static void null_sink_output_handler(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args)
+{
+  char msg_buf[1024] = "";
+  rcutils_char_array_t msg_array = {
+    msg_buf, false, 0u, sizeof(msg_buf), rcutils_get_default_allocator()
+  };
+  char output_buf[1024] = "";
+  rcutils_char_array_t output_array = {
+    output_buf, false, 0u, sizeof(output_buf), rcutils_get_default_allocator()
+  };
+
+  rcutils_ret_t ret = rcutils_char_array_vsprintf(&msg_array, format, *args);
+  if (RCUTILS_RET_OK == ret) {
+    ret = rcutils_logging_format_message(
+      location, severity, name, timestamp, msg_array.buffer, &output_array);
+  }
+  benchmark::DoNotOptimize(ret);
+  benchmark::DoNotOptimize(output_array.buffer);
+  ret = rcutils_char_array_fini(&msg_array);
+  assert(ret == RCUTILS_RET_OK);
+  ret = rcutils_char_array_fini(&output_array);
+  assert(ret == RCUTILS_RET_OK);
+  (void)ret;
+}
+
+// Initialize logging with the null sink output handler for the lifetime of the object.
+class ScopedNullSinkLogging
+{
+public:
+  explicit ScopedNullSinkLogging(int default_level)
+  {
+    rcutils_ret_t ret = rcutils_logging_initialize();
+    assert(ret == RCUTILS_RET_OK);
+    (void)ret;
+    original_handler_ = rcutils_logging_get_output_handler();
+    rcutils_logging_set_output_handler(null_sink_output_handler);
+    rcutils_logging_set_default_logger_level(default_level);
+  }
+
+  ~ScopedNullSinkLogging()
+  {
+    rcutils_logging_set_output_handler(original_handler_);
+    rcutils_ret_t ret = rcutils_logging_shutdown();
+    assert(ret == RCUTILS_RET_OK);
+    (void)ret;
+  }
+
+private:
+  rcutils_logging_output_handler_t original_handler_;
+};
+
 static void benchmark_logging(benchmark::State & state)
 {
   for (auto _ : state) {
@@ -81,3 +142,190 @@ static void benchmark_logging(benchmark::State & state)
 }
 
 BENCHMARK(benchmark_logging);
+
+static void benchmark_log_disabled(benchmark::State & state)
+{
+  ScopedNullSinkLogging logging(RCUTILS_LOG_SEVERITY_WARN);
+  rcutils_log_location_t location = {"func", "file", 42u};
+
+  for (auto _ : state) {
+    rcutils_log(&location, RCUTILS_LOG_SEVERITY_DEBUG, "benchmark_logger", "message %d", 11);
+  }
+}
+
+BENCHMARK(benchmark_log_disabled);
+
+static void benchmark_log_macro_disabled(benchmark::State & state)
+{
+  ScopedNullSinkLogging logging(RCUTILS_LOG_SEVERITY_WARN);
+
+  for (auto _ : state) {
+    RCUTILS_LOG_DEBUG_NAMED("benchmark_logger", "message %d", 11);
+  }
+}
+
+BENCHMARK(benchmark_log_macro_disabled);
+
+static void benchmark_log_enabled_null_sink(benchmark::State & state)
+{
+  ScopedNullSinkLogging logging(RCUTILS_LOG_SEVERITY_DEBUG);
+  rcutils_log_location_t location = {"func", "file", 42u};
+
+  for (auto _ : state) {
+    rcutils_log(&location, RCUTILS_LOG_SEVERITY_INFO, "benchmark_logger", "message %d", 11);
+  }
+}
+
+BENCHMARK(benchmark_log_enabled_null_sink);
+
+static void benchmark_log_macro_enabled_null_sink(benchmark::State & state)
+{
+  ScopedNullSinkLogging logging(RCUTILS_LOG_SEVERITY_DEBUG);
+
+  for (auto _ : state) {
+    RCUTILS_LOG_INFO_NAMED("benchmark_logger", "message %d", 11);
+  }
+}
+
+BENCHMARK(benchmark_log_macro_enabled_null_sink);
+
+// Args: {depth of the logger hierarchy, number of unrelated loggers in the severity map}
+static void benchmark_effective_level(benchmark::State & state)
+{
+  ScopedNullSinkLogging logging(RCUTILS_LOG_SEVERITY_INFO);
+  const int64_t depth = state.range(0);
+  const int64_t map_size = state.range(1);
+
+  for (int64_t i = 0; i < map_size; ++i) {
+    rcutils_ret_t ret = rcutils_logging_set_logger_level(
+      ("unrelated_logger_" + std::to_string(i)).c_str(), RCUTILS_LOG_SEVERITY_WARN);
+    assert(ret == RCUTILS_RET_OK);
+    (void)ret;
+  }
+  // Only the root of the hierarchy has a level set, so the whole hierarchy is walked.
+  std::string name = "root";
+  rcutils_ret_t ret = rcutils_logging_set_logger_level(name.c_str(), RCUTILS_LOG_SEVERITY_DEBUG);
+  assert(ret == RCUTILS_RET_OK);
+  (void)ret;
+  for (int64_t i = 1; i < depth; ++i) {
+    name += ".child" + std::to_string(i);
+  }
+
+  for (auto _ : state) {
+    int level = rcutils_logging_get_logger_effective_level(name.c_str());
+    benchmark::DoNotOptimize(level);
+  }
+}
+
+BENCHMARK(benchmark_effective_level)
+->ArgsProduct({{1, 4, 16}, {0, 16, 1024}});
+
+static const char * const g_format_tokens[] = {
+  "{severity}",
+  "{name}",
+  "{message}",
+  "{function_name}",
+  "{file_name}",
+  "{time}",
+  "{date_time_with_ms}",
+  "{time_as_nanoseconds}",
+  "{line_number}",
+  "[{severity}] [{time}] [{name}]: {message}",
+};
+
+// Arg: index into g_format_tokens of the output format to use.
+static void benchmark_format_message(benchmark::State & state)
+{
+  const char * output_format = g_format_tokens[state.range(0)];
+  state.SetLabel(output_format);
+  bool env_set = rcutils_set_env("RCUTILS_CONSOLE_OUTPUT_FORMAT", output_format);
+  assert(env_set);
+  (void)env_set;
+  ScopedNullSinkLogging logging(RCUTILS_LOG_SEVERITY_DEBUG);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    bool env_unset = rcutils_set_env("RCUTILS_CONSOLE_OUTPUT_FORMAT", NULL);
+    assert(env_unset);
+    (void)env_unset;
+  });
+
+  rcutils_log_location_t location = {"func", "file", 42u};
+  char output_buf[1024] = "";
+  rcutils_char_array_t output_array = {
+    output_buf, false, 0u, sizeof(output_buf), rcutils_get_default_allocator()
+  };
+
+  for (auto _ : state) {
+    output_array.buffer_length = 0u;
+    rcutils_ret_t ret = rcutils_logging_format_message(
+      &location, RCUTILS_LOG_SEVERITY_INFO, "benchmark_logger", 1234567890123456789,
+      "message", &output_array);
+    benchmark::DoNotOptimize(ret);
+  }
+  rcutils_ret_t ret = rcutils_char_array_fini(&output_array);
+  assert(ret == RCUTILS_RET_OK);
+  (void)ret;
+}
+
+BENCHMARK(benchmark_format_message)
+->DenseRange(0, sizeof(g_format_tokens) / sizeof(g_format_tokens[0]) - 1);
+
+// Arg: length of the logged message in bytes.
+static void benchmark_log_long_message(benchmark::State & state)
+{
+  ScopedNullSinkLogging logging(RCUTILS_LOG_SEVERITY_DEBUG);
+  rcutils_log_location_t location = {"func", "file", 42u};
+  std::string message(static_cast<size_t>(state.range(0)), 'x');
+
+  for (auto _ : state) {
+    rcutils_log(
+      &location, RCUTILS_LOG_SEVERITY_INFO, "benchmark_logger", "%s", message.c_str());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(benchmark_log_long_message)
+->Arg(512)->Arg(1023)->Arg(1024)->Arg(4096)->Arg(16384);
+
+static ScopedNullSinkLogging * g_contention_logging = nullptr;
+
+static void benchmark_log_contention(benchmark::State & state)
+{
+  // Setup and teardown happen in the first thread, the other threads wait for it
+  // at the start and end of the benchmark loop.
+  if (state.thread_index() == 0) {
+    g_contention_logging = new ScopedNullSinkLogging(RCUTILS_LOG_SEVERITY_DEBUG);
+  }
+  rcutils_log_location_t location = {"func", "file", 42u};
+  std::string name = "benchmark_logger.thread" + std::to_string(state.thread_index());
+
+  for (auto _ : state) {
+    rcutils_log(&location, RCUTILS_LOG_SEVERITY_INFO, name.c_str(), "message %d", 11);
+  }
+
+  if (state.thread_index() == 0) {
+    delete g_contention_logging;
+    g_contention_logging = nullptr;
+  }
+}
+
+BENCHMARK(benchmark_log_contention)->ThreadRange(1, 64)->UseRealTime();
+
+static void benchmark_log_with_set_logger_level_churn(benchmark::State & state)
+{
+  ScopedNullSinkLogging logging(RCUTILS_LOG_SEVERITY_INFO);
+  rcutils_log_location_t location = {"func", "file", 42u};
+  const int levels[] = {RCUTILS_LOG_SEVERITY_DEBUG, RCUTILS_LOG_SEVERITY_WARN};
+  size_t i = 0;
+
+  for (auto _ : state) {
+    // rcutils_logging_set_logger_level() is not thread-safe with rcutils_log(), so the churn
+    // is interleaved with the logging calls rather than done from another thread.
+    rcutils_ret_t ret = rcutils_logging_set_logger_level("benchmark_logger", levels[i++ & 1]);
+    benchmark::DoNotOptimize(ret);
+    rcutils_log(
+      &location, RCUTILS_LOG_SEVERITY_INFO, "benchmark_logger.child", "message %d", 11);
+  }
+}
+
+BENCHMARK(benchmark_log_with_set_logger_level_churn);
@@ -0,0 +1,151 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <cassert>
+
+#include "rcutils/logging.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/logging_macros.hpp"
+#include "rcutils/time.h"
+
+// The benchmarks below are about the code expanded at each macro call site, so they
+// exercise many distinct call sites in one loop to make the instruction cache and branch
+// predictor footprint visible, rather than a single site which would always be hot.
+
+static void null_output_handler(
+  const rcutils_log_location_t *, int, const char *, rcutils_time_point_value_t,
+  const char *, va_list *)
+{
+}
+
+class ScopedMacroLogging
+{
+public:
+  explicit ScopedMacroLogging(int default_level)
+  {
+    rcutils_ret_t ret = rcutils_logging_initialize();
+    assert(ret == RCUTILS_RET_OK);
+    (void)ret;
+    original_handler_ = rcutils_logging_get_output_handler();
+    rcutils_logging_set_output_handler(null_output_handler);
+    rcutils_logging_set_default_logger_level(default_level);
+  }
+
+  ~ScopedMacroLogging()
+  {
+    rcutils_logging_set_output_handler(original_handler_);
+    rcutils_ret_t ret = rcutils_logging_shutdown();
+    assert(ret == RCUTILS_RET_OK);
+    (void)ret;
+  }
+
+private:
+  rcutils_logging_output_handler_t original_handler_;
+};
+
+#define BENCHMARK_MACRO_SITES(i) \
+  RCUTILS_LOG_DEBUG_NAMED("benchmark_logger", "message %d", i); \
+  RCUTILS_LOG_DEBUG_ONCE_NAMED("benchmark_logger", "message %d", i); \
+  RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(i > 3, "benchmark_logger", "message %d", i); \
+  RCUTILS_LOG_DEBUG_SKIPFIRST_NAMED("benchmark_logger", "message %d", i); \
+  RCUTILS_LOG_DEBUG_THROTTLE_NAMED( \
+    rcutils_steady_time_now, 1000, "benchmark_logger", "message %d", i); \
+  RCUTILS_LOG_DEBUG_SKIPFIRST_THROTTLE_NAMED( \
+    rcutils_steady_time_now, 1000, "benchmark_logger", "message %d", i);
+
+#define BENCHMARK_MACRO_SITES_X8(i) \
+  BENCHMARK_MACRO_SITES(i) BENCHMARK_MACRO_SITES(i) BENCHMARK_MACRO_SITES(i) \
+  BENCHMARK_MACRO_SITES(i) BENCHMARK_MACRO_SITES(i) BENCHMARK_MACRO_SITES(i) \
+  BENCHMARK_MACRO_SITES(i) BENCHMARK_MACRO_SITES(i)
+
+static constexpr int64_t kMacroSitesPerIteration = 6 * 8;
+
+// Arg: the default logger level, which decides whether the DEBUG call sites are enabled.
+static void benchmark_logging_macro_sites(benchmark::State & state)
+{
+  ScopedMacroLogging logging(static_cast<int>(state.range(0)));
+  int i = 0;
+
+  for (auto _ : state) {
+    BENCHMARK_MACRO_SITES_X8(i)
+    ++i;
+  }
+  state.SetItemsProcessed(state.iterations() * kMacroSitesPerIteration);
+}
+
+BENCHMARK(benchmark_logging_macro_sites)
+->Arg(RCUTILS_LOG_SEVERITY_WARN)->Arg(RCUTILS_LOG_SEVERITY_DEBUG);
+
+// Alternate between an enabled and a disabled logger so the severity check branch is
+// not trivially predictable.
+static void benchmark_logging_macro_alternating(benchmark::State & state)
+{
+  ScopedMacroLogging logging(RCUTILS_LOG_SEVERITY_INFO);
+  rcutils_ret_t ret = rcutils_logging_set_logger_level(
+    "benchmark_logger_enabled", RCUTILS_LOG_SEVERITY_DEBUG);
+  assert(ret == RCUTILS_RET_OK);
+  (void)ret;
+  const char * const names[] = {"benchmark_logger_enabled", "benchmark_logger_disabled"};
+  unsigned int i = 0;
+
+  for (auto _ : state) {
+    RCUTILS_LOG_DEBUG_NAMED(names[(i * 7u) % 3u & 1u], "message %u", i);
+    ++i;
+  }
+}
+
+BENCHMARK(benchmark_logging_macro_alternating);
+
+// Most throttled calls are dropped by the throttle condition itself.
+static void benchmark_logging_macro_throttled(benchmark::State & state)
+{
+  ScopedMacroLogging logging(RCUTILS_LOG_SEVERITY_DEBUG);
+  int i = 0;
+
+  for (auto _ : state) {
+    RCUTILS_LOG_DEBUG_THROTTLE_NAMED(
+      rcutils_steady_time_now, 1000, "benchmark_logger", "message %d", i);
+    ++i;
+  }
+}
+
+BENCHMARK(benchmark_logging_macro_throttled);
+
+// Compare the C macros, which hash the logger name on every call, with the C++ macros, which
+// hash it at compile time. A logger level is set so that the severity map isn't empty.
+static void benchmark_logging_macro_name_lookup(benchmark::State & state)
+{
+  ScopedMacroLogging logging(RCUTILS_LOG_SEVERITY_INFO);
+  rcutils_ret_t ret = rcutils_logging_set_logger_level(
+    "benchmark_logger.with_a.longer_name", RCUTILS_LOG_SEVERITY_WARN);
+  assert(ret == RCUTILS_RET_OK);
+  (void)ret;
+  int i = 0;
+
+  if (state.range(0)) {
+    for (auto _ : state) {
+      RCUTILS_CPP_LOG_INFO_NAMED("benchmark_logger.with_a.longer_name", "message %d", i);
+      ++i;
+    }
+  } else {
+    for (auto _ : state) {
+      RCUTILS_LOG_INFO_NAMED("benchmark_logger.with_a.longer_name", "message %d", i);
+      ++i;
+    }
+  }
+}
+
+// Arg: whether the C++ macros are used.
+BENCHMARK(benchmark_logging_macro_name_lookup)->Arg(0)->Arg(1);
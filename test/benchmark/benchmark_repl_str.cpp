@@ -0,0 +1,80 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <cassert>
+
+#include "rcutils/allocator.h"
+#include "rcutils/repl_str.h"
+
+static const char * const kFrom[] = {"$(env HOME)", "$(ns)", "$(node)", "~"};
+static const char * const kTo[] = {"/home/user", "/robot_1/perception", "front_camera", "/root"};
+static constexpr size_t kCount = sizeof(kFrom) / sizeof(kFrom[0]);
+static const char kSubstitution[] =
+  "$(ns)/$(node)/image_rect_color:=~/data/$(node)/image_rect_color_compressed/$(env HOME)";
+
+// Replace each string with a call to rcutils_repl_str(), as was needed before
+// rcutils_repl_str_multi().
+static void benchmark_repl_str_sequential(benchmark::State & state)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  for (auto _ : state) {
+    char * str = rcutils_repl_str(kSubstitution, kFrom[0], kTo[0], &allocator);
+    assert(nullptr != str);
+    for (size_t i = 1; i < kCount; ++i) {
+      char * replaced = rcutils_repl_str(str, kFrom[i], kTo[i], &allocator);
+      assert(nullptr != replaced);
+      allocator.deallocate(str, allocator.state);
+      str = replaced;
+    }
+    benchmark::DoNotOptimize(str);
+    allocator.deallocate(str, allocator.state);
+  }
+}
+
+BENCHMARK(benchmark_repl_str_sequential);
+
+static void benchmark_repl_str_multi(benchmark::State & state)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_repl_str_set_t set = rcutils_get_zero_initialized_repl_str_set();
+  rcutils_ret_t ret = rcutils_repl_str_set_init(&set, kFrom, kTo, kCount, &allocator);
+  assert(ret == RCUTILS_RET_OK);
+  for (auto _ : state) {
+    char * str = rcutils_repl_str_multi(kSubstitution, &set, &allocator);
+    assert(nullptr != str);
+    benchmark::DoNotOptimize(str);
+    allocator.deallocate(str, allocator.state);
+  }
+  ret = rcutils_repl_str_set_fini(&set);
+  assert(ret == RCUTILS_RET_OK);
+  (void)ret;
+}
+
+BENCHMARK(benchmark_repl_str_multi);
+
+static void benchmark_repl_str_set_init(benchmark::State & state)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  for (auto _ : state) {
+    rcutils_repl_str_set_t set = rcutils_get_zero_initialized_repl_str_set();
+    rcutils_ret_t ret = rcutils_repl_str_set_init(&set, kFrom, kTo, kCount, &allocator);
+    assert(ret == RCUTILS_RET_OK);
+    ret = rcutils_repl_str_set_fini(&set);
+    assert(ret == RCUTILS_RET_OK);
+    (void)ret;
+  }
+}
+
+BENCHMARK(benchmark_repl_str_set_init);
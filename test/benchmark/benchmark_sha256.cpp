@@ -0,0 +1,171 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "rcutils/sha256.h"
+
+static std::vector<uint8_t> get_data(size_t size)
+{
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<uint8_t>(i * 31 + 7);
+  }
+  return data;
+}
+
+// Arg: the size of the data hashed with a single update.
+static void benchmark_sha256(benchmark::State & state)
+{
+  const std::vector<uint8_t> data = get_data(static_cast<size_t>(state.range(0)));
+  uint8_t hash[RCUTILS_SHA256_BLOCK_SIZE];
+
+  for (auto _ : state) {
+    rcutils_sha256_ctx_t ctx;
+    rcutils_sha256_init(&ctx);
+    rcutils_sha256_update(&ctx, data.data(), data.size());
+    rcutils_sha256_final(&ctx, hash);
+    benchmark::DoNotOptimize(hash);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(benchmark_sha256)->Arg(64)->Arg(1024)->Arg(65536);
+
+// Arg: the size of each update, for 64 KiB of data fed in pieces, like a serialized message.
+static void benchmark_sha256_updates(benchmark::State & state)
+{
+  const std::vector<uint8_t> data = get_data(65536);
+  const size_t update_size = static_cast<size_t>(state.range(0));
+  uint8_t hash[RCUTILS_SHA256_BLOCK_SIZE];
+
+  for (auto _ : state) {
+    rcutils_sha256_ctx_t ctx;
+    rcutils_sha256_init(&ctx);
+    for (size_t i = 0; i < data.size(); i += update_size) {
+      size_t size = data.size() - i < update_size ? data.size() - i : update_size;
+      rcutils_sha256_update(&ctx, data.data() + i, size);
+    }
+    rcutils_sha256_final(&ctx, hash);
+    benchmark::DoNotOptimize(hash);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+
+BENCHMARK(benchmark_sha256_updates)->Arg(7)->Arg(100)->Arg(4096);
+
+// Args: the length of each of 1000 messages, and whether they are hashed with
+// rcutils_sha256_batch() rather than one by one.
+static void benchmark_sha256_batch(benchmark::State & state)
+{
+  const size_t length = static_cast<size_t>(state.range(0));
+  const size_t count = 1000;
+  const std::vector<uint8_t> data = get_data(length + count);
+  std::vector<const uint8_t *> messages(count);
+  std::vector<size_t> lengths(count, length);
+  for (size_t i = 0; i < count; ++i) {
+    messages[i] = data.data() + i;
+  }
+  std::vector<uint8_t> hashes(count * RCUTILS_SHA256_BLOCK_SIZE);
+
+  if (state.range(1)) {
+    for (auto _ : state) {
+      rcutils_sha256_batch(messages.data(), lengths.data(), count, hashes.data());
+      benchmark::DoNotOptimize(hashes.data());
+    }
+  } else {
+    for (auto _ : state) {
+      for (size_t i = 0; i < count; ++i) {
+        rcutils_sha256_ctx_t ctx;
+        rcutils_sha256_init(&ctx);
+        rcutils_sha256_update(&ctx, messages[i], lengths[i]);
+        rcutils_sha256_final(&ctx, hashes.data() + i * RCUTILS_SHA256_BLOCK_SIZE);
+      }
+      benchmark::DoNotOptimize(hashes.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(count * length));
+}
+
+BENCHMARK(benchmark_sha256_batch)
+->Args({32, 0})->Args({32, 1})
+->Args({256, 0})->Args({256, 1})
+->Args({1024, 0})->Args({1024, 1});
+
+// A file created for the duration of a benchmark, which stays in the page cache.
+class ScopedBenchmarkFile
+{
+public:
+  explicit ScopedBenchmarkFile(size_t size)
+  {
+    const std::vector<uint8_t> data = get_data(size);
+    FILE * file = fopen(path(), "wb");
+    assert(NULL != file);
+    size_t written = fwrite(data.data(), 1, data.size(), file);
+    assert(written == data.size());
+    (void)written;
+    fclose(file);
+  }
+
+  ~ScopedBenchmarkFile()
+  {
+    remove(path());
+  }
+
+  const char * path() const
+  {
+    return "benchmark_sha256_file.bin";
+  }
+};
+
+static constexpr size_t kFileSize = 64 * 1024 * 1024;
+
+// Arg: 0 for a loop of fread() with a 4 KiB buffer, as a baseline, 1 for rcutils_sha256_file(),
+// and 2 for rcutils_sha256_file_tree() with 1 MiB chunks.
+static void benchmark_sha256_file(benchmark::State & state)
+{
+  ScopedBenchmarkFile file(kFileSize);
+  const rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  uint8_t hash[RCUTILS_SHA256_BLOCK_SIZE];
+
+  for (auto _ : state) {
+    if (0 == state.range(0)) {
+      uint8_t buffer[4096];
+      rcutils_sha256_ctx_t ctx;
+      rcutils_sha256_init(&ctx);
+      FILE * stream = fopen(file.path(), "rb");
+      size_t size;
+      while ((size = fread(buffer, 1, sizeof(buffer), stream)) > 0) {
+        rcutils_sha256_update(&ctx, buffer, size);
+      }
+      fclose(stream);
+      rcutils_sha256_final(&ctx, hash);
+    } else {
+      rcutils_ret_t ret = 1 == state.range(0) ?
+        rcutils_sha256_file(file.path(), allocator, hash) :
+        rcutils_sha256_file_tree(file.path(), 1024 * 1024, allocator, hash);
+      assert(ret == RCUTILS_RET_OK);
+      (void)ret;
+    }
+    benchmark::DoNotOptimize(hash);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(kFileSize));
+}
+
+BENCHMARK(benchmark_sha256_file)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMillisecond);
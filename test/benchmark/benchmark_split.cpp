@@ -0,0 +1,85 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <cassert>
+#include <string>
+
+#include "rcutils/split.h"
+#include "rcutils/types/string_array.h"
+
+static const char kNamespacePath[] =
+  "/robot_1/perception/front_camera/image_rect_color/compressed/parameter_events";
+
+// Arg: whether the packed variant is used.
+static void benchmark_split(benchmark::State & state)
+{
+  const rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  auto split = state.range(0) ? rcutils_split_packed : rcutils_split;
+
+  for (auto _ : state) {
+    rcutils_string_array_t tokens = rcutils_get_zero_initialized_string_array();
+    rcutils_ret_t ret = split(kNamespacePath, '/', allocator, &tokens);
+    assert(ret == RCUTILS_RET_OK);
+    benchmark::DoNotOptimize(tokens.data);
+    ret = rcutils_string_array_fini(&tokens);
+    assert(ret == RCUTILS_RET_OK);
+    (void)ret;
+  }
+}
+
+BENCHMARK(benchmark_split)->Arg(0)->Arg(1);
+
+// Arg: whether the packed variant is used.
+static void benchmark_split_last(benchmark::State & state)
+{
+  const rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  auto split_last = state.range(0) ? rcutils_split_last_packed : rcutils_split_last;
+
+  for (auto _ : state) {
+    rcutils_string_array_t tokens = rcutils_get_zero_initialized_string_array();
+    rcutils_ret_t ret = split_last(kNamespacePath, '/', allocator, &tokens);
+    assert(ret == RCUTILS_RET_OK);
+    benchmark::DoNotOptimize(tokens.data);
+    ret = rcutils_string_array_fini(&tokens);
+    assert(ret == RCUTILS_RET_OK);
+    (void)ret;
+  }
+}
+
+BENCHMARK(benchmark_split_last)->Arg(0)->Arg(1);
+
+// Arg: the length of the tokens, in a path of 16 of them.
+static void benchmark_split_tokenizer(benchmark::State & state)
+{
+  std::string path;
+  for (size_t i = 0; i < 16; ++i) {
+    path += "/" + std::string(static_cast<size_t>(state.range(0)), 'a');
+  }
+
+  for (auto _ : state) {
+    rcutils_split_tokenizer_t tokenizer;
+    rcutils_ret_t ret = rcutils_split_tokenizer_init(&tokenizer, path.c_str(), '/');
+    assert(ret == RCUTILS_RET_OK);
+    (void)ret;
+    const char * token;
+    size_t token_length;
+    while (rcutils_split_tokenizer_next(&tokenizer, &token, &token_length)) {
+      benchmark::DoNotOptimize(token);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(path.size()));
+}
+
+BENCHMARK(benchmark_split_tokenizer)->Arg(4)->Arg(16)->Arg(64);
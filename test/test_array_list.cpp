@@ -462,3 +462,134 @@ TEST_F(ArrayListTest, list_add_bad_allocator_fails) {
   state.is_failing = false;
   EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_fini(&list));
 }
+
+TEST_F(ArrayListPreInitTest, add_n) {
+  const uint32_t data[] = {1, 2, 3, 4, 5};
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_add_n(&list, nullptr, 0));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_array_list_add_n(&list, nullptr, 1));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_array_list_add_n(&list, data, SIZE_MAX));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_array_list_add_n(nullptr, data, 1));
+  rcutils_reset_error();
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_array_list_add_n(&list, data, 5));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_array_list_add_n(&list, data, 2));
+  size_t size = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_get_size(&list, &size));
+  EXPECT_EQ(7u, size);
+  const uint32_t expected[] = {1, 2, 3, 4, 5, 1, 2};
+  for (size_t i = 0; i < size; ++i) {
+    uint32_t value = 0;
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_get(&list, i, &value));
+    EXPECT_EQ(expected[i], value);
+  }
+}
+
+TEST_F(ArrayListPreInitTest, reserve_and_shrink_to_fit) {
+  size_t capacity = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_get_capacity(&list, &capacity));
+  EXPECT_EQ(2u, capacity);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_array_list_get_capacity(&list, nullptr));
+  rcutils_reset_error();
+
+  // The capacity never decreases when reserving.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_reserve(&list, 1));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_get_capacity(&list, &capacity));
+  EXPECT_EQ(2u, capacity);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_reserve(&list, 100));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_get_capacity(&list, &capacity));
+  EXPECT_EQ(100u, capacity);
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_array_list_reserve(&list, SIZE_MAX));
+  rcutils_reset_error();
+
+  uint32_t data = 42;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_add(&list, &data));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_add(&list, &data));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_add(&list, &data));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_shrink_to_fit(&list));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_get_capacity(&list, &capacity));
+  EXPECT_EQ(3u, capacity);
+  uint32_t value = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_get(&list, 2, &value));
+  EXPECT_EQ(42u, value);
+
+  // The capacity of an empty list is shrunk to 1.
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_remove(&list, 0));
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_shrink_to_fit(&list));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_get_capacity(&list, &capacity));
+  EXPECT_EQ(1u, capacity);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_add(&list, &data));
+}
+
+TEST_F(ArrayListPreInitTest, swap_remove) {
+  const uint32_t data[] = {1, 2, 3, 4};
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_array_list_add_n(&list, data, 4));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_array_list_swap_remove(&list, 4));
+  rcutils_reset_error();
+
+  // The last entry takes the place of the removed one.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_swap_remove(&list, 1));
+  void * list_data = nullptr;
+  size_t size = 0;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_array_list_get_data(&list, &list_data, &size));
+  ASSERT_EQ(3u, size);
+  const uint32_t * values = static_cast<const uint32_t *>(list_data);
+  EXPECT_EQ(1u, values[0]);
+  EXPECT_EQ(4u, values[1]);
+  EXPECT_EQ(3u, values[2]);
+
+  // Removing the last entry doesn't move anything.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_swap_remove(&list, 2));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_swap_remove(&list, 0));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_swap_remove(&list, 0));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_get_size(&list, &size));
+  EXPECT_EQ(0u, size);
+}
+
+TEST_F(ArrayListPreInitTest, get_data) {
+  void * list_data = nullptr;
+  size_t size = 0;
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_array_list_get_data(&list, nullptr, &size));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_array_list_get_data(&list, &list_data, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_get_data(&list, &list_data, &size));
+  EXPECT_EQ(0u, size);
+
+  const uint32_t data[] = {1, 2, 3};
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_array_list_add_n(&list, data, 3));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_array_list_get_data(&list, &list_data, &size));
+  ASSERT_EQ(3u, size);
+  // The entries can be modified in place.
+  uint32_t * values = static_cast<uint32_t *>(list_data);
+  for (size_t i = 0; i < size; ++i) {
+    values[i] *= 10;
+  }
+  uint32_t value = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_get(&list, 2, &value));
+  EXPECT_EQ(30u, value);
+}
+
+TEST_F(ArrayListTest, reserve_bad_allocator_fails) {
+  allocator_state state;
+  state.is_failing = false;
+  failing_allocator.state = &state;
+  const uint32_t data[] = {1, 2, 3};
+
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_array_list_init(&list, 1, sizeof(uint32_t), &failing_allocator));
+  state.is_failing = true;
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_array_list_reserve(&list, 2));
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_array_list_add_n(&list, data, 3));
+  state.is_failing = false;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_add_n(&list, data, 3));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_swap_remove(&list, 0));
+  state.is_failing = true;
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_array_list_shrink_to_fit(&list));
+
+  state.is_failing = false;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_array_list_fini(&list));
+}
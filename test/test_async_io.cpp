@@ -0,0 +1,249 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "./allocator_testing_utils.h"
+#include "rcutils/async_io.h"
+#include "rcutils/error_handling.h"
+
+// The results given to the callbacks, by the index in user_data.
+struct Results
+{
+  std::vector<int64_t> results;
+  size_t calls = 0;
+};
+
+static void store_result(const rcutils_async_io_request_t * request, int64_t result)
+{
+  Results * results = static_cast<Results *>(request->user_data);
+  results->results.push_back(result);
+  ++results->calls;
+}
+
+static rcutils_async_io_request_t make_request(
+  rcutils_async_io_operation_t operation, Results * results)
+{
+  rcutils_async_io_request_t request{};
+  request.operation = operation;
+  request.fd = -1;
+  request.callback = store_result;
+  request.user_data = results;
+  return request;
+}
+
+class TestAsyncIo : public ::testing::TestWithParam<rcutils_async_io_backend_t>
+{
+public:
+  void SetUp() override
+  {
+    rcutils_async_io_options_t options = rcutils_get_default_async_io_options();
+    options.backend = GetParam();
+    options.queue_depth = 8;
+    options.thread_count = 2;
+    rcutils_ret_t ret = rcutils_async_io_init(&io, &options, &allocator);
+    if (RCUTILS_ASYNC_IO_BACKEND_IO_URING == GetParam() && RCUTILS_RET_ERROR == ret) {
+      rcutils_reset_error();
+      GTEST_SKIP() << "io_uring isn't available";
+    }
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+    if (RCUTILS_ASYNC_IO_BACKEND_AUTO != GetParam()) {
+      EXPECT_EQ(GetParam(), rcutils_async_io_get_backend(&io));
+    }
+    path = "test_async_io_" + std::to_string(static_cast<int>(GetParam()));
+  }
+
+  void TearDown() override
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_io_fini(&io));
+    remove(path.c_str());
+  }
+
+  // Submit a single request and wait for its result.
+  int64_t run(const rcutils_async_io_request_t & request)
+  {
+    Results * results = static_cast<Results *>(request.user_data);
+    const size_t calls = results->calls;
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_io_submit(&io, &request, 1));
+    size_t completions = 0;
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_io_wait(&io, 1, -1, &completions));
+    EXPECT_EQ(1u, completions);
+    EXPECT_EQ(calls + 1, results->calls);
+    return results->results.back();
+  }
+
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_async_io_t io = rcutils_get_zero_initialized_async_io();
+  std::string path;
+};
+
+TEST_P(TestAsyncIo, write_read_stat) {
+  Results results;
+  rcutils_async_io_request_t request = make_request(RCUTILS_ASYNC_IO_OPEN, &results);
+  request.path = path.c_str();
+  request.flags = RCUTILS_ASYNC_IO_OPEN_READ | RCUTILS_ASYNC_IO_OPEN_WRITE |
+    RCUTILS_ASYNC_IO_OPEN_CREATE | RCUTILS_ASYNC_IO_OPEN_TRUNCATE;
+  const int64_t fd = run(request);
+  ASSERT_GE(fd, 0);
+
+  std::string contents = "0123456789";
+  request = make_request(RCUTILS_ASYNC_IO_WRITE, &results);
+  request.fd = static_cast<int>(fd);
+  request.buffer = &contents[0];
+  request.length = contents.size();
+  request.offset = 5;
+  EXPECT_EQ(10, run(request));
+
+  request = make_request(RCUTILS_ASYNC_IO_FSYNC, &results);
+  request.fd = static_cast<int>(fd);
+  request.flags = RCUTILS_ASYNC_IO_FSYNC_DATA_ONLY;
+  EXPECT_EQ(0, run(request));
+
+  char buffer[32] = {};
+  request = make_request(RCUTILS_ASYNC_IO_READ, &results);
+  request.fd = static_cast<int>(fd);
+  request.buffer = buffer;
+  request.length = sizeof(buffer);
+  request.offset = 7;
+  EXPECT_EQ(8, run(request));
+  EXPECT_EQ("23456789", std::string(buffer));
+
+  rcutils_file_stat_t stat{};
+  request = make_request(RCUTILS_ASYNC_IO_STAT, &results);
+  request.path = path.c_str();
+  request.stat = &stat;
+  EXPECT_EQ(0, run(request));
+  EXPECT_EQ(RCUTILS_FILE_TYPE_REGULAR, stat.type);
+  EXPECT_EQ(15u, stat.size);
+  EXPECT_GT(stat.modification_time, 0);
+
+  request = make_request(RCUTILS_ASYNC_IO_CLOSE, &results);
+  request.fd = static_cast<int>(fd);
+  EXPECT_EQ(0, run(request));
+}
+
+TEST_P(TestAsyncIo, batch_larger_than_queue) {
+  // A file and a directory are stated many times, in a single batch.
+  constexpr size_t count = 100;
+  Results results;
+  std::vector<rcutils_file_stat_t> stats(count);
+  std::vector<rcutils_async_io_request_t> requests;
+  for (size_t i = 0; i < count; ++i) {
+    rcutils_async_io_request_t request = make_request(RCUTILS_ASYNC_IO_STAT, &results);
+    request.path = i % 2 ? "test/dummy_readable_file.txt" : "test";
+    request.stat = &stats[i];
+    requests.push_back(request);
+  }
+  // The requests which don't fit in the queue are submitted once earlier ones complete.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_io_submit(&io, requests.data(), requests.size()));
+  EXPECT_GE(results.calls, count - 8);
+  size_t completions = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_io_wait(&io, SIZE_MAX, -1, &completions));
+  EXPECT_EQ(count, results.calls);
+  EXPECT_LE(completions, 8u);
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(0, results.results[i]);
+    EXPECT_EQ(
+      i % 2 ? RCUTILS_FILE_TYPE_REGULAR : RCUTILS_FILE_TYPE_DIRECTORY, stats[i].type) << i;
+  }
+
+  // Nothing is left to wait for.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_io_wait(&io, SIZE_MAX, 1000000, &completions));
+  EXPECT_EQ(0u, completions);
+}
+
+TEST_P(TestAsyncIo, failures) {
+  Results results;
+  rcutils_file_stat_t stat{};
+  rcutils_async_io_request_t request = make_request(RCUTILS_ASYNC_IO_STAT, &results);
+  request.path = "test/non_existing_file.txt";
+  request.stat = &stat;
+  EXPECT_EQ(-ENOENT, run(request));
+
+  request = make_request(RCUTILS_ASYNC_IO_OPEN, &results);
+  request.path = "test/non_existing_file.txt";
+  request.flags = RCUTILS_ASYNC_IO_OPEN_READ;
+  EXPECT_EQ(-ENOENT, run(request));
+
+  char buffer[4];
+  request = make_request(RCUTILS_ASYNC_IO_READ, &results);
+  request.buffer = buffer;
+  request.length = sizeof(buffer);
+  EXPECT_LT(run(request), 0);
+}
+
+TEST_P(TestAsyncIo, invalid_arguments) {
+  Results results;
+  rcutils_async_io_request_t requests[2] = {
+    make_request(RCUTILS_ASYNC_IO_FSYNC, &results),
+    make_request(RCUTILS_ASYNC_IO_STAT, &results),
+  };
+  // The requests before the invalid one are submitted.
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_io_submit(&io, requests, 2));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_io_wait(&io, SIZE_MAX, -1, nullptr));
+  EXPECT_EQ(1u, results.calls);
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_io_submit(&io, nullptr, 1));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_io_submit(&io, nullptr, 0));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_io_submit(nullptr, requests, 1));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_io_wait(nullptr, 1, -1, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_io_init(&io, nullptr, &allocator));
+  rcutils_reset_error();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  Backends, TestAsyncIo,
+  ::testing::Values(
+    RCUTILS_ASYNC_IO_BACKEND_AUTO, RCUTILS_ASYNC_IO_BACKEND_IO_URING,
+    RCUTILS_ASYNC_IO_BACKEND_THREAD_POOL));
+
+TEST(TestAsyncIoInit, init_and_fini) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_async_io_t io = rcutils_get_zero_initialized_async_io();
+  EXPECT_EQ(RCUTILS_ASYNC_IO_BACKEND_AUTO, rcutils_async_io_get_backend(&io));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_io_fini(&io));
+
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_async_io_init(&io, nullptr, &failing_allocator));
+  rcutils_reset_error();
+  rcutils_allocator_t invalid_allocator = rcutils_get_zero_initialized_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_io_init(&io, nullptr, &invalid_allocator));
+  rcutils_reset_error();
+  rcutils_async_io_options_t options = rcutils_get_default_async_io_options();
+  options.queue_depth = 1000000;
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_async_io_init(&io, &options, &allocator));
+  rcutils_reset_error();
+
+  // The requests in progress are completed when finalizing.
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_async_io_init(&io, nullptr, &allocator));
+  Results results;
+  rcutils_file_stat_t stat{};
+  rcutils_async_io_request_t request = make_request(RCUTILS_ASYNC_IO_STAT, &results);
+  request.path = "test";
+  request.stat = &stat;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_io_submit(&io, &request, 1));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_async_io_fini(&io));
+  EXPECT_EQ(1u, results.calls);
+  EXPECT_EQ(nullptr, io.impl);
+}
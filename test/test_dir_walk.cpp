@@ -0,0 +1,316 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "./allocator_testing_utils.h"
+#include "rcutils/dir_walk.h"
+#include "rcutils/error_handling.h"
+
+#ifdef _WIN32
+static const char kSeparator[] = "\\";
+#else
+static const char kSeparator[] = "/";
+#endif
+
+struct FoundEntry
+{
+  size_t depth;
+  rcutils_file_type_t type;
+  uint64_t size;
+};
+
+// The entries found by a walk, by their path relative to the walked directory.
+struct WalkResult
+{
+  std::mutex mutex;
+  std::map<std::string, FoundEntry> entries;
+  size_t duplicates = 0;
+  std::atomic<size_t> calls{0};
+  // The entries given to the callback after these many stop the walk.
+  size_t stop_after = SIZE_MAX;
+  // The name of the directories not to walk into.
+  std::string skipped_name;
+};
+
+static rcutils_dir_walk_action_t record_entry(
+  const rcutils_dir_walk_entry_t * entry, void * user_data)
+{
+  WalkResult * result = static_cast<WalkResult *>(user_data);
+  std::string path = entry->directory;
+  if (!path.empty()) {
+    path += kSeparator;
+  }
+  path += entry->name;
+  FoundEntry found{entry->depth, entry->type, 0};
+  if (RCUTILS_FILE_TYPE_REGULAR == entry->type) {
+    rcutils_file_stat_t stat;
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_dir_walk_entry_stat(entry, &stat));
+    EXPECT_EQ(RCUTILS_FILE_TYPE_REGULAR, stat.type);
+    found.size = stat.size;
+  }
+  {
+    std::lock_guard<std::mutex> lock(result->mutex);
+    if (!result->entries.emplace(path, found).second) {
+      ++result->duplicates;
+    }
+  }
+  if (++result->calls >= result->stop_after) {
+    return RCUTILS_DIR_WALK_STOP;
+  }
+  if (entry->name == result->skipped_name) {
+    return RCUTILS_DIR_WALK_SKIP_SUBTREE;
+  }
+  return RCUTILS_DIR_WALK_CONTINUE;
+}
+
+class TestDirWalk : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    char cwd[1024];
+    ASSERT_TRUE(rcutils_get_cwd(cwd, sizeof(cwd)));
+    root_ = std::string(cwd) + kSeparator + "test_dir_walk_tree";
+    make_dir("");
+    // A wide and deep tree, so that several threads have directories to take from each other.
+    for (int i = 0; i < 8; ++i) {
+      const std::string dir = "dir" + std::to_string(i);
+      make_dir(dir);
+      make_file(dir + kSeparator + "file", i);
+      for (int j = 0; j < 4; ++j) {
+        const std::string subdir = dir + kSeparator + "sub" + std::to_string(j);
+        make_dir(subdir);
+        make_file(subdir + kSeparator + "a.txt", j);
+        make_file(subdir + kSeparator + "b.txt", 100);
+      }
+    }
+    make_file("top.txt", 10);
+  }
+
+  void TearDown() override
+  {
+    for (auto it = created_.rbegin(); it != created_.rend(); ++it) {
+      if (!it->second) {
+        std::remove(it->first.c_str());
+      } else {
+#ifdef _WIN32
+        _rmdir(it->first.c_str());
+#else
+        rmdir(it->first.c_str());
+#endif
+      }
+    }
+  }
+
+protected:
+  std::string path(const std::string & relative_path) const
+  {
+    return relative_path.empty() ? root_ : root_ + kSeparator + relative_path;
+  }
+
+  void make_dir(const std::string & relative_path)
+  {
+    ASSERT_TRUE(rcutils_mkdir(path(relative_path).c_str()));
+    created_.emplace_back(path(relative_path), true);
+  }
+
+  void make_file(const std::string & relative_path, size_t size)
+  {
+    FILE * file = std::fopen(path(relative_path).c_str(), "wb");
+    ASSERT_NE(nullptr, file);
+    for (size_t i = 0; i < size; ++i) {
+      std::fputc('x', file);
+    }
+    std::fclose(file);
+    created_.emplace_back(path(relative_path), false);
+  }
+
+#ifndef _WIN32
+  void make_symlink(const std::string & target, const std::string & relative_path)
+  {
+    ASSERT_EQ(0, symlink(target.c_str(), path(relative_path).c_str()));
+    created_.emplace_back(path(relative_path), false);
+  }
+#endif
+
+  rcutils_ret_t walk(WalkResult & result, const rcutils_dir_walk_options_t & options)
+  {
+    return rcutils_dir_walk(
+      root_.c_str(), &options, record_entry, &result, rcutils_get_default_allocator());
+  }
+
+  std::string root_;
+  // The paths created, and whether each is a directory.
+  std::vector<std::pair<std::string, bool>> created_;
+};
+
+TEST_F(TestDirWalk, all_entries) {
+  for (size_t thread_count : {0, 1, 4}) {
+    rcutils_dir_walk_options_t options = rcutils_get_default_dir_walk_options();
+    options.thread_count = thread_count;
+    WalkResult result;
+    ASSERT_EQ(RCUTILS_RET_OK, walk(result, options)) << thread_count;
+    EXPECT_EQ(0u, result.duplicates);
+    // 8 directories, with a file and 4 subdirectories of 2 files each, and a file.
+    EXPECT_EQ(8u * (1 + 1 + 4 * 3) + 1, result.entries.size());
+
+    const FoundEntry & top = result.entries["top.txt"];
+    EXPECT_EQ(1u, top.depth);
+    EXPECT_EQ(RCUTILS_FILE_TYPE_REGULAR, top.type);
+    EXPECT_EQ(10u, top.size);
+    const FoundEntry & dir = result.entries["dir3"];
+    EXPECT_EQ(1u, dir.depth);
+    EXPECT_EQ(RCUTILS_FILE_TYPE_DIRECTORY, dir.type);
+    const std::string sub = std::string("dir3") + kSeparator + "sub2";
+    EXPECT_EQ(2u, result.entries[sub].depth);
+    const FoundEntry & file = result.entries[sub + kSeparator + "a.txt"];
+    EXPECT_EQ(3u, file.depth);
+    EXPECT_EQ(RCUTILS_FILE_TYPE_REGULAR, file.type);
+    EXPECT_EQ(2u, file.size);
+  }
+}
+
+TEST_F(TestDirWalk, max_depth) {
+  rcutils_dir_walk_options_t options = rcutils_get_default_dir_walk_options();
+  options.max_depth = 1;
+  WalkResult result;
+  ASSERT_EQ(RCUTILS_RET_OK, walk(result, options));
+  EXPECT_EQ(9u, result.entries.size());
+
+  options.max_depth = 2;
+  WalkResult result2;
+  ASSERT_EQ(RCUTILS_RET_OK, walk(result2, options));
+  EXPECT_EQ(8u * (1 + 1 + 4) + 1, result2.entries.size());
+}
+
+TEST_F(TestDirWalk, skip_subtree) {
+  rcutils_dir_walk_options_t options = rcutils_get_default_dir_walk_options();
+  options.thread_count = 2;
+  WalkResult result;
+  result.skipped_name = "sub1";
+  ASSERT_EQ(RCUTILS_RET_OK, walk(result, options));
+  EXPECT_EQ(8u * (1 + 1 + 4 * 3 - 2) + 1, result.entries.size());
+  EXPECT_EQ(1u, result.entries.count(std::string("dir0") + kSeparator + "sub1"));
+  EXPECT_EQ(
+    0u, result.entries.count(
+      std::string("dir0") + kSeparator + "sub1" + kSeparator + "a.txt"));
+}
+
+TEST_F(TestDirWalk, stop) {
+  rcutils_dir_walk_options_t options = rcutils_get_default_dir_walk_options();
+  options.thread_count = 4;
+  WalkResult result;
+  result.stop_after = 5;
+  ASSERT_EQ(RCUTILS_RET_OK, walk(result, options));
+  // The other threads may each be giving an entry when the walk stops.
+  EXPECT_GE(result.calls.load(), 5u);
+  EXPECT_LE(result.calls.load(), 5u + 3u);
+}
+
+#ifndef _WIN32
+TEST_F(TestDirWalk, symlinks) {
+  make_symlink(path("dir1"), "link_to_dir1");
+  make_symlink(path("top.txt"), "link_to_file");
+  make_symlink(path(""), std::string("dir2") + kSeparator + "link_to_top");
+  make_symlink(path("missing"), "broken_link");
+
+  rcutils_dir_walk_options_t options = rcutils_get_default_dir_walk_options();
+  WalkResult result;
+  ASSERT_EQ(RCUTILS_RET_OK, walk(result, options));
+  EXPECT_EQ(8u * (1 + 1 + 4 * 3) + 1 + 4, result.entries.size());
+  EXPECT_EQ(RCUTILS_FILE_TYPE_SYMLINK, result.entries["link_to_dir1"].type);
+  EXPECT_EQ(RCUTILS_FILE_TYPE_SYMLINK, result.entries["link_to_file"].type);
+  EXPECT_EQ(RCUTILS_FILE_TYPE_SYMLINK, result.entries["broken_link"].type);
+
+  // Each directory is walked once, whichever path it is found with first.
+  options.symlinks = RCUTILS_DIR_WALK_SYMLINKS_FOLLOW;
+  options.thread_count = 1;
+  WalkResult followed;
+  ASSERT_EQ(RCUTILS_RET_OK, walk(followed, options));
+  EXPECT_EQ(0u, followed.duplicates);
+  EXPECT_EQ(RCUTILS_FILE_TYPE_DIRECTORY, followed.entries["link_to_dir1"].type);
+  EXPECT_EQ(RCUTILS_FILE_TYPE_REGULAR, followed.entries["link_to_file"].type);
+  EXPECT_EQ(10u, followed.entries["link_to_file"].size);
+  EXPECT_EQ(RCUTILS_FILE_TYPE_SYMLINK, followed.entries["broken_link"].type);
+  const std::string top_link = std::string("dir2") + kSeparator + "link_to_top";
+  EXPECT_EQ(RCUTILS_FILE_TYPE_DIRECTORY, followed.entries[top_link].type);
+  EXPECT_EQ(0u, followed.entries.count(top_link + kSeparator + "top.txt"));
+  size_t dir1_entries = 0;
+  size_t link_entries = 0;
+  for (const auto & entry : followed.entries) {
+    dir1_entries += entry.first.rfind("dir1/", 0) == 0;
+    link_entries += entry.first.rfind("link_to_dir1/", 0) == 0;
+  }
+  EXPECT_EQ(1u + 4u * 3u, dir1_entries + link_entries);
+}
+
+TEST_F(TestDirWalk, unreadable_directory) {
+  if (0 == geteuid()) {
+    GTEST_SKIP() << "Directories are always readable by root";
+  }
+  const std::string dir = path(std::string("dir4") + kSeparator + "sub3");
+  ASSERT_EQ(0, chmod(dir.c_str(), 0));
+  rcutils_dir_walk_options_t options = rcutils_get_default_dir_walk_options();
+  WalkResult result;
+  EXPECT_EQ(RCUTILS_RET_ERROR, walk(result, options));
+  EXPECT_TRUE(rcutils_error_is_set());
+  rcutils_reset_error();
+  ASSERT_EQ(0, chmod(dir.c_str(), 0755));
+}
+#endif
+
+TEST_F(TestDirWalk, invalid_arguments) {
+  WalkResult result;
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_dir_walk(nullptr, nullptr, record_entry, &result, allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_dir_walk(root_.c_str(), nullptr, nullptr, &result, allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_dir_walk(
+      root_.c_str(), nullptr, record_entry, &result, rcutils_get_zero_initialized_allocator()));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_dir_walk(root_.c_str(), nullptr, record_entry, &result, get_failing_allocator()));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR,
+    rcutils_dir_walk(path("missing").c_str(), nullptr, record_entry, &result, allocator));
+  EXPECT_TRUE(rcutils_error_is_set());
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_dir_walk_entry_stat(nullptr, nullptr));
+  rcutils_reset_error();
+}
@@ -12,7 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#include <atomic>
 #include <string>
+#include <thread>
 
 #include "./allocator_testing_utils.h"
 #include "gmock/gmock.h"
@@ -270,6 +276,41 @@ TEST(test_error_handling, recursive) {
   rcutils_reset_error();
 }
 
+TEST(test_error_handling, c_str) {
+  osrf_testing_tools_cpp::memory_tools::ScopedQuickstartGtest scoped_quickstart_gtest;
+  rcutils_ret_t ret =
+    rcutils_initialize_error_handling_thread_local_storage(rcutils_get_default_allocator());
+  ASSERT_EQ(ret, RCUTILS_RET_OK);
+  rcutils_reset_error();
+  EXPECT_STREQ("error not set", rcutils_get_error_c_str());
+
+  const std::string test_message = "test message";
+  rcutils_set_error_state(test_message.c_str(), "file.c", 1);
+  const char * error_string = nullptr;
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    error_string = rcutils_get_error_c_str();
+  });
+  EXPECT_STREQ("test message, at file.c:1", error_string);
+  // The string is formatted once, and not copied.
+  EXPECT_EQ(error_string, rcutils_get_error_c_str());
+  EXPECT_STREQ(rcutils_get_error_string().str, error_string);
+
+  rcutils_set_error_state_static("literal message", "file.c", 2);
+  EXPECT_STREQ("literal message, at file.c:2", rcutils_get_error_c_str());
+
+  // The previous error string can be used to set the next one.
+  RCUTILS_SET_ERROR_MSG_AND_APPEND_PREV_ERROR("outer");
+  EXPECT_THAT(
+    rcutils_get_error_c_str(), ::testing::StartsWith("outer: literal message, at file.c:2, at "));
+  RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING_AND_APPEND_PREV_ERROR("outermost %d", 3);
+  EXPECT_THAT(
+    rcutils_get_error_c_str(), ::testing::StartsWith("outermost 3: outer: literal message, at "));
+
+  rcutils_reset_error();
+  EXPECT_STREQ("error not set", rcutils_get_error_c_str());
+}
+
 TEST(test_error_handling, copy) {
   osrf_testing_tools_cpp::memory_tools::ScopedQuickstartGtest scoped_quickstart_gtest;
   rcutils_ret_t ret =
@@ -340,3 +381,291 @@ TEST(test_error_handling, overwrite) {
     rcutils_reset_error();
   });
 }
+
+TEST(test_error_handling, set_by_reference) {
+  osrf_testing_tools_cpp::memory_tools::ScopedQuickstartGtest scoped_quickstart_gtest;
+  rcutils_ret_t ret =
+    rcutils_initialize_error_handling_thread_local_storage(rcutils_get_default_allocator());
+  ASSERT_EQ(ret, RCUTILS_RET_OK);
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    rcutils_reset_error();
+  });
+
+  printf("The following errors from within error_handling.c are expected.\n");
+  rcutils_set_error_state_static(NULL, __FILE__, 42);
+  EXPECT_FALSE(rcutils_error_is_set());
+  rcutils_set_error_state_static("valid error message", NULL, 42);
+  EXPECT_FALSE(rcutils_error_is_set());
+
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    rcutils_set_error_state_static("static message", "static_file.c", 42);
+  });
+  EXPECT_TRUE(rcutils_error_is_set());
+  EXPECT_NO_MEMORY_OPERATIONS_BEGIN();
+  rcutils_error_string_t error_string = rcutils_get_error_string();
+  EXPECT_NO_MEMORY_OPERATIONS_END();
+  EXPECT_STREQ("static message, at static_file.c:42", error_string.str);
+  const rcutils_error_state_t * error_state = rcutils_get_error_state();
+  ASSERT_NE(nullptr, error_state);
+  EXPECT_STREQ("static message", error_state->message);
+  EXPECT_STREQ("static_file.c", error_state->file);
+  EXPECT_EQ(42u, error_state->line_number);
+
+  // The error state is copied on demand, even if the error string was never formatted.
+  rcutils_reset_error();
+  rcutils_set_error_state_static("another message", "another_file.c", 7);
+  error_state = rcutils_get_error_state();
+  EXPECT_STREQ("another message", error_state->message);
+  EXPECT_STREQ("another_file.c", error_state->file);
+  EXPECT_EQ(7u, error_state->line_number);
+
+  // Setting a copied error after one set by reference, and the other way around.
+  rcutils_reset_error();
+  rcutils_set_error_state_static("by reference", "file.c", 1);
+  rcutils_reset_error();
+  rcutils_set_error_state("by copy", "file.c", 2);
+  EXPECT_STREQ("by copy, at file.c:2", rcutils_get_error_string().str);
+  rcutils_reset_error();
+  rcutils_set_error_state_static("by reference", "file.c", 3);
+  EXPECT_STREQ("by reference, at file.c:3", rcutils_get_error_string().str);
+
+  // Setting the same message again isn't reported as an overwrite, and neither is
+  // reusing the message of the error state.
+  rcutils_set_error_state_static("by reference", "file.c", 4);
+  rcutils_set_error_state(rcutils_get_error_state()->message, "file.c", 5);
+  EXPECT_STREQ("by reference, at file.c:5", rcutils_get_error_string().str);
+
+  RCUTILS_SET_ERROR_MSG_AND_APPEND_PREV_ERROR("outer");
+  EXPECT_THAT(
+    rcutils_get_error_string().str,
+    ::testing::StartsWith("outer: by reference, at file.c:5, at "));
+
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    rcutils_reset_error();
+  });
+  EXPECT_FALSE(rcutils_error_is_set());
+  EXPECT_STREQ("", rcutils_get_error_state()->message);
+  EXPECT_STREQ("error not set", rcutils_get_error_string().str);
+
+  // The macro records its literal message and the file by reference.
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    RCUTILS_SET_ERROR_MSG_STATIC("macro message");
+  });
+  EXPECT_THAT(
+    rcutils_get_error_string().str,
+    ::testing::StartsWith("macro message, at " __FILE__ ":"));
+  rcutils_reset_error();
+}
+
+TEST(test_error_handling, error_chain) {
+  rcutils_reset_error();
+  EXPECT_EQ(0u, rcutils_get_error_chain_size());
+  EXPECT_EQ(nullptr, rcutils_get_error_chain_frame(0));
+  EXPECT_STREQ("error chain empty", rcutils_get_error_chain_string().str);
+
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    rcutils_push_error_frame(RCUTILS_RET_BAD_ALLOC, "root cause", "root.c", 1);
+    RCUTILS_PUSH_ERROR_FRAME(RCUTILS_RET_ERROR, "propagated");
+  });
+  ASSERT_EQ(2u, rcutils_get_error_chain_size());
+  EXPECT_EQ(0u, rcutils_get_error_chain_dropped_frame_count());
+  const rcutils_error_frame_t * frame = rcutils_get_error_chain_frame(0);
+  ASSERT_NE(nullptr, frame);
+  EXPECT_STREQ("root cause", frame->message);
+  EXPECT_STREQ("root.c", frame->file);
+  EXPECT_EQ(1u, frame->line_number);
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, frame->code);
+  frame = rcutils_get_error_chain_frame(1);
+  ASSERT_NE(nullptr, frame);
+  EXPECT_STREQ("propagated", frame->message);
+  EXPECT_EQ(RCUTILS_RET_ERROR, frame->code);
+  EXPECT_EQ(nullptr, rcutils_get_error_chain_frame(2));
+
+  rcutils_reset_error();
+  rcutils_push_error_frame(-3, "root cause", "root.c", 1);
+  rcutils_push_error_frame(RCUTILS_RET_ERROR, "outer", "outer.c", 22);
+  EXPECT_STREQ(
+    "outer (error code 2), at outer.c:22\n"
+    "  caused by: root cause (error code -3), at root.c:1",
+    rcutils_get_error_chain_string().str);
+
+  // Null arguments are ignored.
+  rcutils_push_error_frame(RCUTILS_RET_ERROR, nullptr, "file.c", 1);
+  rcutils_push_error_frame(RCUTILS_RET_ERROR, "message", nullptr, 1);
+  EXPECT_EQ(2u, rcutils_get_error_chain_size());
+
+  // Once the chain is full, the root cause and the most recent frames are kept.
+  rcutils_reset_error();
+  EXPECT_EQ(0u, rcutils_get_error_chain_size());
+  const char * messages[] = {"frame 0", "frame 1", "frame 2", "frame 3"};
+  const size_t frame_count = RCUTILS_ERROR_CHAIN_MAX_FRAMES + 5;
+  for (size_t i = 0; i < frame_count; ++i) {
+    rcutils_push_error_frame(RCUTILS_RET_ERROR, messages[i % 4], "file.c", i);
+  }
+  ASSERT_EQ(static_cast<size_t>(RCUTILS_ERROR_CHAIN_MAX_FRAMES), rcutils_get_error_chain_size());
+  EXPECT_EQ(5u, rcutils_get_error_chain_dropped_frame_count());
+  EXPECT_EQ(0u, rcutils_get_error_chain_frame(0)->line_number);
+  for (size_t i = 1; i < RCUTILS_ERROR_CHAIN_MAX_FRAMES; ++i) {
+    frame = rcutils_get_error_chain_frame(i);
+    ASSERT_NE(nullptr, frame);
+    EXPECT_EQ(i + 5u, frame->line_number);
+    EXPECT_STREQ(messages[(i + 5u) % 4], frame->message);
+  }
+  EXPECT_THAT(
+    std::string(rcutils_get_error_chain_string().str),
+    ::testing::EndsWith(
+      "\n  caused by: [5 frames dropped]\n  caused by: frame 0 (error code 2), at file.c:0"));
+
+  // The rendered chain is truncated.
+  rcutils_reset_error();
+  const std::string long_message(RCUTILS_ERROR_MESSAGE_MAX_LENGTH, 'a');
+  rcutils_push_error_frame(RCUTILS_RET_ERROR, long_message.c_str(), "file.c", 1);
+  rcutils_push_error_frame(RCUTILS_RET_ERROR, "outer", "file.c", 2);
+  rcutils_error_string_t chain = rcutils_get_error_chain_string();
+  EXPECT_EQ(RCUTILS_ERROR_MESSAGE_MAX_LENGTH - 1, strlen(chain.str));
+  EXPECT_THAT(std::string(chain.str), ::testing::StartsWith("outer (error code 2), at file.c:2\n"));
+
+  // The error chain is independent of the error state.
+  EXPECT_FALSE(rcutils_error_is_set());
+  rcutils_reset_error();
+  EXPECT_EQ(0u, rcutils_get_error_chain_size());
+}
+
+namespace
+{
+
+struct CountingAllocatorState
+{
+  std::atomic<size_t> allocations{0};
+  std::atomic<size_t> deallocations{0};
+};
+
+void *
+counting_allocate(size_t size, void * state)
+{
+  ++static_cast<CountingAllocatorState *>(state)->allocations;
+  return malloc(size);
+}
+
+void
+counting_deallocate(void * pointer, void * state)
+{
+  ++static_cast<CountingAllocatorState *>(state)->deallocations;
+  free(pointer);
+}
+
+}  // namespace
+
+TEST(test_error_handling, lazy_thread_local_storage) {
+  CountingAllocatorState state;
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  allocator.allocate = counting_allocate;
+  allocator.deallocate = counting_deallocate;
+  allocator.state = &state;
+
+  // The storage is allocated with the given allocator, and deallocated at thread exit.
+  std::thread(
+    [&allocator, &state]() {
+      rcutils_ret_t ret = rcutils_initialize_error_handling_thread_local_storage(allocator);
+      EXPECT_EQ(RCUTILS_RET_OK, ret);
+      EXPECT_EQ(1u, state.allocations);
+      ret = rcutils_initialize_error_handling_thread_local_storage(allocator);
+      EXPECT_EQ(RCUTILS_RET_OK, ret);
+      rcutils_set_error_state("copied message", "file.c", 1);
+      rcutils_push_error_frame(RCUTILS_RET_ERROR, "frame", "file.c", 2);
+      EXPECT_STREQ("copied message, at file.c:1", rcutils_get_error_string().str);
+      EXPECT_EQ(1u, rcutils_get_error_chain_size());
+      EXPECT_EQ(1u, state.allocations);
+      EXPECT_EQ(0u, state.deallocations);
+    }).join();
+  EXPECT_EQ(1u, state.deallocations);
+
+  // Errors set by reference don't need the storage.
+  std::thread(
+    [&allocator, &state]() {
+      EXPECT_FALSE(rcutils_error_is_set());
+      EXPECT_STREQ("", rcutils_get_error_state()->message);
+      EXPECT_EQ(0u, rcutils_get_error_chain_size());
+      EXPECT_EQ(nullptr, rcutils_get_error_chain_frame(0));
+      rcutils_set_error_state_static("literal message", "file.c", 3);
+      EXPECT_TRUE(rcutils_error_is_set());
+      EXPECT_STREQ("literal message, at file.c:3", rcutils_get_error_string().str);
+      rcutils_reset_error();
+      EXPECT_FALSE(rcutils_error_is_set());
+
+      // The given allocator is still used when initializing after errors were set.
+      rcutils_set_error_state_static("literal message", "file.c", 4);
+      rcutils_ret_t ret = rcutils_initialize_error_handling_thread_local_storage(allocator);
+      EXPECT_EQ(RCUTILS_RET_OK, ret);
+      EXPECT_EQ(2u, state.allocations);
+      EXPECT_STREQ("literal message", rcutils_get_error_state()->message);
+      EXPECT_EQ(4u, rcutils_get_error_state()->line_number);
+      rcutils_reset_error();
+    }).join();
+  EXPECT_EQ(2u, state.deallocations);
+
+  // When the storage cannot be allocated, errors can still be set by reference.
+  std::thread(
+    []() {
+      rcutils_ret_t ret =
+        rcutils_initialize_error_handling_thread_local_storage(get_failing_allocator());
+      EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, ret);
+      rcutils_set_error_state_static("literal message", "file.c", 5);
+      EXPECT_STREQ("literal message, at file.c:5", rcutils_get_error_string().str);
+      rcutils_reset_error();
+    }).join();
+}
+
+#ifndef _WIN32
+// The error handling seen by the destructor of a thread-specific key, once the error storage
+// of the exiting thread was deallocated.
+struct ErrorStateAtThreadExit
+{
+  pthread_key_t key;
+  int destructor_calls = 0;
+  bool error_is_set = true;
+  std::string message;
+  std::string error_string;
+};
+
+static ErrorStateAtThreadExit g_error_state_at_thread_exit;
+
+static void record_error_state_at_thread_exit(void * value)
+{
+  ErrorStateAtThreadExit & state = g_error_state_at_thread_exit;
+  if (1 == ++state.destructor_calls) {
+    // Set the key again, so that the destructor is called again once the ones of all the keys,
+    // including the one of the error storage, were called.
+    EXPECT_EQ(0, pthread_setspecific(state.key, value));
+    return;
+  }
+  state.error_is_set = rcutils_error_is_set();
+  state.message = rcutils_get_error_state()->message;
+  // Errors can still be set, with a new error storage.
+  rcutils_set_error_state("late message", "file.c", 2);
+  state.error_string = rcutils_get_error_string().str;
+  rcutils_reset_error();
+}
+
+TEST(test_error_handling, error_state_at_thread_exit) {
+  ErrorStateAtThreadExit & state = g_error_state_at_thread_exit;
+  ASSERT_EQ(0, pthread_key_create(&state.key, record_error_state_at_thread_exit));
+  std::thread(
+    [&state]() {
+      rcutils_set_error_state("copied message", "file.c", 1);
+      EXPECT_TRUE(rcutils_error_is_set());
+      EXPECT_EQ(0, pthread_setspecific(state.key, &state));
+    }).join();
+  EXPECT_EQ(0, pthread_key_delete(state.key));
+
+  EXPECT_EQ(2, state.destructor_calls);
+  EXPECT_FALSE(state.error_is_set);
+  EXPECT_EQ("", state.message);
+  EXPECT_EQ("late message, at file.c:2", state.error_string);
+}
+#endif
@@ -13,8 +13,18 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <set>
 #include <string>
+#include <thread>
 
 #include "rcutils/env.h"
 #include "rcutils/error_handling.h"
@@ -22,6 +32,7 @@
 
 #include "osrf_testing_tools_cpp/scope_exit.hpp"
 
+#include "./allocator_testing_utils.h"
 #include "./mocking_utils/filesystem.hpp"
 
 static rcutils_allocator_t g_allocator = rcutils_get_default_allocator();
@@ -520,6 +531,218 @@ TEST_F(TestFilesystemFixture, calculate_directory_size_with_recursion) {
   }
 }
 
+TEST_F(TestFilesystemFixture, calculate_directory_size_with_mode) {
+  char * path =
+    rcutils_join_path(this->test_path, "dummy_folder_with_subdir", g_allocator);
+  ASSERT_NE(nullptr, path);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    g_allocator.deallocate(path, g_allocator.state);
+  });
+  uint64_t size = 0;
+  rcutils_ret_t ret = rcutils_calculate_directory_size_with_mode(
+    path, 0, RCUTILS_DIRECTORY_SIZE_APPARENT, &size, g_allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+#ifdef WIN32
+  EXPECT_EQ(18u, size);
+#else
+  EXPECT_EQ(15u, size);
+#endif
+
+  ret = rcutils_calculate_directory_size_with_mode(
+    path, 2, RCUTILS_DIRECTORY_SIZE_APPARENT, &size, g_allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+#ifdef WIN32
+  EXPECT_EQ(12u, size);
+#else
+  EXPECT_EQ(10u, size);
+#endif
+
+  // Each file takes at least as much space on disk as its length, unless it is stored
+  // along with its metadata.
+  uint64_t allocated_size = 0;
+  ret = rcutils_calculate_directory_size_with_mode(
+    path, 0, RCUTILS_DIRECTORY_SIZE_ALLOCATED, &allocated_size, g_allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_TRUE(0u == allocated_size || allocated_size >= 15u) << allocated_size;
+
+  ret = rcutils_calculate_directory_size_with_mode(
+    path, 0, RCUTILS_DIRECTORY_SIZE_APPARENT, &size, get_failing_allocator());
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, ret);
+
+  ret = rcutils_calculate_directory_size_with_mode(
+    path, 0, RCUTILS_DIRECTORY_SIZE_APPARENT, nullptr, g_allocator);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+}
+
+#ifndef _WIN32
+// An allocator counting the calls made from another thread than the given one.
+struct thread_checking_allocator_state
+{
+  std::thread::id thread_id;
+  std::atomic<size_t> other_thread_calls{0};
+};
+
+static void check_allocator_thread(void * state)
+{
+  auto checking_state = static_cast<thread_checking_allocator_state *>(state);
+  if (std::this_thread::get_id() != checking_state->thread_id) {
+    ++checking_state->other_thread_calls;
+  } else {
+    // Give other threads, if any, the time to take some of the directories.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+static void * thread_checking_allocate(size_t size, void * state)
+{
+  check_allocator_thread(state);
+  return g_allocator.allocate(size, g_allocator.state);
+}
+
+static void thread_checking_deallocate(void * pointer, void * state)
+{
+  check_allocator_thread(state);
+  g_allocator.deallocate(pointer, g_allocator.state);
+}
+
+static void * thread_checking_reallocate(void * pointer, size_t size, void * state)
+{
+  check_allocator_thread(state);
+  return g_allocator.reallocate(pointer, size, g_allocator.state);
+}
+
+static void * thread_checking_zero_allocate(
+  size_t number_of_elements, size_t size_of_element, void * state)
+{
+  check_allocator_thread(state);
+  return g_allocator.zero_allocate(number_of_elements, size_of_element, g_allocator.state);
+}
+
+TEST_F(TestFilesystemFixture, calculate_directory_size_parallel) {
+  char * path = rcutils_join_path(this->test_path, "dummy_folder_parallel_size", g_allocator);
+  ASSERT_NE(nullptr, path);
+  const std::string dir(path);
+  g_allocator.deallocate(path, g_allocator.state);
+  ASSERT_TRUE(rcutils_mkdir(dir.c_str()));
+  // Enough subdirectories for several threads to take some of them.
+  const size_t subdir_count = 16;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    for (size_t i = 0; i < subdir_count; ++i) {
+      const std::string subdir = dir + "/subdir" + std::to_string(i);
+      unlink((subdir + "/file").c_str());
+      rmdir(subdir.c_str());
+    }
+    rmdir(dir.c_str());
+  });
+  for (size_t i = 0; i < subdir_count; ++i) {
+    const std::string subdir = dir + "/subdir" + std::to_string(i);
+    ASSERT_TRUE(rcutils_mkdir(subdir.c_str()));
+    FILE * f = fopen((subdir + "/file").c_str(), "w");
+    ASSERT_NE(nullptr, f);
+    fputs("0123456789", f);
+    fclose(f);
+  }
+
+  uint64_t size = 0;
+  rcutils_ret_t ret = rcutils_calculate_directory_size_parallel(
+    dir.c_str(), 0, RCUTILS_DIRECTORY_SIZE_APPARENT, 4, &size, g_allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_EQ(10u * subdir_count, size);
+  ret = rcutils_calculate_directory_size_parallel(
+    dir.c_str(), 0, RCUTILS_DIRECTORY_SIZE_APPARENT, 0, &size, g_allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_EQ(10u * subdir_count, size);
+  ret = rcutils_calculate_directory_size_parallel(
+    dir.c_str(), 1, RCUTILS_DIRECTORY_SIZE_APPARENT, 4, &size, g_allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_EQ(0u, size);
+
+  ret = rcutils_calculate_directory_size_parallel(
+    dir.c_str(), 0, RCUTILS_DIRECTORY_SIZE_APPARENT, 4, nullptr, g_allocator);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+  ret = rcutils_calculate_directory_size_parallel(
+    nullptr, 0, RCUTILS_DIRECTORY_SIZE_APPARENT, 4, &size, g_allocator);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+
+  // The other functions only call the allocator from the calling thread.
+  thread_checking_allocator_state state;
+  state.thread_id = std::this_thread::get_id();
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  allocator.allocate = thread_checking_allocate;
+  allocator.deallocate = thread_checking_deallocate;
+  allocator.reallocate = thread_checking_reallocate;
+  allocator.zero_allocate = thread_checking_zero_allocate;
+  allocator.state = &state;
+  ret = rcutils_calculate_directory_size_with_mode(
+    dir.c_str(), 0, RCUTILS_DIRECTORY_SIZE_ALLOCATED, &size, allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  ret = rcutils_calculate_directory_size_with_recursion(dir.c_str(), 0, &size, allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_EQ(10u * subdir_count, size);
+  EXPECT_EQ(0u, state.other_thread_calls.load());
+}
+
+TEST_F(TestFilesystemFixture, calculate_directory_size_follows_symlinks) {
+  char * path = rcutils_join_path(this->test_path, "dummy_folder_with_symlinks", g_allocator);
+  ASSERT_NE(nullptr, path);
+  const std::string dir(path);
+  g_allocator.deallocate(path, g_allocator.state);
+  ASSERT_TRUE(rcutils_mkdir(dir.c_str()));
+  const std::string file = dir + "/file";
+  const std::string subdir = dir + "/subdir";
+  const std::string subdir_file = subdir + "/file";
+  const std::string file_link = dir + "/file_link";
+  const std::string dir_link = dir + "/dir_link";
+  const std::string loop_link = dir + "/loop_link";
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    unlink(loop_link.c_str());
+    unlink(dir_link.c_str());
+    unlink(file_link.c_str());
+    unlink(subdir_file.c_str());
+    rmdir(subdir.c_str());
+    unlink(file.c_str());
+    rmdir(dir.c_str());
+  });
+  FILE * f = fopen(file.c_str(), "w");
+  ASSERT_NE(nullptr, f);
+  fputs("0123456789", f);
+  fclose(f);
+  ASSERT_TRUE(rcutils_mkdir(subdir.c_str()));
+  f = fopen(subdir_file.c_str(), "w");
+  ASSERT_NE(nullptr, f);
+  fputs("01234", f);
+  fclose(f);
+  // The linked file is outside of the directory, and the linked directory inside of it.
+  char * linked_file = rcutils_join_path(this->test_path, "dummy_readable_file.txt", g_allocator);
+  ASSERT_NE(nullptr, linked_file);
+  ASSERT_EQ(0, symlink(linked_file, file_link.c_str()));
+  g_allocator.deallocate(linked_file, g_allocator.state);
+  ASSERT_EQ(0, symlink(subdir.c_str(), dir_link.c_str()));
+
+  // The linked directory is counted as many times as it is linked.
+  uint64_t size = 0;
+  rcutils_ret_t ret = rcutils_calculate_directory_size_with_recursion(
+    dir.c_str(), 0, &size, g_allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_EQ(10u + 5u + 5u + 5u, size);
+  ret = rcutils_calculate_directory_size(dir.c_str(), &size, g_allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_EQ(10u + 5u, size);
+
+  // Cycles are walked as far as the depth allows.
+  ASSERT_EQ(0, symlink(dir.c_str(), loop_link.c_str()));
+  ret = rcutils_calculate_directory_size_with_recursion(dir.c_str(), 2, &size, g_allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_EQ(10u + 5u + 5u + 5u + (10u + 5u), size);
+  ret = rcutils_calculate_directory_size_with_recursion(dir.c_str(), 0, &size, g_allocator);
+  EXPECT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_GT(size, 10u + 5u + 5u + 5u + (10u + 5u));
+}
+#endif
+
 TEST_F(TestFilesystemFixture, calculate_file_size) {
   char * path =
     rcutils_join_path(this->test_path, "dummy_readable_file.txt", g_allocator);
@@ -601,3 +824,135 @@ TEST_F(TestFilesystemFixture, directory_iterator_on_file) {
   EXPECT_EQ(nullptr, rcutils_dir_iter_start(path, g_allocator));
   rcutils_reset_error();
 }
+
+TEST_F(TestFilesystemFixture, directory_iterator_entry_type_and_stat) {
+  char * path =
+    rcutils_join_path(this->test_path, "dummy_folder", g_allocator);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    g_allocator.deallocate(path, g_allocator.state);
+  });
+
+  rcutils_dir_iter_t * iter = rcutils_dir_iter_start(path, g_allocator);
+  ASSERT_NE(nullptr, iter);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcutils_dir_iter_end(iter);
+  });
+
+  size_t count = 0;
+  do {
+    rcutils_file_stat_t stat;
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_dir_iter_stat(iter, &stat)) << iter->entry_name;
+    // The type is known once the entry is queried.
+    EXPECT_EQ(stat.type, iter->entry_type) << iter->entry_name;
+#ifndef _WIN32
+    // It may differ from the one of the stat on layered file systems.
+    EXPECT_NE(0u, iter->entry_inode) << iter->entry_name;
+#endif
+    if (0 == strcmp("dummy.dummy", iter->entry_name)) {
+      EXPECT_EQ(RCUTILS_FILE_TYPE_REGULAR, stat.type);
+#ifdef WIN32
+      EXPECT_EQ(6u, stat.size);
+#else
+      EXPECT_EQ(5u, stat.size);
+#endif
+    } else {
+      EXPECT_EQ(RCUTILS_FILE_TYPE_DIRECTORY, stat.type) << iter->entry_name;
+    }
+    ++count;
+  } while (rcutils_dir_iter_next(iter));
+  EXPECT_EQ(3u, count);
+
+  rcutils_file_stat_t stat;
+  EXPECT_EQ(RCUTILS_RET_ERROR, rcutils_dir_iter_stat(iter, &stat));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_dir_iter_stat(iter, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_dir_iter_stat(nullptr, &stat));
+  rcutils_reset_error();
+}
+
+TEST_F(TestFilesystemFixture, directory_iterator_with_buffer) {
+  char * path = rcutils_join_path(this->test_path, "dummy_folder_with_many_files", g_allocator);
+  ASSERT_NE(nullptr, path);
+  const std::string dir(path);
+  g_allocator.deallocate(path, g_allocator.state);
+  ASSERT_TRUE(rcutils_mkdir(dir.c_str()));
+  // Enough entries for several batches of the smallest buffer.
+  constexpr size_t file_count = 200;
+  std::set<std::string> expected {".", ".."};
+  for (size_t i = 0; i < file_count; ++i) {
+    std::string name = "file_with_a_long_enough_name_" + std::to_string(i);
+    FILE * f = fopen((dir + "/" + name).c_str(), "w");
+    ASSERT_NE(nullptr, f);
+    fclose(f);
+    expected.insert(name);
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    for (size_t i = 0; i < file_count; ++i) {
+      std::string name = "file_with_a_long_enough_name_" + std::to_string(i);
+      remove((dir + "/" + name).c_str());
+    }
+    remove(dir.c_str());
+  });
+
+  // The buffer isn't aligned on purpose.
+  char buffer[RCUTILS_DIR_ITER_MIN_BUFFER_SIZE + 1];
+  rcutils_dir_iter_t * iter = rcutils_dir_iter_start_with_buffer(
+    dir.c_str(), buffer + 1, RCUTILS_DIR_ITER_MIN_BUFFER_SIZE, g_allocator);
+  ASSERT_NE(nullptr, iter);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcutils_dir_iter_end(iter);
+  });
+
+  do {
+    if (1u != expected.erase(iter->entry_name)) {
+      ADD_FAILURE() << "Unexpected entry '" << iter->entry_name << "' was enumerated";
+      continue;
+    }
+    rcutils_file_stat_t stat;
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_dir_iter_stat(iter, &stat)) << iter->entry_name;
+    EXPECT_EQ(stat.type, iter->entry_type) << iter->entry_name;
+#ifndef _WIN32
+    // It may differ from the one of the stat on layered file systems.
+    EXPECT_NE(0u, iter->entry_inode) << iter->entry_name;
+#endif
+  } while (rcutils_dir_iter_next(iter));
+
+  for (std::string missing : expected) {
+    ADD_FAILURE() << "Expected entry '" << missing << "' was not enumerated";
+  }
+}
+
+TEST_F(TestFilesystemFixture, directory_iterator_with_buffer_invalid_arguments) {
+  char * path =
+    rcutils_join_path(this->test_path, "dummy_folder", g_allocator);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    g_allocator.deallocate(path, g_allocator.state);
+  });
+  char buffer[RCUTILS_DIR_ITER_MIN_BUFFER_SIZE];
+
+  EXPECT_EQ(
+    nullptr, rcutils_dir_iter_start_with_buffer(path, buffer, sizeof(buffer) - 1, g_allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    nullptr, rcutils_dir_iter_start_with_buffer(path, nullptr, sizeof(buffer), g_allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    nullptr, rcutils_dir_iter_start_with_buffer(nullptr, buffer, sizeof(buffer), g_allocator));
+  rcutils_reset_error();
+
+  char * file_path =
+    rcutils_join_path(this->test_path, "dummy_readable_file.txt", g_allocator);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    g_allocator.deallocate(file_path, g_allocator.state);
+  });
+  EXPECT_EQ(
+    nullptr, rcutils_dir_iter_start_with_buffer(file_path, buffer, sizeof(buffer), g_allocator));
+  rcutils_reset_error();
+}
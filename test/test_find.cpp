@@ -14,6 +14,8 @@
 
 #include <stdint.h>
 
+#include <string>
+
 #include "gtest/gtest.h"
 
 #include "rcutils/find.h"
@@ -142,3 +144,69 @@ TEST(test_find, find_lastn) {
     "hello/world///", '/', strlen("hello/world/"), strlen("hello/world/") - 1);
   LOG((size_t)strlen("hello/world/") - 1, ret5);
 }
+
+TEST(test_find, find_any) {
+  EXPECT_EQ(SIZE_MAX, rcutils_find_any(NULL, "/."));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_any("hello/world", NULL));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_any("hello/world", ""));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_any("", "/."));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_any("hello_world", "/."));
+  EXPECT_EQ(5u, rcutils_find_any("hello/world.txt", "/."));
+  EXPECT_EQ(5u, rcutils_find_any("hello.world/txt", "/."));
+  EXPECT_EQ(0u, rcutils_find_any("/hello", "/."));
+
+  EXPECT_EQ(SIZE_MAX, rcutils_find_anyn(NULL, "/.", 10));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_anyn("hello/world", "/.", 0));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_anyn("hello/world", "/.", strlen("hello")));
+  EXPECT_EQ(5u, rcutils_find_anyn("hello/world", "/.", strlen("hello/")));
+
+  EXPECT_EQ(SIZE_MAX, rcutils_find_last_any(NULL, "/."));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_last_any("hello/world", ""));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_last_any("hello_world", "/."));
+  EXPECT_EQ(11u, rcutils_find_last_any("hello/world.txt", "/."));
+  EXPECT_EQ(11u, rcutils_find_last_any("hello.world/txt", "/."));
+
+  EXPECT_EQ(SIZE_MAX, rcutils_find_last_anyn(NULL, "/.", 10));
+  EXPECT_EQ(SIZE_MAX, rcutils_find_last_anyn("hello/world.txt", "/.", 0));
+  EXPECT_EQ(5u, rcutils_find_last_anyn("hello/world.txt", "/.", strlen("hello/world")));
+  EXPECT_EQ(0u, rcutils_find_last_anyn("/hello/world", "/.", strlen("/hello")));
+}
+
+// The strings are longer than the blocks searched with vector instructions, with delimiters
+// at every position, so that the results are compared with a plain loop for all of them.
+TEST(test_find, find_long_strings) {
+  auto reference_find = [](const std::string & str, const std::string & delimiters) -> size_t
+    {
+      size_t index = str.find_first_of(delimiters);
+      return std::string::npos == index ? SIZE_MAX : index;
+    };
+  auto reference_find_last = [](const std::string & str, const std::string & delimiters) -> size_t
+    {
+      size_t index = str.find_last_of(delimiters);
+      return std::string::npos == index ? SIZE_MAX : index;
+    };
+
+  const std::string delimiter_sets[] = {"/", "/.", "/.:-_~|", "/.:-_~|!@#$%"};
+  for (size_t length = 1; length < 80; ++length) {
+    for (size_t position = 0; position <= length; ++position) {
+      std::string str(length, 'a');
+      if (position < length) {
+        str[position] = '/';
+        str[(position + length) / 2] = '.';
+      }
+      EXPECT_EQ(reference_find(str, "/"), rcutils_find(str.c_str(), '/')) << str;
+      EXPECT_EQ(reference_find(str, "/"), rcutils_findn(str.c_str(), '/', length)) << str;
+      EXPECT_EQ(reference_find_last(str, "/"), rcutils_find_last(str.c_str(), '/')) << str;
+      EXPECT_EQ(
+        reference_find_last(str, "/"), rcutils_find_lastn(str.c_str(), '/', length)) << str;
+      for (const std::string & delimiters : delimiter_sets) {
+        EXPECT_EQ(
+          reference_find(str, delimiters),
+          rcutils_find_anyn(str.c_str(), delimiters.c_str(), length)) << str;
+        EXPECT_EQ(
+          reference_find_last(str, delimiters),
+          rcutils_find_last_anyn(str.c_str(), delimiters.c_str(), length)) << str;
+      }
+    }
+  }
+}
@@ -0,0 +1,150 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "rcutils/hash.h"
+
+static std::vector<uint8_t> get_data(size_t size)
+{
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<uint8_t>(i * 31 + 7 + (i >> 8));
+  }
+  return data;
+}
+
+// Compute the CRC-32C one bit at a time, as a reference.
+static uint32_t crc32c_bitwise(uint32_t crc, const uint8_t * data, size_t length)
+{
+  crc = ~crc;
+  for (size_t i = 0; i < length; ++i) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (0x82f63b78u & (0u - (crc & 1u)));
+    }
+  }
+  return ~crc;
+}
+
+// The test vectors of wyhash, with the index of each as its seed.
+TEST(TestHash, hash64_known_values) {
+  const std::string messages[] = {
+    "", "a", "abc", "message digest", "abcdefghijklmnopqrstuvwxyz",
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+    "12345678901234567890123456789012345678901234567890123456789012345678901234567890"};
+  const uint64_t expected[] = {
+    0x0409638ee2bde459ull, 0xa8412d091b5fe0a9ull, 0x32dd92e4b2915153ull,
+    0x8619124089a3a16bull, 0x7a43afb61d7f5f40ull, 0xff42329b90e50d58ull,
+    0xc39cab13b115aad3ull};
+  for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); ++i) {
+    EXPECT_EQ(expected[i], rcutils_hash64(messages[i].data(), messages[i].size(), i)) << i;
+  }
+  EXPECT_EQ(rcutils_hash64(nullptr, 0, 0), rcutils_hash64("", 0, 0));
+}
+
+TEST(TestHash, hash64_seed_and_data) {
+  const std::vector<uint8_t> data = get_data(100);
+  const uint64_t hash = rcutils_hash64(data.data(), data.size(), 0);
+  EXPECT_NE(hash, rcutils_hash64(data.data(), data.size(), 1));
+  EXPECT_NE(hash, rcutils_hash64(data.data(), data.size() - 1, 0));
+  std::vector<uint8_t> changed = data;
+  changed[50] ^= 1;
+  EXPECT_NE(hash, rcutils_hash64(changed.data(), changed.size(), 0));
+  // The hash doesn't depend on the alignment of the data.
+  std::vector<uint8_t> shifted(data.size() + 1);
+  memcpy(shifted.data() + 1, data.data(), data.size());
+  EXPECT_EQ(hash, rcutils_hash64(shifted.data() + 1, data.size(), 0));
+}
+
+TEST(TestHash, hash64_pieces) {
+  const std::vector<uint8_t> data = get_data(300);
+  for (size_t length = 0; length <= data.size(); ++length) {
+    const uint64_t expected = rcutils_hash64(data.data(), length, 42);
+    // Split the data in two pieces at every position, and then in pieces of every size.
+    for (size_t split = 0; split <= length; ++split) {
+      rcutils_hash64_state_t state;
+      rcutils_hash64_init(&state, 42);
+      rcutils_hash64_update(&state, data.data(), split);
+      rcutils_hash64_update(&state, data.data() + split, length - split);
+      ASSERT_EQ(expected, rcutils_hash64_final(&state)) << length << " " << split;
+    }
+    for (size_t piece = 1; piece <= 100; ++piece) {
+      rcutils_hash64_state_t state;
+      rcutils_hash64_init(&state, 42);
+      for (size_t i = 0; i < length; i += piece) {
+        rcutils_hash64_update(&state, data.data() + i, std::min(piece, length - i));
+      }
+      ASSERT_EQ(expected, rcutils_hash64_final(&state)) << length << " " << piece;
+    }
+  }
+}
+
+TEST(TestHash, hash64_final_keeps_state) {
+  const std::vector<uint8_t> data = get_data(200);
+  rcutils_hash64_state_t state;
+  rcutils_hash64_init(&state, 0);
+  for (size_t i = 0; i < data.size(); i += 10) {
+    rcutils_hash64_update(&state, data.data() + i, 10);
+    EXPECT_EQ(rcutils_hash64(data.data(), i + 10, 0), rcutils_hash64_final(&state)) << i;
+  }
+}
+
+TEST(TestHash, crc32c_known_values) {
+  EXPECT_EQ(0u, rcutils_crc32c(0, nullptr, 0));
+  EXPECT_EQ(0xe3069283u, rcutils_crc32c(0, "123456789", 9));
+  // The test vectors of RFC 3720, section B.4.
+  std::vector<uint8_t> data(32, 0);
+  EXPECT_EQ(0x8a9136aau, rcutils_crc32c(0, data.data(), data.size()));
+  std::fill(data.begin(), data.end(), 0xff);
+  EXPECT_EQ(0x62a8ab43u, rcutils_crc32c(0, data.data(), data.size()));
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i);
+  }
+  EXPECT_EQ(0x46dd794eu, rcutils_crc32c(0, data.data(), data.size()));
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(31 - i);
+  }
+  EXPECT_EQ(0x113fdb5cu, rcutils_crc32c(0, data.data(), data.size()));
+}
+
+TEST(TestHash, crc32c_sizes_and_alignments) {
+  // Large enough for several blocks of interleaved hardware checksums.
+  const std::vector<uint8_t> data = get_data(5000);
+  for (size_t offset = 0; offset < 8; ++offset) {
+    for (size_t length = 0; length + offset <= data.size();
+      length += (length < 300 ? 1 : 97))
+    {
+      ASSERT_EQ(
+        crc32c_bitwise(0, data.data() + offset, length),
+        rcutils_crc32c(0, data.data() + offset, length)) << offset << " " << length;
+    }
+  }
+}
+
+TEST(TestHash, crc32c_pieces) {
+  const std::vector<uint8_t> data = get_data(3000);
+  const uint32_t expected = rcutils_crc32c(0, data.data(), data.size());
+  for (size_t split : {0, 1, 7, 8, 767, 768, 769, 2999, 3000}) {
+    uint32_t crc = rcutils_crc32c(0, data.data(), split);
+    crc = rcutils_crc32c(crc, data.data() + split, data.size() - split);
+    EXPECT_EQ(expected, crc) << split;
+  }
+}
@@ -14,6 +14,7 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <string>
 
 #include "./time_bomb_allocator_testing_utils.h"
@@ -452,6 +453,47 @@ TEST_F(HashMapPreInitTest, get_next_key_and_data_working) {
   EXPECT_EQ(RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES, ret) << rcutils_get_error_string().str;
 }
 
+size_t test_hash_map_colliding_hash_func(const void * key)
+{
+  (void)key;
+  return 0;
+}
+
+int test_uint32_memcmp(const void * val1, const void * val2)
+{
+  return memcmp(val1, val2, sizeof(uint32_t));
+}
+
+TEST_F(HashMapBaseTest, unset_while_iterating) {
+  // All the keys are in the same bucket, and each one is unset after getting the next one.
+  rcutils_ret_t ret = rcutils_hash_map_init(
+    &map, 2, sizeof(uint32_t), sizeof(uint32_t),
+    test_hash_map_colliding_hash_func, test_uint32_memcmp, &allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  for (uint32_t key = 0; key < 5; ++key) {
+    ret = rcutils_hash_map_set(&map, &key, &key);
+    ASSERT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  }
+
+  uint32_t key = 0, data = 0;
+  size_t visited = 0;
+  ret = rcutils_hash_map_get_next_key_and_data(&map, NULL, &key, &data);
+  while (RCUTILS_RET_OK == ret) {
+    ++visited;
+    uint32_t previous_key = key;
+    ret = rcutils_hash_map_get_next_key_and_data(&map, &previous_key, &key, &data);
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_unset(&map, &previous_key));
+  }
+  EXPECT_EQ(RCUTILS_RET_HASH_MAP_NO_MORE_ENTRIES, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(5u, visited);
+  size_t size = 0;
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_hash_map_get_size(&map, &size));
+  EXPECT_EQ(0u, size);
+
+  ret = rcutils_hash_map_fini(&map);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+}
+
 /* Use BaseTest as the fixture here so we can control the initial capacity independent of the
  * other tests
  */
@@ -512,3 +554,27 @@ TEST_F(HashMapBaseTest, string_keys) {
   ret = rcutils_hash_map_fini(&map);
   EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
 }
+
+TEST_F(HashMapPreInitTest, get_with_hash) {
+  uint32_t key = 2, data = 22, ret_data = 0;
+
+  rcutils_ret_t ret = rcutils_hash_map_set(&map, &key, &data);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+
+  ret = rcutils_hash_map_get_with_hash(&map, &key, test_hash_map_uint32_hash_func(&key), &ret_data);
+  EXPECT_EQ(RCUTILS_RET_OK, ret) << rcutils_get_error_string().str;
+  EXPECT_EQ(data, ret_data);
+
+  ret = rcutils_hash_map_get_with_hash(&map, &key, 0, &ret_data);
+  EXPECT_EQ(RCUTILS_RET_NOT_FOUND, ret) << rcutils_get_error_string().str;
+
+  ret = rcutils_hash_map_get_with_hash(NULL, &key, 0, &ret_data);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+  rcutils_reset_error();
+  ret = rcutils_hash_map_get_with_hash(&map, NULL, 0, &ret_data);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+  rcutils_reset_error();
+  ret = rcutils_hash_map_get_with_hash(&map, &key, 0, NULL);
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, ret);
+  rcutils_reset_error();
+}
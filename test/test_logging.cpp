@@ -15,6 +15,8 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <climits>
+#include <cstdint>
 #include <string>
 #include <thread>
 #include <vector>
@@ -24,6 +26,12 @@
 #include "rcutils/logging.h"
 #include "rcutils/strdup.h"
 
+#ifndef _WIN32
+# include <fcntl.h>
+# include <signal.h>
+# include <unistd.h>
+#endif
+
 TEST(TestLogging, test_logging_initialization) {
   EXPECT_FALSE(g_rcutils_logging_initialized);
   ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
@@ -536,3 +544,234 @@ TEST(TestLogging, test_logging_macro_thread_safety)
     thread.join();
   }
 }
+
+TEST(TestLogging, test_logging_statistics)
+{
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_logging_get_statistics(nullptr));
+  rcutils_reset_error();
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+
+  auto null_output_handler = [](
+    const rcutils_log_location_t *, int, const char *, rcutils_time_point_value_t,
+    const char *, va_list *) -> void {};
+  rcutils_logging_output_handler_t original_function = rcutils_logging_get_output_handler();
+  rcutils_logging_set_output_handler(null_output_handler);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcutils_logging_set_output_handler(original_function);
+  });
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_WARN);
+
+  rcutils_logging_reset_statistics();
+  rcutils_logging_statistics_t statistics;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&statistics));
+  for (size_t i = 0; i < RCUTILS_LOGGING_STATISTICS_SEVERITY_SLOTS; ++i) {
+    EXPECT_EQ(0u, statistics.records[i]);
+    EXPECT_EQ(0u, statistics.suppressed[i]);
+  }
+  EXPECT_EQ(0u, statistics.bytes_emitted);
+  EXPECT_EQ(0u, statistics.format_failures);
+
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_DEBUG, "name", "message %d", 1);
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_INFO, "name", "message %d", 2);
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_INFO, "name", "message %d", 3);
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_WARN, "name", "message %d", 4);
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_ERROR, NULL, "message %d", 5);
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_ERROR, "name", "message %d", 6);
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&statistics));
+  EXPECT_EQ(1u, statistics.suppressed[RCUTILS_LOG_SEVERITY_DEBUG / 10]);
+  EXPECT_EQ(2u, statistics.suppressed[RCUTILS_LOG_SEVERITY_INFO / 10]);
+  EXPECT_EQ(0u, statistics.suppressed[RCUTILS_LOG_SEVERITY_WARN / 10]);
+  EXPECT_EQ(0u, statistics.records[RCUTILS_LOG_SEVERITY_DEBUG / 10]);
+  EXPECT_EQ(0u, statistics.records[RCUTILS_LOG_SEVERITY_INFO / 10]);
+  EXPECT_EQ(1u, statistics.records[RCUTILS_LOG_SEVERITY_WARN / 10]);
+  EXPECT_EQ(2u, statistics.records[RCUTILS_LOG_SEVERITY_ERROR / 10]);
+  uint64_t timed_records = 0;
+  for (size_t i = 0; i < RCUTILS_LOGGING_STATISTICS_LATENCY_BUCKETS; ++i) {
+    timed_records += statistics.handler_latency[i];
+  }
+  EXPECT_EQ(3u, timed_records);
+  // The custom output handler doesn't write to the stream.
+  EXPECT_EQ(0u, statistics.bytes_emitted);
+
+  // The console output handler accounts for the bytes it writes.
+  rcutils_logging_set_output_handler(original_function);
+  rcutils_log(NULL, RCUTILS_LOG_SEVERITY_WARN, "name", "message %d", 7);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&statistics));
+  EXPECT_EQ(2u, statistics.records[RCUTILS_LOG_SEVERITY_WARN / 10]);
+  EXPECT_LT(0u, statistics.bytes_emitted);
+  EXPECT_EQ(0u, statistics.format_failures);
+
+  rcutils_logging_reset_statistics();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&statistics));
+  EXPECT_EQ(0u, statistics.records[RCUTILS_LOG_SEVERITY_WARN / 10]);
+  EXPECT_EQ(0u, statistics.suppressed[RCUTILS_LOG_SEVERITY_INFO / 10]);
+  EXPECT_EQ(0u, statistics.bytes_emitted);
+
+  // The messages suppressed by different threads are all counted.
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; ++i) {
+    threads.emplace_back(
+      []() {
+        for (size_t j = 0; j < 100; ++j) {
+          EXPECT_FALSE(rcutils_logging_logger_is_enabled_for("name", RCUTILS_LOG_SEVERITY_INFO));
+        }
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&statistics));
+  EXPECT_EQ(400u, statistics.suppressed[RCUTILS_LOG_SEVERITY_INFO / 10]);
+  rcutils_logging_reset_statistics();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_get_statistics(&statistics));
+  EXPECT_EQ(0u, statistics.suppressed[RCUTILS_LOG_SEVERITY_INFO / 10]);
+}
+
+#ifndef _WIN32
+namespace
+{
+
+// Read back what was written to stderr while the object was in scope.
+class StderrCapture
+{
+public:
+  StderrCapture()
+  {
+    EXPECT_EQ(0, pipe(pipe_fds_));
+    EXPECT_EQ(0, fcntl(pipe_fds_[0], F_SETFL, O_NONBLOCK));
+    original_stderr_ = dup(STDERR_FILENO);
+    EXPECT_NE(-1, dup2(pipe_fds_[1], STDERR_FILENO));
+  }
+
+  ~StderrCapture()
+  {
+    restore();
+    close(pipe_fds_[0]);
+  }
+
+  std::string read_all()
+  {
+    restore();
+    std::string output;
+    char buffer[256];
+    ssize_t length;
+    while ((length = read(pipe_fds_[0], buffer, sizeof(buffer))) > 0) {
+      output.append(buffer, static_cast<size_t>(length));
+    }
+    return output;
+  }
+
+private:
+  void restore()
+  {
+    if (-1 != original_stderr_) {
+      dup2(original_stderr_, STDERR_FILENO);
+      close(original_stderr_);
+      close(pipe_fds_[1]);
+      original_stderr_ = -1;
+    }
+  }
+
+  int pipe_fds_[2];
+  int original_stderr_;
+};
+
+void signal_safe_logging_signal_handler(int signal)
+{
+  rcutils_ret_t ret = rcutils_log_signal_safe(
+    RCUTILS_LOG_SEVERITY_FATAL, "signal", "caught signal %d", signal);
+  (void)ret;
+}
+
+}  // namespace
+
+TEST(TestLogging, test_log_signal_safe)
+{
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_log_signal_safe(RCUTILS_LOG_SEVERITY_INFO, "name", NULL));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_log_signal_safe(1, "name", "message"));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_log_signal_safe(-1, "name", "message"));
+
+  // The logging system is initialized with an allocator which fails every allocation from then on.
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  set_failing_allocator_is_failing(failing_allocator, false);
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize_with_allocator(failing_allocator));
+  set_failing_allocator_is_failing(failing_allocator, true);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_failing_allocator_is_failing(failing_allocator, false);
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  });
+  rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_INFO);
+
+  std::string output;
+  {
+    StderrCapture capture;
+    int value = 42;
+    EXPECT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_log_signal_safe(RCUTILS_LOG_SEVERITY_DEBUG, "name", "filtered out"));
+    EXPECT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_log_signal_safe(
+        RCUTILS_LOG_SEVERITY_INFO, "name", "%d %i %u %x %X %c %s %% %p",
+        -7, INT_MIN, 7u, 0xbeefu, 0xbeefu, 'c', "string", static_cast<void *>(NULL)));
+    EXPECT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_log_signal_safe(
+        RCUTILS_LOG_SEVERITY_WARN, NULL, "%ld %lld %llu %zu %jd %hhd %05d %-3.2s|%*d",
+        -1L, LLONG_MIN, ULLONG_MAX, static_cast<size_t>(12), static_cast<intmax_t>(-12),
+        1, 2, "abc", 4, 3));
+    // The string needn't be null terminated within the precision.
+    const char unterminated[3] = {'x', 'y', 'z'};
+    EXPECT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_log_signal_safe(
+        RCUTILS_LOG_SEVERITY_WARN, "name", "%.*s|%.1s|%.*s|%.0s|%.*s", 3, unterminated,
+        unterminated, 2, "a", "abc", -1, "abc"));
+    EXPECT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_log_signal_safe(RCUTILS_LOG_SEVERITY_ERROR, "name", "%d %f %d", value, 1.0, 2));
+    EXPECT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_log_signal_safe(
+        RCUTILS_LOG_SEVERITY_ERROR, "name", "%s", std::string(2000, 'x').c_str()));
+
+    struct sigaction action = {};
+    struct sigaction original_action = {};
+    action.sa_handler = signal_safe_logging_signal_handler;
+    ASSERT_EQ(0, sigaction(SIGUSR1, &action, &original_action));
+    EXPECT_EQ(0, raise(SIGUSR1));
+    EXPECT_EQ(0, sigaction(SIGUSR1, &original_action, NULL));
+
+    output = capture.read_all();
+  }
+
+  std::vector<std::string> lines;
+  size_t start = 0;
+  for (size_t end = output.find('\n'); end != std::string::npos; end = output.find('\n', start)) {
+    lines.push_back(output.substr(start, end - start));
+    start = end + 1;
+  }
+  EXPECT_EQ(output.size(), start);
+  ASSERT_EQ(6u, lines.size()) << output;
+  EXPECT_EQ("[INFO] [name]: -7 -2147483648 7 beef BEEF c string % 0x0", lines[0]);
+  EXPECT_EQ(
+    "[WARN] []: -1 -9223372036854775808 18446744073709551615 12 -12 1 2 ab|3", lines[1]);
+  EXPECT_EQ("[WARN] [name]: xyz|x|a||abc", lines[2]);
+  // Formatting stops at unsupported conversions.
+  EXPECT_EQ("[ERROR] [name]: 42 %f %d", lines[3]);
+  // Long messages are truncated.
+  EXPECT_EQ(RCUTILS_LOGGING_SIGNAL_SAFE_MAX_MESSAGE_LENGTH - 1, lines[4].size());
+  EXPECT_EQ("[ERROR] [name]: xxx", lines[4].substr(0, 19));
+  EXPECT_EQ("[FATAL] [signal]: caught signal " + std::to_string(SIGUSR1), lines[5]);
+}
+#endif
@@ -0,0 +1,191 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <string>
+
+#include "rcutils/logging_macros.hpp"
+#include "rcutils/types/hash_map.h"
+
+using ::testing::EndsWith;
+
+namespace
+{
+
+size_t g_log_calls = 0;
+
+struct LogEvent
+{
+  const rcutils_log_location_t * location;
+  int level;
+  std::string name;
+  std::string message;
+};
+LogEvent g_last_log_event;
+
+template<typename ... Args>
+constexpr bool matches(const char * format)
+{
+  return rcutils::logging::detail::format_checker<
+    rcutils::logging::detail::type_list<Args...>>::matches(format);
+}
+
+enum class Color : uint8_t
+{
+  red,
+  green,
+};
+
+}  // namespace
+
+class TestLoggingMacrosHpp : public ::testing::Test
+{
+public:
+  void SetUp()
+  {
+    g_log_calls = 0;
+    g_last_log_event.message = "SetUp";
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+    rcutils_logging_set_default_logger_level(RCUTILS_LOG_SEVERITY_INFO);
+
+    auto output_handler = [](
+      const rcutils_log_location_t * location,
+      int level, const char * name, rcutils_time_point_value_t,
+      const char * format, va_list * args) -> void
+      {
+        g_log_calls += 1;
+        g_last_log_event.location = location;
+        g_last_log_event.level = level;
+        g_last_log_event.name = name ? name : "";
+        char buffer[1024];
+        vsnprintf(buffer, sizeof(buffer), format, *args);
+        g_last_log_event.message = buffer;
+      };
+    rcutils_logging_set_output_handler(output_handler);
+  }
+
+  void TearDown()
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  }
+};
+
+TEST(TestLoggingMacrosHppStatic, hash_logger_name) {
+  static_assert(
+    rcutils::logging::hash_logger_name("") == 5381u, "the hash of an empty name is the seed");
+  for (const char * name : {"", "name", "name.child", "a_much.longer.logger_name.\xc3\xa9"}) {
+    EXPECT_EQ(rcutils_hash_map_string_hash_func(&name), rcutils::logging::hash_logger_name(name));
+  }
+}
+
+TEST(TestLoggingMacrosHppStatic, format_matches) {
+  static_assert(matches<>("no arguments"), "");
+  static_assert(matches<>("100%%"), "");
+  static_assert(!matches<>("%d"), "");
+  static_assert(!matches<int>("no conversion"), "");
+  static_assert(matches<int>("%d"), "");
+  static_assert(matches<char>("%c"), "");
+  static_assert(matches<bool>("%d"), "");
+  static_assert(matches<int16_t>("%hd"), "");
+  static_assert(matches<unsigned int>("%-08x"), "");
+  static_assert(matches<long>("%ld"), "");  // NOLINT(runtime/int)
+  static_assert(matches<long long>("%lld"), "");  // NOLINT(runtime/int)
+  static_assert(matches<size_t>("%zu"), "");
+  static_assert(matches<Color>("%d"), "");
+  static_assert(matches<int, int, double>("%*.*f"), "");
+  static_assert(matches<float>("%.3f"), "");
+  static_assert(matches<double>("%lg"), "");
+  static_assert(matches<long double>("%Lf"), "");
+  static_assert(matches<const char *>("%s"), "");
+  static_assert(matches<std::string>("%s"), "");
+  static_assert(matches<const char *>("%p"), "");
+  static_assert(matches<const int *>("%p"), "");
+  static_assert(matches<std::nullptr_t>("%p"), "");
+  static_assert(matches<const char *, int, double>("%s=%d (%.2f%%)"), "");
+
+  if (sizeof(long) != sizeof(int)) {  // NOLINT(runtime/int)
+    EXPECT_FALSE(matches<long>("%d"));  // NOLINT(runtime/int)
+    EXPECT_FALSE(matches<size_t>("%u"));
+  }
+  static_assert(!matches<double>("%d"), "");
+  static_assert(!matches<int>("%f"), "");
+  static_assert(!matches<int>("%s"), "");
+  static_assert(!matches<const int *>("%s"), "");
+  static_assert(!matches<double>("%Ld"), "");
+  static_assert(!matches<long double>("%f"), "");
+  static_assert(!matches<int *>("%n"), "");
+  static_assert(!matches<int>("%"), "");
+  static_assert(!matches<int, int>("%d"), "");
+  static_assert(!matches<double>("%*f"), "");
+  static_assert(!matches<std::wstring>("%s"), "");
+}
+
+TEST_F(TestLoggingMacrosHpp, test_logging_named) {
+  const std::string value = "string";
+  for (int i : {1, 2, 3}) {
+    RCUTILS_CPP_LOG_INFO_NAMED("name", "message %d %s %.1f", i, value, 0.5f);
+  }
+  EXPECT_EQ(3u, g_log_calls);
+  ASSERT_NE(nullptr, g_last_log_event.location);
+  EXPECT_STREQ("TestBody", g_last_log_event.location->function_name);
+  EXPECT_THAT(g_last_log_event.location->file_name, EndsWith("test_logging_macros_hpp.cpp"));
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_INFO, g_last_log_event.level);
+  EXPECT_EQ("name", g_last_log_event.name);
+  EXPECT_EQ("message 3 string 0.5", g_last_log_event.message);
+
+  RCUTILS_CPP_LOG_WARN_NAMED("name", "no arguments 100%%");
+  EXPECT_EQ(4u, g_log_calls);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_WARN, g_last_log_event.level);
+  EXPECT_EQ("no arguments 100%", g_last_log_event.message);
+}
+
+TEST_F(TestLoggingMacrosHpp, test_logging_levels) {
+  RCUTILS_CPP_LOG_DEBUG_NAMED("name.child", "debug %d", 1);
+  EXPECT_EQ(0u, g_log_calls);
+
+  // The level of the logger itself is found through the precomputed hash.
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_set_logger_level("name.child", RCUTILS_LOG_SEVERITY_DEBUG));
+  RCUTILS_CPP_LOG_DEBUG_NAMED("name.child", "debug %d", 2);
+  EXPECT_EQ(1u, g_log_calls);
+  EXPECT_EQ("debug 2", g_last_log_event.message);
+  EXPECT_EQ(
+    RCUTILS_LOG_SEVERITY_DEBUG,
+    rcutils_logging_get_logger_effective_level_with_hash(
+      "name.child", rcutils::logging::hash_logger_name("name.child")));
+
+  // The level of the ancestors still applies.
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_set_logger_level("name", RCUTILS_LOG_SEVERITY_ERROR));
+  RCUTILS_CPP_LOG_WARN_NAMED("name.other", "warn %d", 3);
+  EXPECT_EQ(1u, g_log_calls);
+  RCUTILS_CPP_LOG_FATAL_NAMED("name.other", "fatal %d", 4);
+  EXPECT_EQ(2u, g_log_calls);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_FATAL, g_last_log_event.level);
+
+  EXPECT_EQ(-1, rcutils_logging_get_logger_effective_level_with_hash(nullptr, 0));
+}
+
+TEST_F(TestLoggingMacrosHpp, test_logging_conditions) {
+  for (int i : {1, 2, 3}) {
+    RCUTILS_CPP_LOG_COND_NAMED(
+      RCUTILS_LOG_SEVERITY_ERROR,
+      RCUTILS_LOG_CONDITION_ONCE_BEFORE, RCUTILS_LOG_CONDITION_ONCE_AFTER,
+      "name", "once %d", i);
+  }
+  EXPECT_EQ(1u, g_log_calls);
+  EXPECT_EQ("once 1", g_last_log_event.message);
+}
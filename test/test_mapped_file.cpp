@@ -0,0 +1,226 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include "./allocator_testing_utils.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/mapped_file.h"
+
+// A file with the given contents, removed at the end of the test.
+class ScopedTestFile
+{
+public:
+  explicit ScopedTestFile(const std::string & contents)
+  : path_("test_mapped_file_" + std::to_string(reinterpret_cast<uintptr_t>(this)))
+  {
+    FILE * f = fopen(path_.c_str(), "wb");
+    EXPECT_NE(nullptr, f);
+    if (nullptr != f) {
+      EXPECT_EQ(contents.size(), fwrite(contents.data(), 1, contents.size(), f));
+      fclose(f);
+    }
+  }
+
+  ~ScopedTestFile()
+  {
+    remove(path_.c_str());
+  }
+
+  const char * path() const
+  {
+    return path_.c_str();
+  }
+
+private:
+  std::string path_;
+};
+
+static std::string make_contents(size_t size)
+{
+  std::string contents(size, '\0');
+  for (size_t i = 0; i < size; ++i) {
+    contents[i] = static_cast<char>(i * 31 + i / 4096);
+  }
+  return contents;
+}
+
+static std::string to_string(const rcutils_mapped_file_t & file)
+{
+  return std::string(reinterpret_cast<const char *>(file.data), file.size);
+}
+
+TEST(TestMappedFile, open_and_close) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  const std::string contents = make_contents(3 * 4096 + 123);
+  ScopedTestFile test_file(contents);
+
+  const uint32_t all_flags[] = {
+    RCUTILS_MAPPED_FILE_DEFAULT,
+    RCUTILS_MAPPED_FILE_POPULATE,
+    RCUTILS_MAPPED_FILE_HUGE_PAGES,
+    RCUTILS_MAPPED_FILE_POPULATE | RCUTILS_MAPPED_FILE_HUGE_PAGES,
+  };
+  for (uint32_t flags : all_flags) {
+    rcutils_mapped_file_t file = rcutils_get_zero_initialized_mapped_file();
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_mapped_file_open(&file, test_file.path(), flags, &allocator)) << flags;
+    EXPECT_TRUE(file.is_mapped);
+    ASSERT_EQ(contents.size(), file.size);
+    EXPECT_EQ(contents, to_string(file));
+
+    // Opening again without closing first is an error.
+    EXPECT_EQ(
+      RCUTILS_RET_INVALID_ARGUMENT,
+      rcutils_mapped_file_open(&file, test_file.path(), flags, &allocator));
+    rcutils_reset_error();
+
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_mapped_file_close(&file));
+    EXPECT_EQ(nullptr, file.data);
+    EXPECT_EQ(0u, file.size);
+    EXPECT_FALSE(file.is_mapped);
+  }
+
+  // Closing a closed file does nothing.
+  rcutils_mapped_file_t file = rcutils_get_zero_initialized_mapped_file();
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mapped_file_close(&file));
+}
+
+TEST(TestMappedFile, advise_and_prefetch) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  const std::string contents = make_contents(5 * 4096 + 7);
+  ScopedTestFile test_file(contents);
+
+  rcutils_mapped_file_t file = rcutils_get_zero_initialized_mapped_file();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_mapped_file_open(&file, test_file.path(), RCUTILS_MAPPED_FILE_DEFAULT, &allocator));
+
+  const rcutils_mapped_file_advice_t advices[] = {
+    RCUTILS_MAPPED_FILE_ADVICE_SEQUENTIAL,
+    RCUTILS_MAPPED_FILE_ADVICE_RANDOM,
+    RCUTILS_MAPPED_FILE_ADVICE_WILL_NEED,
+    RCUTILS_MAPPED_FILE_ADVICE_DONT_NEED,
+    RCUTILS_MAPPED_FILE_ADVICE_NORMAL,
+  };
+  for (rcutils_mapped_file_advice_t advice : advices) {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_mapped_file_advise(&file, 0, 0, advice)) << advice;
+    // Ranges which don't start on a page, or go past the end, are accepted.
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_mapped_file_advise(&file, 4097, 100000, advice));
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mapped_file_prefetch(&file, 0, 0));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mapped_file_prefetch(&file, 4097, 10));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mapped_file_prefetch(&file, contents.size(), 0));
+  // The contents are still there after the pages were dropped.
+  EXPECT_EQ(contents, to_string(file));
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_mapped_file_prefetch(&file, contents.size() + 1, 0));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_mapped_file_advise(
+      &file, contents.size() + 1, 0, RCUTILS_MAPPED_FILE_ADVICE_NORMAL));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_mapped_file_prefetch(nullptr, 0, 0));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_mapped_file_advise(nullptr, 0, 0, RCUTILS_MAPPED_FILE_ADVICE_NORMAL));
+  rcutils_reset_error();
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mapped_file_close(&file));
+}
+
+TEST(TestMappedFile, empty_file) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  ScopedTestFile test_file("");
+
+  // Empty files can't be mapped, so they are read instead.
+  rcutils_mapped_file_t file = rcutils_get_zero_initialized_mapped_file();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_mapped_file_open(&file, test_file.path(), RCUTILS_MAPPED_FILE_DEFAULT, &allocator));
+  EXPECT_FALSE(file.is_mapped);
+  EXPECT_EQ(nullptr, file.data);
+  EXPECT_EQ(0u, file.size);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mapped_file_prefetch(&file, 0, 0));
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcutils_mapped_file_advise(&file, 0, 0, RCUTILS_MAPPED_FILE_ADVICE_NORMAL));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mapped_file_close(&file));
+}
+
+#ifdef __linux__
+TEST(TestMappedFile, unmappable_file) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  // The files of /proc report an empty size, so they are read instead.
+  rcutils_mapped_file_t file = rcutils_get_zero_initialized_mapped_file();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_mapped_file_open(&file, "/proc/self/status", RCUTILS_MAPPED_FILE_DEFAULT, &allocator));
+  EXPECT_FALSE(file.is_mapped);
+  ASSERT_GT(file.size, 0u);
+  EXPECT_EQ(0u, to_string(file).find("Name:"));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mapped_file_prefetch(&file, 0, 0));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_mapped_file_close(&file));
+
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_mapped_file_open(
+      &file, "/proc/self/status", RCUTILS_MAPPED_FILE_DEFAULT, &failing_allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, file.contents.buffer);
+}
+#endif
+
+TEST(TestMappedFile, invalid_arguments) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_mapped_file_t file = rcutils_get_zero_initialized_mapped_file();
+
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR,
+    rcutils_mapped_file_open(
+      &file, "test/non_existing_file.txt", RCUTILS_MAPPED_FILE_DEFAULT, &allocator));
+  rcutils_reset_error();
+  // Directories can be opened, but not read.
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR,
+    rcutils_mapped_file_open(&file, "test", RCUTILS_MAPPED_FILE_DEFAULT, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, file.data);
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_mapped_file_open(
+      nullptr, "test/dummy_readable_file.txt", RCUTILS_MAPPED_FILE_DEFAULT, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_mapped_file_open(&file, nullptr, RCUTILS_MAPPED_FILE_DEFAULT, &allocator));
+  rcutils_reset_error();
+  rcutils_allocator_t invalid_allocator = rcutils_get_zero_initialized_allocator();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_mapped_file_open(
+      &file, "test/dummy_readable_file.txt", RCUTILS_MAPPED_FILE_DEFAULT, &invalid_allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_mapped_file_close(nullptr));
+  rcutils_reset_error();
+}
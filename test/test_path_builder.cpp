@@ -0,0 +1,265 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "./allocator_testing_utils.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/path_builder.h"
+
+#ifdef _WIN32
+# define SEP "\\"
+#else
+# define SEP "/"
+#endif
+
+class TestPathBuilder : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_init(&builder, &allocator));
+  }
+
+  void TearDown() override
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_fini(&builder));
+  }
+
+  std::string path() const
+  {
+    return rcutils_path_builder_get_path(&builder);
+  }
+
+  // Return the normalized path.
+  std::string normalize(const char * path)
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_set(&builder, path));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_normalize(&builder));
+    EXPECT_EQ(strlen(rcutils_path_builder_get_path(&builder)), builder.length);
+    return this->path();
+  }
+
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_path_builder_t builder = rcutils_get_zero_initialized_path_builder();
+};
+
+TEST_F(TestPathBuilder, push_and_pop) {
+  EXPECT_EQ("", path());
+  EXPECT_FALSE(rcutils_path_builder_pop(&builder));
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, "foo"));
+  EXPECT_EQ("foo", path());
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, "bar"));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, "baz.txt"));
+  EXPECT_EQ("foo" SEP "bar" SEP "baz.txt", path());
+  EXPECT_EQ(15u, builder.length);
+
+  EXPECT_TRUE(rcutils_path_builder_pop(&builder));
+  EXPECT_EQ("foo" SEP "bar", path());
+  EXPECT_TRUE(rcutils_path_builder_pop(&builder));
+  EXPECT_TRUE(rcutils_path_builder_pop(&builder));
+  EXPECT_EQ("", path());
+  EXPECT_EQ(0u, builder.length);
+  EXPECT_FALSE(rcutils_path_builder_pop(&builder));
+
+  // No separator is added after an existing one, and the root is kept when popping.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_set(&builder, "/"));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, "foo"));
+  EXPECT_EQ("/foo", path());
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, "bar/"));
+  EXPECT_EQ("/foo" SEP "bar/", path());
+  EXPECT_TRUE(rcutils_path_builder_pop(&builder));
+  EXPECT_EQ("/foo", path());
+  EXPECT_TRUE(rcutils_path_builder_pop(&builder));
+  EXPECT_EQ("/", path());
+  EXPECT_FALSE(rcutils_path_builder_pop(&builder));
+  EXPECT_EQ("/", path());
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_set(&builder, "//foo//bar"));
+  EXPECT_TRUE(rcutils_path_builder_pop(&builder));
+  EXPECT_EQ("//foo", path());
+  EXPECT_TRUE(rcutils_path_builder_pop(&builder));
+  EXPECT_EQ("//", path());
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_set(&builder, "foo"));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_append(&builder, ".txt", 4));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_append(&builder, nullptr, 0));
+  EXPECT_EQ("foo.txt", path());
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, ""));
+  EXPECT_EQ("foo.txt" SEP, path());
+}
+
+TEST_F(TestPathBuilder, normalize) {
+  EXPECT_EQ("", path());
+  EXPECT_EQ(".", normalize(""));
+  EXPECT_EQ(".", normalize("."));
+  EXPECT_EQ(".", normalize("./"));
+  EXPECT_EQ(".", normalize("foo/.."));
+  EXPECT_EQ("foo", normalize("foo/"));
+  EXPECT_EQ("foo", normalize("./foo/."));
+  EXPECT_EQ("foo" SEP "baz", normalize("foo//bar/..//baz/"));
+  EXPECT_EQ("..", normalize(".."));
+  EXPECT_EQ(".." SEP "..", normalize("../foo/../.."));
+  EXPECT_EQ(".." SEP "bar", normalize("foo/../../bar"));
+  EXPECT_EQ("...", normalize("..."));
+  EXPECT_EQ(".foo" SEP "..bar", normalize(".foo/..bar"));
+  EXPECT_EQ(SEP, normalize("/"));
+  EXPECT_EQ(SEP, normalize("///"));
+  EXPECT_EQ(SEP, normalize("/.."));
+  EXPECT_EQ(SEP "bar", normalize("/../foo/../bar"));
+  EXPECT_EQ(SEP "foo" SEP "bar", normalize("/foo/./bar/"));
+#ifdef _WIN32
+  EXPECT_EQ("C:\\foo", normalize("C:/foo/bar/.."));
+  EXPECT_EQ("C:\\", normalize("C:\\.."));
+  EXPECT_EQ("C:foo", normalize("C:foo\\."));
+  EXPECT_EQ("\\\\server\\share", normalize("//server/share/"));
+#else
+  EXPECT_EQ("C:" SEP "foo", normalize("C:/foo/bar/.."));
+  EXPECT_EQ("foo\\bar", normalize("./foo\\bar"));
+#endif
+}
+
+TEST_F(TestPathBuilder, to_native) {
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_set(&builder, "/foo//bar/baz"));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_to_native(&builder));
+  EXPECT_EQ(SEP "foo" SEP SEP "bar" SEP "baz", path());
+  EXPECT_EQ(13u, builder.length);
+}
+
+TEST_F(TestPathBuilder, long_paths) {
+  // Paths which don't fit in the inline buffer are allocated, and then the memory is reused.
+  std::string expected;
+  for (size_t i = 0; i < 200; ++i) {
+    std::string component = "component" + std::to_string(i);
+    ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, component.c_str()));
+    expected += (i > 0 ? SEP : "") + component;
+  }
+  EXPECT_EQ(expected, path());
+  EXPECT_NE(nullptr, builder.allocated_buffer);
+  const size_t capacity = builder.capacity;
+  EXPECT_GT(capacity, expected.size());
+
+  while (rcutils_path_builder_pop(&builder)) {
+  }
+  EXPECT_EQ("", path());
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_set(&builder, expected.c_str()));
+  EXPECT_EQ(expected, path());
+  EXPECT_EQ(capacity, builder.capacity);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_reserve(&builder, 10 * capacity));
+  EXPECT_EQ(10 * capacity + 1, builder.capacity);
+  EXPECT_EQ(expected, path());
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, ".."));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_normalize(&builder));
+  expected.resize(expected.rfind(SEP));
+  EXPECT_EQ(expected, path());
+}
+
+TEST_F(TestPathBuilder, detach) {
+  // The inline path is copied.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_set(&builder, "foo"));
+  char * path = rcutils_path_builder_detach(&builder);
+  ASSERT_NE(nullptr, path);
+  EXPECT_STREQ("foo", path);
+  EXPECT_EQ("", this->path());
+  allocator.deallocate(path, allocator.state);
+
+  // The allocated path is handed over.
+  const std::string long_path(1000, 'a');
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_set(&builder, long_path.c_str()));
+  const char * buffer = builder.allocated_buffer;
+  path = rcutils_path_builder_detach(&builder);
+  EXPECT_EQ(buffer, path);
+  EXPECT_EQ(long_path, path);
+  EXPECT_EQ(nullptr, builder.allocated_buffer);
+  EXPECT_EQ(0u, builder.capacity);
+  allocator.deallocate(path, allocator.state);
+
+  // The builder can still be used.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, "bar"));
+  EXPECT_EQ("bar", this->path());
+}
+
+TEST(TestPathBuilderAllocation, failing_allocator) {
+  rcutils_allocator_t failing_allocator = get_failing_allocator();
+  rcutils_path_builder_t builder = rcutils_get_zero_initialized_path_builder();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_init(&builder, &failing_allocator));
+
+  // Short paths don't need memory.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_set(&builder, "foo"));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_push(&builder, "bar"));
+
+  const std::string long_path(RCUTILS_PATH_BUILDER_INLINE_SIZE, 'a');
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_path_builder_set(&builder, long_path.c_str()));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC, rcutils_path_builder_push(&builder, long_path.c_str()));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_path_builder_append(&builder, long_path.c_str(), long_path.size()));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, rcutils_path_builder_reserve(&builder, SIZE_MAX));
+  rcutils_reset_error();
+  EXPECT_STREQ("foo" SEP "bar", rcutils_path_builder_get_path(&builder));
+
+  EXPECT_EQ(nullptr, rcutils_path_builder_detach(&builder));
+  rcutils_reset_error();
+  EXPECT_STREQ("foo" SEP "bar", rcutils_path_builder_get_path(&builder));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_fini(&builder));
+}
+
+TEST(TestPathBuilderAllocation, invalid_arguments) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcutils_path_builder_t builder = rcutils_get_zero_initialized_path_builder();
+
+  // A zero initialized builder can be finalized, but not modified.
+  EXPECT_STREQ("", rcutils_path_builder_get_path(&builder));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_push(&builder, "foo"));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_normalize(&builder));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, rcutils_path_builder_detach(&builder));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_fini(&builder));
+
+  rcutils_allocator_t invalid_allocator = rcutils_get_zero_initialized_allocator();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_init(&builder, &invalid_allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_init(nullptr, &allocator));
+  rcutils_reset_error();
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_path_builder_init(&builder, &allocator));
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_set(&builder, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_push(&builder, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_append(&builder, nullptr, 1));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_set(nullptr, "foo"));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_to_native(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_path_builder_fini(nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, rcutils_path_builder_get_path(nullptr));
+  EXPECT_EQ(nullptr, rcutils_path_builder_detach(nullptr));
+  EXPECT_FALSE(rcutils_path_builder_pop(nullptr));
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_path_builder_fini(&builder));
+}
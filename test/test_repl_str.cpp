@@ -14,10 +14,13 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "./allocator_testing_utils.h"
 #include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
 #include "rcutils/repl_str.h"
 
 TEST(test_repl_str, nominal) {
@@ -90,3 +93,158 @@ TEST(test_repl_str, nominal) {
     allocator.deallocate(out, allocator.state);
   }
 }
+
+// Replace the leftmost, then longest matches, the slow way.
+static std::string
+reference_repl_str_multi(
+  const std::string & str,
+  const std::vector<std::string> & from,
+  const std::vector<std::string> & to)
+{
+  std::string out;
+  size_t position = 0;
+  while (position < str.size()) {
+    size_t best_length = 0;
+    size_t best_index = 0;
+    for (size_t i = 0; i < from.size(); ++i) {
+      if (from[i].size() > best_length && 0 == str.compare(position, from[i].size(), from[i])) {
+        best_length = from[i].size();
+        best_index = i;
+      }
+    }
+    if (0 == best_length) {
+      out += str[position++];
+    } else {
+      out += to[best_index];
+      position += best_length;
+    }
+  }
+  return out;
+}
+
+TEST(test_repl_str, multi) {
+  auto allocator = rcutils_get_default_allocator();
+  auto failing_allocator = get_failing_allocator();
+  const char * from[] = {"$(env HOME)", "$(ns)", "$(node)", "~"};
+  const char * to[] = {"/home/user", "/robot", "driver", "$(env HOME)"};
+
+  rcutils_repl_str_set_t set = rcutils_get_zero_initialized_repl_str_set();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_repl_str_set_init(nullptr, from, to, 4, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_repl_str_set_init(&set, nullptr, to, 4, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_repl_str_set_init(&set, from, to, 4, nullptr));
+  rcutils_reset_error();
+  const char * empty_from[] = {"a", ""};
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_repl_str_set_init(&set, empty_from, to, 2, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC, rcutils_repl_str_set_init(&set, from, to, 4, &failing_allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_NOT_INITIALIZED, rcutils_repl_str_set_fini(&set));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, rcutils_repl_str_multi("~", &set, &allocator));
+  rcutils_reset_error();
+
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_repl_str_set_init(&set, from, to, 4, &allocator));
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_repl_str_set_init(&set, from, to, 4, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, rcutils_repl_str_multi(nullptr, &set, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, rcutils_repl_str_multi("~", nullptr, &allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, rcutils_repl_str_multi("~", &set, &failing_allocator));
+  rcutils_reset_error();
+
+  {
+    char * out = rcutils_repl_str_multi("$(ns)/$(node)/log", &set, &allocator);
+    EXPECT_STREQ("/robot/driver/log", out);
+    allocator.deallocate(out, allocator.state);
+  }
+  // Replacements are not matched again
+  {
+    char * out = rcutils_repl_str_multi("~/$(env HOME)/$(env HOME", &set, &allocator);
+    EXPECT_STREQ("$(env HOME)//home/user/$(env HOME", out);
+    allocator.deallocate(out, allocator.state);
+  }
+  {
+    char * out = rcutils_repl_str_multi("", &set, &allocator);
+    EXPECT_STREQ("", out);
+    allocator.deallocate(out, allocator.state);
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_repl_str_set_fini(&set));
+
+  // An empty set duplicates the string
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_repl_str_set_init(&set, nullptr, nullptr, 0, &allocator));
+  {
+    char * out = rcutils_repl_str_multi("foo/{bar}/baz", &set, &allocator);
+    EXPECT_STREQ("foo/{bar}/baz", out);
+    allocator.deallocate(out, allocator.state);
+  }
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_repl_str_set_fini(&set));
+}
+
+TEST(test_repl_str, multi_overlapping) {
+  auto allocator = rcutils_get_default_allocator();
+  // Sets of strings which overlap in every way, and duplicates, of which the first is used
+  const std::vector<std::vector<std::string>> pattern_sets = {
+    {"he", "she", "his", "hers"},
+    {"a", "ab", "abc", "bc", "c"},
+    {"bcd", "abcde", "cd", "x"},
+    {"ab", "cd", "abcdx"},
+    {"aa", "aaa", "a"},
+    {"ab", "ab", "b"},
+  };
+  const std::string alphabet = "abcdehirsx";
+  uint32_t seed = 42;
+  for (const auto & patterns : pattern_sets) {
+    std::vector<std::string> replacements;
+    std::vector<const char *> from;
+    std::vector<const char *> to;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+      replacements.push_back("<" + std::to_string(i) + ">");
+    }
+    for (size_t i = 0; i < patterns.size(); ++i) {
+      from.push_back(patterns[i].c_str());
+      to.push_back(replacements[i].c_str());
+    }
+    rcutils_repl_str_set_t set = rcutils_get_zero_initialized_repl_str_set();
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      rcutils_repl_str_set_init(&set, from.data(), to.data(), from.size(), &allocator));
+    for (size_t n = 0; n < 200; ++n) {
+      std::string str;
+      for (size_t length = n % 24; length > 0; --length) {
+        seed = seed * 1103515245u + 12345u;
+        str += alphabet[(seed >> 16) % (n % 2 ? 4 : alphabet.size())];
+      }
+      char * out = rcutils_repl_str_multi(str.c_str(), &set, &allocator);
+      ASSERT_NE(nullptr, out);
+      EXPECT_EQ(reference_repl_str_multi(str, patterns, replacements), out) << str;
+      allocator.deallocate(out, allocator.state);
+    }
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_repl_str_set_fini(&set));
+  }
+}
+
+TEST(test_repl_str, multi_many_matches) {
+  auto allocator = rcutils_get_default_allocator();
+  const char * from[] = {"{a}", "{b}"};
+  const char * to[] = {"aa", "b"};
+  rcutils_repl_str_set_t set = rcutils_get_zero_initialized_repl_str_set();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_repl_str_set_init(&set, from, to, 2, &allocator));
+  std::string str;
+  std::string expected;
+  for (size_t i = 0; i < 1000; ++i) {
+    str += i % 3 ? "{a}-" : "{b}";
+    expected += i % 3 ? "aa-" : "b";
+  }
+  char * out = rcutils_repl_str_multi(str.c_str(), &set, &allocator);
+  EXPECT_EQ(expected, out);
+  allocator.deallocate(out, allocator.state);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_repl_str_set_fini(&set));
+}
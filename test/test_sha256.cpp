@@ -14,9 +14,40 @@
 
 #include <gtest/gtest.h>
 
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "./allocator_testing_utils.h"
+#include "rcutils/error_handling.h"
 #include "rcutils/sha256.h"
+#include "rcutils/testing/sha256.h"
+
+// The known answers are checked with each transform the processor supports.
+class TestSHA256Transform : public ::testing::TestWithParam<rcutils_sha256_implementation_t>
+{
+public:
+  void SetUp() override
+  {
+    if (!rcutils_sha256_force_implementation(GetParam())) {
+      GTEST_SKIP() << "The transform isn't supported";
+    }
+  }
 
-TEST(TestSHA256, test_text1) {
+  void TearDown() override
+  {
+    EXPECT_TRUE(rcutils_sha256_force_implementation(RCUTILS_SHA256_IMPLEMENTATION_AUTO));
+  }
+};
+
+TEST_P(TestSHA256Transform, test_text1) {
   uint8_t text1[] = {"abc"};
   size_t text1_len = sizeof(text1) - 1;
   uint8_t expected_hash1[RCUTILS_SHA256_BLOCK_SIZE] = {
@@ -35,7 +66,7 @@ TEST(TestSHA256, test_text1) {
   ASSERT_EQ(0, memcmp(expected_hash1, buf, RCUTILS_SHA256_BLOCK_SIZE));
 }
 
-TEST(TestSHA256, test_text2) {
+TEST_P(TestSHA256Transform, test_text2) {
   uint8_t text2[] = {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"};
   size_t text2_len = sizeof(text2) - 1;
   uint8_t expected_hash2[RCUTILS_SHA256_BLOCK_SIZE] = {
@@ -53,7 +84,7 @@ TEST(TestSHA256, test_text2) {
   ASSERT_EQ(0, memcmp(expected_hash2, buf, RCUTILS_SHA256_BLOCK_SIZE));
 }
 
-TEST(TestSHA256, test_multi_update) {
+TEST_P(TestSHA256Transform, test_multi_update) {
   uint8_t text[] = {"aaaaaaaaaa"};
   size_t text_len = sizeof(text) - 1;
 
@@ -73,3 +104,297 @@ TEST(TestSHA256, test_multi_update) {
 
   ASSERT_EQ(0, memcmp(expected_hash, buf, RCUTILS_SHA256_BLOCK_SIZE));
 }
+
+TEST_P(TestSHA256Transform, test_empty) {
+  uint8_t expected_hash[RCUTILS_SHA256_BLOCK_SIZE] = {
+    0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14,
+    0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+    0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c,
+    0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55};
+  uint8_t buf[RCUTILS_SHA256_BLOCK_SIZE];
+
+  rcutils_sha256_ctx_t ctx;
+  rcutils_sha256_init(&ctx);
+  rcutils_sha256_update(&ctx, nullptr, 0);
+  rcutils_sha256_final(&ctx, buf);
+
+  ASSERT_EQ(0, memcmp(expected_hash, buf, RCUTILS_SHA256_BLOCK_SIZE));
+}
+
+TEST_P(TestSHA256Transform, test_two_blocks) {
+  uint8_t text[] = {
+    "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+    "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu"};
+  size_t text_len = sizeof(text) - 1;
+  uint8_t expected_hash[RCUTILS_SHA256_BLOCK_SIZE] = {
+    0xcf, 0x5b, 0x16, 0xa7, 0x78, 0xaf, 0x83, 0x80,
+    0x03, 0x6c, 0xe5, 0x9e, 0x7b, 0x04, 0x92, 0x37,
+    0x0b, 0x24, 0x9b, 0x11, 0xe8, 0xf0, 0x7a, 0x51,
+    0xaf, 0xac, 0x45, 0x03, 0x7a, 0xfe, 0xe9, 0xd1};
+  uint8_t buf[RCUTILS_SHA256_BLOCK_SIZE];
+
+  rcutils_sha256_ctx_t ctx;
+  rcutils_sha256_init(&ctx);
+  rcutils_sha256_update(&ctx, text, text_len);
+  rcutils_sha256_final(&ctx, buf);
+
+  ASSERT_EQ(0, memcmp(expected_hash, buf, RCUTILS_SHA256_BLOCK_SIZE));
+}
+
+TEST_P(TestSHA256Transform, test_million_a) {
+  // Many full blocks are hashed directly from the input.
+  std::vector<uint8_t> text(1000000, 'a');
+  uint8_t expected_hash[RCUTILS_SHA256_BLOCK_SIZE] = {
+    0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92,
+    0x81, 0xa1, 0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67,
+    0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e,
+    0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0};
+  uint8_t buf[RCUTILS_SHA256_BLOCK_SIZE];
+
+  rcutils_sha256_ctx_t ctx;
+  rcutils_sha256_init(&ctx);
+  rcutils_sha256_update(&ctx, text.data(), text.size());
+  rcutils_sha256_final(&ctx, buf);
+
+  ASSERT_EQ(0, memcmp(expected_hash, buf, RCUTILS_SHA256_BLOCK_SIZE));
+}
+
+TEST_P(TestSHA256Transform, test_update_sizes) {
+  std::vector<uint8_t> text(1000);
+  for (size_t i = 0; i < text.size(); ++i) {
+    text[i] = static_cast<uint8_t>(i * 31 + 7);
+  }
+  uint8_t expected_hash[RCUTILS_SHA256_BLOCK_SIZE] = {
+    0x50, 0x97, 0xe7, 0xd5, 0x87, 0x35, 0x2f, 0x50,
+    0x97, 0x06, 0x2a, 0xe6, 0x79, 0xf3, 0x7b, 0xda,
+    0x58, 0x02, 0xd9, 0xf8, 0x75, 0xab, 0xa1, 0x4c,
+    0x8c, 0xb4, 0xd1, 0xa1, 0x88, 0xad, 0xa1, 0x79};
+  uint8_t buf[RCUTILS_SHA256_BLOCK_SIZE];
+
+  // Updates of every size up to a few blocks mix buffered and directly hashed blocks.
+  for (size_t update_size = 1; update_size <= 200; ++update_size) {
+    rcutils_sha256_ctx_t ctx;
+    rcutils_sha256_init(&ctx);
+    for (size_t i = 0; i < text.size(); i += update_size) {
+      rcutils_sha256_update(&ctx, text.data() + i, std::min(update_size, text.size() - i));
+    }
+    rcutils_sha256_final(&ctx, buf);
+
+    ASSERT_EQ(0, memcmp(expected_hash, buf, RCUTILS_SHA256_BLOCK_SIZE)) << update_size;
+  }
+
+  // Input which isn't aligned.
+  std::vector<uint8_t> unaligned_text(text.size() + 1);
+  memcpy(unaligned_text.data() + 1, text.data(), text.size());
+  rcutils_sha256_ctx_t ctx;
+  rcutils_sha256_init(&ctx);
+  rcutils_sha256_update(&ctx, unaligned_text.data() + 1, text.size());
+  rcutils_sha256_final(&ctx, buf);
+
+  ASSERT_EQ(0, memcmp(expected_hash, buf, RCUTILS_SHA256_BLOCK_SIZE));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  Implementations, TestSHA256Transform,
+  ::testing::Values(
+    RCUTILS_SHA256_IMPLEMENTATION_AUTO, RCUTILS_SHA256_IMPLEMENTATION_SCALAR,
+    RCUTILS_SHA256_IMPLEMENTATION_SHANI, RCUTILS_SHA256_IMPLEMENTATION_AVX2,
+    RCUTILS_SHA256_IMPLEMENTATION_ARMV8));
+
+// The batches are checked with each number of lanes the processor supports.
+class TestSHA256Lanes : public ::testing::TestWithParam<size_t>
+{
+public:
+  void SetUp() override
+  {
+    if (!rcutils_sha256_force_lane_count(GetParam())) {
+      GTEST_SKIP() << "The lanes aren't supported";
+    }
+  }
+
+  void TearDown() override
+  {
+    EXPECT_TRUE(rcutils_sha256_force_lane_count(0));
+  }
+};
+
+TEST_P(TestSHA256Lanes, test_batch) {
+  std::vector<uint8_t> text(5000);
+  for (size_t i = 0; i < text.size(); ++i) {
+    text[i] = static_cast<uint8_t>(i * 131 + 17);
+  }
+
+  // Messages of many lengths, so that the lanes finish at different times.
+  std::vector<const uint8_t *> messages;
+  std::vector<size_t> lengths;
+  for (size_t i = 0; i < 300; ++i) {
+    size_t length = (i * 37) % 200;
+    if (0 == i % 50) {
+      length = 4000;
+    }
+    messages.push_back(0 == length ? nullptr : text.data() + i % 7);
+    lengths.push_back(length);
+  }
+
+  std::vector<uint8_t> expected_hashes(messages.size() * RCUTILS_SHA256_BLOCK_SIZE);
+  for (size_t i = 0; i < messages.size(); ++i) {
+    rcutils_sha256_ctx_t ctx;
+    rcutils_sha256_init(&ctx);
+    rcutils_sha256_update(&ctx, messages[i], lengths[i]);
+    rcutils_sha256_final(&ctx, expected_hashes.data() + i * RCUTILS_SHA256_BLOCK_SIZE);
+  }
+
+  for (size_t count : {0u, 1u, 2u, 5u, 16u, 17u, 300u}) {
+    std::vector<uint8_t> hashes(messages.size() * RCUTILS_SHA256_BLOCK_SIZE, 0);
+    rcutils_sha256_batch(messages.data(), lengths.data(), count, hashes.data());
+    EXPECT_EQ(
+      0, memcmp(expected_hashes.data(), hashes.data(), count * RCUTILS_SHA256_BLOCK_SIZE)) <<
+      count;
+    for (size_t i = count * RCUTILS_SHA256_BLOCK_SIZE; i < hashes.size(); ++i) {
+      ASSERT_EQ(0u, hashes[i]) << count;
+    }
+  }
+
+  // A known answer from a batch.
+  const uint8_t * abc = reinterpret_cast<const uint8_t *>("abc");
+  const uint8_t * batch[] = {abc, abc, abc, abc, abc};
+  size_t batch_lengths[] = {3, 3, 3, 3, 3};
+  uint8_t expected_hash[RCUTILS_SHA256_BLOCK_SIZE] = {
+    0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea,
+    0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+    0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+    0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+  uint8_t hashes[5 * RCUTILS_SHA256_BLOCK_SIZE];
+  rcutils_sha256_batch(batch, batch_lengths, 5, hashes);
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(
+      0, memcmp(expected_hash, hashes + i * RCUTILS_SHA256_BLOCK_SIZE, sizeof(expected_hash)));
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(LaneCounts, TestSHA256Lanes, ::testing::Values(0u, 1u, 4u, 8u, 16u));
+
+TEST(TestSHA256, test_force) {
+  EXPECT_TRUE(rcutils_sha256_force_implementation(RCUTILS_SHA256_IMPLEMENTATION_SCALAR));
+  EXPECT_TRUE(rcutils_sha256_force_implementation(RCUTILS_SHA256_IMPLEMENTATION_AUTO));
+
+  EXPECT_TRUE(rcutils_sha256_force_lane_count(1));
+  EXPECT_FALSE(rcutils_sha256_force_lane_count(3));
+  EXPECT_FALSE(rcutils_sha256_force_lane_count(32));
+  EXPECT_TRUE(rcutils_sha256_force_lane_count(0));
+}
+
+static std::vector<uint8_t> sha256(const uint8_t * data, size_t size)
+{
+  std::vector<uint8_t> hash(RCUTILS_SHA256_BLOCK_SIZE);
+  rcutils_sha256_ctx_t ctx;
+  rcutils_sha256_init(&ctx);
+  rcutils_sha256_update(&ctx, data, size);
+  rcutils_sha256_final(&ctx, hash.data());
+  return hash;
+}
+
+static void write_file(const char * file_path, const std::vector<uint8_t> & contents)
+{
+  FILE * file = fopen(file_path, "wb");
+  ASSERT_NE(nullptr, file);
+  EXPECT_EQ(contents.size(), fwrite(contents.data(), 1, contents.size(), file));
+  fclose(file);
+}
+
+TEST(TestSHA256, test_file) {
+  const rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  const char * file_path = "test_sha256_file.bin";
+  std::vector<uint8_t> contents(3 * 1024 * 1024 + 123);
+  for (size_t i = 0; i < contents.size(); ++i) {
+    contents[i] = static_cast<uint8_t>(i * 131 + (i >> 12));
+  }
+  write_file(file_path, contents);
+  std::vector<uint8_t> hash(RCUTILS_SHA256_BLOCK_SIZE);
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_sha256_file(file_path, allocator, hash.data()));
+  EXPECT_EQ(sha256(contents.data(), contents.size()), hash);
+
+  // A mapped file doesn't need the allocator.
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_sha256_file(file_path, get_failing_allocator(), hash.data()));
+  EXPECT_EQ(sha256(contents.data(), contents.size()), hash);
+
+  write_file(file_path, {});
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_sha256_file(file_path, allocator, hash.data()));
+  EXPECT_EQ(sha256(nullptr, 0), hash);
+  EXPECT_EQ(0, remove(file_path));
+
+  EXPECT_EQ(RCUTILS_RET_ERROR, rcutils_sha256_file(file_path, allocator, hash.data()));
+  EXPECT_TRUE(rcutils_error_is_set());
+  rcutils_reset_error();
+
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_sha256_file(nullptr, allocator, hash.data()));
+  rcutils_reset_error();
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_sha256_file(file_path, allocator, nullptr));
+  rcutils_reset_error();
+}
+
+#ifndef _WIN32
+TEST(TestSHA256, test_file_not_mappable) {
+  const char * fifo_path = "test_sha256_file.fifo";
+  (void)remove(fifo_path);
+  ASSERT_EQ(0, mkfifo(fifo_path, 0600));
+  std::vector<uint8_t> contents(2 * 1024 * 1024 + 7);
+  for (size_t i = 0; i < contents.size(); ++i) {
+    contents[i] = static_cast<uint8_t>(i * 7 + (i >> 10));
+  }
+  std::vector<uint8_t> hash(RCUTILS_SHA256_BLOCK_SIZE);
+
+  // A pipe is read instead of being mapped.
+  std::thread writer([&]() {write_file(fifo_path, contents);});
+  EXPECT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_sha256_file(fifo_path, rcutils_get_default_allocator(), hash.data()));
+  writer.join();
+  EXPECT_EQ(sha256(contents.data(), contents.size()), hash);
+
+  std::thread failed_writer([&]() {write_file(fifo_path, {});});
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_sha256_file(fifo_path, get_failing_allocator(), hash.data()));
+  rcutils_reset_error();
+  failed_writer.join();
+
+  EXPECT_EQ(0, remove(fifo_path));
+}
+#endif
+
+TEST(TestSHA256, test_file_tree) {
+  const rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  const char * file_path = "test_sha256_file_tree.bin";
+  std::vector<uint8_t> contents(1024 * 1024 + 4321);
+  for (size_t i = 0; i < contents.size(); ++i) {
+    contents[i] = static_cast<uint8_t>(i * 13 + (i >> 8));
+  }
+  write_file(file_path, contents);
+  std::vector<uint8_t> hash(RCUTILS_SHA256_BLOCK_SIZE);
+
+  for (size_t chunk_size : {1000u, 65536u, 4u * 1024u * 1024u}) {
+    std::vector<uint8_t> chunk_hashes;
+    for (size_t i = 0; i < contents.size(); i += chunk_size) {
+      std::vector<uint8_t> chunk_hash =
+        sha256(contents.data() + i, std::min(chunk_size, contents.size() - i));
+      chunk_hashes.insert(chunk_hashes.end(), chunk_hash.begin(), chunk_hash.end());
+    }
+    EXPECT_EQ(
+      RCUTILS_RET_OK, rcutils_sha256_file_tree(file_path, chunk_size, allocator, hash.data()));
+    EXPECT_EQ(sha256(chunk_hashes.data(), chunk_hashes.size()), hash) << chunk_size;
+  }
+
+  write_file(file_path, {});
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_sha256_file_tree(file_path, 1000, allocator, hash.data()));
+  EXPECT_EQ(sha256(nullptr, 0), hash);
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT, rcutils_sha256_file_tree(file_path, 0, allocator, hash.data()));
+  rcutils_reset_error();
+  EXPECT_EQ(0, remove(file_path));
+
+  EXPECT_EQ(RCUTILS_RET_ERROR, rcutils_sha256_file_tree(file_path, 1000, allocator, hash.data()));
+  rcutils_reset_error();
+}
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "./allocator_testing_utils.h"
@@ -253,3 +256,142 @@ TEST(test_split, split_last) {
   ret = rcutils_string_array_fini(&tokens8);
   ASSERT_EQ(RCUTILS_RET_OK, ret);
 }
+
+TEST(test_split, split_packed) {
+  rcutils_string_array_t tokens = rcutils_get_zero_initialized_string_array();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_split_packed("Test", '/', rcutils_get_default_allocator(), NULL));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_split_last_packed("Test", '/', rcutils_get_default_allocator(), NULL));
+  rcutils_reset_error();
+
+  // All of the tokens are stored in a single allocation
+  rcutils_allocator_t time_bomb_allocator = get_time_bomb_allocator();
+  set_time_bomb_allocator_malloc_count(time_bomb_allocator, 0);
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_split_packed("hello/world", '/', time_bomb_allocator, &tokens));
+  rcutils_reset_error();
+  set_time_bomb_allocator_malloc_count(time_bomb_allocator, 0);
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_split_last_packed("hello/world", '/', time_bomb_allocator, &tokens));
+  rcutils_reset_error();
+  set_time_bomb_allocator_malloc_count(time_bomb_allocator, 1);
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcutils_split_packed("/hello/my//world/", '/', time_bomb_allocator, &tokens));
+  ASSERT_EQ(3u, tokens.size);
+  EXPECT_STREQ("hello", tokens.data[0]);
+  EXPECT_STREQ("my", tokens.data[1]);
+  EXPECT_STREQ("world", tokens.data[2]);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&tokens));
+
+  // The packed variants give the same tokens as the classic ones
+  const char * inputs[] = {
+    "", "/", "//", "///", "hello", "/hello", "hello/", "/hello/", "hello/world", "/hello/world",
+    "hello/world/", "hello//world", "//hello//world//", "my/hello//world", "/my/hello//world/",
+    "a/b/c/d/e/f", "//a", "a//", "a/b//", "//a/b", "/a//b//c/",
+  };
+  for (const char * input : inputs) {
+    for (bool last : {false, true}) {
+      rcutils_string_array_t classic = rcutils_get_zero_initialized_string_array();
+      rcutils_string_array_t packed = rcutils_get_zero_initialized_string_array();
+      if (last) {
+        ASSERT_EQ(
+          RCUTILS_RET_OK,
+          rcutils_split_last(input, '/', rcutils_get_default_allocator(), &classic));
+        ASSERT_EQ(
+          RCUTILS_RET_OK,
+          rcutils_split_last_packed(input, '/', rcutils_get_default_allocator(), &packed));
+      } else {
+        ASSERT_EQ(
+          RCUTILS_RET_OK, rcutils_split(input, '/', rcutils_get_default_allocator(), &classic));
+        ASSERT_EQ(
+          RCUTILS_RET_OK,
+          rcutils_split_packed(input, '/', rcutils_get_default_allocator(), &packed));
+      }
+      ASSERT_EQ(classic.size, packed.size) << input << (last ? " (last)" : "");
+      for (size_t i = 0; i < classic.size; ++i) {
+        EXPECT_STREQ(classic.data[i], packed.data[i]) << input << (last ? " (last)" : "");
+      }
+      EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&classic));
+      EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&packed));
+    }
+  }
+}
+
+TEST(test_split, split_last_leading_delimiters) {
+  // The first token is empty, rather than left uninitialized
+  for (bool packed : {false, true}) {
+    rcutils_string_array_t tokens = rcutils_get_zero_initialized_string_array();
+    ASSERT_EQ(
+      RCUTILS_RET_OK,
+      (packed ? rcutils_split_last_packed : rcutils_split_last)(
+        "//a", '/', rcutils_get_default_allocator(), &tokens));
+    ASSERT_EQ(2u, tokens.size);
+    EXPECT_STREQ("", tokens.data[0]);
+    EXPECT_STREQ("a", tokens.data[1]);
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&tokens));
+  }
+}
+
+TEST(test_split, split_tokenizer) {
+  rcutils_split_tokenizer_t tokenizer;
+  const char * token = nullptr;
+  size_t token_length = 0;
+  EXPECT_EQ(RCUTILS_RET_INVALID_ARGUMENT, rcutils_split_tokenizer_init(nullptr, "a/b", '/'));
+  rcutils_reset_error();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_split_tokenizer_init(&tokenizer, nullptr, '/'));
+  EXPECT_FALSE(rcutils_split_tokenizer_next(&tokenizer, &token, &token_length));
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_split_tokenizer_init(&tokenizer, "a/b", '/'));
+  EXPECT_FALSE(rcutils_split_tokenizer_next(nullptr, &token, &token_length));
+  EXPECT_FALSE(rcutils_split_tokenizer_next(&tokenizer, nullptr, &token_length));
+  EXPECT_FALSE(rcutils_split_tokenizer_next(&tokenizer, &token, nullptr));
+
+  const char * str = "/hello/my//world/";
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_split_tokenizer_init(&tokenizer, str, '/'));
+  ASSERT_TRUE(rcutils_split_tokenizer_next(&tokenizer, &token, &token_length));
+  EXPECT_EQ(str + 1, token);
+  EXPECT_EQ(5u, token_length);
+  ASSERT_TRUE(rcutils_split_tokenizer_next(&tokenizer, &token, &token_length));
+  EXPECT_EQ(str + 7, token);
+  EXPECT_EQ(2u, token_length);
+  ASSERT_TRUE(rcutils_split_tokenizer_next(&tokenizer, &token, &token_length));
+  EXPECT_EQ(str + 11, token);
+  EXPECT_EQ(5u, token_length);
+  EXPECT_FALSE(rcutils_split_tokenizer_next(&tokenizer, &token, &token_length));
+  EXPECT_FALSE(rcutils_split_tokenizer_next(&tokenizer, &token, &token_length));
+
+  // The tokens are the same as the ones of rcutils_split(), including ones longer than the
+  // blocks searched with vector instructions, and delimiters at every position in a block.
+  std::vector<std::string> inputs = {
+    "", "/", "//", "hello", "/hello/", "hello//world", "//a", "a//", "/a//b//c/",
+    std::string(100, '/'), std::string(100, 'a'), "/" + std::string(70, 'a') + "//b/",
+  };
+  for (size_t i = 0; i < 70; ++i) {
+    std::string input(70, 'x');
+    input[i] = '/';
+    inputs.push_back(input);
+    input[69 - i / 2] = '/';
+    inputs.push_back(input);
+  }
+  for (const std::string & input : inputs) {
+    for (char delimiter : {'/', '\0'}) {
+      rcutils_string_array_t tokens = rcutils_get_zero_initialized_string_array();
+      ASSERT_EQ(
+        RCUTILS_RET_OK,
+        rcutils_split(input.c_str(), delimiter, rcutils_get_default_allocator(), &tokens));
+      ASSERT_EQ(RCUTILS_RET_OK, rcutils_split_tokenizer_init(&tokenizer, input.c_str(), delimiter));
+      for (size_t i = 0; i < tokens.size; ++i) {
+        ASSERT_TRUE(rcutils_split_tokenizer_next(&tokenizer, &token, &token_length)) << input;
+        EXPECT_EQ(std::string(tokens.data[i]), std::string(token, token_length)) << input;
+      }
+      EXPECT_FALSE(rcutils_split_tokenizer_next(&tokenizer, &token, &token_length)) << input;
+      EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&tokens));
+    }
+  }
+}
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdint>
+#include <cstring>
+
 #include "gtest/gtest.h"
 
 #include "./allocator_testing_utils.h"
@@ -328,3 +331,131 @@ TEST(test_string_array, string_array_sort) {
 
   ASSERT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&sa0));
 }
+
+TEST(test_string_array, string_array_packed) {
+  auto allocator = rcutils_get_default_allocator();
+  auto failing_allocator = get_failing_allocator();
+  rcutils_string_array_t sa = rcutils_get_zero_initialized_string_array();
+  char * characters = nullptr;
+  rcutils_ret_t ret;
+
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_string_array_init_packed(nullptr, 2, 8, &allocator, &characters));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_string_array_init_packed(&sa, 2, 8, nullptr, &characters));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcutils_string_array_init_packed(&sa, 2, 8, &allocator, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_string_array_init_packed(&sa, SIZE_MAX, 8, &allocator, &characters));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_BAD_ALLOC,
+    rcutils_string_array_init_packed(&sa, 2, 8, &failing_allocator, &characters));
+  rcutils_reset_error();
+
+  // Empty packed arrays don't allocate
+  ret = rcutils_string_array_init_packed(&sa, 0, 0, &failing_allocator, &characters);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_EQ(nullptr, sa.data);
+  EXPECT_EQ(nullptr, characters);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&sa));
+
+  set_failing_allocator_is_failing(failing_allocator, false);
+  ret = rcutils_string_array_init_packed(&sa, 3, 12, &failing_allocator, &characters);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  ASSERT_EQ(3u, sa.size);
+  EXPECT_EQ(reinterpret_cast<char *>(sa.data + 3), characters);
+  // The allocator of a packed array is a private one, which forwards to the given one.
+  EXPECT_NE(failing_allocator.allocate, sa.allocator.allocate);
+  void * forwarded = sa.allocator.allocate(4, sa.allocator.state);
+  ASSERT_NE(nullptr, forwarded);
+  sa.allocator.deallocate(forwarded, sa.allocator.state);
+  for (size_t i = 0; i < sa.size; ++i) {
+    EXPECT_EQ(nullptr, sa.data[i]);
+  }
+  const char * values[] = {"foo", "bar", "baz"};
+  for (size_t i = 0; i < sa.size; ++i) {
+    memcpy(characters + 4 * i, values[i], 4);
+    sa.data[i] = characters + 4 * i;
+  }
+
+  ret = rcutils_string_array_sort(&sa);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_STREQ("bar", sa.data[0]);
+  EXPECT_STREQ("baz", sa.data[1]);
+  EXPECT_STREQ("foo", sa.data[2]);
+
+  rcutils_string_array_t sa_unpacked = rcutils_get_zero_initialized_string_array();
+  ret = rcutils_string_array_init(&sa_unpacked, 3, &allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  sa_unpacked.data[0] = strdup("bar");
+  sa_unpacked.data[1] = strdup("baz");
+  sa_unpacked.data[2] = strdup("foo");
+  int res = 0;
+  ret = rcutils_string_array_cmp(&sa, &sa_unpacked, &res);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_EQ(0, res);
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&sa_unpacked));
+
+  // Resizing a packed array copies its strings into separate allocations
+  set_failing_allocator_is_failing(failing_allocator, true);
+  ret = rcutils_string_array_resize(&sa, 4);
+  EXPECT_EQ(RCUTILS_RET_BAD_ALLOC, ret);
+  EXPECT_EQ(3u, sa.size);
+  EXPECT_NE(failing_allocator.allocate, sa.allocator.allocate);
+  EXPECT_STREQ("bar", sa.data[0]);
+  rcutils_reset_error();
+
+  set_failing_allocator_is_failing(failing_allocator, false);
+  ret = rcutils_string_array_resize(&sa, 4);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  ASSERT_EQ(4u, sa.size);
+  EXPECT_EQ(failing_allocator.allocate, sa.allocator.allocate);
+  EXPECT_EQ(failing_allocator.state, sa.allocator.state);
+  EXPECT_STREQ("bar", sa.data[0]);
+  EXPECT_STREQ("baz", sa.data[1]);
+  EXPECT_STREQ("foo", sa.data[2]);
+  EXPECT_EQ(nullptr, sa.data[3]);
+  sa.data[3] = strdup("qux");
+
+  ret = rcutils_string_array_resize(&sa, 2);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  ASSERT_EQ(2u, sa.size);
+  EXPECT_STREQ("baz", sa.data[1]);
+
+  ret = rcutils_string_array_fini(&sa);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_EQ(failing_allocator.allocate, sa.allocator.allocate);
+
+  // Finalizing a packed array gives it back the allocator it was initialized with
+  ret = rcutils_string_array_init_packed(&sa, 1, 2, &allocator, &characters);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  memcpy(characters, "a", 2);
+  sa.data[0] = characters;
+  ret = rcutils_string_array_fini(&sa);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  EXPECT_EQ(nullptr, sa.data);
+  EXPECT_EQ(allocator.allocate, sa.allocator.allocate);
+  EXPECT_EQ(allocator.state, sa.allocator.state);
+
+  // Shrinking a packed array also unpacks it
+  ret = rcutils_string_array_init_packed(&sa, 2, 4, &allocator, &characters);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  memcpy(characters, "a\0b", 4);
+  sa.data[0] = characters;
+  sa.data[1] = characters + 2;
+  ret = rcutils_string_array_resize(&sa, 1);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+  ASSERT_EQ(1u, sa.size);
+  EXPECT_EQ(allocator.allocate, sa.allocator.allocate);
+  EXPECT_STREQ("a", sa.data[0]);
+  ret = rcutils_string_array_fini(&sa);
+  ASSERT_EQ(RCUTILS_RET_OK, ret);
+}